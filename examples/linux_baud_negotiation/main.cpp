@@ -0,0 +1,526 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example simulates baud rate negotiation between a receiver and the Serial Receiver, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_baud_negotiation/main.cpp -o linux_baud_negotiation -lutil -lpthread
+
+Usage:
+./linux_baud_negotiation
+                            Stand in for a receiver on one end of a pseudo-terminal, with the Serial Receiver on the other end.
+                            A pseudo-terminal carries bytes whatever the baud rate, so the simulated receiver keeps track of the rate
+                            that the Serial Receiver's UART is set to. While the two rates differ, every byte arrives as noise, both ways.
+                            The simulation goes through these steps, with RC channels frames at 500 Hz throughout:
+                            1. Start at 420000 baud.
+                            2. Propose 3750000 baud, which is over CRSF_BAUD_RATE_MAX and must be turned down.
+                            3. Propose 2000000 baud, which must be accepted. Both ends switch.
+                            4. The receiver reboots, and comes back at 420000 baud. The Serial Receiver must fall back.
+                            5. The receiver proposes 2000000 baud again, but misses the answer, and stays at 420000 baud.
+                               The Serial Receiver switches on its own, and must fall back again.
+                            6. In a second Serial Receiver without a wire, the sketch calls bindReceiver() just before a proposal
+                               arrives, so the answer has to wait behind the bind command. Both must go out at 420000 baud, the bind
+                               first, and the UART may only switch once the answer has gone out. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <pty.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define RC_INTERVAL_US    2000
+#define STEP_US           500000
+#define FAST_BAUD_RATE    2000000
+#define TOO_FAST          3750000
+#define RECEIVER_PORT     0
+#define RC_FRAME_SIZE     (crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD)
+#define RESPONSE_TIMEOUTS 50                                                                                                // RC frames to wait for an answer to a speed proposal.
+
+struct NegotiationConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool commandsEnabled = true;
+    static constexpr bool baudRateNegotiationEnabled = true;
+};
+
+/* Turns bytes into noise, if they are sent while the two UARTs are set to different rates. */
+static void addNoise(uint8_t *bytes, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        bytes[i] = (uint8_t)rand();
+    }
+}
+
+/* Passes everything on to the pseudo-terminal, and keeps the rate that the UART has been set to, which a pseudo-terminal ignores.
+What the flight controller sends is noise by the time it arrives, unless the simulated receiver's UART is at the same rate. */
+class RateWatchingTransport final : public hal::SerialTransport
+{
+  public:
+    std::atomic<uint32_t> baudRate;
+    std::atomic<uint32_t> receiverBaudRate;
+
+    RateWatchingTransport(hal::LinuxSerial *serial) : baudRate(0), receiverBaudRate(crsfProtocol::BAUD_RATE), _serial(serial)
+    {
+    }
+
+    void begin(unsigned long rate) override
+    {
+        _serial->begin(rate);
+        baudRate = rate;
+    }
+
+    void setBaudRate(unsigned long rate) override
+    {
+        _serial->setBaudRate(rate);
+        baudRate = rate;
+    }
+
+    void end() override
+    {
+        _serial->end();
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        return _serial->read(buffer, size);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        if (baudRate.load() == receiverBaudRate.load())
+        {
+            return _serial->write(buffer, size);
+        }
+
+        std::vector<uint8_t> noise(size);
+        addNoise(noise.data(), size);
+        return _serial->write(noise.data(), size);
+    }
+
+    void flush() override
+    {
+        _serial->flush();
+    }
+
+  private:
+    hal::LinuxSerial *_serial;
+};
+
+/* Hands the Serial Receiver the bytes that the test gives it, and keeps every frame that the Serial Receiver sends. There is no wire. */
+class ScriptedTransport final : public hal::SerialTransport
+{
+  public:
+    uint32_t baudRate = 0;
+    std::vector<uint8_t> input;
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<uint32_t> sentBaudRates; // The rate that the UART was at when each frame in sent went out.
+
+    void begin(unsigned long rate) override
+    {
+        baudRate = rate;
+    }
+
+    void setBaudRate(unsigned long rate) override
+    {
+        baudRate = rate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        const size_t count = input.size() < size ? input.size() : size;
+        memcpy(buffer, input.data(), count);
+        input.erase(input.begin(), input.begin() + count);
+        return count;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        sent.push_back(std::vector<uint8_t>(buffer, buffer + size));
+        sentBaudRates.push_back(baudRate);
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+static uint64_t nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* The simulated receiver. */
+typedef struct receiver_s
+{
+    hal::LinuxSerial *port;
+    RateWatchingTransport *flightController;
+    uint32_t baudRate;
+    uint64_t nextRcUs;
+    uint32_t rcFramesSent;
+    std::vector<uint8_t> pending;
+    int speedResponse; // -1 until an answer arrives, then whether the proposal was accepted.
+} receiver_t;
+
+static void setReceiverBaudRate(receiver_t *receiver, uint32_t baudRate)
+{
+    receiver->baudRate = baudRate;
+    receiver->flightController->receiverBaudRate = baudRate;
+    receiver->pending.clear();
+}
+
+/* Sends bytes to the flight controller. If the two UARTs are set to different rates, they arrive as noise. */
+static void sendBytes(receiver_t *receiver, const uint8_t *bytes, size_t size)
+{
+    if (receiver->baudRate == receiver->flightController->baudRate.load())
+    {
+        receiver->port->write(bytes, size);
+        return;
+    }
+
+    uint8_t noise[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    addNoise(noise, size);
+    receiver->port->write(noise, size);
+}
+
+static void readFromFlightController(receiver_t *receiver)
+{
+    genericCrc::GenericCRC crc;
+    command_t command;
+    uint8_t port;
+    uint8_t buffer[256];
+    size_t length;
+
+    while ((length = receiver->port->read(buffer, sizeof(buffer))) > 0)
+    {
+        receiver->pending.insert(receiver->pending.end(), buffer, buffer + length);
+
+        // Noise can look like anything, so only take frames that start with the sync byte, have a sane length and a matching CRC.
+        size_t position = 0;
+        while (receiver->pending.size() - position >= 2)
+        {
+            uint8_t *frame = receiver->pending.data() + position;
+            if (frame[0] != crsfProtocol::CRSF_SYNC_BYTE || frame[1] < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC ||
+                frame[1] > crsfProtocol::CRSF_FRAME_SIZE_MAX - 2)
+            {
+                position++;
+                continue;
+            }
+            if (receiver->pending.size() - position < (size_t)frame[1] + 2)
+            {
+                break;
+            }
+            if (crc.calculate(2, frame[2], frame, frame[1] + 1) != frame[frame[1] + 1])
+            {
+                position++;
+                continue;
+            }
+
+            position += frame[1] + 2;
+            if (CommandFrame::decode(frame, &command) && command.command == crsfProtocol::CRSF_COMMAND_GENERAL &&
+                command.subCommand == crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_RESPONSE && command.dataLength >= 2)
+            {
+                port = command.data[0];
+                receiver->speedResponse = port == RECEIVER_PORT ? command.data[1] : 0;
+            }
+        }
+        receiver->pending.erase(receiver->pending.begin(), receiver->pending.begin() + position);
+    }
+}
+
+static void encodeRcFrame(uint8_t *frame)
+{
+    genericCrc::GenericCRC crc;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = CRSF_RC_CHANNEL_CENTER;
+    }
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    frame[RC_FRAME_SIZE - 1] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+}
+
+/* Waits for the next RC frame's time, then sends it. */
+static void sendRcFrame(receiver_t *receiver)
+{
+    while (nowUs() < receiver->nextRcUs)
+    {
+        if (receiver->port->waitForData(1))
+        {
+            readFromFlightController(receiver);
+        }
+    }
+    receiver->nextRcUs += RC_INTERVAL_US;
+
+    uint8_t frame[RC_FRAME_SIZE];
+    encodeRcFrame(frame);
+    sendBytes(receiver, frame, sizeof(frame));
+    receiver->rcFramesSent++;
+}
+
+static void sendRcFrames(receiver_t *receiver, uint64_t durationUs)
+{
+    const uint64_t endUs = nowUs() + durationUs;
+    while (nowUs() < endUs)
+    {
+        sendRcFrame(receiver);
+    }
+}
+
+/* Proposes baudRate, and returns the answer: 1 if it was accepted, 0 if not, -1 if none came. */
+static int propose(receiver_t *receiver, uint32_t baudRate)
+{
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    const uint8_t length = CommandFrame::encodeSpeedProposal(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER,
+                                                             RECEIVER_PORT, baudRate, frame);
+    receiver->speedResponse = -1;
+    sendBytes(receiver, frame, length);
+    for (int i = 0; i < RESPONSE_TIMEOUTS && receiver->speedResponse < 0; i++)
+    {
+        sendRcFrame(receiver);
+    }
+    return receiver->speedResponse;
+}
+
+/* Sends RC frames until the flight controller's UART is at baudRate, and returns how long that took, in milliseconds. */
+static double waitForRate(receiver_t *receiver, uint32_t baudRate, uint64_t timeoutUs)
+{
+    const uint64_t startUs = nowUs();
+    while (receiver->flightController->baudRate.load() != baudRate && nowUs() - startUs < timeoutUs)
+    {
+        sendRcFrame(receiver);
+    }
+    const double elapsedMs = (nowUs() - startUs) / 1000.0;
+
+    // Let the last frame be decoded, so that it is not counted with the frames that follow.
+    usleep(10000);
+    return elapsedMs;
+}
+
+/* Step 6. Everything runs in this thread, with RC channels frames handed over at RC_INTERVAL_US apart, as a receiver sends them.
+Returns true if the bind command and then the answer that accepts the proposal went out at 420000 baud, and the UART switched after that. */
+static bool commandWhileAnswerWaits()
+{
+    ScriptedTransport transport;
+    BasicSerialReceiver<NegotiationConfig> flightController(&transport);
+    uint8_t rcFrame[RC_FRAME_SIZE];
+    uint8_t proposal[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    encodeRcFrame(rcFrame);
+    const uint8_t proposalLength = CommandFrame::encodeSpeedProposal(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER,
+                                                                     RECEIVER_PORT, FAST_BAUD_RATE, proposal);
+    flightController.begin();
+
+    // The sketch asks for a bind, and before its telemetry slot comes round, the proposal arrives. Its answer queues behind the bind.
+    const int proposalBurst = 20;
+    bool bindQueued = false;
+    for (int burst = 0; burst < proposalBurst + 5; burst++)
+    {
+        if (burst == proposalBurst)
+        {
+            bindQueued = flightController.bindReceiver();
+            transport.input.insert(transport.input.end(), proposal, proposal + proposalLength);
+            flightController.processFrames();
+        }
+
+        transport.input.insert(transport.input.end(), rcFrame, rcFrame + sizeof(rcFrame));
+        flightController.processFrames();
+        usleep(RC_INTERVAL_US);
+    }
+
+    int answerPosition = -1;
+    int bindPosition = -1;
+    bool sentBeforeSwitching = true;
+    for (size_t i = 0; i < transport.sent.size(); i++)
+    {
+        command_t command;
+        if (!CommandFrame::decode(transport.sent[i].data(), &command))
+        {
+            continue;
+        }
+
+        if (command.command == crsfProtocol::CRSF_COMMAND_GENERAL && command.subCommand == crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_RESPONSE &&
+            command.dataLength >= 2 && command.data[1] != 0 && answerPosition < 0)
+        {
+            answerPosition = (int)i;
+            sentBeforeSwitching = sentBeforeSwitching && transport.sentBaudRates[i] == crsfProtocol::BAUD_RATE;
+        }
+        else if (command.command == crsfProtocol::CRSF_COMMAND_RX && command.subCommand == crsfProtocol::CRSF_COMMAND_RX_BIND && bindPosition < 0)
+        {
+            bindPosition = (int)i;
+            sentBeforeSwitching = sentBeforeSwitching && transport.sentBaudRates[i] == crsfProtocol::BAUD_RATE;
+        }
+    }
+
+    const bool switched = transport.baudRate == FAST_BAUD_RATE;
+    printf("6. Bind command just before a proposal: bind %s, answer %s, %s, the UART is at %u baud\n",
+           bindPosition >= 0 ? "sent" : bindQueued ? "queued but not sent" : "refused", answerPosition >= 0 ? "sent" : "not sent",
+           sentBeforeSwitching ? "both before switching" : "not both before switching", transport.baudRate);
+    flightController.end();
+    return switched && sentBeforeSwitching && bindPosition >= 0 && answerPosition > bindPosition;
+}
+
+int main()
+{
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    hal::LinuxSerial receiverPort(master);
+    hal::LinuxSerial flightControllerPort(slave);
+    RateWatchingTransport transport(&flightControllerPort);
+    receiverPort.begin(crsfProtocol::BAUD_RATE);
+
+    BasicSerialReceiver<NegotiationConfig> flightController(&transport);
+    if (!flightController.begin())
+    {
+        fprintf(stderr, "Could not start the Serial Receiver\n");
+        return 1;
+    }
+
+    std::mutex lock;
+    std::atomic<bool> running(true);
+    std::thread flightControllerThread([&]() {
+        while (running.load())
+        {
+            flightControllerPort.waitForData(1);
+            std::lock_guard<std::mutex> guard(lock);
+            flightController.processFrames();
+        }
+    });
+
+    auto rcFramesDecoded = [&]() {
+        serialReceiverCounters_t counters;
+        std::lock_guard<std::mutex> guard(lock);
+        flightController.getCounters(&counters);
+        return counters.crsf.rcChannelsFrames;
+    };
+
+    receiver_t receiver = receiver_t();
+    receiver.port = &receiverPort;
+    receiver.flightController = &transport;
+    receiver.baudRate = crsfProtocol::BAUD_RATE;
+    receiver.nextRcUs = nowUs();
+    bool ok = true;
+
+    printf("Wire time of one RC channels frame: %.0f us at 420000 baud, %.0f us at %u baud, %.0f us at %u baud\n",
+           RC_FRAME_SIZE * 10 * 1e6 / crsfProtocol::BAUD_RATE, RC_FRAME_SIZE * 10 * 1e6 / FAST_BAUD_RATE, FAST_BAUD_RATE,
+           RC_FRAME_SIZE * 10 * 1e6 / TOO_FAST, TOO_FAST);
+
+    // 1. 420000 baud.
+    uint32_t sentBefore = receiver.rcFramesSent;
+    uint32_t decodedBefore = rcFramesDecoded();
+    sendRcFrames(&receiver, STEP_US);
+    usleep(10000);
+    uint32_t decoded = rcFramesDecoded() - decodedBefore;
+    printf("1. At 420000 baud: %u of %u RC frames decoded\n", decoded, receiver.rcFramesSent - sentBefore);
+    ok = ok && decoded == receiver.rcFramesSent - sentBefore;
+
+    // 2. Too fast.
+    int answer = propose(&receiver, TOO_FAST);
+    printf("2. Proposed %u baud: %s, the UART is at %u baud\n", TOO_FAST, answer == 0 ? "turned down" : answer > 0 ? "accepted" : "no answer",
+           transport.baudRate.load());
+    ok = ok && answer == 0 && transport.baudRate.load() == crsfProtocol::BAUD_RATE;
+
+    // 3. Accepted. The receiver switches as soon as it has the answer, and the flight controller once the answer has gone out.
+    sentBefore = receiver.rcFramesSent;
+    decodedBefore = rcFramesDecoded();
+    answer = propose(&receiver, FAST_BAUD_RATE);
+    if (answer > 0)
+    {
+        setReceiverBaudRate(&receiver, FAST_BAUD_RATE);
+    }
+    sendRcFrames(&receiver, STEP_US);
+    usleep(10000);
+    decoded = rcFramesDecoded() - decodedBefore;
+    printf("3. Proposed %u baud: %s, the UART is at %u baud, %u of %u RC frames decoded\n", FAST_BAUD_RATE,
+           answer > 0 ? "accepted" : answer == 0 ? "turned down" : "no answer", transport.baudRate.load(), decoded, receiver.rcFramesSent - sentBefore);
+    ok = ok && answer > 0 && transport.baudRate.load() == FAST_BAUD_RATE && decoded + 1 >= receiver.rcFramesSent - sentBefore;
+
+    // 4. The receiver reboots, and comes back at 420000 baud.
+    setReceiverBaudRate(&receiver, crsfProtocol::BAUD_RATE);
+    double fallbackMs = waitForRate(&receiver, crsfProtocol::BAUD_RATE, 4 * NegotiationConfig::baudRateFallbackTimeout * 1000ULL);
+    sentBefore = receiver.rcFramesSent;
+    decodedBefore = rcFramesDecoded();
+    sendRcFrames(&receiver, STEP_US);
+    usleep(10000);
+    decoded = rcFramesDecoded() - decodedBefore;
+    printf("4. Receiver rebooted: fell back after %.0f ms, then %u of %u RC frames decoded\n", fallbackMs, decoded,
+           receiver.rcFramesSent - sentBefore);
+    ok = ok && transport.baudRate.load() == crsfProtocol::BAUD_RATE && decoded == receiver.rcFramesSent - sentBefore;
+
+    // 5. The answer is lost, so the receiver stays at 420000 baud.
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    sendBytes(&receiver, frame, CommandFrame::encodeSpeedProposal(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER,
+                                                                  RECEIVER_PORT, FAST_BAUD_RATE, frame));
+    const double switchMs = waitForRate(&receiver, FAST_BAUD_RATE, STEP_US);
+    fallbackMs = waitForRate(&receiver, crsfProtocol::BAUD_RATE, 4 * NegotiationConfig::baudRateFallbackTimeout * 1000ULL);
+    sentBefore = receiver.rcFramesSent;
+    decodedBefore = rcFramesDecoded();
+    sendRcFrames(&receiver, STEP_US);
+    usleep(10000);
+    decoded = rcFramesDecoded() - decodedBefore;
+    printf("5. Answer lost: switched after %.1f ms, fell back after %.0f ms, then %u of %u RC frames decoded\n", switchMs,
+           fallbackMs, decoded, receiver.rcFramesSent - sentBefore);
+    ok = ok && transport.baudRate.load() == crsfProtocol::BAUD_RATE && decoded == receiver.rcFramesSent - sentBefore;
+
+    running = false;
+    flightControllerThread.join();
+
+    ok = commandWhileAnswerWaits() && ok;
+
+    serialReceiverCounters_t counters;
+    flightController.getCounters(&counters);
+    printf("Counters: %u baud rate changes, %u fallbacks, %u commands, %u CRC errors\n", counters.baudRateChanges, counters.baudRateFallbacks,
+           counters.commands, counters.crsf.crcErrors);
+    ok = ok && counters.baudRateChanges == 2 && counters.baudRateFallbacks == 2;
+    printf("Baud rate negotiation %s\n", ok ? "OK" : "FAILED");
+
+    flightController.end();
+    close(master);
+    close(slave);
+    return ok ? 0 : 1;
+}
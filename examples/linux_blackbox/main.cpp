@@ -0,0 +1,522 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example logs RC channels and link statistics with the blackbox logger on a Linux host, and decodes the logs.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_blackbox/main.cpp -o linux_blackbox -lutil -lpthread
+
+Usage:
+./linux_blackbox --benchmark            Log three simulated 60 second flights at 500 Hz (on the ground, hovering and acro),
+                                        check that each log decodes back to the same values, and report the
+                                        compression ratio and the encode time per frame.
+./linux_blackbox --simulate <log file>  Write the simulated acro flight to <log file>.
+./linux_blackbox <log file> [csv file]  Decode a blackbox log into CSV, one row per record.
+                                        Without [csv file], the CSV goes to stdout.
+
+On a board, set CRSF_BLACKBOX_ENABLED to 1 and hand a BlackboxLogger to SerialReceiver::setBlackbox(),
+with a BlackboxSink that writes to an SD card or flash chip. */
+
+#include "SerialReceiver/Blackbox/Blackbox.hpp"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define FLIGHT_PACKET_RATE          500 // Hz.
+#define FLIGHT_SECONDS              60
+#define FLIGHT_LINK_STATISTICS_RATE 4   // One link statistics frame every this many RC channels frames.
+#define BENCHMARK_REPEATS           5
+
+typedef enum flightProfile_e
+{
+    FLIGHT_GROUND = 0,
+    FLIGHT_HOVER,
+    FLIGHT_ACRO,
+    FLIGHT_PROFILE_COUNT
+} flightProfile_t;
+
+static const char *flightProfileNames[FLIGHT_PROFILE_COUNT] = {"On the ground", "Hovering", "Acro"};
+
+typedef struct flightFrame_s
+{
+    uint32_t timestamp;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    bool hasLinkStatistics;
+    link_statistics_t linkStatistics;
+} flightFrame_t;
+
+/* Keeps the logged bytes in memory. */
+class MemorySink final : public BlackboxSink
+{
+  public:
+    std::vector<uint8_t> data;
+
+    void write(const uint8_t *buffer, size_t length) override
+    {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+};
+
+/* Decodes a blackbox log, one record at a time. */
+class BlackboxReader
+{
+  public:
+    uint32_t timestamp = 0;
+    uint8_t recordType = 0;
+    bool failsafe = false;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    link_statistics_t linkStatistics;
+
+    BlackboxReader(const uint8_t *data, size_t length)
+    {
+        _data = data;
+        _length = length;
+        _position = 0;
+        memset(channels, 0, sizeof(channels));
+    }
+
+    bool readHeader()
+    {
+        if (_length < BLACKBOX_HEADER_SIZE || memcmp(_data, "CFAB", 4) != 0)
+        {
+            return false;
+        }
+
+        const uint16_t version = (uint16_t)(_data[4] | (_data[5] << 8));
+        if (version != BLACKBOX_VERSION || _data[6] != crsfProtocol::RC_CHANNEL_COUNT)
+        {
+            return false;
+        }
+
+        _position = BLACKBOX_HEADER_SIZE;
+        return true;
+    }
+
+    /* Returns false at the end of the log, or if the log is damaged. */
+    bool next()
+    {
+        if (_position >= _length)
+        {
+            return false;
+        }
+
+        const uint8_t tag = _data[_position++];
+        recordType = tag & ~BLACKBOX_FAILSAFE_FLAG;
+        uint32_t value;
+
+        switch (recordType)
+        {
+            case BLACKBOX_RECORD_KEYFRAME:
+                failsafe = (tag & BLACKBOX_FAILSAFE_FLAG) != 0;
+                if (!_readVarint(&timestamp))
+                {
+                    return false;
+                }
+                for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+                {
+                    if (!_readVarint(&value))
+                    {
+                        return false;
+                    }
+                    channels[i] = (uint16_t)value;
+                }
+                return true;
+
+            case BLACKBOX_RECORD_DELTA:
+            {
+                failsafe = (tag & BLACKBOX_FAILSAFE_FLAG) != 0;
+                uint32_t changed;
+                if (!_readVarint(&value) || !_readVarint(&changed))
+                {
+                    return false;
+                }
+                timestamp += value;
+                for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+                {
+                    if (changed & (1UL << i))
+                    {
+                        if (!_readVarint(&value))
+                        {
+                            return false;
+                        }
+                        channels[i] = (uint16_t)(channels[i] + _unZigZag(value));
+                    }
+                }
+                return true;
+            }
+
+            case BLACKBOX_RECORD_LINK_STATISTICS:
+            {
+                uint32_t rssi, lqi, snr, txPower;
+                if (!_readVarint(&value) || !_readVarint(&rssi) || !_readVarint(&lqi) || !_readVarint(&snr) || !_readVarint(&txPower))
+                {
+                    return false;
+                }
+                timestamp += value;
+                linkStatistics.rssi = (int16_t)_unZigZag(rssi);
+                linkStatistics.lqi = (int16_t)_unZigZag(lqi);
+                linkStatistics.snr = (int16_t)_unZigZag(snr);
+                linkStatistics.tx_power = (int16_t)_unZigZag(txPower);
+                return true;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+  private:
+    const uint8_t *_data;
+    size_t _length;
+    size_t _position;
+
+    bool _readVarint(uint32_t *value)
+    {
+        *value = 0;
+        for (int shift = 0; shift < 35 && _position < _length; shift += 7)
+        {
+            const uint8_t byte = _data[_position++];
+            *value |= (uint32_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int32_t _unZigZag(uint32_t value)
+    {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+};
+
+/* A small, repeatable random number generator, so that every run simulates the same flights. */
+static uint32_t randomState = 0x12345678;
+
+static uint32_t nextRandom()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static int noise(int amplitude)
+{
+    return (int)(nextRandom() % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+static uint16_t clampChannel(int value)
+{
+    return (uint16_t)constrain(value, 172, 1811);
+}
+
+/* Simulates the sticks, switches and link of one flight. */
+static std::vector<flightFrame_t> simulateFlight(flightProfile_t profile)
+{
+    std::vector<flightFrame_t> frames;
+    const uint32_t frameCount = FLIGHT_PACKET_RATE * FLIGHT_SECONDS;
+    frames.reserve(frameCount);
+    randomState = 0x12345678 + profile;
+
+    link_statistics_t linkStatistics;
+    linkStatistics.rssi = 60;
+    linkStatistics.lqi = 100;
+    linkStatistics.snr = 10;
+    linkStatistics.tx_power = 100;
+
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        const float t = (float)i / FLIGHT_PACKET_RATE;
+        flightFrame_t frame = {};
+        frame.timestamp = 1000000 + (i * (1000000 / FLIGHT_PACKET_RATE)) + (uint32_t)noise(20);
+
+        /* Switches: arm on Aux1, a three position mode switch on Aux2 that moves every 10 seconds. The rest stay put. */
+        for (size_t channel = 4; channel < crsfProtocol::RC_CHANNEL_COUNT; channel++)
+        {
+            frame.channels[channel] = 992;
+        }
+        frame.channels[crsfProtocol::RC_CHANNEL_AUX1] = profile == FLIGHT_GROUND ? 172 : 1811;
+        frame.channels[crsfProtocol::RC_CHANNEL_AUX2] = profile == FLIGHT_ACRO ? (uint16_t)(172 + (((i / (FLIGHT_PACKET_RATE * 10)) % 3) * 819)) : 172;
+
+        switch (profile)
+        {
+            case FLIGHT_GROUND:
+                // Sticks centred, with the odd count of jitter from the gimbals.
+                frame.channels[crsfProtocol::RC_CHANNEL_ROLL] = clampChannel(992 + (nextRandom() % 10 == 0 ? noise(1) : 0));
+                frame.channels[crsfProtocol::RC_CHANNEL_PITCH] = clampChannel(992 + (nextRandom() % 10 == 0 ? noise(1) : 0));
+                frame.channels[crsfProtocol::RC_CHANNEL_THROTTLE] = 172;
+                frame.channels[crsfProtocol::RC_CHANNEL_YAW] = clampChannel(992 + (nextRandom() % 10 == 0 ? noise(1) : 0));
+                break;
+
+            case FLIGHT_HOVER:
+                // Small corrections around the centre, and a slowly drifting throttle.
+                frame.channels[crsfProtocol::RC_CHANNEL_ROLL] = clampChannel(992 + (int)(30 * sinf(t * 0.7F)) + noise(3));
+                frame.channels[crsfProtocol::RC_CHANNEL_PITCH] = clampChannel(992 + (int)(30 * sinf(t * 0.5F + 1.0F)) + noise(3));
+                frame.channels[crsfProtocol::RC_CHANNEL_THROTTLE] = clampChannel(900 + (int)(40 * sinf(t * 0.2F)) + noise(2));
+                frame.channels[crsfProtocol::RC_CHANNEL_YAW] = clampChannel(992 + noise(3));
+                break;
+
+            default:
+                // Full stick movements: flips, rolls and throttle punches.
+                frame.channels[crsfProtocol::RC_CHANNEL_ROLL] = clampChannel(992 + (int)(800 * sinf(t * 6.0F)) + noise(2));
+                frame.channels[crsfProtocol::RC_CHANNEL_PITCH] = clampChannel(992 + (int)(600 * sinf(t * 4.0F + 1.0F)) + noise(2));
+                frame.channels[crsfProtocol::RC_CHANNEL_THROTTLE] = clampChannel(992 + (int)(700 * sinf(t * 1.5F)) + noise(2));
+                frame.channels[crsfProtocol::RC_CHANNEL_YAW] = clampChannel(992 + (int)(400 * sinf(t * 3.0F + 2.0F)) + noise(2));
+                break;
+        }
+
+        if (i % FLIGHT_LINK_STATISTICS_RATE == 0)
+        {
+            // RSSI wanders by a dB now and then. Link quality drops for a moment once in a while.
+            if (nextRandom() % 8 == 0)
+            {
+                linkStatistics.rssi = (int16_t)constrain(linkStatistics.rssi + noise(1), 40, 110);
+            }
+            if (nextRandom() % 16 == 0)
+            {
+                linkStatistics.snr = (int16_t)constrain(linkStatistics.snr + noise(1), -5, 15);
+            }
+            linkStatistics.lqi = nextRandom() % 50 == 0 ? (int16_t)(90 + noise(5)) : 100;
+
+            frame.hasLinkStatistics = true;
+            frame.linkStatistics = linkStatistics;
+        }
+
+        frames.push_back(frame);
+    }
+
+    return frames;
+}
+
+static void logFlight(BlackboxLogger *logger, MemorySink *sink, const std::vector<flightFrame_t> &frames)
+{
+    logger->begin(sink);
+    for (const flightFrame_t &frame : frames)
+    {
+        logger->logRcChannels(frame.channels, false, frame.timestamp);
+        if (frame.hasLinkStatistics)
+        {
+            logger->logLinkStatistics(&frame.linkStatistics, frame.timestamp);
+        }
+    }
+    logger->end();
+}
+
+/* Decodes the log and checks every channel record against the frames that went in. */
+static bool verifyFlight(const MemorySink &sink, const std::vector<flightFrame_t> &frames)
+{
+    BlackboxReader reader(sink.data.data(), sink.data.size());
+    if (!reader.readHeader())
+    {
+        return false;
+    }
+
+    size_t frame = 0;
+    while (reader.next())
+    {
+        if (reader.recordType == BLACKBOX_RECORD_LINK_STATISTICS)
+        {
+            continue;
+        }
+
+        if (frame >= frames.size() || reader.timestamp != frames[frame].timestamp ||
+            memcmp(reader.channels, frames[frame].channels, sizeof(reader.channels)) != 0)
+        {
+            return false;
+        }
+        frame++;
+    }
+
+    return frame == frames.size();
+}
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static int benchmark()
+{
+    printf("%u seconds at %u Hz, link statistics every %u frames, best of %u\n\n",
+           FLIGHT_SECONDS, FLIGHT_PACKET_RATE, FLIGHT_LINK_STATISTICS_RATE, BENCHMARK_REPEATS);
+    printf("%-14s %10s %10s %7s %10s %9s %11s %8s\n", "Flight", "Raw", "Logged", "Ratio", "Bytes/s", "B/frame", "ns/frame", "Decodes");
+
+    bool allDecoded = true;
+    for (int profile = 0; profile < FLIGHT_PROFILE_COUNT; profile++)
+    {
+        const std::vector<flightFrame_t> frames = simulateFlight((flightProfile_t)profile);
+
+        BlackboxLogger logger;
+        MemorySink sink;
+        double perFrame = 0;
+        for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+        {
+            sink.data.clear();
+            sink.data.reserve(frames.size() * BLACKBOX_RECORD_SIZE_MAX);
+
+            const uint64_t start = monotonicNanoseconds();
+            logFlight(&logger, &sink, frames);
+            const double repeatPerFrame = (double)(monotonicNanoseconds() - start) / (double)frames.size();
+
+            if (repeat == 0 || repeatPerFrame < perFrame)
+            {
+                perFrame = repeatPerFrame;
+            }
+        }
+
+        blackboxStatistics_t statistics;
+        logger.getStatistics(&statistics);
+        const bool decoded = verifyFlight(sink, frames);
+        allDecoded = allDecoded && decoded;
+
+        printf("%-14s %10u %10u %6.1fx %10.0f %9.2f %11.1f %8s\n", flightProfileNames[profile],
+               statistics.bytesRaw, statistics.bytesWritten, (double)statistics.bytesRaw / statistics.bytesWritten,
+               (double)statistics.bytesWritten / FLIGHT_SECONDS, (double)statistics.bytesWritten / frames.size(), perFrame,
+               decoded ? "yes" : "NO");
+    }
+
+    printf("\nRaw is a 4 byte timestamp and the values as plain integers for every frame (36 bytes per RC channels frame).\n");
+    printf("ns/frame includes the calls to a sink that appends to memory.\n");
+    return allDecoded ? 0 : 1;
+}
+
+static int simulate(const char *path)
+{
+    const std::vector<flightFrame_t> frames = simulateFlight(FLIGHT_ACRO);
+    BlackboxLogger logger;
+    MemorySink sink;
+    logFlight(&logger, &sink, frames);
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr || fwrite(sink.data.data(), 1, sink.data.size(), file) != sink.data.size())
+    {
+        perror(path);
+        return 1;
+    }
+    fclose(file);
+
+    printf("Wrote %zu bytes to %s\n", sink.data.size(), path);
+    return 0;
+}
+
+static int decode(const char *inputPath, const char *outputPath)
+{
+    FILE *in = fopen(inputPath, "rb");
+    if (in == nullptr)
+    {
+        perror(inputPath);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), in)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+    fclose(in);
+
+    BlackboxReader reader(data.data(), data.size());
+    if (!reader.readHeader())
+    {
+        fprintf(stderr, "%s is not a CRSF for Arduino blackbox log.\n", inputPath);
+        return 1;
+    }
+
+    FILE *out = outputPath != nullptr ? fopen(outputPath, "w") : stdout;
+    if (out == nullptr)
+    {
+        perror(outputPath);
+        return 1;
+    }
+
+    fprintf(out, "time_us,record,failsafe");
+    for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        fprintf(out, ",ch%zu", i + 1);
+    }
+    fprintf(out, ",rssi,lqi,snr,tx_power\n");
+
+    uint32_t records = 0;
+    while (reader.next())
+    {
+        if (reader.recordType == BLACKBOX_RECORD_LINK_STATISTICS)
+        {
+            fprintf(out, "%u,link,,", reader.timestamp);
+            for (size_t i = 1; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                fprintf(out, ",");
+            }
+            fprintf(out, ",%d,%d,%d,%d\n", reader.linkStatistics.rssi, reader.linkStatistics.lqi, reader.linkStatistics.snr, reader.linkStatistics.tx_power);
+        }
+        else
+        {
+            fprintf(out, "%u,%s,%d", reader.timestamp, reader.recordType == BLACKBOX_RECORD_KEYFRAME ? "key" : "delta", reader.failsafe ? 1 : 0);
+            for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                fprintf(out, ",%u", reader.channels[i]);
+            }
+            fprintf(out, ",,,,\n");
+        }
+        records++;
+    }
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    fprintf(stderr, "Decoded %u records.\n", records);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0)
+    {
+        return benchmark();
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "--simulate") == 0)
+    {
+        return simulate(argv[2]);
+    }
+
+    if (argc >= 2 && argv[1][0] != '-')
+    {
+        return decode(argv[1], argc >= 3 ? argv[2] : nullptr);
+    }
+
+    printf("Usage: %s --benchmark | --simulate <log file> | <log file> [csv file]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,482 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example relays CRSF frames between a receiver and a flight controller on a Linux host, or measures how much latency the relay adds over two pseudo-terminals.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_bridge/main.cpp -o linux_bridge -lutil -lpthread
+
+Usage:
+./linux_bridge <receiver tty> <flight controller tty> [--baud n] [--override channel=value]...
+                            Relay frames between a receiver and a flight controller, forcing each overridden channel
+                            (numbered from 0) to its value. Prints the statistics once a second. Ctrl+C stops.
+./linux_bridge --latency [seconds] [--rate hz]
+                            Send RC channels frames through the bridge over two pseudo-terminals, with telemetry coming back,
+                            and time each frame from the moment it was written to the moment it was read on the far side.
+                            The same is then done through a plain byte copying relay, and the difference is what the bridge adds. */
+
+#include "SerialReceiver/Bridge/Bridge.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define LATENCY_SECONDS  10
+#define LATENCY_RATE_HZ  500
+#define LATENCY_OVERRIDE 4   // The channel that the bridge overrides during the latency run.
+#define TELEMETRY_EVERY  10  // The emulated flight controller sends a battery frame back every this many RC frames.
+#define SEQUENCE_CHANNEL 1   // Channels 1 and 2 carry the frame's sequence number, 11 bits each.
+
+static volatile bool keepRunning = true;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint16_t expectedChannel(uint8_t channel)
+{
+    return (uint16_t)(CRSF_RC_CHANNEL_MIN + 97 * channel);
+}
+
+static size_t buildRcFrame(uint32_t sequence, uint8_t *frame)
+{
+    genericCrc::GenericCRC crc;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = expectedChannel(i);
+    }
+    channels[SEQUENCE_CHANNEL] = (uint16_t)(sequence & 0x07FF);
+    channels[SEQUENCE_CHANNEL + 1] = (uint16_t)((sequence >> 11) & 0x07FF);
+
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    frame[3 + crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+    return crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+static size_t buildBatteryFrame(uint8_t *frame)
+{
+    genericCrc::GenericCRC crc;
+    const uint8_t payload[crsfProtocol::CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE] = {0x00, 0xA8, 0x00, 0x0C, 0x00, 0x01, 0xC2, 80};
+
+    frame[0] = crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER;
+    frame[1] = crsfProtocol::CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR;
+    memcpy(frame + 3, payload, sizeof(payload));
+    frame[3 + sizeof(payload)] = crc.calculate(frame[2], frame + 3, sizeof(payload));
+    return sizeof(payload) + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+/**
+ * @brief Splits a clean byte stream into frames, and hands each one with a valid CRC to onFrame.
+ *
+ * @return The number of frames with a bad CRC.
+ */
+template <typename F>
+static uint32_t splitFrames(std::vector<uint8_t> *pending, const uint8_t *data, size_t length, F onFrame)
+{
+    genericCrc::GenericCRC crc;
+    uint32_t crcErrors = 0;
+
+    pending->insert(pending->end(), data, data + length);
+    size_t position = 0;
+    while (pending->size() - position >= 2 && pending->size() - position >= (size_t)(*pending)[position + 1] + 2)
+    {
+        uint8_t *frame = pending->data() + position;
+        const uint8_t payloadLength = frame[1] - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        if (crc.calculate(frame[2], frame + 3, payloadLength) == frame[frame[1] + 1])
+        {
+            onFrame(frame);
+        }
+        else
+        {
+            crcErrors++;
+        }
+        position += frame[1] + 2;
+    }
+    pending->erase(pending->begin(), pending->begin() + position);
+    return crcErrors;
+}
+
+typedef struct latencyResult_s
+{
+    std::vector<double> latenciesUs;
+    uint32_t framesSent;
+    uint32_t framesReceived;
+    uint32_t channelMismatches;
+    uint32_t crcErrors;
+    uint32_t telemetrySent;
+    uint32_t telemetryReceived;
+} latencyResult_t;
+
+/**
+ * @brief Sends RC channels frames into one pseudo-terminal and reads them out of the other, with either the bridge
+ * or a plain byte copying relay in between.
+ */
+static latencyResult_t measureLatency(bool useBridge, uint32_t seconds, uint32_t rateHz)
+{
+    latencyResult_t result = latencyResult_t();
+    int receiverMaster, receiverSlave, flightControllerMaster, flightControllerSlave;
+    if (openpty(&receiverMaster, &receiverSlave, nullptr, nullptr, nullptr) != 0 ||
+        openpty(&flightControllerMaster, &flightControllerSlave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return result;
+    }
+
+    // The bridge (or the relay) owns the slave ends. The master ends stand in for the receiver and the flight controller.
+    hal::LinuxSerial receiverEnd(receiverMaster);
+    hal::LinuxSerial flightControllerEnd(flightControllerMaster);
+    hal::LinuxSerial receiverPort(receiverSlave);
+    hal::LinuxSerial flightControllerPort(flightControllerSlave);
+    receiverEnd.begin(crsfProtocol::BAUD_RATE);
+    flightControllerEnd.begin(crsfProtocol::BAUD_RATE);
+
+    Bridge bridge(&receiverPort, &flightControllerPort);
+    bridge.begin();
+    bridge.setChannelOverride(LATENCY_OVERRIDE, CRSF_RC_CHANNEL_MAX);
+
+    const uint32_t frameCount = seconds * rateHz;
+    std::vector<uint64_t> sentNs(frameCount, 0);
+    std::atomic<bool> running(true);
+
+    std::thread relayThread([&]() {
+        struct pollfd pfds[2] = {{receiverSlave, POLLIN, 0}, {flightControllerSlave, POLLIN, 0}};
+        uint8_t buffer[BRIDGE_READ_SIZE];
+        while (running.load())
+        {
+            if (poll(pfds, 2, 10) <= 0)
+            {
+                continue;
+            }
+
+            if (useBridge)
+            {
+                bridge.update();
+                continue;
+            }
+
+            size_t length;
+            while ((length = receiverPort.read(buffer, sizeof(buffer))) > 0)
+            {
+                flightControllerPort.write(buffer, length);
+            }
+            while ((length = flightControllerPort.read(buffer, sizeof(buffer))) > 0)
+            {
+                receiverPort.write(buffer, length);
+            }
+        }
+    });
+
+    // The emulated flight controller.
+    std::thread sinkThread([&]() {
+        std::vector<uint8_t> pending;
+        uint8_t buffer[256];
+        uint8_t telemetry[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        const size_t telemetryLength = buildBatteryFrame(telemetry);
+
+        while (running.load())
+        {
+            if (!flightControllerEnd.waitForData(10))
+            {
+                continue;
+            }
+
+            const uint64_t arrivedNs = nowNs();
+            const size_t length = flightControllerEnd.read(buffer, sizeof(buffer));
+            result.crcErrors += splitFrames(&pending, buffer, length, [&](const uint8_t *frame) {
+                if (frame[2] != crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED)
+                {
+                    return;
+                }
+
+                uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+                const crsfProtocol::rcChannelsPacked_t *packed = (const crsfProtocol::rcChannelsPacked_t *)(frame + 3);
+                channels[0] = packed->channel0;
+                channels[1] = packed->channel1;
+                channels[2] = packed->channel2;
+                channels[3] = packed->channel3;
+                channels[4] = packed->channel4;
+                channels[5] = packed->channel5;
+                channels[6] = packed->channel6;
+                channels[7] = packed->channel7;
+                channels[8] = packed->channel8;
+                channels[9] = packed->channel9;
+                channels[10] = packed->channel10;
+                channels[11] = packed->channel11;
+                channels[12] = packed->channel12;
+                channels[13] = packed->channel13;
+                channels[14] = packed->channel14;
+                channels[15] = packed->channel15;
+
+                const uint32_t sequence = channels[SEQUENCE_CHANNEL] | ((uint32_t)channels[SEQUENCE_CHANNEL + 1] << 11);
+                for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+                {
+                    if (i == SEQUENCE_CHANNEL || i == SEQUENCE_CHANNEL + 1)
+                    {
+                        continue;
+                    }
+
+                    const uint16_t expected = (useBridge && i == LATENCY_OVERRIDE) ? CRSF_RC_CHANNEL_MAX : expectedChannel(i);
+                    if (channels[i] != expected)
+                    {
+                        result.channelMismatches++;
+                    }
+                }
+
+                if (sequence < frameCount && sentNs[sequence] != 0)
+                {
+                    result.latenciesUs.push_back((arrivedNs - sentNs[sequence]) / 1000.0);
+                }
+                result.framesReceived++;
+
+                if (result.framesReceived % TELEMETRY_EVERY == 0)
+                {
+                    flightControllerEnd.write(telemetry, telemetryLength);
+                    result.telemetrySent++;
+                }
+            });
+        }
+    });
+
+    // The emulated receiver, in this thread.
+    std::vector<uint8_t> pending;
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    uint8_t buffer[256];
+    const uint64_t intervalNs = 1000000000ULL / rateHz;
+    uint64_t nextNs = nowNs();
+    for (uint32_t sequence = 0; sequence < frameCount && keepRunning; sequence++)
+    {
+        const size_t length = buildRcFrame(sequence, frame);
+        while (nowNs() < nextNs)
+        {
+            if (receiverEnd.waitForData(0))
+            {
+                const size_t received = receiverEnd.read(buffer, sizeof(buffer));
+                result.crcErrors += splitFrames(&pending, buffer, received, [&](const uint8_t *telemetry) {
+                    if (telemetry[2] == crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR)
+                    {
+                        result.telemetryReceived++;
+                    }
+                });
+            }
+            const uint64_t remainingNs = nextNs - nowNs();
+            if (remainingNs < intervalNs)
+            {
+                const struct timespec sleep = {0, (long)(remainingNs > 200000 ? remainingNs - 100000 : 0)};
+                nanosleep(&sleep, nullptr);
+            }
+        }
+
+        sentNs[sequence] = nowNs();
+        receiverEnd.write(frame, length);
+        result.framesSent++;
+        nextNs += intervalNs;
+    }
+
+    // Give the last frames, and the telemetry that they trigger, time to come through.
+    usleep(50000);
+    while (receiverEnd.waitForData(0))
+    {
+        const size_t received = receiverEnd.read(buffer, sizeof(buffer));
+        splitFrames(&pending, buffer, received, [&](const uint8_t *telemetry) {
+            if (telemetry[2] == crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR)
+            {
+                result.telemetryReceived++;
+            }
+        });
+    }
+
+    running = false;
+    relayThread.join();
+    sinkThread.join();
+
+    if (useBridge)
+    {
+        bridgeStatistics_t toFlightController, toReceiver;
+        bridge.getStatistics(BRIDGE_TO_FLIGHT_CONTROLLER, &toFlightController);
+        bridge.getStatistics(BRIDGE_TO_RECEIVER, &toReceiver);
+        printf("Bridge: %u RC frames forwarded (%u rewritten), %u telemetry frames forwarded, %u CRC errors, %u dropped\n",
+               toFlightController.framesForwarded, toFlightController.framesRewritten, toReceiver.framesForwarded,
+               toFlightController.crcErrors + toReceiver.crcErrors, toFlightController.framesDropped + toReceiver.framesDropped);
+    }
+
+    close(receiverMaster);
+    close(receiverSlave);
+    close(flightControllerMaster);
+    close(flightControllerSlave);
+    return result;
+}
+
+static void printLatency(const char *label, latencyResult_t *result)
+{
+    std::vector<double> &latencies = result->latenciesUs;
+    if (latencies.empty())
+    {
+        printf("%-20s no frames\n", label);
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-20s %7u %7u %10.1f %10.1f %10.1f %10.1f %8u/%-8u %6u\n", label, result->framesSent, result->framesReceived,
+           latencies[latencies.size() / 10], latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+           latencies.back(), result->telemetryReceived, result->telemetrySent, result->channelMismatches + result->crcErrors);
+}
+
+static int latency(uint32_t seconds, uint32_t rateHz)
+{
+    printf("%u RC frames a second for %u s through each relay.\n\n", rateHz, seconds);
+
+    latencyResult_t bridged = measureLatency(true, seconds, rateHz);
+    latencyResult_t copied = measureLatency(false, seconds, rateHz);
+
+    printf("\n%-20s %7s %7s %10s %10s %10s %10s %17s %6s\n", "", "Sent", "Recvd", "p10", "p50", "p99", "Max", "Telemetry", "Errors");
+    printLatency("Bridge", &bridged);
+    printLatency("Byte copy relay", &copied);
+    if (bridged.latenciesUs.empty() || copied.latenciesUs.empty())
+    {
+        return 1;
+    }
+
+    printf("(Latency in us, from writing the last byte of a frame to reading it on the far side. Errors are channel\n"
+           " mismatches and CRC errors on either end. The bridge overrides channel %d, and every frame is checked for it.)\n\n",
+           LATENCY_OVERRIDE);
+    printf("Added by the bridge over a byte copy: %.1f us at p50, %.1f us at p99\n",
+           bridged.latenciesUs[bridged.latenciesUs.size() / 2] - copied.latenciesUs[copied.latenciesUs.size() / 2],
+           bridged.latenciesUs[bridged.latenciesUs.size() * 99 / 100] - copied.latenciesUs[copied.latenciesUs.size() * 99 / 100]);
+
+    const bool ok = bridged.framesReceived == bridged.framesSent && bridged.channelMismatches == 0 && bridged.crcErrors == 0 &&
+                    bridged.telemetryReceived == bridged.telemetrySent;
+    printf("Bridge %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+static int relay(const char *receiverDevice, const char *flightControllerDevice, uint32_t baudRate, const std::vector<std::pair<uint8_t, uint16_t>> &overrides)
+{
+    hal::LinuxSerial receiverPort(receiverDevice);
+    hal::LinuxSerial flightControllerPort(flightControllerDevice);
+    Bridge bridge(&receiverPort, &flightControllerPort);
+    if (!bridge.begin(baudRate) || !receiverPort.isOpen() || !flightControllerPort.isOpen())
+    {
+        fprintf(stderr, "Could not open %s or %s\n", receiverDevice, flightControllerDevice);
+        return 1;
+    }
+
+    for (size_t i = 0; i < overrides.size(); i++)
+    {
+        bridge.setChannelOverride(overrides[i].first, overrides[i].second);
+    }
+
+    struct pollfd pfds[2] = {{receiverPort.getFileDescriptor(), POLLIN, 0}, {flightControllerPort.getFileDescriptor(), POLLIN, 0}};
+    uint32_t lastPrint = millis();
+    while (keepRunning)
+    {
+        poll(pfds, 2, 100);
+        bridge.update();
+
+        if (millis() - lastPrint >= 1000)
+        {
+            lastPrint = millis();
+
+            bridgeStatistics_t toFlightController, toReceiver;
+            bridge.getStatistics(BRIDGE_TO_FLIGHT_CONTROLLER, &toFlightController);
+            bridge.getStatistics(BRIDGE_TO_RECEIVER, &toReceiver);
+            printf("To FC: %u forwarded, %u rewritten, %u CRC errors, %u timeouts | To receiver: %u forwarded, %u CRC errors, %u timeouts\n",
+                   toFlightController.framesForwarded, toFlightController.framesRewritten, toFlightController.crcErrors,
+                   toFlightController.timeouts, toReceiver.framesForwarded, toReceiver.crcErrors, toReceiver.timeouts);
+        }
+    }
+
+    bridge.end();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || (strcmp(argv[1], "--latency") != 0 && argc < 3))
+    {
+        printf("Usage: %s <receiver tty> <flight controller tty> [--baud n] [--override channel=value]...\n"
+               "       %s --latency [seconds] [--rate hz]\n",
+               argv[0], argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    uint32_t baudRate = crsfProtocol::BAUD_RATE;
+    uint32_t rateHz = LATENCY_RATE_HZ;
+    uint32_t seconds = LATENCY_SECONDS;
+    std::vector<std::pair<uint8_t, uint16_t>> overrides;
+    for (int i = 2; i < argc; i++)
+    {
+        unsigned channel, value;
+        if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc)
+        {
+            baudRate = (uint32_t)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+        {
+            rateHz = (uint32_t)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--override") == 0 && i + 1 < argc && sscanf(argv[++i], "%u=%u", &channel, &value) == 2)
+        {
+            overrides.push_back(std::make_pair((uint8_t)channel, (uint16_t)value));
+        }
+        else if (argv[i][0] != '-')
+        {
+            seconds = (uint32_t)atoi(argv[i]);
+        }
+    }
+
+    if (strcmp(argv[1], "--latency") == 0)
+    {
+        return latency(seconds > 0 ? seconds : 1, rateHz > 0 ? rateHz : LATENCY_RATE_HZ);
+    }
+
+    return relay(argv[1], argv[2], baudRate, overrides);
+}
@@ -0,0 +1,478 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example analyses a fleet of CRSF captures in parallel on a Linux host, and benchmarks how that scales with threads.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_capture_analytics/main.cpp -o linux_capture_analytics -lutil -lpthread
+
+Usage:
+./linux_capture_analytics --generate <dir> <count>    Write count synthetic captures into <dir>. They are 500 Hz flights of
+                                                       very different lengths, with link statistics, CRC errors and
+                                                       the occasional loss of signal (and failsafe).
+./linux_capture_analytics [--threads n] [--from s] [--to s] <captures...>
+                                                       Analyse the captures, and report each one and the whole fleet.
+                                                       --from and --to limit the analysis to part of each capture, in seconds
+                                                       from its start. Indexed captures jump straight to --from.
+./linux_capture_analytics --index <capture>            Print the summary of each second of a capture from its index,
+                                                       without decoding it.
+./linux_capture_analytics [--threads n] --benchmark [dir]
+                                                       Generate a corpus in [dir] (default: a temporary directory),
+                                                       analyse it with 1, 2, 4 ... threads up to n (default: one per CPU),
+                                                       check that every run gives the same results, and report the speedup.
+
+Captures are written by serialReceiverLayer::CaptureWriter, eg from a receiver's read loop:
+    captureWriter.writeChunk(timestampUs, buffer, bytesRead); */
+
+#include "SerialReceiver/CaptureAnalyzer/CaptureAnalyzer.hpp"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define CORPUS_PACKET_RATE          500 // Hz.
+#define CORPUS_LINK_STATISTICS_RATE 4   // One link statistics frame every this many RC channels frames.
+#define CORPUS_SECONDS_MIN          10
+#define CORPUS_SECONDS_MAX          300
+#define CORPUS_BENCHMARK_FILES      64
+#define BENCHMARK_REPEATS           3
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* xorshift32. The corpus only has to look like real flights and be the same every time. */
+static uint32_t nextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static float randomUnit(uint32_t *state)
+{
+    return (float)(nextRandom(state) >> 8) / 16777216.0F;
+}
+
+static size_t appendFrame(uint8_t *buffer, uint8_t type, const void *payload, uint8_t payloadSize, bool corruptCrc)
+{
+    genericCrc::GenericCRC crc;
+    buffer[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    buffer[1] = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    buffer[2] = type;
+    memcpy(buffer + 3, payload, payloadSize);
+    buffer[3 + payloadSize] = crc.calculate(type, buffer + 3, payloadSize) ^ (corruptCrc ? 0xFF : 0x00);
+    return payloadSize + 4;
+}
+
+/* Writes one synthetic flight. Short flights are much more common than long ones,
+so that a fleet has the uneven mix of file sizes that work stealing is there for. */
+static bool generateCapture(const char *path, uint32_t seed)
+{
+    uint32_t random = seed * 2654435761U + 1;
+    const float u = randomUnit(&random);
+    const uint32_t seconds = CORPUS_SECONDS_MIN + (uint32_t)((CORPUS_SECONDS_MAX - CORPUS_SECONDS_MIN) * u * u * u);
+    const uint32_t frameCount = seconds * CORPUS_PACKET_RATE;
+
+    CaptureWriter writer;
+    if (!writer.begin(path))
+    {
+        return false;
+    }
+
+    uint64_t timestampUs = 1000000;
+    uint32_t lossFramesLeft = 0;
+    float lqi = 100.0F;
+    float rssi = 50.0F;
+    crsfProtocol::rcChannelsPacked_t channels;
+    memset(&channels, 0, sizeof(channels));
+
+    uint8_t chunk[2 * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        timestampUs += 1000000 / CORPUS_PACKET_RATE;
+
+        // Now and then the signal fades for up to two seconds.
+        if (lossFramesLeft == 0 && nextRandom(&random) % (20 * CORPUS_PACKET_RATE) == 0)
+        {
+            lossFramesLeft = 100 + nextRandom(&random) % (2 * CORPUS_PACKET_RATE);
+        }
+
+        const float targetLqi = lossFramesLeft > 0 ? 40.0F : 98.0F;
+        const float targetRssi = lossFramesLeft > 0 ? 110.0F : 55.0F;
+        lqi += (targetLqi - lqi) * 0.05F + (randomUnit(&random) - 0.5F) * 2.0F;
+        rssi += (targetRssi - rssi) * 0.05F + (randomUnit(&random) - 0.5F) * 2.0F;
+        lqi = constrain(lqi, 0.0F, 100.0F);
+        rssi = constrain(rssi, 30.0F, 130.0F);
+
+        // During a fade, most frames never arrive.
+        if (lossFramesLeft > 0)
+        {
+            lossFramesLeft--;
+            if (randomUnit(&random) * 100.0F > lqi)
+            {
+                continue;
+            }
+        }
+
+        const float t = (float)i / CORPUS_PACKET_RATE;
+        channels.channel0 = (unsigned)(992 + 600 * sinf(t * 1.3F));
+        channels.channel1 = (unsigned)(992 + 400 * sinf(t * 0.7F));
+        channels.channel2 = (unsigned)(600 + 300 * sinf(t * 0.2F));
+        channels.channel3 = (unsigned)(992 + 200 * sinf(t * 2.1F));
+        channels.channel4 = 1811;
+
+        // About one frame in 500 is corrupted by noise on the wire.
+        size_t length = appendFrame(chunk, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, &channels,
+                                    crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE, nextRandom(&random) % 500 == 0);
+
+        if (i % CORPUS_LINK_STATISTICS_RATE == 0)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = (uint8_t)rssi;
+            linkStatistics.uplink_link_quality = (uint8_t)lqi;
+            linkStatistics.uplink_snr = (int8_t)(10 - (rssi - 50.0F) / 5.0F);
+            linkStatistics.uplink_tx_power = 2;
+            length += appendFrame(chunk + length, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, &linkStatistics,
+                                  crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE, false);
+        }
+
+        if (!writer.writeChunk(timestampUs, chunk, length))
+        {
+            return false;
+        }
+    }
+
+    return writer.end();
+}
+
+static bool generateCorpus(const char *directory, uint32_t count, std::vector<std::string> *paths)
+{
+    mkdir(directory, 0755);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/flight_%04u.cfac", directory, i);
+        if (!generateCapture(path, i + 1))
+        {
+            fprintf(stderr, "Could not write %s\n", path);
+            return false;
+        }
+        paths->push_back(path);
+    }
+
+    return true;
+}
+
+static void printHeading()
+{
+    printf("%-28s %8s %7s %9s %13s %9s %8s %10s %9s\n",
+           "Capture", "Length", "Rate", "LQ mean", "RSSI mean", "CRC err", "Errors", "Failsafes", "RC gap");
+    printf("%-28s %8s %7s %9s %13s %9s %8s %10s %9s\n",
+           "", "(s)", "(Hz)", "(min) %", "(worst) -dBm", "", "(%)", "(s)", "max (ms)");
+}
+
+static void printStatistics(const char *name, const captureStatistics_t *statistics)
+{
+    if (statistics->files == 0)
+    {
+        printf("%-28s not a capture\n", name);
+        return;
+    }
+
+    char lq[32];
+    char rssi[32];
+    char failsafes[32];
+    snprintf(lq, sizeof(lq), "%.1f (%d)", CaptureAnalyzer::getMeanLqi(statistics), statistics->lqiMin);
+    snprintf(rssi, sizeof(rssi), "%.1f (%d)", CaptureAnalyzer::getMeanRssi(statistics), statistics->rssiMax);
+    snprintf(failsafes, sizeof(failsafes), "%u (%.1f)", statistics->failsafeEvents, statistics->failsafeUs / 1e6);
+
+    printf("%-28s %8.1f %7.1f %9s %13s %9llu %8.3f %10s %9.1f\n",
+           name, statistics->durationUs / 1e6, CaptureAnalyzer::getPacketRate(statistics), lq, rssi,
+           (unsigned long long)statistics->crcErrors, CaptureAnalyzer::getErrorRate(statistics) * 100.0F, failsafes,
+           statistics->maxRcGapUs / 1e3);
+}
+
+static int analyzeCaptures(const std::vector<std::string> &paths, unsigned threadCount, uint64_t fromUs, uint64_t toUs)
+{
+    std::vector<const char *> names;
+    for (const std::string &path : paths)
+    {
+        names.push_back(path.c_str());
+    }
+
+    CaptureAnalyzer analyzer(threadCount);
+    analyzer.setTimeRange(fromUs, toUs);
+    std::vector<captureStatistics_t> perFile(paths.size());
+    captureStatistics_t fleet;
+
+    const uint64_t start = monotonicNanoseconds();
+    analyzer.analyze(names.data(), names.size(), perFile.data(), &fleet);
+    const double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+    printHeading();
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        const char *slash = strrchr(names[i], '/');
+        printStatistics(slash != nullptr ? slash + 1 : names[i], &perFile[i]);
+    }
+
+    char fleetName[64];
+    snprintf(fleetName, sizeof(fleetName), "Fleet (%u captures)", fleet.files);
+    printf("\n");
+    printStatistics(fleetName, &fleet);
+
+    printf("\n%.1f hours of flight, %.1f MB, analysed in %.3f s on %u threads (%.0f MB/s)",
+           fleet.durationUs / 3.6e9, fleet.bytes / 1e6, seconds, analyzer.getThreadPool()->getThreadCount(), fleet.bytes / 1e6 / seconds);
+    if (fleet.invalidFiles > 0)
+    {
+        printf(". %u of the files were not captures", fleet.invalidFiles);
+    }
+    printf("\n");
+    return fleet.invalidFiles > 0 ? 1 : 0;
+}
+
+static int benchmark(const char *directory, unsigned maxThreads)
+{
+    char temporary[] = "/tmp/crsf_captures_XXXXXX";
+    const bool removeAfter = directory == nullptr;
+    if (directory == nullptr)
+    {
+        directory = mkdtemp(temporary);
+        if (directory == nullptr)
+        {
+            perror("mkdtemp");
+            return 1;
+        }
+    }
+
+    printf("Generating %u captures in %s...\n", CORPUS_BENCHMARK_FILES, directory);
+    std::vector<std::string> paths;
+    if (!generateCorpus(directory, CORPUS_BENCHMARK_FILES, &paths))
+    {
+        return 1;
+    }
+
+    std::vector<const char *> names;
+    for (const std::string &path : paths)
+    {
+        names.push_back(path.c_str());
+    }
+
+    const unsigned cpus = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    if (maxThreads == 0)
+    {
+        maxThreads = cpus;
+    }
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::vector<captureStatistics_t> reference(paths.size());
+    captureStatistics_t referenceFleet;
+    double singleThreadSeconds = 0;
+    bool matches = true;
+
+    printf("%u CPUs. Best of %u runs for each thread count.\n", cpus, BENCHMARK_REPEATS);
+    if (maxThreads > cpus)
+    {
+        printf("There are more threads than CPUs, so the speedup cannot go past %u.\n", cpus);
+    }
+    printf("\n");
+    printf("%8s %10s %10s %9s %11s %8s\n", "Threads", "Time (s)", "MB/s", "Speedup", "Efficiency", "Steals");
+
+    for (size_t t = 0; t < threadCounts.size(); t++)
+    {
+        CaptureAnalyzer analyzer(threadCounts[t]);
+        std::vector<captureStatistics_t> perFile(paths.size());
+        captureStatistics_t fleet;
+        double best = 0;
+
+        for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+        {
+            const uint64_t start = monotonicNanoseconds();
+            analyzer.analyze(names.data(), names.size(), perFile.data(), &fleet);
+            const double seconds = (monotonicNanoseconds() - start) / 1e9;
+            if (repeat == 0 || seconds < best)
+            {
+                best = seconds;
+            }
+        }
+
+        // Every thread count has to come up with exactly the same figures as one thread.
+        if (t == 0)
+        {
+            reference = perFile;
+            referenceFleet = fleet;
+            singleThreadSeconds = best;
+        }
+        else if (memcmp(reference.data(), perFile.data(), perFile.size() * sizeof(captureStatistics_t)) != 0 ||
+                 memcmp(&referenceFleet, &fleet, sizeof(fleet)) != 0)
+        {
+            matches = false;
+        }
+
+        threadPoolStatistics_t poolStatistics;
+        analyzer.getThreadPool()->getStatistics(&poolStatistics);
+
+        const double speedup = singleThreadSeconds / best;
+        printf("%8u %10.3f %10.0f %8.2fx %10.0f%% %8.1f\n", threadCounts[t], best, fleet.bytes / 1e6 / best, speedup,
+               100.0 * speedup / threadCounts[t], (double)poolStatistics.steals / poolStatistics.runs);
+    }
+
+    printf("\nFleet: %u captures, %.1f hours of flight, %.1f MB, %llu RC channels frames, %llu CRC errors, %u failsafes\n",
+           referenceFleet.files, referenceFleet.durationUs / 3.6e9, referenceFleet.bytes / 1e6,
+           (unsigned long long)referenceFleet.rcChannelsFrames, (unsigned long long)referenceFleet.crcErrors, referenceFleet.failsafeEvents);
+    printf("Results %s across thread counts.\n", matches ? "match" : "DO NOT MATCH");
+
+    if (removeAfter)
+    {
+        for (const std::string &path : paths)
+        {
+            unlink(path.c_str());
+        }
+        rmdir(directory);
+    }
+
+    return matches ? 0 : 1;
+}
+
+static int printIndex(const char *path)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+
+    CaptureReader reader(file.getData(), file.getSize());
+    if (!reader.readHeader())
+    {
+        fprintf(stderr, "%s is not a capture\n", path);
+        return 1;
+    }
+
+    if (!reader.hasIndex())
+    {
+        fprintf(stderr, "%s has no index\n", path);
+        return 1;
+    }
+
+    uint64_t startUs = 0;
+    reader.getStartTime(&startUs);
+
+    printf("%10s %12s %8s %10s %10s %8s %8s %10s\n", "Time (s)", "Offset", "Chunks", "RC frames", "Link stats", "CRC err", "LQ min", "RSSI max");
+    captureIndexSegment_t segment;
+    for (uint32_t i = 0; reader.getSegment(i, &segment); i++)
+    {
+        printf("%10.1f %12llu %8u %10u %10u %8u %8d %10d\n", (segment.firstTimestampUs - startUs) / 1e6, (unsigned long long)segment.offset,
+               segment.entryCount, segment.rcChannelsFrames, segment.linkStatisticsFrames, segment.crcErrors, segment.lqiMin, segment.rssiMax);
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 4 && strcmp(argv[1], "--generate") == 0)
+    {
+        std::vector<std::string> paths;
+        if (!generateCorpus(argv[2], (uint32_t)atoi(argv[3]), &paths))
+        {
+            return 1;
+        }
+        printf("Wrote %zu captures to %s\n", paths.size(), argv[2]);
+        return 0;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "--index") == 0)
+    {
+        return printIndex(argv[2]);
+    }
+
+    unsigned threadCount = 0;
+    bool runBenchmark = false;
+    uint64_t fromUs = 0;
+    uint64_t toUs = UINT64_MAX;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threadCount = (unsigned)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc)
+        {
+            fromUs = (uint64_t)(atof(argv[++i]) * 1e6);
+        }
+        else if (strcmp(argv[i], "--to") == 0 && i + 1 < argc)
+        {
+            toUs = (uint64_t)(atof(argv[++i]) * 1e6);
+        }
+        else if (strcmp(argv[i], "--benchmark") == 0)
+        {
+            runBenchmark = true;
+        }
+        else
+        {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (runBenchmark && paths.size() <= 1)
+    {
+        return benchmark(paths.empty() ? nullptr : paths[0].c_str(), threadCount);
+    }
+
+    if (paths.empty() || runBenchmark)
+    {
+        fprintf(stderr, "Usage: %s --generate <dir> <count>\n"
+                        "       %s [--threads n] [--from s] [--to s] <captures...>\n"
+                        "       %s --index <capture>\n"
+                        "       %s [--threads n] --benchmark [dir]\n",
+                argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+
+    return analyzeCaptures(paths, threadCount, fromUs, toUs);
+}
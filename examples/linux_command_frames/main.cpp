@@ -0,0 +1,276 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example checks command frames, inner CRC included, against known frames, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_command_frames/main.cpp -o linux_command_frames -lutil -lpthread
+
+Usage:
+./linux_command_frames
+                            Both CRCs are checked against their check values (the CRC of "123456789").
+                            Known command frames are encoded and compared byte for byte, then decoded again,
+                            and frames with a damaged inner CRC must be turned down.
+                            Last, a receiver is fed command frames from memory: it must answer speed proposals in its telemetry slot,
+                            hand other commands to the command callback, count damaged ones, and send a bind command when asked.
+                            Commands that are queued faster than they go out must all be sent, until the telemetry queue is full.
+The known frames were worked out with a plain bitwise CRC8 (polynomials 0xD5 and 0xBA, starting at 0), separately from this library.
+Build with -DCRC_OPTIMISATION_LEVEL=1 instead to check the table-less CRCs. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+// Speed proposals are only ever accepted when baud rate negotiation is enabled.
+struct CommandsConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool commandsEnabled = true;
+    static constexpr bool baudRateNegotiationEnabled = true;
+};
+
+static const uint8_t bindFrame[] = {0xC8, 0x07, 0x32, 0xEC, 0xC8, 0x10, 0x01, 0x9E, 0xE8};
+static const uint8_t speedProposalFrame[] = {0xC8, 0x0C, 0x32, 0xC8, 0xEC, 0x0A, 0x70, 0x00, 0x00, 0x0F, 0x42, 0x40, 0x16, 0x11}; // Port 0, 1 Mbaud.
+static const uint8_t speedAcceptedFrame[] = {0xC8, 0x09, 0x32, 0xEC, 0xC8, 0x0A, 0x71, 0x00, 0x01, 0x28, 0xC9};
+static const uint8_t forceDisarmFrame[] = {0xC8, 0x07, 0x32, 0xC8, 0xEA, 0x01, 0x01, 0xFE, 0xFC};
+
+static uint32_t failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%-60s %s\n", what, ok ? "OK" : "FAILED");
+    failures += ok ? 0 : 1;
+}
+
+/* A transport that hands over whatever has been queued for the receiver, and keeps everything that the receiver sends. */
+class MemoryTransport final : public hal::SerialTransport
+{
+  public:
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        const size_t count = input.size() < size ? input.size() : size;
+        memcpy(buffer, input.data(), count);
+        input.erase(input.begin(), input.begin() + count);
+        return count;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        output.insert(output.end(), buffer, buffer + size);
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+static void queueRcFrame(MemoryTransport *transport)
+{
+    genericCrc::GenericCRC crc;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = CRSF_RC_CHANNEL_CENTER;
+    }
+
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    frame[3 + crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+    transport->input.insert(transport->input.end(), frame, frame + crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD);
+}
+
+/* Feeds frame to the receiver, and returns the command frames that it sent back. */
+static std::vector<std::vector<uint8_t>> feed(BasicSerialReceiver<CommandsConfig> *receiver, MemoryTransport *transport, const uint8_t *frame, size_t size)
+{
+    transport->input.insert(transport->input.end(), frame, frame + size);
+    transport->output.clear();
+    while (!transport->input.empty())
+    {
+        receiver->processFrames();
+    }
+
+    std::vector<std::vector<uint8_t>> commands;
+    for (size_t position = 0; position + 2 <= transport->output.size(); position += transport->output[position + 1] + 2)
+    {
+        if (transport->output[position + 2] == crsfProtocol::CRSF_FRAMETYPE_COMMAND)
+        {
+            commands.emplace_back(transport->output.begin() + position, transport->output.begin() + position + transport->output[position + 1] + 2);
+        }
+    }
+    return commands;
+}
+
+static bool sameFrame(const std::vector<uint8_t> &frame, const uint8_t *expected, size_t size)
+{
+    return frame.size() == size && memcmp(frame.data(), expected, size) == 0;
+}
+
+static bool acceptSpeedProposal(uint8_t port, uint32_t baudRate)
+{
+    return port == 0 && baudRate == 1000000;
+}
+
+static bool turnDownSpeedProposal(uint8_t port, uint32_t baudRate)
+{
+    (void)port;
+    (void)baudRate;
+    return false;
+}
+
+static command_t lastCommand;
+static uint32_t commandCallbacks = 0;
+
+static void onCommand(const command_t *command)
+{
+    lastCommand = *command;
+    commandCallbacks++;
+}
+
+int main()
+{
+    genericCrc::GenericCRC crc;
+    uint8_t checkData[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    check(crc.calculate(checkData[0], checkData + 1, sizeof(checkData) - 1) == 0xBC, "CRC8 DVB S2 check value is 0xBC");
+    check(crc.calculateCommand(checkData, sizeof(checkData)) == 0x20, "CRC8 0xBA check value is 0x20");
+
+    // Encoding.
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    uint8_t length = CommandFrame::encodeBind(crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER, crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, frame);
+    check(length == sizeof(bindFrame) && memcmp(frame, bindFrame, length) == 0, "Encode receiver bind");
+    length = CommandFrame::encodeSpeedProposal(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER, 0, 1000000, frame);
+    check(length == sizeof(speedProposalFrame) && memcmp(frame, speedProposalFrame, length) == 0, "Encode speed proposal");
+    length = CommandFrame::encodeSpeedResponse(crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER, crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, 0, true, frame);
+    check(length == sizeof(speedAcceptedFrame) && memcmp(frame, speedAcceptedFrame, length) == 0, "Encode speed response");
+    const command_t disarm = {crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER,
+                              crsfProtocol::CRSF_COMMAND_FC, crsfProtocol::CRSF_COMMAND_FC_FORCE_DISARM, nullptr, 0};
+    length = CommandFrame::encode(&disarm, frame);
+    check(length == sizeof(forceDisarmFrame) && memcmp(frame, forceDisarmFrame, length) == 0, "Encode force disarm");
+    uint8_t tooLong[COMMAND_DATA_SIZE_MAX + 1] = {0};
+    const command_t oversized = {crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER, crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, 0, 0, tooLong, sizeof(tooLong)};
+    check(CommandFrame::encode(&oversized, frame) == 0, "Data that does not fit in one frame is turned down");
+
+    // Decoding.
+    command_t command;
+    uint8_t port = 0xFF;
+    uint32_t baudRate = 0;
+    check(CommandFrame::decode(speedProposalFrame, &command) && command.destination == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER &&
+              command.origin == crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER && command.command == crsfProtocol::CRSF_COMMAND_GENERAL &&
+              command.subCommand == crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_PROPOSAL && command.dataLength == 5 &&
+              CommandFrame::decodeSpeedProposal(&command, &port, &baudRate) && port == 0 && baudRate == 1000000,
+          "Decode speed proposal");
+    check(CommandFrame::decode(bindFrame, &command) && command.command == crsfProtocol::CRSF_COMMAND_RX &&
+              command.subCommand == crsfProtocol::CRSF_COMMAND_RX_BIND && command.dataLength == 0 &&
+              !CommandFrame::decodeSpeedProposal(&command, &port, &baudRate),
+          "Decode receiver bind");
+
+    // Damage the inner CRC, and mend the outer one, so that only the inner CRC can catch it.
+    uint8_t damaged[sizeof(speedProposalFrame)];
+    memcpy(damaged, speedProposalFrame, sizeof(damaged));
+    damaged[12] ^= 0x01;
+    damaged[13] = crc.calculate(2, damaged[2], damaged, 13);
+    check(!CommandFrame::decode(damaged, &command), "A damaged inner CRC is turned down");
+    damaged[12] ^= 0x01;
+    damaged[9] ^= 0x80;
+    damaged[13] = crc.calculate(2, damaged[2], damaged, 13);
+    check(!CommandFrame::decode(damaged, &command), "Damaged data with a mended outer CRC is turned down");
+
+    // The receiver answers in the telemetry slot that follows each frame.
+    MemoryTransport transport;
+    BasicSerialReceiver<CommandsConfig> receiver(&transport);
+    receiver.begin();
+    receiver.telemetryWriteBattery(1680.0F, 125.0F, 450, 80);
+
+    receiver.setSpeedProposalCallback(turnDownSpeedProposal);
+    std::vector<std::vector<uint8_t>> sent = feed(&receiver, &transport, speedProposalFrame, sizeof(speedProposalFrame));
+    check(sent.size() == 1 && sent[0].size() == 11 && sent[0][8] == 0 && receiver.getBaudRate() == crsfProtocol::BAUD_RATE,
+          "Speed proposal that the callback turns down gets a 0");
+
+    receiver.setSpeedProposalCallback(acceptSpeedProposal);
+    sent = feed(&receiver, &transport, speedProposalFrame, sizeof(speedProposalFrame));
+    check(sent.size() == 1 && sameFrame(sent[0], speedAcceptedFrame, sizeof(speedAcceptedFrame)) && receiver.getBaudRate() == 1000000,
+          "Speed proposal is answered with the known response");
+
+    receiver.setCommandCallback(onCommand);
+    sent = feed(&receiver, &transport, forceDisarmFrame, sizeof(forceDisarmFrame));
+    check(sent.empty() && commandCallbacks == 1 && lastCommand.command == crsfProtocol::CRSF_COMMAND_FC &&
+              lastCommand.subCommand == crsfProtocol::CRSF_COMMAND_FC_FORCE_DISARM && lastCommand.origin == crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER,
+          "Force disarm goes to the command callback");
+
+    damaged[9] ^= 0x80;
+    damaged[12] ^= 0x01;
+    damaged[13] = crc.calculate(2, damaged[2], damaged, 13);
+    sent = feed(&receiver, &transport, damaged, sizeof(damaged));
+    serialReceiverCounters_t counters;
+    receiver.getCounters(&counters);
+    check(sent.empty() && counters.crsf.commandCrcErrors == 1 && counters.commands == 3, "A damaged inner CRC is counted, and dropped");
+
+    check(receiver.bindReceiver(), "Bind is queued");
+    transport.output.clear();
+    queueRcFrame(&transport);
+    sent = feed(&receiver, &transport, nullptr, 0);
+    check(sent.size() == 1 && sameFrame(sent[0], bindFrame, sizeof(bindFrame)), "Bind goes out in the next telemetry slot");
+
+    // Commands that are sent faster than the slots come wait their turn, until the queue is full.
+    bool queued = true;
+    for (int i = 0; i < TELEMETRY_QUEUE_SIZE; i++)
+    {
+        queued = receiver.bindReceiver() && queued;
+    }
+    check(queued && !receiver.bindReceiver(), "A full telemetry queue turns the next command down");
+    for (int i = 0; i < TELEMETRY_QUEUE_SIZE + 1; i++)
+    {
+        queueRcFrame(&transport);
+    }
+    sent = feed(&receiver, &transport, nullptr, 0);
+    receiver.getCounters(&counters);
+    queued = sent.size() == TELEMETRY_QUEUE_SIZE && counters.telemetryQueueFull == 1;
+    for (size_t i = 0; i < sent.size(); i++)
+    {
+        queued = queued && sameFrame(sent[i], bindFrame, sizeof(bindFrame));
+    }
+    check(queued, "Every queued command goes out, one per slot");
+
+    receiver.end();
+    printf("Command frames %s\n", failures == 0 ? "OK" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
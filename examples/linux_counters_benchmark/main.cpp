@@ -0,0 +1,262 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example measures what the health counters cost the Serial Receiver, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_counters_benchmark/main.cpp -o linux_counters_benchmark -lutil -lpthread
+
+The same block of frames (mostly RC channels, with some link statistics and some frames with a bad CRC)
+is decoded from memory by three receivers: one with the health counters and two without.
+The runs are interleaved, the receivers take turns at going first, and the best of several repeats is kept.
+The difference between the two receivers without counters is the noise floor of the measurement.
+The cost of the counters should be of the same size. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+
+#include <stdio.h>
+#include <time.h>
+
+using namespace serialReceiverLayer;
+
+#define BENCHMARK_FRAMES  1000
+#define BENCHMARK_PASSES  2000
+#define BENCHMARK_REPEATS 15
+
+struct NoCountersConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool healthCountersEnabled = false;
+};
+
+static uint8_t frames[BENCHMARK_FRAMES * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+static size_t framesLength = 0;
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* A transport that copies whole frames, as many as fit, and accepts (and drops) telemetry.
+Handing over whole frames keeps every frame within one chunk, and so within one timestamp.
+The decoder's frame timeout then can never cut a frame in two, even if the host stalls the benchmark,
+and each receiver decodes exactly the same frames. */
+class MemoryTransport final : public hal::SerialTransport
+{
+  public:
+    size_t position = 0;
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        size_t count = 0;
+        while (position + count < framesLength)
+        {
+            const size_t frameSize = frames[position + count + 1] + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+            if (count + frameSize > size)
+            {
+                break;
+            }
+            count += frameSize;
+        }
+
+        memcpy(buffer, frames + position, count);
+        position += count;
+        return count;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        (void)buffer;
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    (void)rcChannels;
+}
+
+static void onReceiveLinkStatistics(link_statistics_t linkStatistics)
+{
+    (void)linkStatistics;
+}
+
+static void appendFrame(uint8_t type, const uint8_t *payload, uint8_t payloadSize, bool corruptCrc)
+{
+    genericCrc::GenericCRC crc;
+    crsfProtocol::frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame.frame.frameLength = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame.frame.type = type;
+    memcpy(frame.frame.payload, payload, payloadSize);
+    frame.frame.payload[payloadSize] = crc.calculate(type, frame.frame.payload, payloadSize) ^ (corruptCrc ? 0xFF : 0x00);
+
+    const size_t size = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+    memcpy(frames + framesLength, frame.raw, size);
+    framesLength += size;
+}
+
+static void buildFrames()
+{
+    for (uint32_t i = 0; i < BENCHMARK_FRAMES; i++)
+    {
+        if (i % 10 == 5)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = 60;
+            linkStatistics.uplink_link_quality = 100;
+            appendFrame(crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, (const uint8_t *)&linkStatistics,
+                        crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE, false);
+            continue;
+        }
+
+        crsfProtocol::rcChannelsPacked_t channels;
+        memset(&channels, 0, sizeof(channels));
+        channels.channel0 = 172 + (i % 1640);
+        channels.channel2 = 992;
+        appendFrame(crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, (const uint8_t *)&channels,
+                    crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE, i % 100 == 99);
+    }
+}
+
+/* Decodes the frames BENCHMARK_PASSES times and returns the nanoseconds per byte. */
+template <class Config>
+static double runOnce(BasicSerialReceiver<Config> *receiver, MemoryTransport *transport)
+{
+    const uint64_t start = monotonicNanoseconds();
+    for (int pass = 0; pass < BENCHMARK_PASSES; pass++)
+    {
+        // processFrames() returns after a short read, so keep calling it until the frames run out.
+        transport->position = 0;
+        while (transport->position < framesLength)
+        {
+            receiver->processFrames();
+        }
+    }
+    const uint64_t elapsed = monotonicNanoseconds() - start;
+
+    return (double)elapsed / ((double)framesLength * BENCHMARK_PASSES);
+}
+
+int main()
+{
+    buildFrames();
+    printf("Decoding %u frames (%zu bytes), %u times per receiver, best of %u\n",
+           BENCHMARK_FRAMES, framesLength, BENCHMARK_PASSES, BENCHMARK_REPEATS);
+
+    MemoryTransport countedTransport;
+    MemoryTransport uncountedTransport;
+    MemoryTransport referenceTransport;
+    BasicSerialReceiver<> counted(&countedTransport);
+    BasicSerialReceiver<NoCountersConfig> uncounted(&uncountedTransport);
+    BasicSerialReceiver<NoCountersConfig> reference(&referenceTransport);
+
+    counted.begin();
+    uncounted.begin();
+    reference.begin();
+    counted.setRcChannelsCallback(onReceiveRcChannels);
+    uncounted.setRcChannelsCallback(onReceiveRcChannels);
+    reference.setRcChannelsCallback(onReceiveRcChannels);
+    counted.setLinkStatisticsCallback(onReceiveLinkStatistics);
+    uncounted.setLinkStatisticsCallback(onReceiveLinkStatistics);
+    reference.setLinkStatisticsCallback(onReceiveLinkStatistics);
+
+    /* Interleave the receivers, and take turns at going first, so that slow periods on the host
+    and the order of the runs affect all of them alike. */
+    double perByte[3] = {0, 0, 0};
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        for (int turn = 0; turn < 3; turn++)
+        {
+            const int receiver = (repeat + turn) % 3;
+            double repeatPerByte;
+            if (receiver == 0)
+            {
+                repeatPerByte = runOnce(&counted, &countedTransport);
+            }
+            else if (receiver == 1)
+            {
+                repeatPerByte = runOnce(&uncounted, &uncountedTransport);
+            }
+            else
+            {
+                repeatPerByte = runOnce(&reference, &referenceTransport);
+            }
+
+            if (repeat == 0 || repeatPerByte < perByte[receiver])
+            {
+                perByte[receiver] = repeatPerByte;
+            }
+        }
+    }
+
+    const double countedPerByte = perByte[0];
+    const double uncountedPerByte = perByte[1];
+    const double referencePerByte = perByte[2];
+
+    printf("%-34s %7.2f ns/byte\n", "Health counters on", countedPerByte);
+    printf("%-34s %7.2f ns/byte\n", "Health counters off", uncountedPerByte);
+    printf("%-34s %7.2f ns/byte\n", "Health counters off (again)", referencePerByte);
+    printf("\nThe counters cost %+.2f ns/byte. The noise floor is %.2f ns/byte.\n",
+           countedPerByte - (uncountedPerByte < referencePerByte ? uncountedPerByte : referencePerByte),
+           uncountedPerByte > referencePerByte ? uncountedPerByte - referencePerByte : referencePerByte - uncountedPerByte);
+
+    serialReceiverCounters_t counters;
+    counted.getCounters(&counters);
+    printf("\nCounters after %u passes:\n", BENCHMARK_PASSES * BENCHMARK_REPEATS);
+    printf("  bytes received           %u\n", counters.bytesReceived);
+    printf("  RC channels frames       %u\n", counters.crsf.rcChannelsFrames);
+    printf("  link statistics frames   %u\n", counters.crsf.linkStatisticsFrames);
+    printf("  other frames             %u\n", counters.crsf.otherFrames);
+    printf("  CRC errors               %u\n", counters.crsf.crcErrors);
+    printf("  length errors            %u\n", counters.crsf.lengthErrors);
+    printf("  timeouts                 %u\n", counters.crsf.timeouts);
+    printf("  UART overruns            %u\n", counters.uartOverruns);
+    printf("  bytes discarded          %u\n", counters.bytesDiscarded);
+    printf("  telemetry frames sent    %u\n", counters.telemetryFramesSent);
+    printf("  telemetry frames dropped %u\n", counters.telemetryFramesDropped);
+    printf("  RC channels callbacks    %u\n", counters.rcChannelsCallbacks);
+    printf("  link stats callbacks     %u\n", counters.linkStatisticsCallbacks);
+
+    counted.end();
+    uncounted.end();
+    reference.end();
+    return 0;
+}
@@ -0,0 +1,311 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example checks that the receiver role answers device pings, over a pseudo-terminal, as a handset would see it.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_device_info/main.cpp -o linux_device_info -lutil -lpthread
+
+Usage:
+./linux_device_info [seconds]
+                            Stand in for a handset on one end of a pseudo-terminal, with the receiver role on the other end.
+                            RC channels frames go out at 250 Hz, with a device ping after every few of them. The pings take turns
+                            at being for the flight controller, for every device, and for another device, which must not be answered.
+                            Every device info frame that comes back is decoded and checked, and so is the order of the other
+                            telemetry frames, which the answers must not disturb. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <pty.h>
+#include <stdio.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+struct DeviceInfoConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool telemetryDeviceInfoEnabled = true;
+};
+
+#define LOOPBACK_SECONDS   5
+#define RC_INTERVAL_US     4000
+#define PING_EVERY         10                                           // A ping follows every this many RC channels frames.
+#define DEVICE_NAME        "Loopback FC"
+#define DEVICE_SERIAL      0x12345678
+#define DEVICE_HARDWARE    0x00010203
+#define HANDSET_ADDRESS    crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER
+#define LUA_SCRIPT_ADDRESS 0xEF                                         // ExpressLRS's Lua script pings from its own address.
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t readU32BE(const uint8_t *buffer)
+{
+    return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | buffer[3];
+}
+
+static size_t buildRcFrame(uint8_t *frame)
+{
+    genericCrc::GenericCRC crc;
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = CRSF_RC_CHANNEL_CENTER;
+    }
+
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    frame[3 + crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+    return crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+static size_t buildPingFrame(uint8_t destination, uint8_t origin, uint8_t *frame)
+{
+    genericCrc::GenericCRC crc;
+    frame[0] = crsfProtocol::CRSF_SYNC_BYTE;
+    frame[1] = crsfProtocol::CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_DEVICE_PING;
+    frame[3] = destination;
+    frame[4] = origin;
+    frame[5] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE);
+    return crsfProtocol::CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+typedef struct handset_s
+{
+    std::vector<uint8_t> pending;
+    std::vector<uint8_t> expectedOrigins; // The origin of each ping that should be answered, oldest first.
+    std::vector<uint64_t> pingSentNs;
+    std::vector<double> replyLatenciesUs;
+    std::vector<uint8_t> telemetryTypes; // Every other telemetry frame's type, in order.
+    uint32_t deviceInfoFrames;
+    uint32_t deviceInfoErrors;
+    uint32_t crcErrors;
+} handset_t;
+
+/* Checks one device info frame against what the receiver was told to say, and against the ping that it answers. */
+static void checkDeviceInfo(handset_t *handset, const uint8_t *frame, uint64_t arrivedNs)
+{
+    const uint8_t *payload = frame + 3;
+    const uint8_t payloadLength = frame[1] - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    const size_t nameLength = strnlen((const char *)payload + 2, payloadLength - 2);
+    const uint8_t *fields = payload + 2 + nameLength + 1;
+    bool ok = nameLength == strlen(DEVICE_NAME) && memcmp(payload + 2, DEVICE_NAME, nameLength) == 0 &&
+              payloadLength == 2 + nameLength + 1 + crsfProtocol::CRSF_FRAME_DEVICE_INFO_FIELDS_SIZE;
+
+    if (ok)
+    {
+        ok = payload[1] == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER && readU32BE(fields) == DEVICE_SERIAL &&
+             readU32BE(fields + 4) == DEVICE_HARDWARE && readU32BE(fields + 8) == TELEMETRY_DEVICE_SOFTWARE_VERSION &&
+             fields[12] == 0 && fields[13] == TELEMETRY_DEVICE_PARAMETER_VERSION;
+    }
+
+    const size_t answered = handset->deviceInfoFrames++;
+    if (answered >= handset->expectedOrigins.size() || payload[0] != handset->expectedOrigins[answered])
+    {
+        ok = false;
+    }
+    else
+    {
+        handset->replyLatenciesUs.push_back((arrivedNs - handset->pingSentNs[answered]) / 1000.0);
+    }
+
+    if (!ok)
+    {
+        handset->deviceInfoErrors++;
+    }
+}
+
+static void readTelemetry(handset_t *handset, hal::LinuxSerial *port)
+{
+    genericCrc::GenericCRC crc;
+    uint8_t buffer[256];
+    size_t length;
+
+    while ((length = port->read(buffer, sizeof(buffer))) > 0)
+    {
+        const uint64_t arrivedNs = nowNs();
+        handset->pending.insert(handset->pending.end(), buffer, buffer + length);
+
+        size_t position = 0;
+        while (handset->pending.size() - position >= 2 && handset->pending.size() - position >= (size_t)handset->pending[position + 1] + 2)
+        {
+            uint8_t *frame = handset->pending.data() + position;
+            position += frame[1] + 2;
+
+            if (crc.calculate(frame[2], frame + 3, frame[1] - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC) != frame[frame[1] + 1])
+            {
+                handset->crcErrors++;
+            }
+            else if (frame[2] == crsfProtocol::CRSF_FRAMETYPE_DEVICE_INFO)
+            {
+                checkDeviceInfo(handset, frame, arrivedNs);
+            }
+            else
+            {
+                handset->telemetryTypes.push_back(frame[2]);
+            }
+        }
+        handset->pending.erase(handset->pending.begin(), handset->pending.begin() + position);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const uint32_t seconds = argc > 1 && atoi(argv[1]) > 0 ? (uint32_t)atoi(argv[1]) : LOOPBACK_SECONDS;
+
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    hal::LinuxSerial handsetPort(master);
+    hal::LinuxSerial receiverPort(slave);
+    handsetPort.begin(crsfProtocol::BAUD_RATE);
+    BasicSerialReceiver<DeviceInfoConfig> receiver(&receiverPort);
+    if (!receiver.begin())
+    {
+        fprintf(stderr, "Could not start the receiver\n");
+        return 1;
+    }
+    receiver.setDeviceInfo(DEVICE_NAME, DEVICE_SERIAL, DEVICE_HARDWARE);
+    receiver.telemetryWriteBattery(1680.0F, 125.0F, 450, 80);
+
+    std::atomic<bool> receiving(true);
+    std::thread receiverThread([&]() {
+        while (receiving.load())
+        {
+            if (receiverPort.waitForData(10))
+            {
+                receiver.processFrames();
+            }
+        }
+    });
+
+    handset_t handset = handset_t();
+    const uint8_t pingDestinations[3] = {crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, crsfProtocol::CRSF_ADDRESS_BROADCAST, crsfProtocol::CRSF_ADDRESS_CRSF_TRANSMITTER};
+    const uint8_t pingOrigins[3] = {HANDSET_ADDRESS, LUA_SCRIPT_ADDRESS, HANDSET_ADDRESS};
+    uint32_t rcFrames = 0;
+    uint32_t pings = 0;
+    uint32_t unansweredPings = 0;
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+
+    printf("Handset: RC channels at %u Hz for %u s, with a ping after every %u frames.\n", 1000000 / RC_INTERVAL_US, seconds, PING_EVERY);
+    const uint64_t startNs = nowNs();
+    uint64_t nextNs = startNs;
+    while (nowNs() - startNs < (uint64_t)seconds * 1000000000ULL)
+    {
+        while (nowNs() < nextNs)
+        {
+            if (handsetPort.waitForData(1))
+            {
+                readTelemetry(&handset, &handsetPort);
+            }
+        }
+        nextNs += RC_INTERVAL_US * 1000ULL;
+
+        handsetPort.write(frame, buildRcFrame(frame));
+        rcFrames++;
+
+        if (rcFrames % PING_EVERY == 0)
+        {
+            // Wait for the RC frame's telemetry first, as a handset waits for its telemetry window.
+            usleep(500);
+            readTelemetry(&handset, &handsetPort);
+
+            const uint8_t kind = pings % 3;
+            if (kind == 2)
+            {
+                unansweredPings++;
+            }
+            else
+            {
+                handset.expectedOrigins.push_back(pingOrigins[kind]);
+                handset.pingSentNs.push_back(nowNs());
+            }
+            handsetPort.write(frame, buildPingFrame(pingDestinations[kind], pingOrigins[kind], frame));
+            pings++;
+        }
+    }
+
+    usleep(50000);
+    readTelemetry(&handset, &handsetPort);
+    receiving = false;
+    receiverThread.join();
+
+    // Every frame that was received, the pings for another device included, gets one telemetry slot.
+    // Each answer takes its ping's slot, so the other telemetry must still come round in the same order, with nothing skipped.
+    const uint8_t schedule[] = {crsfProtocol::CRSF_FRAMETYPE_ATTITUDE, crsfProtocol::CRSF_FRAMETYPE_BARO_ALTITUDE,
+                                crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR, crsfProtocol::CRSF_FRAMETYPE_GPS};
+    const size_t scheduleLength = sizeof(schedule) / sizeof(schedule[0]);
+    uint32_t outOfOrder = 0;
+    for (size_t i = 0; i < handset.telemetryTypes.size(); i++)
+    {
+        if (handset.telemetryTypes[i] != schedule[i % scheduleLength])
+        {
+            outOfOrder++;
+        }
+    }
+
+    serialReceiverCounters_t counters;
+    receiver.getCounters(&counters);
+
+    std::sort(handset.replyLatenciesUs.begin(), handset.replyLatenciesUs.end());
+    printf("RC frames sent: %u, pings sent: %u (%u for another device)\n", rcFrames, pings, unansweredPings);
+    printf("Device info frames: %u received, %zu expected, %u wrong | pings seen by the receiver: %u\n", handset.deviceInfoFrames,
+           handset.expectedOrigins.size(), handset.deviceInfoErrors, counters.devicePings);
+    printf("Other telemetry frames: %zu received, %u expected, %u out of order | CRC errors: %u\n", handset.telemetryTypes.size(),
+           rcFrames + unansweredPings, outOfOrder, handset.crcErrors);
+    if (!handset.replyLatenciesUs.empty())
+    {
+        printf("Ping to device info: %.1f us p50, %.1f us p99\n", handset.replyLatenciesUs[handset.replyLatenciesUs.size() / 2],
+               handset.replyLatenciesUs[handset.replyLatenciesUs.size() * 99 / 100]);
+    }
+
+    const bool ok = handset.deviceInfoFrames == handset.expectedOrigins.size() && handset.deviceInfoErrors == 0 &&
+                    handset.telemetryTypes.size() == rcFrames + unansweredPings && outOfOrder == 0 && handset.crcErrors == 0 &&
+                    counters.devicePings == handset.expectedOrigins.size();
+    printf("Device info %s\n", ok ? "OK" : "FAILED");
+
+    receiver.end();
+    close(master);
+    close(slave);
+    return ok ? 0 : 1;
+}
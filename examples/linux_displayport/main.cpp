@@ -0,0 +1,404 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example measures how many bytes a DisplayPort sends for typical OSD updates, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_displayport/main.cpp -o linux_displayport -lutil -lpthread
+
+Usage:
+./linux_displayport
+                            Runs a DisplayPort against a simulated handset canvas, in simulated time. There is one telemetry slot
+                            every 4 ms, and the OSD task draws and flushes its screen every 100 ms. These screens are drawn:
+                            - Startup: one flight screen, then nothing changes.
+                            - In flight: the flight screen, with the battery, altitude, speed, RSSI and timer changing at their own rates.
+                            - Menu: a settings menu, with the cursor moving down a line every 400 ms and a value changing now and then.
+                            - Page switch: the flight screen and the menu, one after the other, every 2 s.
+                            For each screen, the bytes that three ways of sending every flush take are compared: the whole screen,
+                            every row that changed (the DisplayPort's standard UPDATE frames) and only the spans that changed
+                            (its SPANS frames), both without a budget.
+                            Then the DisplayPort is run with its default encoding and budget of CRSF_DISPLAYPORT_BYTE_RATE bytes per second,
+                            and its bytes per second and the time that the canvas takes to catch up with a flush are reported.
+                            Last, the in flight screen is run again with 5% of the frames lost on the way, and the canvas must be
+                            repaired by the refreshes once the screen stops changing.
+                            The canvases read frames as a handset that shows a Betaflight canvas does: an UPDATE is a row, then that
+                            row's characters. Only the canvas for SPANS frames reads those. Every canvas must end up the same as the screen,
+                            and the canvases that do not read SPANS frames must not be sent any. */
+
+#include "SerialReceiver/CRC/CRC.hpp"
+#include "SerialReceiver/DisplayPort/DisplayPort.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace serialReceiverLayer;
+
+#define ROWS           8                              // A 128x64 monochrome handset, with a 6x8 font.
+#define COLUMNS        21
+#define SLOT_US        4000
+#define FLUSH_US       100000
+#define START_US       0xFFF00000                     // Just before micros() wraps around.
+#define UNLIMITED_RATE 65535
+#define LOSS_PERCENT   5
+#define FRAME_OVERHEAD 7                              // Sync, length, type, destination, origin, subcommand and CRC.
+#define ROW_FRAME_SIZE (FRAME_OVERHEAD + 1 + COLUMNS) // An UPDATE frame: the row, then its characters.
+#define SETTLE_US      1000000                        // How long the budgeted DisplayPort gets to catch up, after the last flush.
+
+typedef char screen_t[ROWS][COLUMNS];
+typedef void (*drawFunction_t)(screen_t screen, uint32_t time);
+
+/* The handset's side: applies each DisplayPort frame to its canvas, as a handset that shows a Betaflight canvas does.
+With knowsSpans, it reads SPANS frames as well. Without, it ignores them, and every other subcommand that it does not know. */
+class Canvas
+{
+  public:
+    Canvas(bool knowsSpans = false)
+    {
+        memset(cells, ' ', sizeof(cells));
+        badFrames = 0;
+        ignoredFrames = 0;
+        _knowsSpans = knowsSpans;
+    }
+
+    void apply(const uint8_t *frame, uint8_t length)
+    {
+        uint8_t copy[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        memcpy(copy, frame, length);
+        if (length < FRAME_OVERHEAD || copy[1] != length - 2 || copy[2] != crsfProtocol::CRSF_FRAMETYPE_DISPLAYPORT_CMD ||
+            copy[3] != crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER || _crc.calculate(2, copy[2], copy, length - 1) != copy[length - 1])
+        {
+            badFrames++;
+            return;
+        }
+
+        if (copy[5] == DISPLAYPORT_SUBCOMMAND_CLEAR)
+        {
+            memset(cells, ' ', sizeof(cells));
+            return;
+        }
+
+        if (copy[5] == DISPLAYPORT_SUBCOMMAND_UPDATE)
+        {
+            const uint8_t row = copy[6];
+            const uint8_t characters = length - FRAME_OVERHEAD - 1;
+            if (length <= FRAME_OVERHEAD || row >= ROWS || characters > COLUMNS)
+            {
+                badFrames++;
+                return;
+            }
+
+            memcpy(cells[row], &copy[7], characters);
+            return;
+        }
+
+        if (copy[5] != DISPLAYPORT_SUBCOMMAND_SPANS || !_knowsSpans)
+        {
+            ignoredFrames++;
+            return;
+        }
+
+        for (uint8_t i = 6; i + DISPLAYPORT_SPAN_HEADER_SIZE <= length - 1;)
+        {
+            const uint8_t row = copy[i];
+            const uint8_t column = copy[i + 1];
+            const uint8_t spanLength = copy[i + 2];
+            i += DISPLAYPORT_SPAN_HEADER_SIZE;
+            if (row >= ROWS || column + spanLength > COLUMNS || i + spanLength > length - 1)
+            {
+                badFrames++;
+                return;
+            }
+
+            memcpy(&cells[row][column], &copy[i], spanLength);
+            i += spanLength;
+        }
+    }
+
+    uint32_t mismatches(const screen_t screen)
+    {
+        uint32_t count = 0;
+        for (int r = 0; r < ROWS; r++)
+        {
+            for (int c = 0; c < COLUMNS; c++)
+            {
+                count += cells[r][c] != screen[r][c];
+            }
+        }
+
+        return count;
+    }
+
+    screen_t cells;
+    uint32_t badFrames;
+    uint32_t ignoredFrames;
+
+  private:
+    genericCrc::GenericCRC _crc;
+    bool _knowsSpans;
+};
+
+static void writeText(screen_t screen, int row, int column, const char *text)
+{
+    for (; *text != '\0' && column < COLUMNS; column++)
+    {
+        screen[row][column] = *text++;
+    }
+}
+
+static void drawFlight(screen_t screen, uint32_t time)
+{
+    char line[COLUMNS + 1];
+    const uint32_t ms = time / 1000;
+    const uint32_t seconds = ms / 1000;
+
+    writeText(screen, 0, 0, "ANGLE          ARMED");
+    snprintf(line, sizeof(line), "BAT %2u.%02uV  %3uA", 16 - (unsigned)(ms / 30000) % 3, 80 - (unsigned)(ms / 300) % 80, 12 + (unsigned)(ms / 700) % 9);
+    writeText(screen, 1, 0, line);
+    snprintf(line, sizeof(line), "ALT %4u.%um", 100 + (unsigned)(ms / 1000) % 50, (unsigned)(ms / 100) % 10);
+    writeText(screen, 2, 0, line);
+    snprintf(line, sizeof(line), "SPD %3ukm/h", 40 + (unsigned)(ms / 200) % 30);
+    writeText(screen, 3, 0, line);
+    snprintf(line, sizeof(line), "RSSI %4ddBm  LQ %3u", -60 - (int)(ms / 500) % 20, 100 - (unsigned)(ms / 2500) % 4);
+    writeText(screen, 4, 0, line);
+    writeText(screen, 5, 0, "SATS 14  HOME  0.3km");
+    writeText(screen, 6, 0, "---------------------");
+    snprintf(line, sizeof(line), "TIME %02u:%02u  MAH %4u", (unsigned)(seconds / 60) % 100, (unsigned)seconds % 60, 120 + (unsigned)(ms / 250));
+    writeText(screen, 7, 0, line);
+}
+
+static void drawMenu(screen_t screen, uint32_t time)
+{
+    static const char *const items[ROWS - 1] = {"RATE PROFILE", "PID PROFILE", "VTX CHANNEL", "VTX POWER", "OSD PROFILE", "BEEPER", "SAVE + EXIT"};
+    const uint32_t ms = time / 1000;
+    const unsigned cursor = (ms / 400) % (ROWS - 1);
+    char line[COLUMNS + 1];
+
+    writeText(screen, 0, 0, "---- SETTINGS ----");
+    for (unsigned i = 0; i < ROWS - 1; i++)
+    {
+        const unsigned value = i == 2 ? 1 + (unsigned)(ms / 3000) % 8 : i + 1;
+        snprintf(line, sizeof(line), "%c%-14s%3u", i == cursor ? '>' : ' ', items[i], value);
+        writeText(screen, i + 1, 0, line);
+    }
+}
+
+static void drawStartup(screen_t screen, uint32_t time)
+{
+    (void)time;
+    drawFlight(screen, 0);
+}
+
+static void drawPageSwitch(screen_t screen, uint32_t time)
+{
+    if ((time / 2000000) % 2 == 0)
+    {
+        drawFlight(screen, time);
+    }
+    else
+    {
+        drawMenu(screen, time);
+    }
+}
+
+typedef struct pattern_s
+{
+    const char *name;
+    drawFunction_t draw;
+    uint32_t duration;
+} pattern_t;
+
+typedef struct result_s
+{
+    uint32_t flushes;
+    uint32_t fullScreenBytes;
+    uint32_t changedRowBytes;
+    uint32_t spanBytes;
+    uint32_t budgetBytes;
+    displayPortStatistics_t statistics;
+    uint32_t catchUps;
+    uint64_t catchUpTotal;
+    uint32_t catchUpMax;
+    uint32_t mismatches;
+    uint32_t badFrames;
+    uint32_t ignoredFrames;
+} result_t;
+
+static uint32_t lossState = 0x12345678;
+
+static bool frameLost()
+{
+    lossState ^= lossState << 13;
+    lossState ^= lossState >> 17;
+    lossState ^= lossState << 5;
+    return lossState % 100 < LOSS_PERCENT;
+}
+
+/* Runs one pattern, then keeps going for settle more microseconds without changing the screen. */
+static void run(const pattern_t *pattern, bool lossy, uint32_t settle, result_t *result)
+{
+    DisplayPort budgeted(ROWS, COLUMNS);
+    DisplayPort rows(ROWS, COLUMNS, UNLIMITED_RATE);
+    DisplayPort spans(ROWS, COLUMNS, UNLIMITED_RATE);
+    rows.setRefreshInterval(0);
+    spans.setRefreshInterval(0);
+    spans.setEncoding(DISPLAYPORT_ENCODING_SPANS);
+    DisplayPort *const ports[] = {&budgeted, &rows, &spans};
+    Canvas canvas;
+    Canvas rowsCanvas;
+    Canvas spansCanvas(true);
+    Canvas *const canvases[] = {&canvas, &rowsCanvas, &spansCanvas};
+    screen_t screen;
+    screen_t previous;
+    bool catchingUp = false;
+    uint32_t catchUpStart = 0;
+    uint32_t nextFlush = 0;
+
+    memset(result, 0, sizeof(*result));
+    memset(previous, ' ', sizeof(previous));
+    for (uint32_t elapsed = 0; elapsed < pattern->duration + settle; elapsed += SLOT_US)
+    {
+        const uint32_t now = START_US + elapsed;
+        if (elapsed >= nextFlush && elapsed < pattern->duration)
+        {
+            nextFlush += FLUSH_US;
+            memset(screen, ' ', sizeof(screen));
+            pattern->draw(screen, elapsed);
+
+            for (DisplayPort *port : ports)
+            {
+                port->clear();
+                for (int r = 0; r < ROWS; r++)
+                {
+                    for (int c = 0; c < COLUMNS; c++)
+                    {
+                        port->write(r, c, screen[r][c]);
+                    }
+                }
+
+                port->flush();
+            }
+
+            result->fullScreenBytes += ROWS * ROW_FRAME_SIZE;
+            result->flushes++;
+
+            if (!catchingUp && memcmp(screen, previous, sizeof(screen)) != 0)
+            {
+                catchingUp = true;
+                catchUpStart = elapsed;
+            }
+
+            memcpy(previous, screen, sizeof(previous));
+        }
+
+        uint8_t length = rows.update(now);
+        if (length > 0)
+        {
+            rowsCanvas.apply(rows.getFrame(), length);
+        }
+
+        length = spans.update(now);
+        if (length > 0)
+        {
+            spansCanvas.apply(spans.getFrame(), length);
+        }
+
+        length = budgeted.update(now);
+        if (length > 0 && !(lossy && frameLost()))
+        {
+            canvas.apply(budgeted.getFrame(), length);
+        }
+
+        if (catchingUp && budgeted.isIdle())
+        {
+            const uint32_t catchUp = elapsed + SLOT_US - catchUpStart;
+            catchingUp = false;
+            result->catchUps++;
+            result->catchUpTotal += catchUp;
+            result->catchUpMax = catchUp > result->catchUpMax ? catchUp : result->catchUpMax;
+        }
+
+        if (elapsed + SLOT_US == pattern->duration)
+        {
+            budgeted.getStatistics(&result->statistics);
+        }
+    }
+
+    displayPortStatistics_t statistics;
+    rows.getStatistics(&statistics);
+    result->changedRowBytes = statistics.bytes;
+    spans.getStatistics(&statistics);
+    result->spanBytes = statistics.bytes;
+    for (Canvas *c : canvases)
+    {
+        result->mismatches += c->mismatches(previous);
+        result->badFrames += c->badFrames;
+        result->ignoredFrames += c->ignoredFrames;
+    }
+}
+
+int main()
+{
+    const pattern_t patterns[] = {
+        {"Startup", drawStartup, 2000000},
+        {"In flight", drawFlight, 20000000},
+        {"Menu", drawMenu, 10000000},
+        {"Page switch", drawPageSwitch, 10000000},
+    };
+    bool ok = true;
+    result_t result;
+
+    printf("%u x %u screen, flushed every %u ms, one telemetry slot every %u ms. Bytes per second, CRSF framing included:\n\n", ROWS, COLUMNS, FLUSH_US / 1000, SLOT_US / 1000);
+    printf("%-12s %12s %12s %12s | %9s %7s %9s %9s %17s\n", "", "Whole screen", "Changed rows", "Dirty spans", "Budgeted", "Frames", "Throttled", "Refreshes", "Catch up mean/max");
+    for (const pattern_t &pattern : patterns)
+    {
+        run(&pattern, false, SETTLE_US, &result);
+        const double seconds = pattern.duration / 1e6;
+        const double catchUpMean = result.catchUps > 0 ? result.catchUpTotal / 1000.0 / result.catchUps : 0;
+        printf("%-12s %12.0f %12.0f %12.0f | %9.0f %7u %9u %9u %9.0f/%4u ms\n", pattern.name, result.fullScreenBytes / seconds, result.changedRowBytes / seconds,
+               result.spanBytes / seconds, result.statistics.bytes / seconds, result.statistics.frames, result.statistics.throttledSlots,
+               result.statistics.refreshes, catchUpMean, result.catchUpMax / 1000);
+
+        // One frame may go out ahead of the budget.
+        if (result.statistics.bytes > CRSF_DISPLAYPORT_BYTE_RATE * seconds + crsfProtocol::CRSF_FRAME_SIZE_MAX || result.mismatches > 0 || result.badFrames > 0 ||
+            result.ignoredFrames > 0)
+        {
+            printf("  FAILED: %u characters on the canvases differ from the screen, %u bad frames, %u frames a canvas did not read\n", result.mismatches,
+                   result.badFrames, result.ignoredFrames);
+            ok = false;
+        }
+    }
+
+    // Every row is refreshed once in ROWS refresh intervals, after the screen stops changing.
+    const uint32_t settle = (ROWS + 1) * DISPLAYPORT_REFRESH_INTERVAL * 1000;
+    run(&patterns[1], true, settle, &result);
+    printf("\nIn flight, with %u%% of the frames lost: %u characters differ from the screen, %u s after it stopped changing\n", LOSS_PERCENT, result.mismatches,
+           settle / 1000000);
+    if (result.mismatches > 0 || result.badFrames > 0 || result.ignoredFrames > 0)
+    {
+        ok = false;
+    }
+
+    printf("\nDisplayPort %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example measures what the frame router costs per frame, with 1, 4 and 8 sinks.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_frame_router_benchmark/main.cpp -o linux_frame_router_benchmark -lutil -lpthread
+
+The same block of frames (mostly RC channels, with some link statistics and some frames with a bad CRC)
+is decoded from memory by several decoders. One has the frame router compiled out, one has it compiled in with no router set,
+and the others route every frame to 1, 4 and 8 sinks. Each sink only adds up a byte of each frame that it is given,
+so what is measured is the dispatch itself. The runs are interleaved, and the best of several repeats is kept. */
+
+#include "SerialReceiver/CRSF/CRSF.hpp"
+#include "SerialReceiver/FrameRouter/FrameRouter.hpp"
+
+#include <stdio.h>
+#include <time.h>
+
+using namespace serialReceiverLayer;
+
+#define BENCHMARK_FRAMES  1000
+#define BENCHMARK_PASSES  2000
+#define BENCHMARK_REPEATS 15
+#define BENCHMARK_RUNS    5
+
+struct RouterConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool frameRouterEnabled = true;
+};
+
+static uint8_t frames[BENCHMARK_FRAMES * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+static size_t framesLength = 0;
+static uint32_t validFrames = 0;
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* Stands in for a logger, an OSD or a bridge. It reads the frame through the const view, as a real sink would. */
+class SummingSink final : public FrameSink
+{
+  public:
+    uint32_t frames = 0;
+    uint32_t sum = 0;
+
+    void onFrame(const crsfProtocol::frame_t *frame, uint32_t timestamp) override
+    {
+        (void)timestamp;
+        frames++;
+        sum += frame->frame.payload[0];
+    }
+};
+
+static void appendFrame(uint8_t type, const uint8_t *payload, uint8_t payloadSize, bool corruptCrc)
+{
+    genericCrc::GenericCRC crc;
+    crsfProtocol::frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame.frame.frameLength = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame.frame.type = type;
+    memcpy(frame.frame.payload, payload, payloadSize);
+    frame.frame.payload[payloadSize] = crc.calculate(type, frame.frame.payload, payloadSize) ^ (corruptCrc ? 0xFF : 0x00);
+
+    const size_t size = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+    memcpy(frames + framesLength, frame.raw, size);
+    framesLength += size;
+    validFrames += corruptCrc ? 0 : 1;
+}
+
+static void buildFrames()
+{
+    for (uint32_t i = 0; i < BENCHMARK_FRAMES; i++)
+    {
+        if (i % 10 == 5)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = 60;
+            linkStatistics.uplink_link_quality = 100;
+            appendFrame(crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, (const uint8_t *)&linkStatistics,
+                        crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE, false);
+            continue;
+        }
+
+        crsfProtocol::rcChannelsPacked_t channels;
+        memset(&channels, 0, sizeof(channels));
+        channels.channel0 = 172 + (i % 1640);
+        channels.channel2 = 992;
+        appendFrame(crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, (const uint8_t *)&channels,
+                    crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE, i % 100 == 99);
+    }
+}
+
+/* Decodes the frames BENCHMARK_PASSES times and returns the nanoseconds per frame. All bytes share one timestamp,
+so the decoder's frame timeout never cuts a frame in two. */
+template <class Config>
+static double runOnce(BasicCRSF<Config> *decoder)
+{
+    const uint64_t start = monotonicNanoseconds();
+    for (int pass = 0; pass < BENCHMARK_PASSES; pass++)
+    {
+        const uint32_t timestamp = (uint32_t)pass;
+        for (size_t i = 0; i < framesLength; i++)
+        {
+            decoder->receiveFrames(frames[i], timestamp);
+        }
+    }
+    const uint64_t elapsed = monotonicNanoseconds() - start;
+
+    return (double)elapsed / ((double)BENCHMARK_FRAMES * BENCHMARK_PASSES);
+}
+
+int main()
+{
+    buildFrames();
+    printf("Decoding %u frames (%u with a valid CRC, %zu bytes), %u times per decoder, best of %u\n\n",
+           BENCHMARK_FRAMES, validFrames, framesLength, BENCHMARK_PASSES, BENCHMARK_REPEATS);
+
+    const uint8_t sinkCounts[BENCHMARK_RUNS] = {0, 0, 1, 4, 8};
+    const char *labels[BENCHMARK_RUNS] = {"Router compiled out", "No router set", "1 sink", "4 sinks", "8 sinks"};
+
+    CRSF compiledOut;
+    BasicCRSF<RouterConfig> decoders[BENCHMARK_RUNS - 1];
+    FrameRouter routers[BENCHMARK_RUNS - 1];
+    SummingSink sinks[FRAME_ROUTER_ROUTE_COUNT];
+
+    compiledOut.begin();
+    compiledOut.setFrameTime(crsfProtocol::BAUD_RATE, 10);
+    for (int i = 0; i < BENCHMARK_RUNS - 1; i++)
+    {
+        decoders[i].begin();
+        decoders[i].setFrameTime(crsfProtocol::BAUD_RATE, 10);
+
+        const uint8_t sinkCount = sinkCounts[i + 1];
+        for (uint8_t j = 0; j < sinkCount; j++)
+        {
+            // Every sink takes every frame type, from any address, which is the worst case for the router.
+            routers[i].addRoute(&sinks[j]);
+        }
+        if (sinkCount > 0)
+        {
+            decoders[i].setFrameRouter(&routers[i]);
+        }
+    }
+
+    double perFrame[BENCHMARK_RUNS];
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        for (int turn = 0; turn < BENCHMARK_RUNS; turn++)
+        {
+            const int run = (repeat + turn) % BENCHMARK_RUNS;
+            const double repeatPerFrame = run == 0 ? runOnce(&compiledOut) : runOnce(&decoders[run - 1]);
+            if (repeat == 0 || repeatPerFrame < perFrame[run])
+            {
+                perFrame[run] = repeatPerFrame;
+            }
+        }
+    }
+
+    printf("%-22s %12s %18s %16s\n", "", "ns/frame", "Over no router", "ns/delivery");
+    for (int run = 0; run < BENCHMARK_RUNS; run++)
+    {
+        const double added = perFrame[run] - perFrame[1];
+        if (sinkCounts[run] > 0)
+        {
+            // Only frames with a valid CRC are routed.
+            const double perDelivery = added * BENCHMARK_FRAMES / ((double)validFrames * sinkCounts[run]);
+            printf("%-22s %12.2f %+18.2f %16.2f\n", labels[run], perFrame[run], added, perDelivery);
+        }
+        else
+        {
+            printf("%-22s %12.2f %+18.2f %16s\n", labels[run], perFrame[run], added, "-");
+        }
+    }
+
+    // Each sink must have been given exactly the frames with a valid CRC, on every pass.
+    const uint32_t expected = validFrames * BENCHMARK_PASSES * BENCHMARK_REPEATS;
+    bool ok = true;
+    for (int i = 0; i < BENCHMARK_RUNS - 1; i++)
+    {
+        frameRouterStatistics_t statistics;
+        routers[i].getStatistics(&statistics);
+        if (sinkCounts[i + 1] > 0 && (statistics.frames != expected || statistics.deliveries != expected * sinkCounts[i + 1]))
+        {
+            ok = false;
+        }
+    }
+
+    uint32_t sinkFrames = 0;
+    for (int i = 0; i < FRAME_ROUTER_ROUTE_COUNT; i++)
+    {
+        sinkFrames += sinks[i].frames;
+    }
+    ok = ok && sinkFrames == expected * (1 + 4 + 8);
+    printf("\nDeliveries %s (%u frames to %u sink calls)\n", ok ? "OK" : "MISMATCH", expected * 3, sinkFrames);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,418 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example simulates a receiver and the Serial Receiver sharing one wire, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_half_duplex/main.cpp -o linux_half_duplex -lutil -lpthread
+
+Usage:
+./linux_half_duplex
+                            Puts a simulated receiver and the Serial Receiver on one simulated wire at 420000 baud, in a single thread.
+                            Every byte goes on the wire at its real time, and comes back to the device that sent it as an echo.
+                            Bytes that two devices have on the wire at the same time arrive as noise, and that is counted as a collision.
+                            Once per RC period, the receiver sends a burst: link statistics (every 10th burst), a device ping
+                            (every 100th burst), then an RC channels frame. The flight controller's main loop also stalls for 5 ms
+                            every 250 bursts, as if it had something else to do.
+                            These runs are made, and the collisions and lost frames are reported for each:
+                            1. Without half duplex mode, at 500 Hz. Telemetry goes out after every frame, and the echo is decoded.
+                            2. With half duplex mode, at 500 Hz.
+                            3. With half duplex mode, at 666 Hz. The gap is too short for the longer telemetry frames (and the
+                               device info frame), which must be dropped instead of colliding.
+                            With half duplex mode, there must be no collisions, no lost telemetry and no echo in the decoder.
+                            RC channels and link statistics can still be lost if the host itself stalls for longer than the
+                            decoder's frame time while a frame is arriving, as the decoder then drops that frame and resynchronises. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define BUS_RECEIVER          0
+#define BUS_FLIGHT_CONTROLLER 1
+#define RUN_US                3000000
+#define STALL_US              5000
+#define LATE_US               20                                                                                                // Bursts that the simulation would start later than this are skipped, as if the packet was lost on the air.
+#define STALL_BURSTS          250
+#define LINK_STATISTICS_BURST 10
+#define PING_BURST            100
+#define RC_FRAME_SIZE         (crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD)
+
+// Both runs answer the receiver's pings, so that there is more than the scheduled telemetry to fit in the gaps.
+struct FullDuplexConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool telemetryDeviceInfoEnabled = true;
+};
+
+struct HalfDuplexConfig : FullDuplexConfig
+{
+    static constexpr bool halfDuplexEnabled = true;
+};
+
+/* True if time a is after time b. micros() wraps around, so the difference is compared instead. */
+static bool isAfter(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) > 0;
+}
+
+/* One wire, shared by the receiver and the flight controller. The flight controller hears everything on the wire, its own bytes included.
+The receiver is assumed to drop its own echo, so it only hears the flight controller. */
+class SharedBus
+{
+  public:
+    uint32_t collisions;
+
+    SharedBus(uint32_t baudRate) : collisions(0), _baudRate(baudRate)
+    {
+        _lineFree[BUS_RECEIVER] = micros();
+        _lineFree[BUS_FLIGHT_CONTROLLER] = micros();
+    }
+
+    /* Puts bytes on the wire from startTime, or once the source's own UART has finished what it was sending before. */
+    void transmit(uint8_t source, const uint8_t *bytes, size_t size, uint32_t startTime)
+    {
+        uint32_t start = isAfter(_lineFree[source], startTime) ? _lineFree[source] : startTime;
+        const uint32_t end = start + _byteEndTime(size);
+        _lineFree[source] = end;
+
+        // Bytes that overlap the other device's transmission are noise, for both devices' bytes.
+        bool collided = false;
+        for (const transmission_t &other : _transmissions)
+        {
+            if (other.source != source && isAfter(end, other.start) && isAfter(other.end, start))
+            {
+                collided = true;
+                for (std::deque<busByte_t> &queue : _queues)
+                {
+                    for (busByte_t &queued : queue)
+                    {
+                        if (queued.source == other.source && isAfter(queued.end, start) && isAfter(end, queued.end - _byteEndTime(1)))
+                        {
+                            queued.value = (uint8_t)rand();
+                        }
+                    }
+                }
+            }
+        }
+        collisions += collided ? 1 : 0;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            busByte_t byte = {start + _byteEndTime(i + 1), source, bytes[i]};
+            for (const transmission_t &other : _transmissions)
+            {
+                if (other.source != source && isAfter(byte.end, other.start) && isAfter(other.end, byte.end - _byteEndTime(1)))
+                {
+                    byte.value = (uint8_t)rand();
+                }
+            }
+
+            _insert(_queues[BUS_FLIGHT_CONTROLLER], byte);
+            if (source != BUS_RECEIVER)
+            {
+                _insert(_queues[BUS_RECEIVER], byte);
+            }
+        }
+
+        _transmissions.push_back({start, end, source});
+        while (_transmissions.size() > 16)
+        {
+            _transmissions.pop_front();
+        }
+    }
+
+    /* Returns the bytes that have finished arriving at device by now. */
+    size_t read(uint8_t device, uint8_t *buffer, size_t size)
+    {
+        const uint32_t now = micros();
+        std::deque<busByte_t> &queue = _queues[device];
+        size_t length = 0;
+        while (length < size && !queue.empty() && !isAfter(queue.front().end, now))
+        {
+            buffer[length++] = queue.front().value;
+            queue.pop_front();
+        }
+        return length;
+    }
+
+  private:
+    typedef struct busByte_s
+    {
+        uint32_t end;
+        uint8_t source;
+        uint8_t value;
+    } busByte_t;
+
+    typedef struct transmission_s
+    {
+        uint32_t start;
+        uint32_t end;
+        uint8_t source;
+    } transmission_t;
+
+    uint32_t _baudRate;
+    uint32_t _lineFree[2];
+    std::deque<transmission_t> _transmissions;
+    std::deque<busByte_t> _queues[2];
+
+    uint32_t _byteEndTime(size_t bytes)
+    {
+        return (uint32_t)(bytes * 10000000ULL / _baudRate);
+    }
+
+    static void _insert(std::deque<busByte_t> &queue, const busByte_t &byte)
+    {
+        auto position = std::upper_bound(queue.begin(), queue.end(), byte, [](const busByte_t &a, const busByte_t &b) { return isAfter(b.end, a.end); });
+        queue.insert(position, byte);
+    }
+};
+
+/* The flight controller's UART, on the shared wire. */
+class BusTransport final : public hal::SerialTransport
+{
+  public:
+    BusTransport(SharedBus *bus) : _bus(bus)
+    {
+    }
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        return _bus->read(BUS_FLIGHT_CONTROLLER, buffer, size);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        _bus->transmit(BUS_FLIGHT_CONTROLLER, buffer, size, micros());
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+
+  private:
+    SharedBus *_bus;
+};
+
+/* The simulated receiver's side of a run. */
+typedef struct receiver_s
+{
+    SharedBus *bus;
+    uint32_t bursts;
+    uint32_t burstsSkipped;
+    uint32_t rcFramesSent;
+    uint32_t linkStatisticsSent;
+    uint32_t pingsSent;
+    uint32_t telemetryFramesReceived;
+    uint32_t deviceInfoReceived;
+    std::vector<uint8_t> pending;
+} receiver_t;
+
+static uint8_t finishFrame(uint8_t *frame, uint8_t type, uint8_t payloadSize)
+{
+    genericCrc::GenericCRC crc;
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = type;
+    frame[payloadSize + 3] = crc.calculate(type, frame + 3, payloadSize);
+    return payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+static void sendBurst(receiver_t *receiver, uint32_t startTime)
+{
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+
+    if (receiver->bursts % LINK_STATISTICS_BURST == 0)
+    {
+        const uint8_t payload[crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE] = {50, 50, 100, 10, 0, 4, 2, 50, 100, 10};
+        memcpy(frame + 3, payload, sizeof(payload));
+        receiver->bus->transmit(BUS_RECEIVER, frame, finishFrame(frame, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, sizeof(payload)), startTime);
+        receiver->linkStatisticsSent++;
+    }
+
+    if (receiver->bursts % PING_BURST == PING_BURST / 2)
+    {
+        frame[3] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+        frame[4] = crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER;
+        receiver->bus->transmit(BUS_RECEIVER, frame, finishFrame(frame, crsfProtocol::CRSF_FRAMETYPE_DEVICE_PING, crsfProtocol::CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE), startTime);
+        receiver->pingsSent++;
+    }
+
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = CRSF_RC_CHANNEL_CENTER;
+    }
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    receiver->bus->transmit(BUS_RECEIVER, frame, finishFrame(frame, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE),
+                            startTime);
+    receiver->rcFramesSent++;
+    receiver->bursts++;
+}
+
+/* Counts the telemetry frames that reach the receiver whole. */
+static void readTelemetry(receiver_t *receiver)
+{
+    genericCrc::GenericCRC crc;
+    uint8_t buffer[64];
+    size_t length;
+
+    while ((length = receiver->bus->read(BUS_RECEIVER, buffer, sizeof(buffer))) > 0)
+    {
+        receiver->pending.insert(receiver->pending.end(), buffer, buffer + length);
+    }
+
+    // Noise can look like anything, so only take frames that start with the sync byte, have a sane length and a matching CRC.
+    size_t position = 0;
+    while (receiver->pending.size() - position >= 2)
+    {
+        uint8_t *frame = receiver->pending.data() + position;
+        if (frame[0] != crsfProtocol::CRSF_SYNC_BYTE || frame[1] < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC ||
+            frame[1] > crsfProtocol::CRSF_FRAME_SIZE_MAX - 2)
+        {
+            position++;
+            continue;
+        }
+        if (receiver->pending.size() - position < (size_t)frame[1] + 2)
+        {
+            break;
+        }
+        if (crc.calculate(2, frame[2], frame, frame[1] + 1) != frame[frame[1] + 1])
+        {
+            position++;
+            continue;
+        }
+
+        receiver->telemetryFramesReceived++;
+        receiver->deviceInfoReceived += frame[2] == crsfProtocol::CRSF_FRAMETYPE_DEVICE_INFO ? 1 : 0;
+        position += frame[1] + 2;
+    }
+    receiver->pending.erase(receiver->pending.begin(), receiver->pending.begin() + position);
+}
+
+/* Runs one simulation, prints what happened, and returns true if nothing collided, no telemetry was lost and no echo was decoded. */
+template <class Config>
+static bool simulate(const char *name, uint32_t periodUs)
+{
+    SharedBus bus(crsfProtocol::BAUD_RATE);
+    BusTransport transport(&bus);
+    BasicSerialReceiver<Config> flightController(&transport);
+    if (!flightController.begin())
+    {
+        fprintf(stderr, "Could not start the Serial Receiver\n");
+        return false;
+    }
+    flightController.setDeviceInfo("Half duplex FC");
+    flightController.telemetryWriteAttitude(100, -200, 300);
+    flightController.telemetryWriteBattery(16.8F, 12.5F, 1300, 80);
+    flightController.telemetryWriteGPS(-37.8136F, 144.9631F, 120.0F, 12.0F, 90.0F, 12);
+
+    receiver_t receiver = receiver_t();
+    receiver.bus = &bus;
+
+    const uint32_t startTime = micros();
+    uint32_t nextBurst = startTime;
+    uint32_t stallUntil = startTime;
+    while (isAfter(startTime + RUN_US, micros()))
+    {
+        if (!isAfter(nextBurst, micros()))
+        {
+            /* The host can stall this whole simulation. A burst that is sent late would have bytes that arrived in the past,
+            after the flight controller already saw an idle line, and nothing real works like that. */
+            if (isAfter(micros(), nextBurst + LATE_US))
+            {
+                receiver.burstsSkipped++;
+            }
+            else
+            {
+                if (receiver.bursts % STALL_BURSTS == STALL_BURSTS / 2)
+                {
+                    stallUntil = nextBurst + STALL_US;
+                }
+                sendBurst(&receiver, nextBurst);
+            }
+            nextBurst += periodUs;
+        }
+
+        if (!isAfter(stallUntil, micros()))
+        {
+            flightController.processFrames();
+        }
+        readTelemetry(&receiver);
+    }
+
+    // Let the last burst and its telemetry finish.
+    const uint32_t drainUntil = micros() + 2 * periodUs;
+    while (isAfter(drainUntil, micros()))
+    {
+        flightController.processFrames();
+        readTelemetry(&receiver);
+    }
+
+    serialReceiverCounters_t counters;
+    flightController.getCounters(&counters);
+    flightController.end();
+
+    const uint32_t rcFramesLost = receiver.rcFramesSent - counters.crsf.rcChannelsFrames;
+    const uint32_t linkStatisticsLost = receiver.linkStatisticsSent - counters.crsf.linkStatisticsFrames;
+    const uint32_t telemetryFramesLost = counters.telemetryFramesSent - receiver.telemetryFramesReceived;
+    const uint32_t echoesDecoded = counters.crsf.otherFrames - counters.devicePings;
+
+    printf("%s, every %u us (%u bursts skipped by a late host):\n", name, periodUs, receiver.burstsSkipped);
+    printf("  %u collisions on the wire (%u seen in the echo)\n", bus.collisions, counters.collisions);
+    printf("  RC channels lost: %u of %u, link statistics lost: %u of %u, pings answered: %u of %u\n", rcFramesLost, receiver.rcFramesSent,
+           linkStatisticsLost, receiver.linkStatisticsSent, receiver.deviceInfoReceived, receiver.pingsSent);
+    printf("  Telemetry frames lost: %u of %u sent. %u dropped because they did not fit, %u slots missed\n", telemetryFramesLost,
+           counters.telemetryFramesSent, counters.halfDuplexFramesDropped, counters.halfDuplexSlotsMissed);
+    printf("  Echo: %u bytes kept from the decoder, %u of our own frames decoded as if they came from the receiver\n", counters.echoBytes, echoesDecoded);
+
+    return bus.collisions == 0 && telemetryFramesLost == 0 && echoesDecoded == 0;
+}
+
+int main()
+{
+    printf("Wire time of one RC channels frame at 420000 baud: %.0f us\n", RC_FRAME_SIZE * 10 * 1e6 / crsfProtocol::BAUD_RATE);
+
+    simulate<FullDuplexConfig>("1. Without half duplex mode", 2000);
+    bool ok = simulate<HalfDuplexConfig>("2. With half duplex mode", 2000);
+    ok = simulate<HalfDuplexConfig>("3. With half duplex mode", 1500) && ok;
+
+    printf("Half duplex %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example runs the two receiver configurations from the multiple_receivers sketch on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_multiple_receivers/main.cpp -o linux_multiple_receivers -lutil -lpthread
+
+Usage:
+./linux_multiple_receivers
+                            Feeds RC channels frames from memory to a receiver with the default configuration and to an RC only
+                            receiver (no telemetry, no link statistics), as in the multiple_receivers sketch.
+                            The default receiver goes by the link statistics: it must report failsafe on a weak link, and not
+                            on a good one. The RC only receiver has no link statistics to go by, and must never report failsafe
+                            while frames arrive. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define RC_FRAMES 50
+
+struct RcOnlyConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool telemetryEnabled = false;
+    static constexpr bool linkStatisticsEnabled = false;
+};
+
+/* Hands over the bytes that were put in input, and throws away what is written. */
+class MemoryTransport final : public hal::SerialTransport
+{
+  public:
+    std::vector<uint8_t> input;
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        const size_t count = size < input.size() ? size : input.size();
+        memcpy(buffer, input.data(), count);
+        input.erase(input.begin(), input.begin() + count);
+        return count;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        (void)buffer;
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+typedef struct callbackCount_s
+{
+    uint32_t frames;
+    uint32_t failsafes;
+} callbackCount_t;
+
+static callbackCount_t mainCount;
+static callbackCount_t backupCount;
+
+static void onReceiveMainRcChannels(rcChannels_t *rcChannels)
+{
+    mainCount.frames++;
+    mainCount.failsafes += rcChannels->failsafe;
+}
+
+static void onReceiveBackupRcChannels(rcChannels_t *rcChannels)
+{
+    backupCount.frames++;
+    backupCount.failsafes += rcChannels->failsafe;
+}
+
+static void appendFrame(std::vector<uint8_t> *bytes, uint8_t type, const uint8_t *payload, uint8_t size)
+{
+    genericCrc::GenericCRC crc;
+    bytes->push_back(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER);
+    bytes->push_back(size + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+    bytes->push_back(type);
+    bytes->insert(bytes->end(), payload, payload + size);
+    bytes->push_back(crc.calculate(type, bytes->data() + bytes->size() - size, size));
+}
+
+/* Feeds RC_FRAMES RC channels frames to receiver, each one after a link statistics frame with the given uplink quality
+if withLinkStatistics is set. processFrames() runs after each RC channels frame, as the frames arrive 4 ms apart. */
+template <class Config>
+static void feed(BasicSerialReceiver<Config> *receiver, MemoryTransport *transport, bool withLinkStatistics, uint8_t linkQuality)
+{
+    for (int i = 0; i < RC_FRAMES; i++)
+    {
+        std::vector<uint8_t> bytes;
+        if (withLinkStatistics)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = 60;
+            linkStatistics.uplink_link_quality = linkQuality;
+            appendFrame(&bytes, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, (const uint8_t *)&linkStatistics,
+                        crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE);
+        }
+
+        crsfProtocol::rcChannelsPacked_t channels;
+        memset(&channels, 0, sizeof(channels));
+        channels.channel2 = 172 + i * 10;
+        appendFrame(&bytes, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, (const uint8_t *)&channels, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+
+        transport->input = bytes;
+        while (!transport->input.empty())
+        {
+            receiver->processFrames();
+        }
+    }
+}
+
+static bool report(const char *what, const callbackCount_t *count, bool failsafeExpected)
+{
+    const bool ok = count->frames == RC_FRAMES && count->failsafes == (failsafeExpected ? RC_FRAMES : 0);
+    printf("%-48s %2u RC frames, %2u in failsafe: %s\n", what, count->frames, count->failsafes, ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int main()
+{
+    MemoryTransport mainPort;
+    MemoryTransport backupPort;
+    SerialReceiver mainReceiver(&mainPort);
+    BasicSerialReceiver<RcOnlyConfig> backupReceiver(&backupPort);
+    bool ok = true;
+
+    if (!mainReceiver.begin() || !backupReceiver.begin())
+    {
+        fprintf(stderr, "Could not start the receivers\n");
+        return 1;
+    }
+
+    mainReceiver.setRcChannelsCallback(onReceiveMainRcChannels);
+    backupReceiver.setRcChannelsCallback(onReceiveBackupRcChannels);
+
+    memset(&mainCount, 0, sizeof(mainCount));
+    feed(&mainReceiver, &mainPort, true, 100);
+    ok = report("Main receiver, 100% link quality:", &mainCount, false) && ok;
+
+    memset(&mainCount, 0, sizeof(mainCount));
+    feed(&mainReceiver, &mainPort, true, 50);
+    ok = report("Main receiver, 50% link quality:", &mainCount, true) && ok;
+
+    memset(&backupCount, 0, sizeof(backupCount));
+    feed(&backupReceiver, &backupPort, false, 0);
+    ok = report("RC only receiver, no link statistics:", &backupCount, false) && ok;
+
+    mainReceiver.end();
+    backupReceiver.end();
+    printf("Multiple receivers %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
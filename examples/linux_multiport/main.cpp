@@ -0,0 +1,289 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example monitors many CRSF links at once on a Linux host, and measures how the CPU cost scales with the number of links.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_multiport/main.cpp -o linux_multiport -lutil -lpthread
+
+Usage:
+./linux_multiport /dev/ttyUSB0 /dev/ttyUSB1 ...   Monitor real receivers and print what arrives on each port.
+./linux_multiport --benchmark                      Simulate 1, 2, 4 ... 64 receivers over pseudo-terminal pairs
+                                                   and report the CPU time spent per link. */
+
+#include "SerialReceiver/MultiPortReceiver/MultiPortReceiver.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <fcntl.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace serialReceiverLayer;
+
+static volatile bool keepRunning = true;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+/* Prints a summary of each port twice per second. */
+class PrintingSink : public MultiPortSink
+{
+  public:
+    void onRcChannels(uint8_t port, uint64_t timestampUs, const rcChannels_t *rcChannels) override
+    {
+        if (timestampUs - lastPrint[port] >= 500000)
+        {
+            lastPrint[port] = timestampUs;
+            printf("[%u] RC Channels <A: %u, E: %u, T: %u, R: %u> FailSafe: %s\n", port,
+                   rcChannels->value[0], rcChannels->value[1], rcChannels->value[2], rcChannels->value[3],
+                   rcChannels->failsafe ? "Active" : "Inactive");
+        }
+    }
+
+    void onLinkStatistics(uint8_t port, uint64_t timestampUs, const link_statistics_t *linkStatistics) override
+    {
+        (void)timestampUs;
+        printf("[%u] Link Statistics <RSSI: %d, LQ: %u, SNR: %d>\n", port, linkStatistics->rssi, linkStatistics->lqi, linkStatistics->snr);
+    }
+
+  private:
+    uint64_t lastPrint[MULTIPORT_RECEIVER_PORTS_MAX] = {};
+};
+
+/* Counts records, which is all the benchmark needs. */
+class CountingSink : public MultiPortSink
+{
+  public:
+    uint32_t rcRecords = 0;
+    uint32_t linkRecords = 0;
+
+    void onRcChannels(uint8_t port, uint64_t timestampUs, const rcChannels_t *rcChannels) override
+    {
+        (void)port;
+        (void)timestampUs;
+        (void)rcChannels;
+        rcRecords++;
+    }
+
+    void onLinkStatistics(uint8_t port, uint64_t timestampUs, const link_statistics_t *linkStatistics) override
+    {
+        (void)port;
+        (void)timestampUs;
+        (void)linkStatistics;
+        linkRecords++;
+    }
+};
+
+static size_t buildFrame(genericCrc::GenericCRC *crc, crsfProtocol::frame_t *frame, uint8_t type, uint8_t payloadSize)
+{
+    frame->frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame->frame.frameLength = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame->frame.type = type;
+    frame->frame.payload[payloadSize] = crc->calculate(type, frame->frame.payload, payloadSize);
+    return frame->frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+}
+
+/* Simulates one receiver per pseudo-terminal: RC frames at packetRate Hz, with a link statistics frame every tenth packet.
+One thread drives every port, so that the writer's own overhead does not grow with the port count. */
+static void simulateReceivers(const int *fds, size_t portCount, unsigned int packetRate, unsigned int seconds)
+{
+    genericCrc::GenericCRC crc;
+    crsfProtocol::frame_t rcFrame;
+    crsfProtocol::frame_t linkFrame;
+    memset(&rcFrame, 0, sizeof(rcFrame));
+    memset(&linkFrame, 0, sizeof(linkFrame));
+
+    crsfProtocol::rcChannelsPacked_t *channels = (crsfProtocol::rcChannelsPacked_t *)rcFrame.frame.payload;
+    linkFrame.frame.payload[0] = 60;  // Uplink RSSI.
+    linkFrame.frame.payload[2] = 100; // Uplink link quality.
+    linkFrame.frame.payload[3] = 10;  // Uplink SNR.
+    const size_t linkFrameSize = buildFrame(&crc, &linkFrame, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE);
+
+    const unsigned long period = 1000000 / packetRate;
+    unsigned long nextFrame = micros();
+
+    for (unsigned int i = 0; i < packetRate * seconds && keepRunning; i++)
+    {
+        channels->channel0 = 172 + (i % 1640);
+        channels->channel1 = 992;
+        channels->channel2 = 172;
+        channels->channel3 = 992;
+        const size_t rcFrameSize = buildFrame(&crc, &rcFrame, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+
+        for (size_t port = 0; port < portCount; port++)
+        {
+            if (write(fds[port], rcFrame.raw, rcFrameSize) < 0)
+            {
+                continue;
+            }
+
+            if (i % 10 == 0)
+            {
+                write(fds[port], linkFrame.raw, linkFrameSize);
+            }
+        }
+
+        nextFrame += period;
+        const long remaining = (long)(nextFrame - micros());
+        if (remaining > 0)
+        {
+            delayMicroseconds(remaining);
+        }
+    }
+}
+
+static double cpuSeconds(int who)
+{
+    struct rusage usage;
+    getrusage(who, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+}
+
+static bool runBenchmark(size_t portCount, unsigned int packetRate, unsigned int seconds)
+{
+    int masters[MULTIPORT_RECEIVER_PORTS_MAX];
+    int slaves[MULTIPORT_RECEIVER_PORTS_MAX];
+    hal::LinuxSerial *ports[MULTIPORT_RECEIVER_PORTS_MAX];
+
+    CountingSink sink;
+    MultiPortReceiver receiver(&sink);
+    if (!receiver.begin())
+    {
+        perror("epoll_create1");
+        return false;
+    }
+
+    for (size_t i = 0; i < portCount; i++)
+    {
+        if (openpty(&masters[i], &slaves[i], nullptr, nullptr, nullptr) != 0)
+        {
+            perror("openpty");
+            return false;
+        }
+
+        ports[i] = new hal::LinuxSerial(slaves[i]);
+        ports[i]->begin(crsfProtocol::BAUD_RATE);
+        receiver.addPort(ports[i]);
+    }
+
+    std::thread simulator(simulateReceivers, masters, portCount, packetRate, seconds);
+
+    /* The receiver runs on this thread, so RUSAGE_THREAD measures the receiver alone. */
+    const double cpuStart = cpuSeconds(RUSAGE_THREAD);
+    const unsigned long start = micros();
+
+    const uint32_t expected = (uint32_t)(portCount * packetRate * seconds);
+    while (keepRunning && sink.rcRecords < expected && micros() - start < (seconds + 1) * 1000000UL)
+    {
+        receiver.poll(100);
+    }
+
+    const double cpu = cpuSeconds(RUSAGE_THREAD) - cpuStart;
+    const double wall = (micros() - start) / 1.0e6;
+    simulator.join();
+
+    multiPortStatistics_t statistics;
+    receiver.getStatistics(&statistics);
+
+    printf("%5zu %10u %10u %10u %10.1f %9.2f %12.3f\n",
+           portCount, sink.rcRecords, sink.linkRecords, statistics.readCalls,
+           statistics.readCalls / wall, 100.0 * cpu / wall, 100.0 * cpu / wall / portCount);
+
+    receiver.end();
+    for (size_t i = 0; i < portCount; i++)
+    {
+        delete ports[i];
+        close(masters[i]);
+        close(slaves[i]);
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <tty device> [<tty device> ...] | --benchmark\n", argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (strcmp(argv[1], "--benchmark") == 0)
+    {
+        const unsigned int packetRate = 250;
+        const unsigned int seconds = 2;
+
+        printf("%u Hz per link, %u s per run\n", packetRate, seconds);
+        printf("%5s %10s %10s %10s %10s %9s %12s\n", "links", "rc", "linkstats", "read()", "read()/s", "cpu %", "cpu %/link");
+
+        for (size_t portCount = 1; portCount <= MULTIPORT_RECEIVER_PORTS_MAX && keepRunning; portCount *= 2)
+        {
+            if (!runBenchmark(portCount, packetRate, seconds))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    PrintingSink sink;
+    MultiPortReceiver receiver(&sink);
+    if (!receiver.begin())
+    {
+        perror("epoll_create1");
+        return 1;
+    }
+
+    for (int i = 1; i < argc && i <= MULTIPORT_RECEIVER_PORTS_MAX; i++)
+    {
+        hal::LinuxSerial *port = new hal::LinuxSerial(argv[i]);
+        port->begin(crsfProtocol::BAUD_RATE);
+
+        if (receiver.addPort(port) < 0)
+        {
+            printf("Unable to open %s\n", argv[i]);
+            delete port;
+        }
+    }
+
+    receiver.run(&keepRunning);
+
+    multiPortStatistics_t statistics;
+    receiver.getStatistics(&statistics);
+    printf("\nRC channels: %u, link statistics: %u, read() calls: %u, ports closed: %u\n",
+           statistics.rcFrames, statistics.linkFrames, statistics.readCalls, statistics.portsClosed);
+
+    return 0;
+}
@@ -0,0 +1,493 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example decodes one large CRSF capture on several threads on a Linux host, and checks that the result matches a serial decode.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_parallel_decode/main.cpp -o linux_parallel_decode -lutil -lpthread
+
+Usage:
+./linux_parallel_decode --generate <capture> [seconds]    Write a synthetic capture of a 1000 Hz link (default: 3000 seconds,
+                                                            about 140 MB). The bytes are split into reads of random sizes,
+                                                            so frames straddle chunks, and there is some line noise.
+./linux_parallel_decode [--threads n] <capture>            Decode a capture on n threads (default: one per CPU).
+./linux_parallel_decode [--threads n] --benchmark [capture]
+                                                            Generate a capture (default: a temporary file), decode it serially
+                                                            and then with 1, 2, 4 ... threads up to n, and check that every
+                                                            decode gives exactly the same frames and counters.
+./linux_parallel_decode --check                            Decode a short version 1 capture (which has no index) in small
+                                                            segments on several threads, and check that the segments that
+                                                            start part way through a frame are reconciled with the serial decode. */
+
+#include "SerialReceiver/CaptureDecoder/CaptureDecoder.hpp"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define LINK_PACKET_RATE     1000 // Hz. At this rate the link is never idle for long enough to time a frame out.
+#define LINK_STATISTICS_RATE 10   // One link statistics frame every this many RC channels frames.
+#define LINK_READ_SIZE_MAX   96   // Largest read from the UART, in bytes.
+#define DEFAULT_SECONDS      3000
+#define BENCHMARK_REPEATS    3
+#define CHECK_SECONDS        60   // Length of the --check capture.
+#define CHECK_SEGMENT_SIZE   4096 // Bytes per segment in --check, so that there are hundreds of segments to reconcile.
+#define CHECK_THREADS        4
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t nextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* Hashes every frame, in order, so that two decodes can be compared without keeping millions of frames around. */
+class HashSink final : public CaptureDecoderSink
+{
+  public:
+    uint64_t hash = 14695981039346656037ULL;
+    uint64_t rcChannelsFrames = 0;
+    uint64_t linkStatisticsFrames = 0;
+
+    void onRcChannels(uint64_t offset, uint64_t timestampUs, const uint16_t *rcChannels) override
+    {
+        _add(&offset, sizeof(offset));
+        _add(&timestampUs, sizeof(timestampUs));
+        _add(rcChannels, crsfProtocol::RC_CHANNEL_COUNT * sizeof(uint16_t));
+        rcChannelsFrames++;
+    }
+
+    void onLinkStatistics(uint64_t offset, uint64_t timestampUs, const link_statistics_t *linkStatistics) override
+    {
+        _add(&offset, sizeof(offset));
+        _add(&timestampUs, sizeof(timestampUs));
+        _add(linkStatistics, sizeof(link_statistics_t));
+        linkStatisticsFrames++;
+    }
+
+  private:
+    void _add(const void *data, size_t size)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+};
+
+static size_t appendFrame(uint8_t *buffer, uint8_t type, const void *payload, uint8_t payloadSize, bool corruptCrc)
+{
+    genericCrc::GenericCRC crc;
+    buffer[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    buffer[1] = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    buffer[2] = type;
+    memcpy(buffer + 3, payload, payloadSize);
+    buffer[3 + payloadSize] = crc.calculate(type, buffer + 3, payloadSize) ^ (corruptCrc ? 0xFF : 0x00);
+    return payloadSize + 4;
+}
+
+/* Writes a continuous 1000 Hz stream. Each byte arrives when the UART would have received it at 420000 baud,
+and the reads that the capture is made of end at random points, much like a busy host reading a serial port. */
+static bool generateCapture(const char *path, uint32_t seconds, bool indexed = true)
+{
+    CaptureWriter writer;
+    if (!writer.begin(path, crsfProtocol::BAUD_RATE, indexed))
+    {
+        return false;
+    }
+
+    const double byteTimeUs = 10.0 * 1000000.0 / crsfProtocol::BAUD_RATE;
+    uint32_t random = 0x12345678;
+    std::vector<uint8_t> pending;
+    std::vector<double> arrivals;
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    crsfProtocol::rcChannelsPacked_t channels;
+    memset(&channels, 0, sizeof(channels));
+
+    const uint32_t frameCount = seconds * LINK_PACKET_RATE;
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        const double frameStartUs = 1000000.0 + (double)i * 1000000.0 / LINK_PACKET_RATE;
+        const float t = (float)i / LINK_PACKET_RATE;
+        channels.channel0 = (unsigned)(992 + 600 * sinf(t * 1.3F));
+        channels.channel1 = (unsigned)(992 + 400 * sinf(t * 0.7F));
+        channels.channel2 = (unsigned)(600 + 300 * sinf(t * 0.2F));
+        channels.channel3 = (unsigned)(992 + 200 * sinf(t * 2.1F));
+
+        size_t length = appendFrame(frame, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, &channels,
+                                    crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE, nextRandom(&random) % 1000 == 0);
+        if (i % LINK_STATISTICS_RATE == 0)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = (uint8_t)(50 + nextRandom(&random) % 20);
+            linkStatistics.uplink_link_quality = (uint8_t)(90 + nextRandom(&random) % 11);
+            length += appendFrame(frame + length, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, &linkStatistics,
+                                  crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE, false);
+        }
+
+        // Now and then, a burst of line noise arrives in place of the start of a frame.
+        size_t skip = 0;
+        if (nextRandom(&random) % 2000 == 0)
+        {
+            skip = 1 + nextRandom(&random) % 8;
+            for (size_t j = 0; j < skip; j++)
+            {
+                frame[j] = (uint8_t)nextRandom(&random);
+            }
+        }
+
+        for (size_t j = 0; j < length; j++)
+        {
+            pending.push_back(frame[j]);
+            arrivals.push_back(frameStartUs + (double)j * byteTimeUs);
+        }
+
+        // Hand over everything that has arrived by now, in reads of random sizes.
+        // Once in a while the host is late, and the rest of the frame is read together with the next one.
+        if (nextRandom(&random) % 500 == 0)
+        {
+            continue;
+        }
+
+        while (!pending.empty())
+        {
+            const size_t readSize = min((size_t)(1 + nextRandom(&random) % LINK_READ_SIZE_MAX), pending.size());
+            if (!writer.writeChunk((uint64_t)arrivals[readSize - 1], pending.data(), readSize))
+            {
+                return false;
+            }
+            pending.erase(pending.begin(), pending.begin() + readSize);
+            arrivals.erase(arrivals.begin(), arrivals.begin() + readSize);
+        }
+    }
+
+    if (!pending.empty() && !writer.writeChunk((uint64_t)arrivals.back(), pending.data(), pending.size()))
+    {
+        return false;
+    }
+
+    return writer.end();
+}
+
+static bool sameResults(const HashSink *a, const crsfCounters_t *aCounters, const HashSink *b, const crsfCounters_t *bCounters)
+{
+    return a->hash == b->hash && a->rcChannelsFrames == b->rcChannelsFrames && a->linkStatisticsFrames == b->linkStatisticsFrames &&
+           memcmp(aCounters, bCounters, sizeof(crsfCounters_t)) == 0;
+}
+
+static void printCounters(const HashSink *sink, const crsfCounters_t *counters)
+{
+    printf("RC channels: %llu, link statistics: %llu, other: %u, CRC errors: %u, length errors: %u, timeouts: %u, hash %016llx\n",
+           (unsigned long long)sink->rcChannelsFrames, (unsigned long long)sink->linkStatisticsFrames, counters->otherFrames,
+           counters->crcErrors, counters->lengthErrors, counters->timeouts, (unsigned long long)sink->hash);
+}
+
+static int decodeCapture(const char *path, unsigned threadCount)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+
+    CaptureDecoder decoder(threadCount);
+    HashSink sink;
+    crsfCounters_t counters;
+
+    const uint64_t start = monotonicNanoseconds();
+    if (!decoder.decode(file.getData(), file.getSize(), &sink, &counters))
+    {
+        fprintf(stderr, "%s is not a capture\n", path);
+        return 1;
+    }
+    const double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+    printCounters(&sink, &counters);
+    printf("%.1f MB decoded in %.3f s on %u threads (%.0f MB/s)\n", file.getSize() / 1e6, seconds,
+           decoder.getThreadPool()->getThreadCount(), file.getSize() / 1e6 / seconds);
+    return 0;
+}
+
+/* Captures from before version 2 have no index. Without one, the decoder has to guess where frames start, and the guesses
+that land part way through a frame are what reconciliation fixes. A version 2 capture written without an index reads the
+same way, so this only has to change the version in the header. */
+static bool makeVersion1(const char *path)
+{
+    FILE *file = fopen(path, "r+b");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    const uint8_t version[2] = {1, 0};
+    const bool written = fseek(file, 4, SEEK_SET) == 0 && fwrite(version, 1, sizeof(version), file) == sizeof(version);
+    return fclose(file) == 0 && written;
+}
+
+static int check()
+{
+    char path[] = "/tmp/crsf_capture_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+
+    if (!generateCapture(path, CHECK_SECONDS, false) || !makeVersion1(path))
+    {
+        fprintf(stderr, "Could not write %s\n", path);
+        unlink(path);
+        return 1;
+    }
+
+    MappedFile file;
+    if (!file.open(path))
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        unlink(path);
+        return 1;
+    }
+
+    HashSink reference;
+    crsfCounters_t referenceCounters;
+    CaptureDecoder::decodeSerial(file.getData(), file.getSize(), &reference, &referenceCounters);
+    printf("Serial:   ");
+    printCounters(&reference, &referenceCounters);
+
+    CaptureDecoder decoder(CHECK_THREADS, CHECK_SEGMENT_SIZE);
+    HashSink sink;
+    crsfCounters_t counters;
+    const bool decoded = decoder.decode(file.getData(), file.getSize(), &sink, &counters);
+    printf("Parallel: ");
+    printCounters(&sink, &counters);
+
+    captureDecoderStatistics_t statistics;
+    decoder.getStatistics(&statistics);
+    printf("%u segments on %u threads, %u reconciled, %u decoded again in full, %llu bytes decoded twice\n", statistics.segments,
+           decoder.getThreadPool()->getThreadCount(), statistics.reconciled, statistics.redecoded, (unsigned long long)statistics.bytesRedecoded);
+
+    file.close();
+    unlink(path);
+
+    const bool same = decoded && sameResults(&reference, &referenceCounters, &sink, &counters);
+    const bool reconciled = statistics.reconciled > 0;
+    printf("Same frames and counters as the serial decode: %s\n", same ? "OK" : "FAILED");
+    printf("Segments that started part way through a frame were reconciled: %s\n", reconciled ? "OK" : "FAILED");
+
+    const bool passed = same && reconciled;
+    printf("Parallel decode %s\n", passed ? "OK" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+static int benchmark(const char *path, unsigned maxThreads)
+{
+    char temporary[] = "/tmp/crsf_capture_XXXXXX";
+    const bool removeAfter = path == nullptr;
+    if (path == nullptr)
+    {
+        const int fd = mkstemp(temporary);
+        if (fd < 0)
+        {
+            perror("mkstemp");
+            return 1;
+        }
+        close(fd);
+        path = temporary;
+    }
+
+    printf("Generating %u seconds of capture in %s...\n", DEFAULT_SECONDS, path);
+    if (!generateCapture(path, DEFAULT_SECONDS))
+    {
+        fprintf(stderr, "Could not write %s\n", path);
+        return 1;
+    }
+
+    MappedFile file;
+    if (!file.open(path))
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+
+    const unsigned cpus = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    if (maxThreads == 0)
+    {
+        maxThreads = cpus;
+    }
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    // The reference: one decoder, from start to end, on this thread.
+    HashSink reference;
+    crsfCounters_t referenceCounters;
+    double serialSeconds = 0;
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        HashSink sink;
+        const uint64_t start = monotonicNanoseconds();
+        CaptureDecoder::decodeSerial(file.getData(), file.getSize(), &sink, &referenceCounters);
+        const double seconds = (monotonicNanoseconds() - start) / 1e9;
+        if (repeat == 0 || seconds < serialSeconds)
+        {
+            serialSeconds = seconds;
+        }
+        reference = sink;
+    }
+
+    printf("%.1f MB, %u CPUs. Best of %u runs.\n", file.getSize() / 1e6, cpus, BENCHMARK_REPEATS);
+    if (maxThreads > cpus)
+    {
+        printf("There are more threads than CPUs, so the speedup cannot go past %u.\n", cpus);
+    }
+    printf("Serial: ");
+    printCounters(&reference, &referenceCounters);
+
+    printf("\n%8s %10s %10s %9s %11s %11s %10s %8s\n", "Threads", "Time (s)", "MB/s", "Speedup", "Segments", "Reconciled", "Redecoded", "Result");
+    printf("%8s %10.3f %10.0f %8.2fx %11s %11s %10s %8s\n", "serial", serialSeconds, file.getSize() / 1e6 / serialSeconds, 1.0, "-", "-", "-", "-");
+
+    bool matches = true;
+    for (size_t t = 0; t < threadCounts.size(); t++)
+    {
+        CaptureDecoder decoder(threadCounts[t]);
+        double best = 0;
+        bool same = true;
+
+        for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+        {
+            HashSink sink;
+            crsfCounters_t counters;
+            const uint64_t start = monotonicNanoseconds();
+            decoder.decode(file.getData(), file.getSize(), &sink, &counters);
+            const double seconds = (monotonicNanoseconds() - start) / 1e9;
+            if (repeat == 0 || seconds < best)
+            {
+                best = seconds;
+            }
+
+            same = same && sameResults(&reference, &referenceCounters, &sink, &counters);
+        }
+
+        captureDecoderStatistics_t statistics;
+        decoder.getStatistics(&statistics);
+        matches = matches && same;
+
+        printf("%8u %10.3f %10.0f %8.2fx %11u %11u %10u %8s\n", threadCounts[t], best, file.getSize() / 1e6 / best, serialSeconds / best,
+               statistics.segments / BENCHMARK_REPEATS, statistics.reconciled / BENCHMARK_REPEATS, statistics.redecoded / BENCHMARK_REPEATS,
+               same ? "same" : "DIFFERS");
+    }
+
+    printf("\nResults %s the serial decoder.\n", matches ? "match" : "DO NOT MATCH");
+
+    file.close();
+    if (removeAfter)
+    {
+        unlink(path);
+    }
+
+    return matches ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--generate") == 0)
+    {
+        if (!generateCapture(argv[2], argc == 4 ? (uint32_t)atoi(argv[3]) : DEFAULT_SECONDS))
+        {
+            fprintf(stderr, "Could not write %s\n", argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc == 2 && strcmp(argv[1], "--check") == 0)
+    {
+        return check();
+    }
+
+    unsigned threadCount = 0;
+    bool runBenchmark = false;
+    const char *path = nullptr;
+    bool usage = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threadCount = (unsigned)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--benchmark") == 0)
+        {
+            runBenchmark = true;
+        }
+        else if (path == nullptr)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            usage = true;
+        }
+    }
+
+    if (runBenchmark && !usage)
+    {
+        return benchmark(path, threadCount);
+    }
+
+    if (path == nullptr || usage)
+    {
+        fprintf(stderr, "Usage: %s --generate <capture> [seconds]\n"
+                        "       %s [--threads n] <capture>\n"
+                        "       %s [--threads n] --benchmark [capture]\n"
+                        "       %s --check\n",
+                argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+
+    return decodeCapture(path, threadCount);
+}
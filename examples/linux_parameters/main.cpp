@@ -0,0 +1,537 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example serves a 100 entry device menu to a stand-in handset over a pseudo-terminal, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_parameters/main.cpp -o linux_parameters -lutil -lpthread
+
+Usage:
+./linux_parameters
+                            Stand in for a handset on one end of a pseudo-terminal, with the receiver role on the other end.
+                            The handset pings the flight controller for its parameter count, then reads every parameter,
+                            chunk by chunk, as a handset's device menu does: one request after each RC channels frame, at 250 Hz.
+                            Each parameter is put back together, decoded and checked against the table. Then a few parameters
+                            are written, out of range values included, and read back.
+                            Last, the time that the server takes to serialise one chunk is measured in-process. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <atomic>
+#include <math.h>
+#include <pty.h>
+#include <stdio.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define MENU_SIZE        100
+#define RC_INTERVAL_US   4000
+#define REPLY_TIMEOUT_US 50000
+#define HANDSET_ADDRESS  crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER
+#define SERIALISE_PASSES 2000
+
+// The parameter server's frames are only looked at when parametersEnabled is set.
+struct ParametersConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool telemetryDeviceInfoEnabled = true;
+    static constexpr bool parametersEnabled = true;
+};
+
+/* The menu. The first entries are written out, as a sketch would write them. The rest are generated, to make up MENU_SIZE. */
+enum menuFolders_e
+{
+    FOLDER_RATES = 1,
+    FOLDER_FILTERS = 5,
+    FOLDER_TUNING = 9
+};
+
+static uint8_t rateProfile = 0;
+static uint16_t rcRate = 100;
+static float expo = 0.25F;
+static uint8_t filterType = 1;
+static int16_t gyroLowpass = 250;
+static int8_t trim = 0;
+static uint8_t saveStep = PARAMETER_COMMAND_READY;
+static uint8_t tuning[MENU_SIZE];
+static char tuningNames[MENU_SIZE][12];
+
+static std::vector<parameterDescriptor_t> buildMenu()
+{
+    std::vector<parameterDescriptor_t> menu = {
+        parameterFolder("Rates"),
+        parameterSelection("Profile", FOLDER_RATES, &rateProfile, "One;Two;Three"),
+        parameterUint16("RC rate", FOLDER_RATES, &rcRate, 10, 255, 100),
+        parameterFloat("Expo", FOLDER_RATES, &expo, 0, 100, 25, 2, 5),
+        parameterFolder("Filters"),
+        parameterSelection("Type", FOLDER_FILTERS, &filterType, "PT1;Biquad;PT2;PT3", 1),
+        parameterInt16("Lowpass", FOLDER_FILTERS, &gyroLowpass, -1, 1000, 250, "Hz"),
+        parameterInt8("Trim", FOLDER_FILTERS, &trim, -50, 50, 0),
+        parameterFolder("Tuning"),
+        parameterInfo("About", PARAMETER_ROOT, "This menu is served by CRSF for Arduino. It is long enough to need more than one chunk."),
+        parameterCommand("Save", PARAMETER_ROOT, &saveStep, "Saving..."),
+    };
+
+    for (size_t i = menu.size(); i < MENU_SIZE; i++)
+    {
+        snprintf(tuningNames[i], sizeof(tuningNames[i]), "Gain %zu", i);
+        tuning[i] = (uint8_t)i;
+        menu.push_back(parameterUint8(tuningNames[i], FOLDER_TUNING, &tuning[i], 0, 200, 100));
+    }
+    return menu;
+}
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int32_t readBE(const uint8_t *buffer, uint8_t size, bool isSigned)
+{
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < size; i++)
+    {
+        value = (value << 8) | buffer[i];
+    }
+    if (isSigned && size < 4 && (value & (1UL << (size * 8 - 1))) != 0)
+    {
+        value |= ~0UL << (size * 8);
+    }
+    return (int32_t)value;
+}
+
+static size_t finishFrame(uint8_t *frame, uint8_t payloadSize)
+{
+    genericCrc::GenericCRC crc;
+    frame[1] = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[3 + payloadSize] = crc.calculate(frame[2], frame + 3, payloadSize);
+    return payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+}
+
+static size_t buildRcFrame(uint8_t *frame)
+{
+    uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        channels[i] = CRSF_RC_CHANNEL_CENTER;
+    }
+
+    frame[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+    Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+    return finishFrame(frame, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+}
+
+static size_t buildRequest(uint8_t type, const uint8_t *fields, uint8_t fieldsSize, uint8_t *frame)
+{
+    frame[0] = crsfProtocol::CRSF_SYNC_BYTE;
+    frame[2] = type;
+    frame[3] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[4] = HANDSET_ADDRESS;
+    memcpy(frame + 5, fields, fieldsSize);
+    return finishFrame(frame, 2 + fieldsSize);
+}
+
+/* The handset's end of the pseudo-terminal. It keeps the one reply that it waits for, and counts the rest. */
+typedef struct handset_s
+{
+    hal::LinuxSerial *port;
+    std::vector<uint8_t> pending;
+    std::vector<uint8_t> reply;
+    uint8_t waitingFor;
+    uint64_t nextRcNs;
+    uint32_t rcFrames;
+    uint32_t requests;
+    uint32_t timeouts;
+    uint32_t crcErrors;
+} handset_t;
+
+static void readFrames(handset_t *handset)
+{
+    genericCrc::GenericCRC crc;
+    uint8_t buffer[256];
+    size_t length;
+
+    while ((length = handset->port->read(buffer, sizeof(buffer))) > 0)
+    {
+        handset->pending.insert(handset->pending.end(), buffer, buffer + length);
+
+        size_t position = 0;
+        while (handset->pending.size() - position >= 2 && handset->pending.size() - position >= (size_t)handset->pending[position + 1] + 2)
+        {
+            uint8_t *frame = handset->pending.data() + position;
+            position += frame[1] + 2;
+
+            if (crc.calculate(frame[2], frame + 3, frame[1] - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC) != frame[frame[1] + 1])
+            {
+                handset->crcErrors++;
+            }
+            else if (frame[2] == handset->waitingFor && frame[3] == HANDSET_ADDRESS)
+            {
+                handset->reply.assign(frame, frame + frame[1] + 2);
+            }
+        }
+        handset->pending.erase(handset->pending.begin(), handset->pending.begin() + position);
+    }
+}
+
+/* Sends the next RC channels frame on time, then request, and waits for a reply of type replyType.
+Returns false if none came. A replyType of 0 waits for nothing. */
+static bool transact(handset_t *handset, const uint8_t *request, size_t requestSize, uint8_t replyType)
+{
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    while (nowNs() < handset->nextRcNs)
+    {
+        if (handset->port->waitForData(1))
+        {
+            readFrames(handset);
+        }
+    }
+    handset->nextRcNs += RC_INTERVAL_US * 1000ULL;
+
+    handset->waitingFor = replyType;
+    handset->reply.clear();
+    handset->port->write(frame, buildRcFrame(frame));
+    handset->port->write(request, requestSize);
+    handset->rcFrames++;
+    handset->requests++;
+    if (replyType == 0)
+    {
+        return true;
+    }
+
+    const uint64_t deadline = nowNs() + REPLY_TIMEOUT_US * 1000ULL;
+    while (handset->reply.empty() && nowNs() < deadline)
+    {
+        if (handset->port->waitForData(1))
+        {
+            readFrames(handset);
+        }
+    }
+
+    if (handset->reply.empty())
+    {
+        handset->timeouts++;
+        return false;
+    }
+    return true;
+}
+
+/* Reads one whole parameter, chunk by chunk, into entry. Returns the number of chunks, or 0 if it went wrong. */
+static uint32_t readParameter(handset_t *handset, uint8_t number, std::vector<uint8_t> *entry)
+{
+    uint8_t request[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    uint8_t expectedRemaining = 0;
+    entry->clear();
+
+    for (uint8_t chunk = 0;; chunk++)
+    {
+        const uint8_t fields[2] = {number, chunk};
+        if (!transact(handset, request, buildRequest(crsfProtocol::CRSF_FRAMETYPE_PARAMETER_READ, fields, 2, request),
+                      crsfProtocol::CRSF_FRAMETYPE_PARAMETER_SETTINGS_ENTRY))
+        {
+            return 0;
+        }
+
+        const uint8_t *reply = handset->reply.data();
+        const uint8_t remaining = reply[6];
+        if (reply[4] != crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER || reply[5] != number || (chunk > 0 && remaining != expectedRemaining))
+        {
+            return 0;
+        }
+        entry->insert(entry->end(), reply + 7, reply + handset->reply.size() - 1);
+
+        if (remaining == 0)
+        {
+            return chunk + 1;
+        }
+        expectedRemaining = remaining - 1;
+    }
+}
+
+static bool writeParameter(handset_t *handset, uint8_t number, const uint8_t *value, uint8_t size)
+{
+    uint8_t request[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    uint8_t fields[5] = {number};
+    memcpy(fields + 1, value, size);
+    return transact(handset, request, buildRequest(crsfProtocol::CRSF_FRAMETYPE_PARAMETER_WRITE, fields, 1 + size, request), 0);
+}
+
+/* Decodes one entry as a handset would, and checks it against the table. number 0 is the root folder. */
+static bool checkEntry(const std::vector<parameterDescriptor_t> &menu, uint8_t number, const std::vector<uint8_t> &entry)
+{
+    const size_t size = entry.size();
+    if (size < 3)
+    {
+        return false;
+    }
+
+    const uint8_t *data = entry.data();
+    const char *name = (const char *)data + 2;
+    const size_t nameLength = strnlen(name, size - 2);
+    const uint8_t *fields = data + 2 + nameLength + 1;
+    const size_t fieldsSize = size - 2 - nameLength - 1;
+    if (nameLength == size - 2)
+    {
+        return false;
+    }
+
+    const uint8_t folder = number;
+    if (number == PARAMETER_ROOT)
+    {
+        if (data[0] != PARAMETER_ROOT || data[1] != PARAMETER_TYPE_FOLDER || strcmp(name, PARAMETER_ROOT_NAME) != 0)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        const parameterDescriptor_t *parameter = &menu[number - 1];
+        if (data[0] != parameter->parent || data[1] != parameter->type || strcmp(name, parameter->name) != 0)
+        {
+            return false;
+        }
+
+        switch (parameter->type)
+        {
+            case PARAMETER_TYPE_UINT8:
+            case PARAMETER_TYPE_INT8:
+            case PARAMETER_TYPE_UINT16:
+            case PARAMETER_TYPE_INT16:
+            {
+                const uint8_t width = parameter->type >= PARAMETER_TYPE_UINT16 ? 2 : 1;
+                const bool isSigned = parameter->type == PARAMETER_TYPE_INT8 || parameter->type == PARAMETER_TYPE_INT16;
+                int32_t value;
+                switch (parameter->type)
+                {
+                    case PARAMETER_TYPE_UINT8:
+                        value = *(uint8_t *)parameter->value;
+                        break;
+                    case PARAMETER_TYPE_INT8:
+                        value = *(int8_t *)parameter->value;
+                        break;
+                    case PARAMETER_TYPE_UINT16:
+                        value = *(uint16_t *)parameter->value;
+                        break;
+                    default:
+                        value = *(int16_t *)parameter->value;
+                        break;
+                }
+                return fieldsSize == 4U * width + strlen(parameter->text) + 1 && readBE(fields, width, isSigned) == value &&
+                       readBE(fields + width, width, isSigned) == parameter->min && readBE(fields + 2 * width, width, isSigned) == parameter->max &&
+                       readBE(fields + 3 * width, width, isSigned) == parameter->defaultValue && strcmp((const char *)fields + 4 * width, parameter->text) == 0;
+            }
+            case PARAMETER_TYPE_FLOAT:
+                return fieldsSize == 21 + strlen(parameter->text) + 1 &&
+                       readBE(fields, 4, true) == (int32_t)lroundf(*(float *)parameter->value * powf(10.0F, parameter->decimals)) &&
+                       readBE(fields + 4, 4, true) == parameter->min && readBE(fields + 8, 4, true) == parameter->max &&
+                       readBE(fields + 12, 4, true) == parameter->defaultValue && fields[16] == parameter->decimals &&
+                       readBE(fields + 17, 4, true) == parameter->step;
+            case PARAMETER_TYPE_TEXT_SELECTION:
+            {
+                const size_t optionsLength = strlen(parameter->text);
+                uint8_t max = 0;
+                for (size_t i = 0; i < optionsLength; i++)
+                {
+                    max += parameter->text[i] == ';' ? 1 : 0;
+                }
+                return fieldsSize == optionsLength + 1 + 4 + 1 && strcmp((const char *)fields, parameter->text) == 0 &&
+                       fields[optionsLength + 1] == *(uint8_t *)parameter->value && fields[optionsLength + 2] == 0 &&
+                       fields[optionsLength + 3] == max && fields[optionsLength + 4] == parameter->defaultValue;
+            }
+            case PARAMETER_TYPE_INFO:
+                return fieldsSize == strlen(parameter->text) + 1 && strcmp((const char *)fields, parameter->text) == 0;
+            case PARAMETER_TYPE_COMMAND:
+                return fieldsSize == 2 + strlen(parameter->text) + 1 && fields[0] == *(uint8_t *)parameter->value &&
+                       strcmp((const char *)fields + 2, parameter->text) == 0;
+            case PARAMETER_TYPE_FOLDER:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    // A folder lists its children, in order, then PARAMETER_FOLDER_END.
+    size_t child = 0;
+    for (size_t i = 0; i < menu.size(); i++)
+    {
+        if (menu[i].parent == folder)
+        {
+            if (child >= fieldsSize || fields[child] != i + 1)
+            {
+                return false;
+            }
+            child++;
+        }
+    }
+    return child + 1 == fieldsSize && fields[child] == PARAMETER_FOLDER_END;
+}
+
+int main()
+{
+    const std::vector<parameterDescriptor_t> menu = buildMenu();
+    ParameterServer server(menu.data(), (uint8_t)menu.size());
+
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    hal::LinuxSerial handsetPort(master);
+    hal::LinuxSerial receiverPort(slave);
+    handsetPort.begin(crsfProtocol::BAUD_RATE);
+    BasicSerialReceiver<ParametersConfig> receiver(&receiverPort);
+    if (!receiver.begin())
+    {
+        fprintf(stderr, "Could not start the receiver\n");
+        return 1;
+    }
+    receiver.setParameterServer(&server);
+
+    std::atomic<bool> receiving(true);
+    std::thread receiverThread([&]() {
+        while (receiving.load())
+        {
+            if (receiverPort.waitForData(10))
+            {
+                receiver.processFrames();
+            }
+        }
+    });
+
+    handset_t handset = handset_t();
+    handset.port = &handsetPort;
+    handset.nextRcNs = nowNs();
+    bool ok = true;
+
+    // The device info tells the handset how many parameters there are.
+    uint8_t request[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    uint8_t parameterCount = 0;
+    if (transact(&handset, request, buildRequest(crsfProtocol::CRSF_FRAMETYPE_DEVICE_PING, nullptr, 0, request), crsfProtocol::CRSF_FRAMETYPE_DEVICE_INFO))
+    {
+        const uint8_t *reply = handset.reply.data();
+        const size_t nameLength = strlen((const char *)reply + 5);
+        parameterCount = reply[5 + nameLength + 1 + 12];
+    }
+    printf("Device info: %u parameters\n", parameterCount);
+    ok = ok && parameterCount == menu.size();
+
+    // Read the whole menu, as the handset's device menu does when it is opened.
+    std::vector<uint8_t> entry;
+    uint32_t chunks = 0;
+    uint32_t wrong = 0;
+    uint32_t failed = 0;
+    const uint32_t requestsBefore = handset.requests;
+    const uint64_t startNs = nowNs();
+    for (uint16_t number = 0; number <= parameterCount; number++)
+    {
+        const uint32_t entryChunks = readParameter(&handset, (uint8_t)number, &entry);
+        if (entryChunks == 0)
+        {
+            failed++;
+            continue;
+        }
+        chunks += entryChunks;
+        wrong += checkEntry(menu, (uint8_t)number, entry) ? 0 : 1;
+    }
+    const double enumerationMs = (nowNs() - startNs) / 1e6;
+    printf("Menu: %u parameters read in %.0f ms, in %u requests (%u chunks), %u wrong, %u failed\n", parameterCount + 1, enumerationMs,
+           handset.requests - requestsBefore, chunks, wrong, failed);
+    ok = ok && wrong == 0 && failed == 0;
+
+    // Write a few parameters, out of range values included, and read them back.
+    const uint8_t rcRateValue[2] = {0x01, 0x2C};                 // 300, clamped to 255.
+    const uint8_t lowpassValue[2] = {0xFF, 0xFF};                // -1.
+    const uint8_t expoValue[4] = {0x00, 0x00, 0x00, 0x28};       // 0.40
+    const uint8_t filterValue[1] = {7};                          // Clamped to the last option.
+    const uint8_t trimValue[1] = {(uint8_t)-80};                 // Clamped to -50.
+    writeParameter(&handset, 3, rcRateValue, 2);
+    writeParameter(&handset, 7, lowpassValue, 2);
+    writeParameter(&handset, 4, expoValue, 4);
+    writeParameter(&handset, 6, filterValue, 1);
+    writeParameter(&handset, 8, trimValue, 1);
+    writeParameter(&handset, 1, filterValue, 1);                 // A folder, which must be rejected.
+
+    // The reads that follow make sure that the writes have been handled.
+    uint32_t readBackWrong = 0;
+    const uint8_t written[] = {3, 7, 4, 6, 8};
+    for (uint8_t number : written)
+    {
+        readBackWrong += readParameter(&handset, number, &entry) > 0 && checkEntry(menu, number, entry) ? 0 : 1;
+    }
+    const bool valuesOk = rcRate == 255 && gyroLowpass == -1 && fabsf(expo - 0.40F) < 0.001F && filterType == 3 && trim == -50;
+    printf("Writes: rc rate %u, lowpass %d, expo %.2f, filter type %u, trim %d | %u read back wrong\n", rcRate, gyroLowpass, expo,
+           filterType, trim, readBackWrong);
+    ok = ok && readBackWrong == 0 && valuesOk;
+
+    usleep(20000);
+    receiving = false;
+    receiverThread.join();
+
+    parameterServerStatistics_t statistics;
+    server.getStatistics(&statistics);
+    printf("Server: %u reads, %u writes, %u rejected | handset: %u timeouts, %u CRC errors\n", statistics.reads, statistics.writes,
+           statistics.rejected, handset.timeouts, handset.crcErrors);
+    ok = ok && statistics.writes == 5 && statistics.rejected == 1 && handset.timeouts == 0 && handset.crcErrors == 0;
+
+    // How long it takes the server to serialise one chunk, measured in-process.
+    uint32_t served = 0;
+    const uint64_t serialiseStartNs = nowNs();
+    for (int pass = 0; pass < SERIALISE_PASSES; pass++)
+    {
+        for (uint16_t number = 0; number <= parameterCount; number++)
+        {
+            for (uint8_t chunk = 0;; chunk++)
+            {
+                const uint8_t fields[2] = {(uint8_t)number, chunk};
+                buildRequest(crsfProtocol::CRSF_FRAMETYPE_PARAMETER_READ, fields, 2, request);
+                if (server.handleRequest(request) == 0 || server.getReply()[6] == 0)
+                {
+                    break;
+                }
+                served++;
+            }
+            served++;
+        }
+    }
+    printf("Serialising: %.0f ns per chunk (including building the request), %zu bytes of RAM in the server\n",
+           (double)(nowNs() - serialiseStartNs) / served, sizeof(server));
+
+    printf("Parameters %s\n", ok ? "OK" : "FAILED");
+
+    receiver.end();
+    close(master);
+    close(slave);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+--[[
+crsf.lua
+Wireshark dissector for the CRSF frames that linux_pcapng_export (PcapngWriter) writes, on link type DLT_USER0 (147).
+This file is a part of the CRSF for Arduino library, and is licensed under the GNU General Public License v3.0.
+
+Load it with:
+    wireshark -X lua_script:crsf.lua capture.pcapng
+or copy it into Wireshark's personal plugins folder.
+Display filters then work on its fields, eg "crsf.type == 0x16", "crsf.link.uplink_lq < 70" or "crsf.crc_valid == 0".
+]]
+
+local crsf = Proto("crsf", "Crossfire (CRSF)")
+
+local addresses = {
+    [0x00] = "Broadcast", [0x10] = "USB", [0x80] = "TBS Core PNP Pro", [0xC0] = "Current sensor", [0xC2] = "GPS",
+    [0xC4] = "TBS Blackbox", [0xC8] = "Flight controller", [0xCC] = "Race tag", [0xEA] = "Radio transmitter",
+    [0xEC] = "CRSF receiver", [0xEE] = "CRSF transmitter",
+}
+
+local types = {
+    [0x02] = "GPS", [0x07] = "Vario", [0x08] = "Battery sensor", [0x09] = "Baro altitude", [0x0B] = "Heartbeat",
+    [0x14] = "Link statistics", [0x16] = "RC channels", [0x17] = "Subset RC channels", [0x1C] = "Link statistics RX",
+    [0x1D] = "Link statistics TX", [0x1E] = "Attitude", [0x21] = "Flight mode", [0x28] = "Device ping",
+    [0x29] = "Device info", [0x2B] = "Parameter settings entry", [0x2C] = "Parameter read", [0x2D] = "Parameter write",
+    [0x32] = "Command", [0x7A] = "MSP request", [0x7B] = "MSP response", [0x7C] = "MSP write", [0x7D] = "DisplayPort command",
+}
+
+local f = {
+    address = ProtoField.uint8("crsf.address", "Address", base.HEX, addresses),
+    length = ProtoField.uint8("crsf.length", "Length", base.DEC),
+    type = ProtoField.uint8("crsf.type", "Type", base.HEX, types),
+    payload = ProtoField.bytes("crsf.payload", "Payload"),
+    crc = ProtoField.uint8("crsf.crc", "CRC", base.HEX),
+    crc_valid = ProtoField.bool("crsf.crc_valid", "CRC valid"),
+    uplink_rssi_1 = ProtoField.uint8("crsf.link.uplink_rssi_1", "Uplink RSSI 1 (-dBm)"),
+    uplink_rssi_2 = ProtoField.uint8("crsf.link.uplink_rssi_2", "Uplink RSSI 2 (-dBm)"),
+    uplink_lq = ProtoField.uint8("crsf.link.uplink_lq", "Uplink link quality (%)"),
+    uplink_snr = ProtoField.int8("crsf.link.uplink_snr", "Uplink SNR (dB)"),
+    active_antenna = ProtoField.uint8("crsf.link.active_antenna", "Active antenna"),
+    rf_mode = ProtoField.uint8("crsf.link.rf_mode", "RF mode"),
+    uplink_tx_power = ProtoField.uint8("crsf.link.uplink_tx_power", "Uplink TX power"),
+    downlink_rssi = ProtoField.uint8("crsf.link.downlink_rssi", "Downlink RSSI (-dBm)"),
+    downlink_lq = ProtoField.uint8("crsf.link.downlink_lq", "Downlink link quality (%)"),
+    downlink_snr = ProtoField.int8("crsf.link.downlink_snr", "Downlink SNR (dB)"),
+}
+
+local channels = {}
+for i = 1, 16 do
+    channels[i] = ProtoField.uint16("crsf.rc.ch" .. i, "Channel " .. i)
+    f["ch" .. i] = channels[i]
+end
+
+local fieldList = {}
+for _, field in pairs(f) do
+    table.insert(fieldList, field)
+end
+crsf.fields = fieldList
+
+-- CRC8, polynomial 0xD5, over the type and the payload.
+local function crc8(tvb, offset, length)
+    local crc = 0
+    for i = offset, offset + length - 1 do
+        crc = bit.bxor(crc, tvb(i, 1):uint())
+        for _ = 1, 8 do
+            if bit.band(crc, 0x80) ~= 0 then
+                crc = bit.band(bit.bxor(bit.lshift(crc, 1), 0xD5), 0xFF)
+            else
+                crc = bit.band(bit.lshift(crc, 1), 0xFF)
+            end
+        end
+    end
+    return crc
+end
+
+function crsf.dissector(tvb, pinfo, tree)
+    if tvb:len() < 4 then
+        return 0
+    end
+
+    pinfo.cols.protocol = "CRSF"
+    local frameType = tvb(2, 1):uint()
+    local payloadLength = tvb:len() - 4
+    local subtree = tree:add(crsf, tvb(), "Crossfire, " .. (types[frameType] or string.format("Type 0x%02X", frameType)))
+
+    subtree:add(f.address, tvb(0, 1))
+    subtree:add(f.length, tvb(1, 1))
+    subtree:add(f.type, tvb(2, 1))
+    if payloadLength > 0 then
+        subtree:add(f.payload, tvb(3, payloadLength))
+    end
+    subtree:add(f.crc, tvb(tvb:len() - 1, 1))
+    subtree:add(f.crc_valid, tvb(tvb:len() - 1, 1), crc8(tvb, 2, tvb:len() - 3) == tvb(tvb:len() - 1, 1):uint())
+    pinfo.cols.info = types[frameType] or string.format("Type 0x%02X", frameType)
+
+    if frameType == 0x16 and payloadLength == 22 then
+        -- Sixteen 11 bit channels, packed least significant bit first.
+        local rc = subtree:add(crsf, tvb(3, 22), "RC channels")
+        local info = {}
+        for i = 1, 16 do
+            local bitOffset = (i - 1) * 11
+            local byte = 3 + math.floor(bitOffset / 8)
+            local value = tvb(byte, 1):uint() + tvb(byte + 1, 1):uint() * 256
+            if byte + 2 < 25 then
+                value = value + tvb(byte + 2, 1):uint() * 65536
+            end
+            value = bit.band(bit.rshift(value, bitOffset % 8), 0x7FF)
+            rc:add(channels[i], tvb(byte, math.min(3, 25 - byte)), value)
+            if i <= 4 then
+                table.insert(info, tostring(value))
+            end
+        end
+        pinfo.cols.info = "RC channels " .. table.concat(info, " ")
+    elseif frameType == 0x14 and payloadLength == 10 then
+        local link = subtree:add(crsf, tvb(3, 10), "Link statistics")
+        link:add(f.uplink_rssi_1, tvb(3, 1))
+        link:add(f.uplink_rssi_2, tvb(4, 1))
+        link:add(f.uplink_lq, tvb(5, 1))
+        link:add(f.uplink_snr, tvb(6, 1))
+        link:add(f.active_antenna, tvb(7, 1))
+        link:add(f.rf_mode, tvb(8, 1))
+        link:add(f.uplink_tx_power, tvb(9, 1))
+        link:add(f.downlink_rssi, tvb(10, 1))
+        link:add(f.downlink_lq, tvb(11, 1))
+        link:add(f.downlink_snr, tvb(12, 1))
+        pinfo.cols.info = string.format("Link statistics LQ %d%% RSSI -%d dBm", tvb(5, 1):uint(), tvb(3, 1):uint())
+    end
+
+    return tvb:len()
+end
+
+local encapsulations = wtap_encaps or wtap
+DissectorTable.get("wtap_encap"):add(encapsulations.USER0, crsf)
@@ -0,0 +1,284 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example converts CRSF captures to pcapng files, which Wireshark and tshark can open, and measures how fast it does so.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_pcapng_export/main.cpp -o linux_pcapng_export -lutil -lpthread
+
+Usage:
+./linux_pcapng_export <capture> <output.pcapng> [start time]
+                                        Convert a capture. Every frame with a valid CRC becomes one packet.
+                                        Pass the Unix time (in seconds) at which the capture's clock was 0
+                                        to see wall clock times in the analyser.
+./linux_pcapng_export --benchmark [seconds]
+                                        Generate a capture (default: 600 seconds of a 500 Hz link), then time a plain decode
+                                        against a decode that also writes the pcapng file, and check that every frame was written.
+
+Viewing the output:
+The packets use the user link type DLT_USER0 (147). crsf.lua (next to this file) is a Wireshark dissector for them:
+    wireshark -X lua_script:examples/linux_pcapng_export/crsf.lua output.pcapng
+    tshark -X lua_script:examples/linux_pcapng_export/crsf.lua -r output.pcapng -Y "crsf.type == 0x14"
+Filtering, statistics and graphs then all happen in the analyser. */
+
+#include "SerialReceiver/CaptureDecoder/CaptureDecoder.hpp"
+#include "SerialReceiver/Pcapng/Pcapng.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace serialReceiverLayer;
+
+#define LINK_PACKET_RATE     500 // Hz.
+#define LINK_STATISTICS_RATE 10  // One link statistics frame every this many RC channels frames.
+#define LINK_READ_SIZE_MAX   96  // Largest read from the UART, in bytes.
+#define DEFAULT_SECONDS      600
+#define BENCHMARK_REPEATS    3
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t nextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* Decodes frames without doing anything with them, as the baseline for the benchmark. */
+class NullSink final : public CaptureDecoderSink
+{
+  public:
+    void onRcChannels(uint64_t offset, uint64_t timestampUs, const uint16_t *rcChannels) override
+    {
+        (void)offset;
+        (void)timestampUs;
+        (void)rcChannels;
+    }
+
+    void onLinkStatistics(uint64_t offset, uint64_t timestampUs, const link_statistics_t *linkStatistics) override
+    {
+        (void)offset;
+        (void)timestampUs;
+        (void)linkStatistics;
+    }
+};
+
+static size_t appendFrame(uint8_t *buffer, uint8_t type, const void *payload, uint8_t payloadSize, bool corruptCrc)
+{
+    genericCrc::GenericCRC crc;
+    buffer[0] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    buffer[1] = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    buffer[2] = type;
+    memcpy(buffer + 3, payload, payloadSize);
+    buffer[3 + payloadSize] = crc.calculate(type, buffer + 3, payloadSize) ^ (corruptCrc ? 0xFF : 0x00);
+    return payloadSize + 4;
+}
+
+/* Writes RC channels and link statistics frames in reads of random sizes, with the odd corrupted frame,
+and now and then a frame that is cut short by a dropout, so that the decoder has to time it out. */
+static bool generateCapture(const char *path, uint32_t seconds)
+{
+    CaptureWriter writer;
+    if (!writer.begin(path))
+    {
+        return false;
+    }
+
+    uint32_t random = 0x2468ACE1;
+    uint8_t frames[2 * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    crsfProtocol::rcChannelsPacked_t channels;
+    memset(&channels, 0, sizeof(channels));
+
+    const uint32_t frameCount = seconds * LINK_PACKET_RATE;
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        const uint64_t timestampUs = 1000000 + (uint64_t)i * 1000000 / LINK_PACKET_RATE;
+        channels.channel0 = 172 + i % 1640;
+        channels.channel2 = 172 + nextRandom(&random) % 1640;
+
+        size_t length = appendFrame(frames, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, &channels,
+                                    crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE, nextRandom(&random) % 1000 == 0);
+        if (i % LINK_STATISTICS_RATE == 0)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = (uint8_t)(50 + nextRandom(&random) % 20);
+            linkStatistics.uplink_link_quality = (uint8_t)(90 + nextRandom(&random) % 11);
+            length += appendFrame(frames + length, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, &linkStatistics,
+                                  crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE, false);
+        }
+
+        if (nextRandom(&random) % 3000 == 0)
+        {
+            length = 1 + nextRandom(&random) % 20;
+        }
+
+        size_t written = 0;
+        while (written < length)
+        {
+            const size_t readSize = min((size_t)(1 + nextRandom(&random) % LINK_READ_SIZE_MAX), length - written);
+            if (!writer.writeChunk(timestampUs + written * 25, frames + written, readSize))
+            {
+                return false;
+            }
+            written += readSize;
+        }
+    }
+
+    return writer.end();
+}
+
+static int convert(const char *capturePath, const char *outputPath, uint64_t timeOffsetUs)
+{
+    MappedFile file;
+    if (!file.open(capturePath))
+    {
+        fprintf(stderr, "Could not open %s\n", capturePath);
+        return 1;
+    }
+
+    PcapngWriter writer;
+    if (!writer.begin(outputPath))
+    {
+        fprintf(stderr, "Could not create %s\n", outputPath);
+        return 1;
+    }
+
+    const uint64_t start = monotonicNanoseconds();
+    const bool converted = writer.writeCapture(file.getData(), file.getSize(), timeOffsetUs);
+    const bool closed = writer.end();
+    const double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+    if (!converted || !closed)
+    {
+        fprintf(stderr, converted ? "Could not write %s\n" : "%s is not a capture, or the output could not be written\n",
+                converted ? outputPath : capturePath);
+        return 1;
+    }
+
+    pcapngStatistics_t statistics;
+    writer.getStatistics(&statistics);
+    printf("%llu frames written, %llu left out with a bad CRC. %.1f MB in, %.1f MB out, in %.3f s (%.0f MB/s)\n",
+           (unsigned long long)statistics.frames, (unsigned long long)statistics.crcErrors, file.getSize() / 1e6,
+           statistics.bytesWritten / 1e6, seconds, file.getSize() / 1e6 / seconds);
+    return 0;
+}
+
+static int benchmark(uint32_t seconds)
+{
+    char capturePath[] = "/tmp/crsf_capture_XXXXXX";
+    char outputPath[] = "/tmp/crsf_pcapng_XXXXXX";
+    const int captureFd = mkstemp(capturePath);
+    const int outputFd = mkstemp(outputPath);
+    if (captureFd < 0 || outputFd < 0)
+    {
+        perror("mkstemp");
+        return 1;
+    }
+    close(captureFd);
+    close(outputFd);
+
+    printf("Generating %u seconds of capture...\n", seconds);
+    MappedFile file;
+    if (!generateCapture(capturePath, seconds) || !file.open(capturePath))
+    {
+        fprintf(stderr, "Could not write %s\n", capturePath);
+        unlink(capturePath);
+        unlink(outputPath);
+        return 1;
+    }
+
+    double decodeSeconds = 0;
+    double exportSeconds = 0;
+    crsfCounters_t counters;
+    pcapngStatistics_t statistics;
+    bool written = true;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        NullSink sink;
+        uint64_t start = monotonicNanoseconds();
+        CaptureDecoder::decodeSerial(file.getData(), file.getSize(), &sink, &counters);
+        const double decodeTime = (monotonicNanoseconds() - start) / 1e9;
+
+        PcapngWriter writer;
+        start = monotonicNanoseconds();
+        written = writer.begin(outputPath) && writer.writeCapture(file.getData(), file.getSize()) && writer.end() && written;
+        const double exportTime = (monotonicNanoseconds() - start) / 1e9;
+        writer.getStatistics(&statistics);
+
+        if (repeat == 0 || decodeTime < decodeSeconds)
+        {
+            decodeSeconds = decodeTime;
+        }
+        if (repeat == 0 || exportTime < exportSeconds)
+        {
+            exportSeconds = exportTime;
+        }
+    }
+
+    unlink(capturePath);
+    unlink(outputPath);
+
+    const uint64_t validFrames = (uint64_t)counters.rcChannelsFrames + counters.linkStatisticsFrames + counters.otherFrames;
+    const bool matches = written && statistics.frames == validFrames && statistics.crcErrors == counters.crcErrors;
+
+    printf("%.1f MB of capture. Best of %u runs.\n", file.getSize() / 1e6, BENCHMARK_REPEATS);
+    printf("Decode only:        %.3f s, %6.0f MB/s\n", decodeSeconds, file.getSize() / 1e6 / decodeSeconds);
+    printf("Decode and export:  %.3f s, %6.0f MB/s, %.1f M frames/s, %.1f MB of pcapng\n", exportSeconds,
+           file.getSize() / 1e6 / exportSeconds, statistics.frames / 1e6 / exportSeconds, statistics.bytesWritten / 1e6);
+    printf("Frames written: %llu of %llu valid (%u CRC errors, %u timeouts, %u length errors in the capture): %s\n",
+           (unsigned long long)statistics.frames, (unsigned long long)validFrames, counters.crcErrors, counters.timeouts,
+           counters.lengthErrors, matches ? "OK" : "MISMATCH");
+    return matches ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0)
+    {
+        return benchmark(argc >= 3 ? (uint32_t)strtoul(argv[2], nullptr, 10) : DEFAULT_SECONDS);
+    }
+
+    if (argc == 3 || argc == 4)
+    {
+        const uint64_t timeOffsetUs = argc == 4 ? (uint64_t)(strtod(argv[3], nullptr) * 1e6) : 0;
+        return convert(argv[1], argv[2], timeOffsetUs);
+    }
+
+    fprintf(stderr, "Usage: %s <capture> <output.pcapng> [start time]\n"
+                    "       %s --benchmark [seconds]\n",
+            argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example runs CRSF for Arduino on a Linux host, such as a Raspberry Pi companion computer.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_receiver/main.cpp -o linux_receiver -lutil -lpthread
+
+Usage:
+./linux_receiver /dev/ttyAMA0 [options]   Receive from a real receiver wired to the Pi's UART.
+./linux_receiver --pty [options]          Loop simulated RC frames through a pseudo-terminal pair and report
+                                          the read() system call rate and the decode latency.
+
+Options:
+--cpu <n>         Pin the receiver to CPU n.
+--priority <n>    Run the receiver under SCHED_FIFO at priority n (needs root or CAP_SYS_NICE).
+--lock            Lock memory with mlockall().
+--prefault        Pre-fault the stack and buffers.
+--period <us>     Wake up every <us> microseconds instead of on data, and report the
+                  p50/p99/p99.9 wake-up latency. Use this to benchmark the options above. */
+
+#include "CRSFforArduino.hpp"
+#include "SerialReceiver/LinuxRunner/LinuxRunner.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <fcntl.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <thread>
+#include <unistd.h>
+
+static volatile bool keepRunning = true;
+static uint32_t rcFrameCount = 0;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+static void onReceiveRcChannels(serialReceiverLayer::rcChannels_t *rcChannels)
+{
+    rcFrameCount++;
+
+    static unsigned long lastPrint = 0;
+    if (millis() - lastPrint >= 500)
+    {
+        lastPrint = millis();
+        printf("RC Channels <A: %u, E: %u, T: %u, R: %u, Aux1: %u> FailSafe: %s\n",
+               rcChannels->value[0], rcChannels->value[1], rcChannels->value[2], rcChannels->value[3], rcChannels->value[4],
+               rcChannels->failsafe ? "Active" : "Inactive");
+    }
+}
+
+/* Simulates a receiver by writing RC frames into the master side of a pseudo-terminal at packetRate Hz.
+Telemetry sent back by CRSF for Arduino is read and discarded, just like a receiver would. */
+static void simulateReceiver(int fd, unsigned int packetRate, unsigned int seconds)
+{
+    genericCrc::GenericCRC crc;
+    crsfProtocol::frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+
+    frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame.frame.frameLength = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame.frame.type = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+
+    crsfProtocol::rcChannelsPacked_t *channels = (crsfProtocol::rcChannelsPacked_t *)frame.frame.payload;
+    const size_t frameSize = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+
+    const unsigned int frameCount = packetRate * seconds;
+    for (unsigned int i = 0; i < frameCount && keepRunning; i++)
+    {
+        channels->channel0 = 172 + (i % 1640);
+        channels->channel1 = 992;
+        channels->channel2 = 172;
+        channels->channel3 = 992;
+        channels->channel4 = 1811;
+        frame.frame.payload[crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] =
+            crc.calculate(frame.frame.type, frame.frame.payload, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+
+        if (write(fd, frame.raw, frameSize) != (ssize_t)frameSize)
+        {
+            break;
+        }
+
+        uint8_t telemetry[256];
+        while (read(fd, telemetry, sizeof(telemetry)) > 0)
+        {
+            ;
+        }
+
+        delayMicroseconds(1000000 / packetRate);
+    }
+
+    keepRunning = false;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <tty device> | --pty [--cpu <n>] [--priority <n>] [--lock] [--prefault] [--period <us>]\n", argv[0]);
+        return 1;
+    }
+
+    serialReceiverLayer::linuxRunnerOptions_t options;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc)
+        {
+            options.cpu = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--priority") == 0 && i + 1 < argc)
+        {
+            options.priority = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--lock") == 0)
+        {
+            options.lockMemory = true;
+        }
+        else if (strcmp(argv[i], "--prefault") == 0)
+        {
+            options.prefault = true;
+        }
+        else if (strcmp(argv[i], "--period") == 0 && i + 1 < argc)
+        {
+            options.periodUs = (uint32_t)atoi(argv[++i]);
+        }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    const bool usePty = strcmp(argv[1], "--pty") == 0;
+    int master = -1;
+    int slave = -1;
+
+    if (usePty)
+    {
+        if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+        {
+            perror("openpty");
+            return 1;
+        }
+
+        fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    }
+
+    hal::LinuxSerial *port = usePty ? new hal::LinuxSerial(slave) : new hal::LinuxSerial(argv[1]);
+    serialReceiverLayer::SerialReceiver *receiver = new serialReceiverLayer::SerialReceiver(port);
+
+    if (!receiver->begin() || !port->isOpen())
+    {
+        printf("CRSF for Arduino failed to initialise.\n");
+        return 1;
+    }
+
+    receiver->setRcChannelsCallback(onReceiveRcChannels);
+
+    serialReceiverLayer::LinuxRunner runner(receiver, port);
+    if (!runner.setOptions(&options))
+    {
+        printf("Some real-time options could not be applied. Carrying on without them.\n");
+    }
+
+    serialReceiverLayer::linuxRunnerRealTimeStatus_t realTimeStatus;
+    runner.getRealTimeStatus(&realTimeStatus);
+    printf("CPU pinned: %s, SCHED_FIFO: %s, memory locked: %s, prefaulted: %s\n",
+           realTimeStatus.cpuPinned ? "yes" : "no", realTimeStatus.fifoScheduling ? "yes" : "no",
+           realTimeStatus.memoryLocked ? "yes" : "no", realTimeStatus.prefaulted ? "yes" : "no");
+
+    std::thread simulator;
+    if (usePty)
+    {
+        simulator = std::thread(simulateReceiver, master, 500, 10);
+    }
+
+    runner.run(&keepRunning);
+
+    serialReceiverLayer::linuxRunnerStatistics_t statistics;
+    runner.getStatistics(&statistics);
+
+    printf("\nRan for %.2f s\n", statistics.elapsedUs / 1.0e6);
+    printf("read() calls: %u (%.1f per second), %u bytes\n", statistics.readCalls, statistics.readCallsPerSecond, statistics.bytesRead);
+    printf("Decode latency: mean %u us, max %u us over %u wake-ups\n", statistics.decodeLatencyMeanUs, statistics.decodeLatencyMaxUs, statistics.decodeCount);
+    printf("RC channels callbacks: %u\n", rcFrameCount);
+
+    if (options.periodUs > 0)
+    {
+        printf("Wake-up latency over %u periods of %u us: p50 %u us, p99 %u us, p99.9 %u us, max %u us\n",
+               statistics.wakeCount, options.periodUs, statistics.wakeLatencyP50Us, statistics.wakeLatencyP99Us,
+               statistics.wakeLatencyP999Us, statistics.wakeLatencyMaxUs);
+    }
+
+    if (simulator.joinable())
+    {
+        simulator.join();
+    }
+
+    receiver->end();
+    delete receiver;
+    delete port;
+
+    if (usePty)
+    {
+        close(master);
+        close(slave);
+    }
+
+    return 0;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example shares live RC channels and link statistics with other processes on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_shared_memory/main.cpp -o linux_shared_memory -lutil -lpthread
+
+Usage:
+./linux_shared_memory publish /dev/ttyAMA0   Decode a receiver and publish to shared memory.
+./linux_shared_memory read                   Print what the publisher is sharing.
+./linux_shared_memory --benchmark [readers]  Fork reader processes (3 by default), publish at 1 kHz,
+                                             and report torn snapshots and the publish to read latency.
+./linux_shared_memory --restart              Leave the segment as a publisher that crashed halfway through writing would,
+                                             then start a new publisher on it. A reader that has the segment mapped must
+                                             be able to read again, and must get what the new publisher sends. */
+
+#include "SerialReceiver/LinuxRunner/LinuxRunner.hpp"
+#include "SerialReceiver/SharedMemory/SharedMemory.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define BENCHMARK_NAME "/crsf_for_arduino_benchmark"
+#define BENCHMARK_RATE 1000
+#define BENCHMARK_SECONDS 3
+
+static volatile bool keepRunning = true;
+static SharedMemoryPublisher *publisher = nullptr;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    publisher->publishRcChannels(rcChannels);
+}
+
+static void onReceiveLinkStatistics(link_statistics_t linkStatistics)
+{
+    publisher->publishLinkStatistics(&linkStatistics);
+}
+
+static int publish(const char *device)
+{
+    SharedMemoryPublisher sharedMemory;
+    if (!sharedMemory.begin())
+    {
+        perror("shm_open");
+        return 1;
+    }
+
+    publisher = &sharedMemory;
+
+    hal::LinuxSerial port(device);
+    SerialReceiver receiver(&port);
+    if (!receiver.begin() || !port.isOpen())
+    {
+        printf("Unable to open %s\n", device);
+        return 1;
+    }
+
+    receiver.setRcChannelsCallback(onReceiveRcChannels);
+    receiver.setLinkStatisticsCallback(onReceiveLinkStatistics);
+
+    LinuxRunner runner(&receiver, &port);
+    runner.run(&keepRunning);
+
+    receiver.end();
+    sharedMemory.end();
+    return 0;
+}
+
+static int printSnapshots()
+{
+    SharedMemoryReader reader;
+    while (!reader.begin() && keepRunning)
+    {
+        printf("Waiting for the publisher...\n");
+        sleep(1);
+    }
+
+    while (keepRunning)
+    {
+        rcChannels_t rcChannels;
+        link_statistics_t linkStatistics;
+        uint64_t timestampNs;
+
+        if (reader.readRcChannels(&rcChannels, &timestampNs))
+        {
+            printf("RC Channels <A: %u, E: %u, T: %u, R: %u> FailSafe: %s, %.1f ms old\n",
+                   rcChannels.value[0], rcChannels.value[1], rcChannels.value[2], rcChannels.value[3],
+                   rcChannels.failsafe ? "Active" : "Inactive", (sharedMemoryTimestampNs() - timestampNs) / 1.0e6);
+        }
+
+        if (reader.readLinkStatistics(&linkStatistics))
+        {
+            printf("Link Statistics <RSSI: %d, LQ: %d, SNR: %d>\n", linkStatistics.rssi, linkStatistics.lqi, linkStatistics.snr);
+        }
+
+        usleep(500000);
+    }
+
+    return 0;
+}
+
+/* A reader process. It polls the sequence number, snapshots each new record, checks that every channel
+carries the same value (a torn read would mix two records) and measures how long after publication it saw the record. */
+static void benchmarkReader(int index, int resultFd)
+{
+    SharedMemoryReader reader(BENCHMARK_NAME);
+    while (!reader.begin())
+    {
+        usleep(1000);
+    }
+
+    std::vector<uint32_t> latencies;
+    latencies.reserve(BENCHMARK_RATE * BENCHMARK_SECONDS);
+    uint32_t lastSequence = reader.getRcChannelsSequence();
+    uint32_t torn = 0;
+    uint32_t retriesExhausted = 0;
+    const uint64_t end = sharedMemoryTimestampNs() + (BENCHMARK_SECONDS + 1) * 1000000000ULL;
+
+    while (sharedMemoryTimestampNs() < end && latencies.size() < BENCHMARK_RATE * BENCHMARK_SECONDS)
+    {
+        if (reader.getRcChannelsSequence() == lastSequence)
+        {
+            sched_yield();
+            continue;
+        }
+
+        rcChannels_t rcChannels;
+        uint64_t timestampNs;
+        if (!reader.readRcChannels(&rcChannels, &timestampNs, &lastSequence))
+        {
+            retriesExhausted++;
+            continue;
+        }
+
+        const uint64_t now = sharedMemoryTimestampNs();
+        latencies.push_back((uint32_t)(now - timestampNs));
+
+        for (int i = 1; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+        {
+            if (rcChannels.value[i] != rcChannels.value[0])
+            {
+                torn++;
+                break;
+            }
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const size_t count = latencies.size();
+    char result[256];
+    int length = snprintf(result, sizeof(result), "reader %d: %zu snapshots, %u torn, %u gave up, latency p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                          index, count, torn, retriesExhausted,
+                          count ? latencies[count / 2] / 1000.0 : 0.0,
+                          count ? latencies[(count * 99) / 100] / 1000.0 : 0.0,
+                          count ? latencies[count - 1] / 1000.0 : 0.0);
+    write(resultFd, result, length);
+}
+
+static int benchmark(int readerCount)
+{
+    SharedMemoryPublisher sharedMemory(BENCHMARK_NAME);
+    if (!sharedMemory.begin())
+    {
+        perror("shm_open");
+        return 1;
+    }
+
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0)
+    {
+        perror("pipe");
+        return 1;
+    }
+
+    std::vector<pid_t> readers;
+    for (int i = 0; i < readerCount; i++)
+    {
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(pipeFds[0]);
+            benchmarkReader(i, pipeFds[1]);
+            _exit(0);
+        }
+
+        readers.push_back(pid);
+    }
+
+    close(pipeFds[1]);
+
+    // Give the readers time to map the segment.
+    usleep(100000);
+
+    rcChannels_t rcChannels;
+    rcChannels.valid = true;
+    rcChannels.failsafe = false;
+
+    const uint64_t period = 1000000000ULL / BENCHMARK_RATE;
+    uint64_t next = sharedMemoryTimestampNs();
+    for (uint32_t i = 0; i < BENCHMARK_RATE * BENCHMARK_SECONDS && keepRunning; i++)
+    {
+        for (int channel = 0; channel < crsfProtocol::RC_CHANNEL_COUNT; channel++)
+        {
+            rcChannels.value[channel] = (uint16_t)(i & 0x7ff);
+        }
+
+        sharedMemory.publishRcChannels(&rcChannels);
+
+        next += period;
+        const int64_t remaining = (int64_t)(next - sharedMemoryTimestampNs());
+        if (remaining > 0)
+        {
+            struct timespec duration = {0, (long)remaining};
+            nanosleep(&duration, nullptr);
+        }
+    }
+
+    printf("Published %u RC channels records at %u Hz to %d readers\n", BENCHMARK_RATE * BENCHMARK_SECONDS, BENCHMARK_RATE, readerCount);
+
+    char buffer[4096];
+    ssize_t length;
+    while ((length = ::read(pipeFds[0], buffer, sizeof(buffer))) > 0)
+    {
+        fwrite(buffer, 1, length, stdout);
+    }
+
+    for (pid_t pid : readers)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+
+    sharedMemory.end();
+    return 0;
+}
+
+/* Returns true if a reader can read RC channels, and the values that it reads are value (or not valid, if value is 0). */
+static bool readsBack(SharedMemoryReader *reader, uint16_t value, uint32_t *sequence)
+{
+    rcChannels_t rcChannels;
+    if (!reader->tryReadRcChannels(&rcChannels, nullptr, sequence))
+    {
+        return false;
+    }
+
+    return value == 0 ? !rcChannels.valid : rcChannels.valid && rcChannels.value[crsfProtocol::RC_CHANNEL_THROTTLE] == value;
+}
+
+static int restart()
+{
+    SharedMemoryPublisher crashed(BENCHMARK_NAME);
+    SharedMemoryReader reader(BENCHMARK_NAME);
+    if (!crashed.begin() || !reader.begin())
+    {
+        perror("shm_open");
+        return 1;
+    }
+
+    rcChannels_t rcChannels;
+    memset(&rcChannels, 0, sizeof(rcChannels));
+    rcChannels.valid = true;
+    rcChannels.value[crsfProtocol::RC_CHANNEL_THROTTLE] = 1000;
+    crashed.publishRcChannels(&rcChannels);
+    uint32_t sequenceBefore = 0;
+    const bool readBefore = readsBack(&reader, 1000, &sequenceBefore);
+
+    // Stop the first publisher halfway through its next write: the sequence number is left odd.
+    const int fd = shm_open(BENCHMARK_NAME, O_RDWR, 0);
+    sharedMemorySegment_t *segment = (sharedMemorySegment_t *)mmap(nullptr, sizeof(sharedMemorySegment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    segment->rcChannels.sequence.fetch_add(1);
+    segment->rcChannels.rcChannels.value[crsfProtocol::RC_CHANNEL_THROTTLE] = 1234;
+    munmap(segment, sizeof(sharedMemorySegment_t));
+    crashed.end(false);
+    const bool readWhileStuck = readsBack(&reader, 1000, nullptr) || readsBack(&reader, 1234, nullptr);
+
+    SharedMemoryPublisher restarted(BENCHMARK_NAME);
+    if (!restarted.begin())
+    {
+        perror("shm_open");
+        return 1;
+    }
+
+    uint32_t sequenceEmpty = 0;
+    const bool readEmpty = readsBack(&reader, 0, &sequenceEmpty);
+    rcChannels.value[crsfProtocol::RC_CHANNEL_THROTTLE] = 2000;
+    restarted.publishRcChannels(&rcChannels);
+    uint32_t sequenceAfter = 0;
+    const bool readAfter = readsBack(&reader, 2000, &sequenceAfter);
+
+    const bool ok = readBefore && !readWhileStuck && readEmpty && readAfter && sequenceEmpty > sequenceBefore && sequenceAfter > sequenceEmpty;
+    printf("Before the crash: %s (record %u). Left mid write: %s. After the restart: %s (record %u), then %s (record %u)\n",
+           readBefore ? "read" : "not read", sequenceBefore, readWhileStuck ? "read" : "not read", readEmpty ? "empty" : "not empty", sequenceEmpty,
+           readAfter ? "read" : "not read", sequenceAfter);
+    printf("Restart %s\n", ok ? "OK" : "FAILED");
+
+    reader.end();
+    restarted.end();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (argc >= 3 && strcmp(argv[1], "publish") == 0)
+    {
+        return publish(argv[2]);
+    }
+    else if (argc >= 2 && strcmp(argv[1], "read") == 0)
+    {
+        return printSnapshots();
+    }
+    else if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0)
+    {
+        return benchmark(argc >= 3 ? atoi(argv[2]) : 3);
+    }
+    else if (argc >= 2 && strcmp(argv[1], "--restart") == 0)
+    {
+        return restart();
+    }
+
+    printf("Usage: %s publish <tty device> | read | --benchmark [readers] | --restart\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example measures what it costs the Serial Receiver to take each byte from its transport, on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_stream_benchmark/main.cpp -o linux_stream_benchmark -lutil -lpthread
+
+The same block of RC channels frames is decoded from memory through three transports:
+1. StreamTransport<HardwareSerial>: available() and read() are virtual calls, one read() per byte.
+   This is what a sketch gets when it passes a HardwareSerial pointer.
+2. StreamTransport<MemoryStream>: the same Arduino style stream, but a concrete class,
+   so read() is called directly and inlined.
+3. A SerialTransport that hands over a whole chunk with memcpy(), like hal::LinuxSerial does with read().
+
+To see what inlining the receive hot path is worth, build it four ways and compare the results:
+add -DCRSF_INLINE_HOT_PATH=1 to inline the hot path from the headers, and -flto to enable link time optimisation. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+
+#include <stdio.h>
+#include <time.h>
+
+using namespace serialReceiverLayer;
+
+#define BENCHMARK_FRAMES 1000
+#define BENCHMARK_PASSES 2000
+#define BENCHMARK_REPEATS 5
+
+static uint8_t frames[BENCHMARK_FRAMES * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+static size_t framesLength = 0;
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* An Arduino style stream over the frames, reached through HardwareSerial's virtual functions. */
+class VirtualMemoryStream : public HardwareSerial
+{
+  public:
+    size_t position = 0;
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    int available() override
+    {
+        return (int)(framesLength - position);
+    }
+
+    int read() override
+    {
+        return position < framesLength ? frames[position++] : -1;
+    }
+
+    size_t write(uint8_t data) override
+    {
+        (void)data;
+        return 1;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        (void)buffer;
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+/* The same stream as a concrete class with no virtual functions. */
+class MemoryStream
+{
+  public:
+    size_t position = 0;
+
+    void begin(unsigned long baudRate)
+    {
+        (void)baudRate;
+    }
+
+    void end()
+    {
+    }
+
+    int available()
+    {
+        return (int)(framesLength - position);
+    }
+
+    int read()
+    {
+        return position < framesLength ? frames[position++] : -1;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        (void)buffer;
+        return size;
+    }
+
+    void flush()
+    {
+    }
+};
+
+/* A transport that copies whole chunks. */
+class MemoryTransport final : public hal::SerialTransport
+{
+  public:
+    size_t position = 0;
+
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        const size_t count = min(size, framesLength - position);
+        memcpy(buffer, frames + position, count);
+        position += count;
+        return count;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        (void)buffer;
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+};
+
+static uint32_t callbacks = 0;
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    (void)rcChannels;
+    callbacks++;
+}
+
+static void buildFrames()
+{
+    genericCrc::GenericCRC crc;
+    for (uint32_t i = 0; i < BENCHMARK_FRAMES; i++)
+    {
+        crsfProtocol::frame_t frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+        frame.frame.frameLength = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        frame.frame.type = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+
+        crsfProtocol::rcChannelsPacked_t *channels = (crsfProtocol::rcChannelsPacked_t *)frame.frame.payload;
+        channels->channel0 = 172 + (i % 1640);
+        channels->channel2 = 992;
+        frame.frame.payload[crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] =
+            crc.calculate(frame.frame.type, frame.frame.payload, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+
+        const size_t size = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+        memcpy(frames + framesLength, frame.raw, size);
+        framesLength += size;
+    }
+}
+
+/* Decodes the frames BENCHMARK_PASSES times and returns the nanoseconds per byte. */
+template <typename T>
+static double run(const char *name, hal::SerialTransport *transport, T *stream)
+{
+    SerialReceiver receiver(transport);
+    receiver.begin();
+    receiver.setRcChannelsCallback(onReceiveRcChannels);
+
+    /* Keep the best of several repeats, so that other processes on the host do not skew the result. */
+    double perByte = 0;
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        callbacks = 0;
+        const uint64_t start = monotonicNanoseconds();
+        for (int pass = 0; pass < BENCHMARK_PASSES; pass++)
+        {
+            stream->position = 0;
+            receiver.processFrames();
+        }
+        const uint64_t elapsed = monotonicNanoseconds() - start;
+
+        const double repeatPerByte = (double)elapsed / ((double)framesLength * BENCHMARK_PASSES);
+        if (repeat == 0 || repeatPerByte < perByte)
+        {
+            perByte = repeatPerByte;
+        }
+    }
+
+    printf("%-34s %7.2f ns/byte  (%u callbacks)\n", name, perByte, callbacks);
+    receiver.end();
+    return perByte;
+}
+
+int main()
+{
+    buildFrames();
+    printf("Decoding %u frames (%zu bytes), %u times per transport, best of %u (CRSF_INLINE_HOT_PATH = %d)\n",
+           BENCHMARK_FRAMES, framesLength, BENCHMARK_PASSES, BENCHMARK_REPEATS, CRSF_INLINE_HOT_PATH);
+
+    VirtualMemoryStream virtualStream;
+    hal::StreamTransport<HardwareSerial> virtualTransport(&virtualStream);
+    MemoryStream stream;
+    hal::StreamTransport<MemoryStream> inlineTransport(&stream);
+    MemoryTransport chunkTransport;
+
+    const double virtualPerByte = run("StreamTransport<HardwareSerial>", &virtualTransport, &virtualStream);
+    const double inlinePerByte = run("StreamTransport<MemoryStream>", &inlineTransport, &stream);
+    const double chunkPerByte = run("SerialTransport, memcpy() chunks", &chunkTransport, &chunkTransport);
+
+    printf("\nInlined read() saves %.2f ns/byte, chunked reads save %.2f ns/byte over virtual read() calls.\n",
+           virtualPerByte - inlinePerByte, virtualPerByte - chunkPerByte);
+    return 0;
+}
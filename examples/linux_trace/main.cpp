@@ -0,0 +1,404 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example records a trace of the Serial Receiver on a Linux host, and turns trace dumps into Chrome trace JSON.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_trace/main.cpp -o linux_trace -lutil -lpthread
+
+Usage:
+./linux_trace --record <dump file>        Loop one second of simulated frames through a pseudo-terminal pair with tracing on,
+                                          and write the trace dump to <dump file>. Now and then a frame has a bad CRC
+                                          or is cut short, so that the trace shows CRC errors and resyncs.
+./linux_trace <dump file> [json file]     Turn a trace dump (from --record, or from dumpTrace() on a board) into
+                                          Chrome trace JSON. Open it in chrome://tracing or https://ui.perfetto.dev.
+                                          Without [json file], the JSON goes to stdout. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <fcntl.h>
+#include <pty.h>
+#include <stdio.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace serialReceiverLayer;
+
+#define SIMULATED_PACKET_RATE 250 // Hz.
+#define SIMULATED_SECONDS     1
+
+/* Tracing is a compile-time option. This configuration turns it on for the receiver below only. */
+struct TracedConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool traceEnabled = true;
+    static constexpr uint16_t traceEventCount = 4096;
+};
+
+static volatile bool keepRunning = true;
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    (void)rcChannels;
+}
+
+static void onReceiveLinkStatistics(link_statistics_t linkStatistics)
+{
+    (void)linkStatistics;
+}
+
+static size_t buildFrame(crsfProtocol::frame_t *frame, uint8_t type, const void *payload, uint8_t payloadSize)
+{
+    genericCrc::GenericCRC crc;
+    memset(frame, 0, sizeof(crsfProtocol::frame_t));
+    frame->frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame->frame.frameLength = payloadSize + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame->frame.type = type;
+    memcpy(frame->frame.payload, payload, payloadSize);
+    frame->frame.payload[payloadSize] = crc.calculate(type, frame->frame.payload, payloadSize);
+
+    return frame->frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+}
+
+/* Writes RC channels frames into the master side of a pseudo-terminal, with a link statistics frame every 10th frame.
+Every 50th frame has a bad CRC, and every 80th frame is cut short. */
+static void simulateReceiver(int fd)
+{
+    const unsigned int frameCount = SIMULATED_PACKET_RATE * SIMULATED_SECONDS;
+    for (unsigned int i = 0; i < frameCount && keepRunning; i++)
+    {
+        crsfProtocol::frame_t frame;
+        size_t frameSize;
+
+        if (i % 10 == 5)
+        {
+            crsfProtocol::crsf_payload_link_statistics_t linkStatistics;
+            memset(&linkStatistics, 0, sizeof(linkStatistics));
+            linkStatistics.uplink_rssi_1 = 60;
+            linkStatistics.uplink_link_quality = 100;
+            frameSize = buildFrame(&frame, crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS, &linkStatistics, crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE);
+        }
+        else
+        {
+            crsfProtocol::rcChannelsPacked_t channels;
+            memset(&channels, 0, sizeof(channels));
+            channels.channel0 = 172 + (i % 1640);
+            channels.channel2 = 992;
+            frameSize = buildFrame(&frame, crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, &channels, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+        }
+
+        if (i % 50 == 49)
+        {
+            frame.raw[frameSize - 1] ^= 0xFF;
+        }
+
+        if (i % 80 == 79)
+        {
+            frameSize /= 2;
+        }
+
+        if (write(fd, frame.raw, frameSize) != (ssize_t)frameSize)
+        {
+            break;
+        }
+
+        uint8_t telemetry[256];
+        while (read(fd, telemetry, sizeof(telemetry)) > 0)
+        {
+            ;
+        }
+
+        delayMicroseconds(1000000 / SIMULATED_PACKET_RATE);
+    }
+
+    keepRunning = false;
+}
+
+static int record(const char *path)
+{
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    hal::LinuxSerial port(slave);
+    BasicSerialReceiver<TracedConfig> receiver(&port);
+    if (!receiver.begin() || !port.isOpen())
+    {
+        printf("CRSF for Arduino failed to initialise.\n");
+        return 1;
+    }
+
+    receiver.setRcChannelsCallback(onReceiveRcChannels);
+    receiver.setLinkStatisticsCallback(onReceiveLinkStatistics);
+    receiver.clearTrace();
+
+    std::thread simulator(simulateReceiver, master);
+    while (keepRunning)
+    {
+        if (port.waitForData(100))
+        {
+            receiver.processFrames();
+        }
+    }
+    simulator.join();
+
+    const size_t dumpSize = receiver.getTraceDumpSize();
+    uint8_t *dump = new uint8_t[dumpSize];
+    const size_t length = receiver.dumpTrace(dump, dumpSize);
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr || fwrite(dump, 1, length, file) != length)
+    {
+        perror(path);
+        delete[] dump;
+        return 1;
+    }
+    fclose(file);
+    delete[] dump;
+
+    serialReceiverCounters_t counters;
+    receiver.getCounters(&counters);
+    printf("Wrote %zu bytes (%zu events) to %s\n", length, (length - TRACE_DUMP_HEADER_SIZE) / TRACE_DUMP_EVENT_SIZE, path);
+    printf("%u RC channels frames, %u link statistics frames, %u CRC errors, %u resyncs\n",
+           counters.crsf.rcChannelsFrames, counters.crsf.linkStatisticsFrames, counters.crsf.crcErrors,
+           counters.crsf.timeouts + counters.crsf.lengthErrors);
+
+    receiver.end();
+    close(master);
+    close(slave);
+    return 0;
+}
+
+static uint16_t readU16LE(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t readU32LE(const uint8_t *buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+}
+
+static const char *frameTypeName(uint8_t type)
+{
+    switch (type)
+    {
+        case crsfProtocol::CRSF_FRAMETYPE_GPS:
+            return "GPS";
+        case crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR:
+            return "battery";
+        case crsfProtocol::CRSF_FRAMETYPE_BARO_ALTITUDE:
+            return "baro altitude";
+        case crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS:
+            return "link statistics";
+        case crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
+            return "RC channels";
+        case crsfProtocol::CRSF_FRAMETYPE_ATTITUDE:
+            return "attitude";
+        case crsfProtocol::CRSF_FRAMETYPE_FLIGHT_MODE:
+            return "flight mode";
+        default:
+            return "other";
+    }
+}
+
+static const char *callbackName(uint8_t callback)
+{
+    switch (callback)
+    {
+        case TRACE_CALLBACK_RC_CHANNELS:
+            return "RC channels callback";
+        case TRACE_CALLBACK_LINK_STATISTICS:
+            return "link statistics callback";
+        case TRACE_CALLBACK_FLIGHT_MODE:
+            return "flight mode callback";
+        default:
+            return "callback";
+    }
+}
+
+/* The decoder, the callbacks and telemetry each get their own track in the timeline. */
+#define TRACK_DECODER   1
+#define TRACK_CALLBACKS 2
+#define TRACK_TELEMETRY 3
+
+static void writeEvent(FILE *out, bool *first, const char *name, char phase, uint64_t timestamp, int track, const char *args)
+{
+    fprintf(out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%d%s%s%s}",
+            *first ? "" : ",", name, phase, (unsigned long long)timestamp, track,
+            args != nullptr ? ",\"args\":{" : "", args != nullptr ? args : "", args != nullptr ? "}" : "");
+    *first = false;
+}
+
+static int convert(const char *inputPath, const char *outputPath)
+{
+    FILE *in = fopen(inputPath, "rb");
+    if (in == nullptr)
+    {
+        perror(inputPath);
+        return 1;
+    }
+
+    uint8_t header[TRACE_DUMP_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), in) != sizeof(header) || memcmp(header, "CFAT", 4) != 0)
+    {
+        fprintf(stderr, "%s is not a CRSF for Arduino trace dump.\n", inputPath);
+        fclose(in);
+        return 1;
+    }
+
+    const uint16_t version = readU16LE(header + 4);
+    const uint16_t eventSize = readU16LE(header + 6);
+    const uint32_t eventCount = readU32LE(header + 8);
+    const uint32_t overwritten = readU32LE(header + 12);
+    if (version != TRACE_DUMP_VERSION || eventSize < TRACE_DUMP_EVENT_SIZE)
+    {
+        fprintf(stderr, "%s has an unsupported trace format (version %u, %u byte events).\n", inputPath, version, eventSize);
+        fclose(in);
+        return 1;
+    }
+
+    FILE *out = outputPath != nullptr ? fopen(outputPath, "w") : stdout;
+    if (out == nullptr)
+    {
+        perror(outputPath);
+        fclose(in);
+        return 1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"overwrittenEvents\":%u},\"traceEvents\":[", overwritten);
+    bool first = true;
+    writeEvent(out, &first, "thread_name", 'M', 0, TRACK_DECODER, "\"name\":\"Decoder\"");
+    writeEvent(out, &first, "thread_name", 'M', 0, TRACK_CALLBACKS, "\"name\":\"Callbacks\"");
+    writeEvent(out, &first, "thread_name", 'M', 0, TRACK_TELEMETRY, "\"name\":\"Telemetry\"");
+
+    /* Timestamps are 32 bit micros() values. Follow them across wrap-arounds by adding up the differences. */
+    uint64_t timestamp = 0;
+    uint32_t lastTimestamp = 0;
+    bool frameOpen = false;
+    uint32_t converted = 0;
+    char args[96];
+    uint8_t event[256];
+
+    for (uint32_t i = 0; i < eventCount && fread(event, 1, eventSize, in) == eventSize; i++)
+    {
+        const uint32_t eventTimestamp = readU32LE(event);
+        const uint8_t type = event[4];
+        const uint8_t argument = event[5];
+        const uint16_t data = readU16LE(event + 6);
+
+        if (i == 0)
+        {
+            lastTimestamp = eventTimestamp;
+        }
+        timestamp += (int64_t)(int32_t)(eventTimestamp - lastTimestamp);
+        lastTimestamp = eventTimestamp;
+
+        switch (type)
+        {
+            case TRACE_EVENT_FRAME_START:
+                writeEvent(out, &first, "frame", 'B', timestamp, TRACK_DECODER, nullptr);
+                frameOpen = true;
+                break;
+
+            case TRACE_EVENT_FRAME_DECODED:
+            case TRACE_EVENT_CRC_ERROR:
+                snprintf(args, sizeof(args), "\"type\":\"0x%02X %s\",\"length\":%u,\"crc\":\"%s\"",
+                         argument, frameTypeName(argument), data, type == TRACE_EVENT_FRAME_DECODED ? "ok" : "bad");
+                if (frameOpen)
+                {
+                    writeEvent(out, &first, "frame", 'E', timestamp, TRACK_DECODER, args);
+                    frameOpen = false;
+                }
+                if (type == TRACE_EVENT_CRC_ERROR)
+                {
+                    writeEvent(out, &first, "CRC error", 'i', timestamp, TRACK_DECODER, args);
+                }
+                break;
+
+            case TRACE_EVENT_RESYNC:
+                snprintf(args, sizeof(args), argument == TRACE_RESYNC_TIMEOUT ? "\"reason\":\"timeout\",\"bytesDropped\":%u" : "\"reason\":\"bad length\",\"lengthByte\":%u", data);
+                if (frameOpen)
+                {
+                    writeEvent(out, &first, "frame", 'E', timestamp, TRACK_DECODER, args);
+                    frameOpen = false;
+                }
+                writeEvent(out, &first, "resync", 'i', timestamp, TRACK_DECODER, args);
+                break;
+
+            case TRACE_EVENT_CALLBACK_START:
+            case TRACE_EVENT_CALLBACK_END:
+                writeEvent(out, &first, callbackName(argument), type == TRACE_EVENT_CALLBACK_START ? 'B' : 'E', timestamp, TRACK_CALLBACKS, nullptr);
+                break;
+
+            case TRACE_EVENT_TELEMETRY_TX_START:
+                snprintf(args, sizeof(args), "\"type\":\"0x%02X %s\",\"length\":%u", argument, frameTypeName(argument), data);
+                writeEvent(out, &first, "telemetry", 'B', timestamp, TRACK_TELEMETRY, args);
+                break;
+
+            case TRACE_EVENT_TELEMETRY_TX_END:
+                snprintf(args, sizeof(args), "\"written\":%u", data);
+                writeEvent(out, &first, "telemetry", 'E', timestamp, TRACK_TELEMETRY, args);
+                break;
+
+            default:
+                // Unknown event types, eg from a newer version of the library, are skipped.
+                continue;
+        }
+
+        converted++;
+    }
+
+    fprintf(out, "\n]}\n");
+    fclose(in);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    fprintf(stderr, "Converted %u of %u events (%u older events had been overwritten).\n", converted, eventCount, overwritten);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "--record") == 0)
+    {
+        return record(argv[2]);
+    }
+
+    if (argc >= 2 && argv[1][0] != '-')
+    {
+        return convert(argv[1], argc >= 3 ? argv[2] : nullptr);
+    }
+
+    printf("Usage: %s --record <dump file> | <dump file> [json file]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,509 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example drives a CRSF TX module from a Linux host, or pairs the transmitter role with the receiver role over a pseudo-terminal and measures the jitter.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_transmitter/main.cpp -o linux_transmitter -lutil -lpthread
+
+Usage:
+./linux_transmitter <tty device> [--baud n] [--rate hz]
+                            Drive a TX module (eg an ExpressLRS module on a USB serial adapter) with centred sticks,
+                            and print its timing and telemetry once a second. Ctrl+C stops.
+./linux_transmitter --loopback [seconds] [--rate hz]
+                            Pair the transmitter role with the receiver role over a pseudo-terminal.
+                            The receiver side also stands in for a TX module: its RF clock runs a little fast,
+                            and it sends timing corrections in the second half of the run.
+                            Prints how far off the module's RF cycle the frames arrived, and their jitter,
+                            with and without the corrections, and checks every channel and the telemetry that came back.
+                            Last, subset RC channels frames are captured, decoded as a receiver decodes them
+                            (us = value / 2 + 988) and checked against the microseconds of the channels that were set. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
+#include "hal/LinuxSerial/LinuxSerial.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define LOOPBACK_SECONDS         10
+#define MODULE_CLOCK_ERROR_PPM   500 // How much faster the emulated module's RF clock runs than the transmitter's.
+#define MODULE_ADVANCE_US        300 // How long before each RF packet the emulated module wants the RC channels.
+#define MODULE_CORRECTION_FRAMES 4   // The emulated module sends a timing correction every this many RC frames.
+#define LOCK_SETTLE_FRAMES       100 // Frames after the first correction that are left out of the locked statistics.
+#define SUBSET_FRAMES            24  // Subset RC channels frames that are decoded by the subset check.
+
+static volatile bool keepRunning = true;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+/* The emulated module. It lives in the receiver's thread, and only touches these from there. */
+static hal::LinuxSerial *modulePort = nullptr;
+static double moduleIntervalUs = 0;
+static uint32_t moduleStartUs = 0;
+static std::atomic<bool> moduleCorrections(false);
+static uint32_t moduleFrameCount = 0;
+static uint32_t firstCorrectionFrame = UINT32_MAX;
+
+typedef struct arrival_s
+{
+    uint32_t timeUs;
+    double offsetUs; // How much earlier than MODULE_ADVANCE_US before the next RF packet the frame arrived.
+    bool corrected;  // Timing corrections were being sent.
+} arrival_t;
+
+static std::vector<arrival_t> arrivals;
+static uint32_t channelMismatches = 0;
+static std::atomic<uint16_t> expectedSweep(CRSF_RC_CHANNEL_MIN);
+
+static uint16_t expectedChannel(uint8_t channel)
+{
+    // Every channel gets a different value, so that a packing mistake cannot go unnoticed.
+    return (uint16_t)(CRSF_RC_CHANNEL_MIN + 97 * channel);
+}
+
+static void sendTimingCorrection(double offsetUs)
+{
+    genericCrc::GenericCRC crc;
+    const uint32_t intervalTenths = (uint32_t)lround(moduleIntervalUs * 10);
+    const int32_t offsetTenths = (int32_t)lround(offsetUs * 10);
+
+    uint8_t frame[crsfProtocol::CRSF_FRAME_RADIO_ID_TIMING_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD];
+    frame[0] = crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER;
+    frame[1] = crsfProtocol::CRSF_FRAME_RADIO_ID_TIMING_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = crsfProtocol::CRSF_FRAMETYPE_RADIO_ID;
+    frame[3] = crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER;
+    frame[4] = crsfProtocol::CRSF_ADDRESS_CRSF_TRANSMITTER;
+    frame[5] = crsfProtocol::CRSF_RADIO_ID_TIMING_CORRECTION;
+    for (int i = 0; i < 4; i++)
+    {
+        frame[6 + i] = (uint8_t)(intervalTenths >> (24 - 8 * i));
+        frame[10 + i] = (uint8_t)((uint32_t)offsetTenths >> (24 - 8 * i));
+    }
+    frame[14] = crc.calculate(frame[2], frame + 3, crsfProtocol::CRSF_FRAME_RADIO_ID_TIMING_PAYLOAD_SIZE);
+    modulePort->write(frame, sizeof(frame));
+}
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    const uint32_t now = micros();
+
+    for (uint8_t i = 1; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        if (rcChannels->value[i] != expectedChannel(i))
+        {
+            channelMismatches++;
+        }
+    }
+    if (rcChannels->value[0] < CRSF_RC_CHANNEL_MIN || rcChannels->value[0] > CRSF_RC_CHANNEL_MAX)
+    {
+        channelMismatches++;
+    }
+
+    // Where in the module's RF cycle the frame landed.
+    const double phaseUs = fmod((double)(uint32_t)(now - moduleStartUs), moduleIntervalUs);
+    double offsetUs = (moduleIntervalUs - phaseUs) - MODULE_ADVANCE_US;
+    if (offsetUs > moduleIntervalUs / 2)
+    {
+        offsetUs -= moduleIntervalUs;
+    }
+
+    const bool corrected = moduleCorrections.load();
+    arrivals.push_back({now, offsetUs, corrected});
+    moduleFrameCount++;
+
+    if (corrected && moduleFrameCount % MODULE_CORRECTION_FRAMES == 0)
+    {
+        if (firstCorrectionFrame == UINT32_MAX)
+        {
+            firstCorrectionFrame = (uint32_t)arrivals.size();
+        }
+        sendTimingCorrection(offsetUs);
+    }
+}
+
+static uint32_t telemetryFrames[256];
+
+static void onTelemetry(uint8_t frameType, const transmitterTelemetry_t *telemetry)
+{
+    (void)telemetry;
+    telemetryFrames[frameType]++;
+}
+
+static void printStatistics(const char *label, const std::vector<double> &offsets, const std::vector<double> &intervals)
+{
+    if (offsets.empty() || intervals.empty())
+    {
+        printf("%-24s no frames\n", label);
+        return;
+    }
+
+    std::vector<double> absOffsets;
+    double meanInterval = 0;
+    for (size_t i = 0; i < offsets.size(); i++)
+    {
+        absOffsets.push_back(fabs(offsets[i]));
+    }
+    for (size_t i = 0; i < intervals.size(); i++)
+    {
+        meanInterval += intervals[i];
+    }
+    meanInterval /= intervals.size();
+
+    std::vector<double> deviations;
+    for (size_t i = 0; i < intervals.size(); i++)
+    {
+        deviations.push_back(fabs(intervals[i] - meanInterval));
+    }
+    std::sort(absOffsets.begin(), absOffsets.end());
+    std::sort(deviations.begin(), deviations.end());
+
+    printf("%-24s %7zu %10.1f %10.1f %10.1f %10.2f %10.1f %10.1f\n", label, offsets.size(),
+           absOffsets[absOffsets.size() / 2], absOffsets[absOffsets.size() * 99 / 100], absOffsets.back(),
+           meanInterval, deviations[deviations.size() / 2], deviations[deviations.size() * 99 / 100]);
+}
+
+/* Keeps the last frame that was written to it, for the subset check. */
+class FrameCapture final : public hal::SerialTransport
+{
+  public:
+    void begin(unsigned long baudRate) override
+    {
+        (void)baudRate;
+    }
+
+    void end() override
+    {
+    }
+
+    size_t read(uint8_t *buffer, size_t size) override
+    {
+        (void)buffer;
+        (void)size;
+        return 0;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        length = size < sizeof(frame) ? size : sizeof(frame);
+        memcpy(frame, buffer, length);
+        return size;
+    }
+
+    void flush() override
+    {
+    }
+
+    uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+    size_t length = 0;
+};
+
+/* Sends subset RC channels frames with every channel value from 172 to 1811 somewhere in them, and decodes each one
+the way a receiver does. Every channel must come out within half a microsecond of the value that was set. */
+static bool checkSubsetFrames(uint16_t packetRate)
+{
+    const uint8_t subsets[][2] = {{0, 16}, {4, 8}, {13, 3}};
+    FrameCapture capture;
+    Transmitter transmitter(&capture);
+    genericCrc::GenericCRC crc;
+    uint32_t channelsChecked = 0;
+    uint32_t badFrames = 0;
+    double worstErrorUs = 0;
+
+    transmitter.begin(crsfProtocol::BAUD_RATE, packetRate);
+    for (uint32_t frameNumber = 0; frameNumber < SUBSET_FRAMES; frameNumber++)
+    {
+        const uint8_t first = subsets[frameNumber % 3][0];
+        const uint8_t count = subsets[frameNumber % 3][1];
+        uint16_t values[crsfProtocol::RC_CHANNEL_COUNT];
+        for (uint8_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+        {
+            values[i] = (uint16_t)(CRSF_RC_CHANNEL_MIN + (frameNumber * 71 + i * 113) % (CRSF_RC_CHANNEL_MAX - CRSF_RC_CHANNEL_MIN + 1));
+        }
+
+        // The ends of the range, so that clamping cannot go unnoticed.
+        values[first] = frameNumber % 2 == 0 ? CRSF_RC_CHANNEL_MIN : CRSF_RC_CHANNEL_MAX;
+        transmitter.setChannels(values);
+        transmitter.setSubset(first, count);
+
+        capture.length = 0;
+        delayMicroseconds(transmitter.getTimeUntilNextFrame());
+        while (!transmitter.update())
+        {
+        }
+
+        uint8_t *frame = capture.frame;
+        const uint8_t payloadLength = frame[1] - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        if (capture.length != (size_t)payloadLength + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD ||
+            frame[2] != crsfProtocol::CRSF_FRAMETYPE_SUBSET_RC_CHANNELS_PACKED || crc.calculate(frame[2], frame + 3, payloadLength) != frame[3 + payloadLength] ||
+            (frame[3] & 0x1F) != first || ((frame[3] >> 5) & 0x03) != crsfProtocol::CRSF_SUBSET_RC_RESOLUTION_11B ||
+            payloadLength != 1 + (count * 11 + 7) / 8)
+        {
+            badFrames++;
+            continue;
+        }
+
+        // 11 bits per channel, least significant bit first.
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint32_t value = 0;
+            for (uint8_t bit = 0; bit < 11; bit++)
+            {
+                const uint32_t position = (uint32_t)i * 11 + bit;
+                value |= (uint32_t)((frame[4 + position / 8] >> (position % 8)) & 1) << bit;
+            }
+
+            const double decodedUs = value / 2.0 + 988;
+            const double expectedUs = 988 + (values[first + i] - CRSF_RC_CHANNEL_MIN) * 1024.0 / (CRSF_RC_CHANNEL_MAX - CRSF_RC_CHANNEL_MIN);
+            worstErrorUs = fabs(decodedUs - expectedUs) > worstErrorUs ? fabs(decodedUs - expectedUs) : worstErrorUs;
+            channelsChecked++;
+        }
+    }
+
+    transmitter.end();
+    const bool ok = badFrames == 0 && channelsChecked > 0 && worstErrorUs <= 0.5;
+    printf("Subset RC channels: %u frames, %u channels decoded to microseconds, worst error %.2f us, %u bad frames: %s\n", SUBSET_FRAMES,
+           channelsChecked, worstErrorUs, badFrames, ok ? "OK" : "MISMATCH");
+    return ok;
+}
+
+static int loopback(uint32_t seconds, uint16_t packetRate)
+{
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    // A pseudo-terminal has no baud rate, so it is left in raw mode by LinuxSerial, and frames arrive as soon as they are written.
+    hal::LinuxSerial transmitterPort(master);
+    hal::LinuxSerial receiverPort(slave);
+    SerialReceiver receiver(&receiverPort);
+    Transmitter transmitter(&transmitterPort);
+
+    if (!receiver.begin() || !transmitter.begin(crsfProtocol::BAUD_RATE, packetRate))
+    {
+        fprintf(stderr, "Could not start the receiver or the transmitter\n");
+        return 1;
+    }
+
+    // The receiver role only takes RC channels that are addressed to a flight controller.
+    transmitter.setDestination(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER);
+    transmitter.setTelemetryCallback(onTelemetry);
+    for (uint8_t i = 1; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+    {
+        transmitter.setChannel(i, expectedChannel(i));
+    }
+
+    modulePort = &receiverPort;
+    moduleIntervalUs = (1000000.0 / packetRate) * (1.0 - MODULE_CLOCK_ERROR_PPM / 1e6);
+    moduleStartUs = micros();
+    arrivals.reserve(seconds * packetRate + 16);
+    receiver.setRcChannelsCallback(onReceiveRcChannels);
+
+    std::atomic<bool> receiving(true);
+    std::thread receiverThread([&]() {
+        while (receiving.load())
+        {
+            if (receiverPort.waitForData(10))
+            {
+                receiver.processFrames();
+            }
+            receiver.telemetryWriteBattery(1680.0F, 125.0F, 450, 80);
+            receiver.telemetryWriteAttitude(150, -300, 900);
+        }
+    });
+
+    printf("Transmitter at %u Hz, emulated module at %.3f Hz (%d ppm fast), corrections from %u s.\n", packetRate,
+           1000000.0 / moduleIntervalUs, MODULE_CLOCK_ERROR_PPM, seconds / 2);
+
+    const uint32_t startUs = micros();
+    uint32_t sweep = 0;
+    while (keepRunning && micros() - startUs < seconds * 1000000UL)
+    {
+        if (micros() - startUs >= seconds * 500000UL)
+        {
+            moduleCorrections = true;
+        }
+
+        const uint32_t waitUs = transmitter.getTimeUntilNextFrame();
+        struct pollfd pfd = {master, POLLIN, 0};
+        const struct timespec timeout = {0, (long)waitUs * 1000};
+        ppoll(&pfd, 1, &timeout, nullptr);
+
+        transmitter.setChannel(0, (uint16_t)(CRSF_RC_CHANNEL_MIN + sweep % (CRSF_RC_CHANNEL_MAX - CRSF_RC_CHANNEL_MIN)));
+        if (transmitter.update())
+        {
+            sweep++;
+        }
+    }
+
+    // Give the last frames time to arrive.
+    delay(50);
+    receiving = false;
+    receiverThread.join();
+
+    transmitterStatistics_t statistics;
+    transmitter.getStatistics(&statistics);
+
+    std::vector<double> offsets[2];
+    std::vector<double> intervals[2];
+    for (size_t i = 0; i < arrivals.size(); i++)
+    {
+        const int phase = arrivals[i].corrected ? 1 : 0;
+        if (phase == 1 && (firstCorrectionFrame == UINT32_MAX || i < firstCorrectionFrame + LOCK_SETTLE_FRAMES))
+        {
+            continue;
+        }
+
+        offsets[phase].push_back(arrivals[i].offsetUs);
+        if (i > 0 && arrivals[i - 1].corrected == arrivals[i].corrected)
+        {
+            intervals[phase].push_back((double)(uint32_t)(arrivals[i].timeUs - arrivals[i - 1].timeUs));
+        }
+    }
+
+    printf("\n%-24s %7s %10s %10s %10s %10s %10s %10s\n", "", "Frames", "|off| p50", "|off| p99", "|off| max", "Interval", "Jitter p50", "Jitter p99");
+    printStatistics("Free running", offsets[0], intervals[0]);
+    printStatistics("Phase locked", offsets[1], intervals[1]);
+    printf("(All in us. The offset is how far from %d us before the module's RF packet each frame arrived,\n the jitter is how far each interval between arrivals was from the mean.)\n\n", MODULE_ADVANCE_US);
+
+    printf("RC frames sent: %u, dropped: %u, late: %u, received: %zu, channel mismatches: %u\n", statistics.rcFramesSent,
+           statistics.rcFramesDropped, statistics.lateFrames, arrivals.size(), channelMismatches);
+    printf("Telemetry frames: %u (battery %u, attitude %u, timing corrections %u), CRC errors: %u, interval now %u us\n",
+           statistics.telemetryFrames, telemetryFrames[crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR],
+           telemetryFrames[crsfProtocol::CRSF_FRAMETYPE_ATTITUDE], statistics.timingCorrections, statistics.crcErrors,
+           transmitter.getIntervalUs());
+
+    transmitterTelemetry_t telemetry;
+    transmitter.getTelemetry(&telemetry);
+    const bool telemetryOk = telemetry.battery.voltage == 168 && telemetry.battery.current == 12 && telemetry.battery.capacity == 450 &&
+                             telemetry.battery.percent == 80;
+    printf("Battery telemetry decoded as %.1f V, %.1f A, %u mAh, %u%%: %s\n", telemetry.battery.voltage / 10.0,
+           telemetry.battery.current / 10.0, telemetry.battery.capacity, telemetry.battery.percent, telemetryOk ? "OK" : "MISMATCH");
+
+    receiver.end();
+    transmitter.end();
+    close(master);
+    close(slave);
+
+    const bool subsetOk = checkSubsetFrames(packetRate);
+    return channelMismatches == 0 && telemetryOk && statistics.timingCorrections > 0 && subsetOk ? 0 : 1;
+}
+
+static int drive(const char *device, uint32_t baudRate, uint16_t packetRate)
+{
+    hal::LinuxSerial port(device);
+    Transmitter transmitter(&port);
+    if (!transmitter.begin(baudRate, packetRate) || !port.isOpen())
+    {
+        fprintf(stderr, "Could not open %s\n", device);
+        return 1;
+    }
+
+    uint32_t lastPrint = millis();
+    while (keepRunning)
+    {
+        const uint32_t waitUs = transmitter.getTimeUntilNextFrame();
+        struct pollfd pfd = {port.getFileDescriptor(), POLLIN, 0};
+        const struct timespec timeout = {0, (long)waitUs * 1000};
+        ppoll(&pfd, 1, &timeout, nullptr);
+        transmitter.update();
+
+        if (millis() - lastPrint >= 1000)
+        {
+            lastPrint = millis();
+
+            transmitterStatistics_t statistics;
+            transmitterTelemetry_t telemetry;
+            transmitter.getStatistics(&statistics);
+            transmitter.getTelemetry(&telemetry);
+            printf("%s, interval %u us, offset %d us | sent %u, late %u | LQ %d%% RSSI -%d dBm | battery %.1f V | telemetry %u, CRC errors %u\n",
+                   transmitter.isSynchronised() ? "synchronised" : "free running", transmitter.getIntervalUs(),
+                   transmitter.getLastOffsetUs(), statistics.rcFramesSent, statistics.lateFrames, telemetry.linkStatistics.lqi,
+                   telemetry.linkStatistics.rssi, telemetry.battery.voltage / 10.0, statistics.telemetryFrames, statistics.crcErrors);
+        }
+    }
+
+    transmitter.end();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <tty device> [--baud n] [--rate hz]\n"
+               "       %s --loopback [seconds] [--rate hz]\n",
+               argv[0], argv[0]);
+        return 1;
+    }
+
+    uint32_t baudRate = crsfProtocol::BAUD_RATE;
+    uint16_t packetRate = TRANSMITTER_PACKET_RATE_DEFAULT;
+    uint32_t seconds = LOOPBACK_SECONDS;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc)
+        {
+            baudRate = (uint32_t)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+        {
+            packetRate = (uint16_t)atoi(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            seconds = (uint32_t)atoi(argv[i]);
+        }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (strcmp(argv[1], "--loopback") == 0)
+    {
+        return loopback(seconds > 1 ? seconds : 2, packetRate > 0 ? packetRate : TRANSMITTER_PACKET_RATE_DEFAULT);
+    }
+
+    return drive(argv[1], baudRate, packetRate);
+}
@@ -0,0 +1,322 @@
+/**
+ * @file main.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This example receives CRSF frames from a simulator over UDP, for software-in-the-loop testing on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Build (from the top level CRSFforArduino folder):
+g++ -std=gnu++17 -O2 -DCRC_OPTIMISATION_LEVEL=0 -Isrc $(find src -name '*.cpp') examples/linux_udp/main.cpp -o linux_udp -lutil -lpthread
+
+Usage:
+./linux_udp <local port> [remote port]   Receive CRSF frames on the local UDP port and send telemetry back
+                                         to the remote port (or to whoever sent the last frame).
+./linux_udp --benchmark                  Measure the datagram to callback latency and the sustained frame rate over loopback. */
+
+#include "SerialReceiver/SerialReceiver.hpp"
+#include "hal/UdpSerial/UdpSerial.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace serialReceiverLayer;
+
+#define BENCHMARK_LATENCY_FRAMES 2000
+#define BENCHMARK_LATENCY_RATE   1000
+#define BENCHMARK_WINDOW_FRAMES  256
+#define BENCHMARK_SECONDS        2
+
+static volatile bool keepRunning = true;
+
+static std::atomic<uint64_t> sendTimesNs[BENCHMARK_LATENCY_FRAMES];
+static std::vector<uint32_t> latenciesNs;
+static uint32_t lastSequence = UINT32_MAX;
+static std::atomic<uint32_t> linkStatisticsFrames(0);
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    keepRunning = false;
+}
+
+static uint64_t monotonicNanoseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static void onReceiveRcChannels(rcChannels_t *rcChannels)
+{
+    static unsigned long lastPrint = 0;
+    if (millis() - lastPrint >= 500)
+    {
+        lastPrint = millis();
+        printf("RC Channels <A: %u, E: %u, T: %u, R: %u> FailSafe: %s\n",
+               rcChannels->value[0], rcChannels->value[1], rcChannels->value[2], rcChannels->value[3],
+               rcChannels->failsafe ? "Active" : "Inactive");
+    }
+}
+
+/* The benchmark's callback. The simulator puts a sequence number into the first two channels,
+so the callback can look up when that frame's datagram was sent. */
+static void onBenchmarkRcChannels(rcChannels_t *rcChannels)
+{
+    const uint32_t sequence = rcChannels->value[0] | ((uint32_t)rcChannels->value[1] << 11);
+    if (sequence != lastSequence && sequence < BENCHMARK_LATENCY_FRAMES)
+    {
+        lastSequence = sequence;
+        latenciesNs.push_back((uint32_t)(monotonicNanoseconds() - sendTimesNs[sequence].load(std::memory_order_acquire)));
+    }
+}
+
+static void onBenchmarkLinkStatistics(link_statistics_t linkStatistics)
+{
+    (void)linkStatistics;
+    linkStatisticsFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+static size_t buildRcFrame(genericCrc::GenericCRC *crc, uint8_t *buffer, uint32_t sequence)
+{
+    crsfProtocol::frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame.frame.frameLength = crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame.frame.type = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+
+    crsfProtocol::rcChannelsPacked_t *channels = (crsfProtocol::rcChannelsPacked_t *)frame.frame.payload;
+    channels->channel0 = sequence & 0x7ff;
+    channels->channel1 = (sequence >> 11) & 0x7ff;
+    channels->channel2 = 172;
+    channels->channel3 = 992;
+    frame.frame.payload[crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE] =
+        crc->calculate(frame.frame.type, frame.frame.payload, crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE);
+
+    const size_t size = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+    memcpy(buffer, frame.raw, size);
+    return size;
+}
+
+static size_t buildLinkStatisticsFrame(genericCrc::GenericCRC *crc, uint8_t *buffer)
+{
+    crsfProtocol::frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.frame.deviceAddress = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame.frame.frameLength = crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame.frame.type = crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS;
+    frame.frame.payload[0] = 60;  // Uplink RSSI.
+    frame.frame.payload[2] = 100; // Uplink link quality.
+    frame.frame.payload[crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE] =
+        crc->calculate(frame.frame.type, frame.frame.payload, crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE);
+
+    const size_t size = frame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+    memcpy(buffer, frame.raw, size);
+    return size;
+}
+
+static int drainTelemetry(int fd)
+{
+    int datagrams = 0;
+    uint8_t telemetry[UDP_SERIAL_DATAGRAM_SIZE_MAX];
+    while (recv(fd, telemetry, sizeof(telemetry), MSG_DONTWAIT) > 0)
+    {
+        datagrams++;
+    }
+
+    return datagrams;
+}
+
+/* The simulator. First it sends one RC frame per datagram at a steady rate, to measure latency.
+Then it sends datagrams of four frames (RC, link statistics, RC, link statistics) as fast as the receiver keeps up. */
+static void simulate(uint16_t port, uint32_t *framesSentOut, uint32_t *telemetryReceived)
+{
+    const int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_in destination;
+    memset(&destination, 0, sizeof(destination));
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &destination.sin_addr);
+    connect(fd, (struct sockaddr *)&destination, sizeof(destination));
+
+    genericCrc::GenericCRC crc;
+    uint8_t datagram[4 * crsfProtocol::CRSF_FRAME_SIZE_MAX];
+
+    for (uint32_t i = 0; i < BENCHMARK_LATENCY_FRAMES && keepRunning; i++)
+    {
+        const size_t size = buildRcFrame(&crc, datagram, i);
+        sendTimesNs[i].store(monotonicNanoseconds(), std::memory_order_release);
+        send(fd, datagram, size, 0);
+        *telemetryReceived += drainTelemetry(fd);
+        delayMicroseconds(1000000 / BENCHMARK_LATENCY_RATE);
+    }
+
+    delay(100);
+
+    size_t size = buildRcFrame(&crc, datagram, BENCHMARK_LATENCY_FRAMES);
+    size += buildLinkStatisticsFrame(&crc, datagram + size);
+    size += buildRcFrame(&crc, datagram + size, BENCHMARK_LATENCY_FRAMES);
+    size += buildLinkStatisticsFrame(&crc, datagram + size);
+
+    const uint32_t linkStatisticsBefore = linkStatisticsFrames.load();
+    uint32_t framesSent = 0;
+    uint32_t framesWrittenOff = 0;
+    unsigned long stalledSince = 0;
+    const unsigned long start = millis();
+    while (millis() - start < BENCHMARK_SECONDS * 1000 && keepRunning)
+    {
+        /* Only run a little ahead of the receiver, so that the socket buffer never overflows.
+        If the receiver stops catching up, the missing frames were lost, so stop waiting for them. */
+        const uint32_t framesDecoded = (linkStatisticsFrames.load(std::memory_order_relaxed) - linkStatisticsBefore) * 2;
+        if (framesSent - framesWrittenOff - framesDecoded > BENCHMARK_WINDOW_FRAMES)
+        {
+            if (stalledSince == 0)
+            {
+                stalledSince = millis();
+            }
+            else if (millis() - stalledSince > 10)
+            {
+                framesWrittenOff = framesSent - framesDecoded;
+            }
+
+            delayMicroseconds(50);
+            continue;
+        }
+
+        stalledSince = 0;
+        if (send(fd, datagram, size, 0) == (ssize_t)size)
+        {
+            framesSent += 4;
+        }
+
+        *telemetryReceived += drainTelemetry(fd);
+    }
+
+    delay(100);
+    *telemetryReceived += drainTelemetry(fd);
+    *framesSentOut = framesSent;
+    close(fd);
+    keepRunning = false;
+}
+
+static int benchmark()
+{
+    hal::UdpSerial udp(0);
+    SerialReceiver receiver(&udp);
+    if (!receiver.begin() || !udp.isOpen())
+    {
+        printf("Unable to open the UDP socket.\n");
+        return 1;
+    }
+
+    latenciesNs.reserve(BENCHMARK_LATENCY_FRAMES);
+    receiver.setRcChannelsCallback(onBenchmarkRcChannels);
+    receiver.setLinkStatisticsCallback(onBenchmarkLinkStatistics);
+
+    uint32_t framesSent = 0;
+    uint32_t telemetryReceived = 0;
+    std::thread simulator(simulate, udp.getLocalPort(), &framesSent, &telemetryReceived);
+
+    uint64_t throughputStart = 0;
+    uint32_t linkStatisticsStart = 0;
+    while (keepRunning)
+    {
+        if (udp.waitForData(100))
+        {
+            receiver.processFrames();
+        }
+
+        if (throughputStart == 0 && linkStatisticsFrames.load() > 0)
+        {
+            throughputStart = monotonicNanoseconds();
+            linkStatisticsStart = linkStatisticsFrames.load();
+        }
+    }
+
+    const double throughputSeconds = (monotonicNanoseconds() - throughputStart) / 1.0e9;
+    simulator.join();
+
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    const size_t count = latenciesNs.size();
+    if (count > 0)
+    {
+        printf("Latency, datagram sent to RC channels callback, %zu of %u frames at %u Hz:\n", count, BENCHMARK_LATENCY_FRAMES, BENCHMARK_LATENCY_RATE);
+        printf("    p50 %.1f us, p99 %.1f us, max %.1f us\n",
+               latenciesNs[count / 2] / 1000.0, latenciesNs[(count * 99) / 100] / 1000.0, latenciesNs[count - 1] / 1000.0);
+    }
+
+    const uint32_t frames = (linkStatisticsFrames.load() - linkStatisticsStart) * 2;
+    printf("Sustained rate, four frames per datagram: %u of %u frames in %.2f s, %.0f frames/s\n", frames, framesSent, throughputSeconds, frames / throughputSeconds);
+
+    hal::udpSerialStatistics_t statistics;
+    udp.getStatistics(&statistics);
+    printf("Datagrams received: %u, telemetry datagrams sent: %u, received by the simulator: %u\n",
+           statistics.datagramsReceived, statistics.datagramsSent, telemetryReceived);
+
+    receiver.end();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0)
+    {
+        return benchmark();
+    }
+
+    if (argc < 2)
+    {
+        printf("Usage: %s <local port> [remote port] | --benchmark\n", argv[0]);
+        return 1;
+    }
+
+    hal::UdpSerial udp((uint16_t)atoi(argv[1]), argc >= 3 ? (uint16_t)atoi(argv[2]) : 0);
+    SerialReceiver receiver(&udp);
+    if (!receiver.begin() || !udp.isOpen())
+    {
+        printf("Unable to open UDP port %s.\n", argv[1]);
+        return 1;
+    }
+
+    receiver.setRcChannelsCallback(onReceiveRcChannels);
+
+    while (keepRunning)
+    {
+        if (udp.waitForData(100))
+        {
+            receiver.processFrames();
+        }
+    }
+
+    receiver.end();
+    return 0;
+}
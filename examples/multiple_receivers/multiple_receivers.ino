@@ -0,0 +1,128 @@
+/**
+ * @file multiple_receivers.ino
+ * @author CRSF for Arduino contributors
+ * @brief Example of how to run two differently configured receivers in the same sketch.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This example is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/* The main receiver on Serial1 uses the options in CFA_Config.hpp, including telemetry.
+A second, RC only receiver on Serial2 (eg a backup link) leaves out telemetry and link statistics,
+so none of that code or RAM is spent on it. Without link statistics, its failsafe flag stays false while RC channels arrive.
+Your board needs two spare hardware serial ports for this example. */
+
+#include "CRSFforArduino.hpp"
+
+struct RcOnlyConfig : crsfForArduinoConfig::DefaultConfig
+{
+    static constexpr bool telemetryEnabled = false;
+    static constexpr bool linkStatisticsEnabled = false;
+};
+
+serialReceiverLayer::SerialReceiver mainReceiver(&Serial1);
+serialReceiverLayer::BasicSerialReceiver<RcOnlyConfig> backupReceiver(&Serial2);
+
+void onReceiveMainRcChannels(serialReceiverLayer::rcChannels_t *rcChannels);
+void onReceiveBackupRcChannels(serialReceiverLayer::rcChannels_t *rcChannels);
+
+void setup()
+{
+    // Initialise the serial port & wait for the port to open.
+    Serial.begin(115200);
+    while (!Serial)
+    {
+        ;
+    }
+
+    // Initialise both receivers.
+    if (!mainReceiver.begin() || !backupReceiver.begin())
+    {
+        Serial.println("CRSF for Arduino initialisation failed!");
+        while (1)
+        {
+            delay(10);
+        }
+    }
+
+    mainReceiver.setRcChannelsCallback(onReceiveMainRcChannels);
+    backupReceiver.setRcChannelsCallback(onReceiveBackupRcChannels);
+
+    // Show the user that the sketch is ready.
+    Serial.println("Multiple Receivers Example");
+    delay(1000);
+    Serial.println("Ready");
+    delay(1000);
+}
+
+void loop()
+{
+    mainReceiver.processFrames();
+    backupReceiver.processFrames();
+
+    // The main receiver also sends telemetry back to the transmitter. Battery voltage is in mV * 100.
+    mainReceiver.telemetryWriteBattery(370.0F, 0.0F, 0, 100);
+}
+
+void onReceiveMainRcChannels(serialReceiverLayer::rcChannels_t *rcChannels)
+{
+    if (rcChannels->failsafe == false)
+    {
+        /* Print the throttle channel every 100 ms. */
+        unsigned long thisTime = millis();
+        static unsigned long lastTime = millis();
+
+        /* Compensate for millis() overflow. */
+        if (thisTime < lastTime)
+        {
+            lastTime = thisTime;
+        }
+
+        if (thisTime - lastTime >= 100)
+        {
+            lastTime = thisTime;
+            Serial.print("Main Throttle: ");
+            Serial.println(mainReceiver.rcToUs(rcChannels->value[crsfProtocol::RC_CHANNEL_THROTTLE]));
+        }
+    }
+}
+
+void onReceiveBackupRcChannels(serialReceiverLayer::rcChannels_t *rcChannels)
+{
+    if (rcChannels->failsafe == false)
+    {
+        /* Print the throttle channel every 100 ms. */
+        unsigned long thisTime = millis();
+        static unsigned long lastTime = millis();
+
+        /* Compensate for millis() overflow. */
+        if (thisTime < lastTime)
+        {
+            lastTime = thisTime;
+        }
+
+        if (thisTime - lastTime >= 100)
+        {
+            lastTime = thisTime;
+            Serial.print("Backup Throttle: ");
+            Serial.println(backupReceiver.rcToUs(rcChannels->value[crsfProtocol::RC_CHANNEL_THROTTLE]));
+        }
+    }
+}
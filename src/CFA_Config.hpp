@@ -26,7 +26,11 @@
 
 #pragma once
 
+#if defined(ARDUINO)
 #include "Arduino.h"
+#elif defined(__linux__)
+#include "hal/LinuxCompat/LinuxCompat.hpp"
+#endif
 
 /* The following defines are used to configure CRSF for Arduino.
 You can change these values to suit your needs. */
@@ -84,7 +88,12 @@ information back to your controller. */
 - TELEMETRY_BATTERY_ENABLED: Enables or disables battery telemetry output.
 - TELEMETRY_FLIGHTMODE_ENABLED: Enables or disables flight mode telemetry output.
 - TELEMETRY_GPS_ENABLED: Enables or disables GPS telemetry output.
-- TELEMETRY_SIMULATE_ARBITRARY_VALUES: When enabled, arbitrary values are sent for telemetry. */
+- TELEMETRY_SIMULATE_ARBITRARY_VALUES: When enabled, arbitrary values are sent for telemetry.
+- TELEMETRY_DEVICE_INFO_ENABLED: Answers device pings from the handset with a device info frame,
+  so that the flight controller shows up in the handset's device list (eg the ExpressLRS or TBS Agent Lua scripts).
+  This is off by default, because the answers go out on the wire and the frame takes RAM. Set it to 1 here (or build with
+  -DCRSF_TELEMETRY_DEVICE_INFO_ENABLED=1, or set telemetryDeviceInfoEnabled in your own configuration) to turn it on.
+- TELEMETRY_DEVICE_NAME: The name that the handset shows for the flight controller, until setDeviceInfo() gives it another. */
 #define CRSF_TELEMETRY_ENABLED 1
 
 #define CRSF_TELEMETRY_ATTITUDE_ENABLED     1
@@ -97,8 +106,148 @@ information back to your controller. */
 
 #define CRSF_TELEMETRY_GPS_ENABLED 1
 
+#ifndef CRSF_TELEMETRY_DEVICE_INFO_ENABLED
+#define CRSF_TELEMETRY_DEVICE_INFO_ENABLED 0
+#endif
+
+#ifndef CRSF_TELEMETRY_DEVICE_NAME
+#define CRSF_TELEMETRY_DEVICE_NAME "CRSF for Arduino"
+#endif
+
 #define CRSF_LINK_STATISTICS_ENABLED 1
 
+/* Health Counters
+- CRSF_HEALTH_COUNTERS_ENABLED: Counts received bytes and frames, CRC and length errors, timeouts, flushed bytes,
+  telemetry frames sent and dropped, and callback invocations. Read them with getCounters().
+  Each counter is a plain increment, so they cost next to nothing and can be left on in the field. */
+#ifndef CRSF_HEALTH_COUNTERS_ENABLED
+#define CRSF_HEALTH_COUNTERS_ENABLED 1
+#endif
+
+/* Trace Options
+- CRSF_TRACE_ENABLED: Records a timestamped event for each frame start, decoded frame, CRC error, resync,
+  callback and telemetry frame into a ring buffer. Take a binary dump of it with dumpTrace().
+  The linux_trace example turns a dump into a timeline that chrome://tracing or Perfetto can show.
+- CRSF_TRACE_EVENT_COUNT: The number of events that the ring holds. Each event takes 8 bytes of RAM.
+  This must be a power of two. */
+#ifndef CRSF_TRACE_ENABLED
+#define CRSF_TRACE_ENABLED 0
+#endif
+
+#ifndef CRSF_TRACE_EVENT_COUNT
+#define CRSF_TRACE_EVENT_COUNT 256
+#endif
+
+/* Blackbox Options
+- CRSF_BLACKBOX_ENABLED: Lets the Serial Receiver pass every RC channels frame and every change in link statistics
+  to a BlackboxLogger (see setBlackbox()), which writes them to your storage in a few bytes per frame. */
+#ifndef CRSF_BLACKBOX_ENABLED
+#define CRSF_BLACKBOX_ENABLED 0
+#endif
+
+/* Parameter Options
+- CRSF_PARAMETERS_ENABLED: Lets the handset read and change your settings in its device menu, through a ParameterServer
+  (see setParameterServer()). This needs CRSF_TELEMETRY_ENABLED, because the entries go back to the handset as telemetry,
+  and CRSF_TELEMETRY_DEVICE_INFO_ENABLED, because the handset finds the parameters through the device info. */
+#ifndef CRSF_PARAMETERS_ENABLED
+#define CRSF_PARAMETERS_ENABLED 0
+#endif
+
+/* Command Options
+- CRSF_COMMANDS_ENABLED: Lets the Serial Receiver take command frames that are addressed to the flight controller,
+  check their inner CRC, and answer the ones that need an answer (eg the receiver's baud rate proposals).
+  It also lets you send commands, such as bindReceiver(). Commands go out in telemetry slots, so sending needs CRSF_TELEMETRY_ENABLED.
+  This is off by default, because it answers on the wire and its buffers take RAM. Set it to 1 here (or build with
+  -DCRSF_COMMANDS_ENABLED=1, or set commandsEnabled in your own configuration) to turn it on. */
+#ifndef CRSF_COMMANDS_ENABLED
+#define CRSF_COMMANDS_ENABLED 0
+#endif
+
+/* Baud Rate Options
+- CRSF_BAUD_RATE_NEGOTIATION_ENABLED: Lets the receiver move the link to a faster baud rate than 420000, with a speed proposal.
+  The Serial Receiver accepts the proposal, switches its UART over once the answer has gone out, and goes back to 420000 baud
+  if no RC channels or link statistics arrive for CRSF_BAUD_RATE_FALLBACK_TIMEOUT (ie the link broke, or the receiver never switched).
+  This needs CRSF_COMMANDS_ENABLED and CRSF_TELEMETRY_ENABLED. Your UART must be able to run at the rates that you accept.
+- CRSF_BAUD_RATE_MAX: The fastest baud rate that is accepted. A speed proposal callback (see setSpeedProposalCallback()) can be pickier.
+- CRSF_BAUD_RATE_FALLBACK_TIMEOUT: How long to go without RC channels or link statistics at a negotiated baud rate before falling back,
+  in milliseconds. */
+#ifndef CRSF_BAUD_RATE_NEGOTIATION_ENABLED
+#define CRSF_BAUD_RATE_NEGOTIATION_ENABLED 0
+#endif
+
+#ifndef CRSF_BAUD_RATE_MAX
+#define CRSF_BAUD_RATE_MAX 2000000
+#endif
+
+#ifndef CRSF_BAUD_RATE_FALLBACK_TIMEOUT
+#define CRSF_BAUD_RATE_FALLBACK_TIMEOUT 500
+#endif
+
+/* Half Duplex Options
+- CRSF_HALF_DUPLEX_ENABLED: For receivers that share one wire for both directions (eg a single-wire UART, or TX and RX tied together).
+  Telemetry only goes out in the idle gap that follows an RC channels frame, and only if nothing else is already arriving
+  and the whole frame fits before the receiver's next burst of frames is due, one RC period after the last one started.
+  Frames that cannot fit are dropped.
+- CRSF_HALF_DUPLEX_TURNAROUND: How long the line takes to change direction, in microseconds.
+  This is allowed for both before and after each telemetry frame.
+- CRSF_HALF_DUPLEX_ECHO: Set this to 1 if your wiring hands every byte that you send back to your UART's receiver.
+  Those bytes are dropped before they reach the decoder. An echo that does not match what was sent means that another
+  device was transmitting at the same time, and is counted as a collision. Set this to 0 if your UART leaves its
+  receiver off while it transmits. */
+#ifndef CRSF_HALF_DUPLEX_ENABLED
+#define CRSF_HALF_DUPLEX_ENABLED 0
+#endif
+
+#ifndef CRSF_HALF_DUPLEX_TURNAROUND
+#define CRSF_HALF_DUPLEX_TURNAROUND 20
+#endif
+
+#ifndef CRSF_HALF_DUPLEX_ECHO
+#define CRSF_HALF_DUPLEX_ECHO 1
+#endif
+
+/* DisplayPort Options
+- CRSF_DISPLAYPORT_ENABLED: Lets the Serial Receiver send a DisplayPort's screen to the handset's canvas (see setDisplayPort()).
+  Only the rows that changed go out, in telemetry slots, as often as the byte budget allows. This needs CRSF_TELEMETRY_ENABLED.
+- CRSF_DISPLAYPORT_BYTE_RATE: How many bytes per second DisplayPort frames may take from the downlink, by default.
+  The downlink only carries a few hundred bytes per second, and the rest of your telemetry needs its share. */
+#ifndef CRSF_DISPLAYPORT_ENABLED
+#define CRSF_DISPLAYPORT_ENABLED 0
+#endif
+
+#ifndef CRSF_DISPLAYPORT_BYTE_RATE
+#define CRSF_DISPLAYPORT_BYTE_RATE 300
+#endif
+
+/* Frame Router Options
+- CRSF_FRAME_ROUTER_ENABLED: Lets the decoder hand every frame with a valid CRC to a FrameRouter (see setFrameRouter()),
+  which passes it on to each FrameSink whose route matches the frame's type and address.
+- CRSF_FRAME_ROUTER_ROUTE_COUNT: The number of routes that a FrameRouter holds. Each route takes 8 bytes of RAM on a 32 bit MCU,
+  and the router takes another 256 * (CRSF_FRAME_ROUTER_ROUTE_COUNT / 8) bytes for its table of routes by frame type.
+  This must be 8, 16 or 32. */
+#ifndef CRSF_FRAME_ROUTER_ENABLED
+#define CRSF_FRAME_ROUTER_ENABLED 0
+#endif
+
+#ifndef CRSF_FRAME_ROUTER_ROUTE_COUNT
+#define CRSF_FRAME_ROUTER_ROUTE_COUNT 8
+#endif
+
+/* Performance Options
+- CRSF_INLINE_HOT_PATH: When enabled, the receive hot path (CRSF::receiveFrames(), the CRC8 calculation and the
+  SerialBuffer writers) is declared inline in the headers, instead of being compiled once into its source files.
+  This lets the compiler inline the whole per-byte decode loop into SerialReceiver::processFrames(),
+  even when link time optimisation is turned off (as it is in many Arduino cores). It costs some extra flash. */
+#ifndef CRSF_INLINE_HOT_PATH
+#define CRSF_INLINE_HOT_PATH 0
+#endif
+
+#if CRSF_INLINE_HOT_PATH > 0
+#define CRSF_HOT_PATH inline
+#else
+#define CRSF_HOT_PATH
+#endif
+
 /* Debug Options
 - DEBUG_ENABLED: Enables or disables debug output over the selected serial port.
 - CRSF_DEBUG_SERIAL_PORT: The serial port to use for debug output. Usually the native USB port.
@@ -125,4 +274,65 @@ Better to use CRSF_TELEMETRY_ENABLED instead. */
     static_assert(false, "All telemetry options are disabled. Set CRSF_TELEMETRY_ENABLED to 0 to disable telemetry instead.");
 #endif
 
+/* Compile-time configuration
+The options above are the defaults for every receiver. To give one receiver its own options,
+derive a configuration from DefaultConfig, override the options that you want to change and
+pass it to BasicSerialReceiver (or BasicCRSF and BasicTelemetry). For example:
+
+    struct RcOnlyConfig : crsfForArduinoConfig::DefaultConfig
+    {
+        static constexpr bool telemetryEnabled = false;
+        static constexpr bool linkStatisticsEnabled = false;
+    };
+
+    serialReceiverLayer::BasicSerialReceiver<RcOnlyConfig> rcOnlyReceiver(&Serial2);
+
+Features that a configuration disables are removed at compile time, so each receiver only pays for what it uses.
+Several differently configured receivers can live in the same firmware. */
+    struct DefaultConfig
+    {
+        static constexpr bool rcEnabled = CRSF_RC_ENABLED > 0;
+        static constexpr bool flightModesEnabled = CRSF_FLIGHTMODES_ENABLED > 0;
+        static constexpr bool linkStatisticsEnabled = CRSF_LINK_STATISTICS_ENABLED > 0;
+
+        static constexpr bool telemetryEnabled = CRSF_TELEMETRY_ENABLED > 0;
+        static constexpr bool telemetryAttitudeEnabled = CRSF_TELEMETRY_ATTITUDE_ENABLED > 0;
+        static constexpr bool telemetryBaroAltitudeEnabled = CRSF_TELEMETRY_BAROALTITUDE_ENABLED > 0;
+        static constexpr bool telemetryBatteryEnabled = CRSF_TELEMETRY_BATTERY_ENABLED > 0;
+        static constexpr bool telemetryFlightModeEnabled = CRSF_TELEMETRY_FLIGHTMODE_ENABLED > 0;
+        static constexpr bool telemetryGpsEnabled = CRSF_TELEMETRY_GPS_ENABLED > 0;
+        static constexpr bool telemetryDeviceInfoEnabled = CRSF_TELEMETRY_DEVICE_INFO_ENABLED > 0;
+
+        static constexpr bool healthCountersEnabled = CRSF_HEALTH_COUNTERS_ENABLED > 0;
+
+        static constexpr bool traceEnabled = CRSF_TRACE_ENABLED > 0;
+        static constexpr uint16_t traceEventCount = CRSF_TRACE_EVENT_COUNT;
+
+        static constexpr bool blackboxEnabled = CRSF_BLACKBOX_ENABLED > 0;
+
+        static constexpr bool frameRouterEnabled = CRSF_FRAME_ROUTER_ENABLED > 0;
+
+        static constexpr bool parametersEnabled = CRSF_PARAMETERS_ENABLED > 0;
+
+        static constexpr bool commandsEnabled = CRSF_COMMANDS_ENABLED > 0;
+
+        static constexpr bool baudRateNegotiationEnabled = CRSF_BAUD_RATE_NEGOTIATION_ENABLED > 0;
+        static constexpr uint32_t baudRateMax = CRSF_BAUD_RATE_MAX;
+        static constexpr uint32_t baudRateFallbackTimeout = CRSF_BAUD_RATE_FALLBACK_TIMEOUT;
+
+        static constexpr bool halfDuplexEnabled = CRSF_HALF_DUPLEX_ENABLED > 0;
+        static constexpr uint32_t halfDuplexTurnaround = CRSF_HALF_DUPLEX_TURNAROUND;
+        static constexpr bool halfDuplexEcho = CRSF_HALF_DUPLEX_ECHO > 0;
+
+        static constexpr bool displayPortEnabled = CRSF_DISPLAYPORT_ENABLED > 0;
+    };
+
+/* Tests a configuration option. C++17 compilers discard the disabled branch outright.
+Older compilers (many Arduino cores still use gnu++11) see a constant condition and optimise the branch away. */
+#if __cplusplus >= 201703L
+#define CRSF_IF_CONSTEXPR(option) if constexpr (option)
+#else
+#define CRSF_IF_CONSTEXPR(option) if (option)
+#endif
+
 }; // namespace crsfForArduinoConfig
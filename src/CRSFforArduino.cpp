@@ -26,7 +26,6 @@
  */
 
 #include "CRSFforArduino.hpp"
-#include "Arduino.h"
 
 namespace sketchLayer
 {
@@ -34,28 +33,30 @@ namespace sketchLayer
      * @brief Construct a new CRSFforArduino object.
      * 
      */
-    CRSFforArduino::CRSFforArduino()
+    CRSFforArduino::CRSFforArduino() :
+        _serialReceiver()
     {
-#if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        _serialReceiver = new SerialReceiver();
-#endif
     }
 
     /**
-     * @brief Construct a new CRSFforArduino object with the specified RX and TX pins.
+     * @brief Construct a new CRSFforArduino object that reads from the specified serial port.
      * 
-     * @param rxPin 
-     * @param txPin 
+     * @param serialPort The serial port to read CRSF frames from.
      */
-    CRSFforArduino::CRSFforArduino(HardwareSerial *serialPort)
+    CRSFforArduino::CRSFforArduino(HardwareSerial *serialPort) :
+        _serialReceiver(serialPort)
+    {
+    }
+
+    /**
+     * @brief Construct a new CRSFforArduino object that reads from any transport,
+     * such as USB CDC or a PIO UART wrapped in a hal::StreamTransport.
+     *
+     * @param transport The transport to read CRSF frames from. It is not deleted by CRSF for Arduino.
+     */
+    CRSFforArduino::CRSFforArduino(hal::SerialTransport *transport) :
+        _serialReceiver(transport)
     {
-#if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        _serialReceiver = new SerialReceiver(serialPort);
-#else
-        // Prevent compiler warnings
-        (void)rxPin;
-        (void)txPin;
-#endif
     }
 
     /**
@@ -64,9 +65,6 @@ namespace sketchLayer
      */
     CRSFforArduino::~CRSFforArduino()
     {
-#if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        delete _serialReceiver;
-#endif
     }
 
     /**
@@ -77,7 +75,7 @@ namespace sketchLayer
     bool CRSFforArduino::begin()
     {
 #if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        return _serialReceiver->begin();
+        return _serialReceiver.begin();
 #else
         // Return false if RC is disabled
         return false;
@@ -91,7 +89,7 @@ namespace sketchLayer
     void CRSFforArduino::end()
     {
 #if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        _serialReceiver->end();
+        _serialReceiver.end();
 #endif
     }
 
@@ -103,14 +101,53 @@ namespace sketchLayer
     void CRSFforArduino::update()
     {
 #if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        _serialReceiver->processFrames();
+        _serialReceiver.processFrames();
 #endif
 
 #if CRSF_RC_ENABLED > 0 && CRSF_FLIGHTMODES_ENABLED > 0
-        _serialReceiver->handleFlightMode();
+        _serialReceiver.handleFlightMode();
 #endif
     }
 
+    /**
+     * @brief Takes a snapshot of the receiver's health counters (bytes and frames received, CRC errors, timeouts, etc).
+     * These help to find out why frames go missing.
+     *
+     * @param counters Where to copy the counters to.
+     */
+    void CRSFforArduino::getCounters(serialReceiverLayer::serialReceiverCounters_t *counters)
+    {
+        _serialReceiver.getCounters(counters);
+    }
+
+    /**
+     * @brief Sets all of the health counters back to zero.
+     */
+    void CRSFforArduino::resetCounters()
+    {
+        _serialReceiver.resetCounters();
+    }
+
+    /**
+     * @brief Returns the size of the buffer that dumpTrace() needs. This is 0 unless CRSF_TRACE_ENABLED is set.
+     */
+    size_t CRSFforArduino::getTraceDumpSize()
+    {
+        return _serialReceiver.getTraceDumpSize();
+    }
+
+    /**
+     * @brief Writes a binary dump of the most recent receiver events into buffer.
+     *
+     * @param buffer Where to write the dump to.
+     * @param size The size of buffer. Use getTraceDumpSize() to get a size that holds every event.
+     * @return The number of bytes written.
+     */
+    size_t CRSFforArduino::dumpTrace(uint8_t *buffer, size_t size)
+    {
+        return _serialReceiver.dumpTrace(buffer, size);
+    }
+
     /**
      * @brief Reads the specified RC channel.
      * @param channel The channel to read.
@@ -121,7 +158,7 @@ namespace sketchLayer
     [[deprecated("Use RC channel callback instead")]] uint16_t CRSFforArduino::readRcChannel(uint8_t channel, bool raw)
     {
 #if CRSF_RC_ENABLED > 0
-        return _serialReceiver->readRcChannel(channel - 1, raw);
+        return _serialReceiver.readRcChannel(channel - 1, raw);
 #else
         // Prevent compiler warnings
         (void)channel;
@@ -141,7 +178,7 @@ namespace sketchLayer
     [[deprecated("Use RC channel callback instead")]] uint16_t CRSFforArduino::getChannel(uint8_t channel)
     {
 #if CRSF_RC_ENABLED > 0
-        return _serialReceiver->getChannel(channel - 1);
+        return _serialReceiver.getChannel(channel - 1);
 #else
         // Prevent compiler warnings
         (void)channel;
@@ -160,7 +197,7 @@ namespace sketchLayer
     uint16_t CRSFforArduino::rcToUs(uint16_t rc)
     {
 #if CRSF_RC_ENABLED > 0
-        return _serialReceiver->rcToUs(rc);
+        return _serialReceiver.rcToUs(rc);
 #else
         // Prevent compiler warnings
         (void)rc;
@@ -173,7 +210,7 @@ namespace sketchLayer
     void CRSFforArduino::setRcChannelsCallback(void (*callback)(serialReceiverLayer::rcChannels_t *rcChannels))
     {
 #if CRSF_RC_ENABLED > 0
-        _serialReceiver->setRcChannelsCallback(callback);
+        _serialReceiver.setRcChannelsCallback(callback);
 #else
         // Prevent compiler warnings
         (void)callback;
@@ -183,7 +220,7 @@ namespace sketchLayer
     void CRSFforArduino::setLinkStatisticsCallback(void (*callback)(serialReceiverLayer::link_statistics_t linkStatistics))
     {
 #if CRSF_LINK_STATISTICS_ENABLED > 0
-        _serialReceiver->setLinkStatisticsCallback(callback);
+        _serialReceiver.setLinkStatisticsCallback(callback);
 #else
         // Prevent compiler warnings
         (void)callback;
@@ -202,7 +239,7 @@ namespace sketchLayer
     bool CRSFforArduino::setFlightMode(serialReceiverLayer::flightModeId_t flightMode, uint8_t channel, uint16_t min, uint16_t max)
     {
 #if CRSF_RC_ENABLED > 0 && CRSF_FLIGHTMODES_ENABLED > 0
-        return _serialReceiver->setFlightMode(flightMode, channel - 1, _serialReceiver->usToRc(min), _serialReceiver->usToRc(max));
+        return _serialReceiver.setFlightMode(flightMode, channel - 1, _serialReceiver.usToRc(min), _serialReceiver.usToRc(max));
 #else
         // Prevent compiler warnings
         (void)flightMode;
@@ -223,7 +260,7 @@ namespace sketchLayer
     void CRSFforArduino::setFlightModeCallback(void (*callback)(serialReceiverLayer::flightModeId_t flightMode))
     {
 #if CRSF_RC_ENABLED > 0 && CRSF_FLIGHTMODES_ENABLED > 0
-        _serialReceiver->setFlightModeCallback(callback);
+        _serialReceiver.setFlightModeCallback(callback);
 #else
         // Prevent compiler warnings
         (void)callback;
@@ -240,7 +277,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteAttitude(int16_t roll, int16_t pitch, int16_t yaw)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_ATTITUDE_ENABLED > 0
-        _serialReceiver->telemetryWriteAttitude(roll, pitch, yaw);
+        _serialReceiver.telemetryWriteAttitude(roll, pitch, yaw);
 #else
         // Prevent compiler warnings
         (void)roll;
@@ -258,7 +295,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteBaroAltitude(uint16_t altitude, int16_t vario)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_BAROALTITUDE_ENABLED > 0
-        _serialReceiver->telemetryWriteBaroAltitude(altitude, vario);
+        _serialReceiver.telemetryWriteBaroAltitude(altitude, vario);
 #else
         // Prevent compiler warnings
         (void)altitude;
@@ -277,7 +314,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteBattery(float voltage, float current, uint32_t fuel, uint8_t percent)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_BATTERY_ENABLED > 0
-        _serialReceiver->telemetryWriteBattery(voltage, current, fuel, percent);
+        _serialReceiver.telemetryWriteBattery(voltage, current, fuel, percent);
 #else
         // Prevent compiler warnings
         (void)voltage;
@@ -295,7 +332,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteFlightMode(serialReceiverLayer::flightModeId_t flightMode)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_FLIGHTMODE_ENABLED > 0
-        _serialReceiver->telemetryWriteFlightMode(flightMode);
+        _serialReceiver.telemetryWriteFlightMode(flightMode);
 #else
         // Prevent compiler warnings
         (void)flightMode;
@@ -310,7 +347,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteCustomFlightMode(const char *flightMode, bool armed)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_FLIGHTMODE_ENABLED > 0
-        _serialReceiver->telemetryWriteCustomFlightMode(flightMode, armed);
+        _serialReceiver.telemetryWriteCustomFlightMode(flightMode, armed);
 #else
         // Prevent compiler warnings
         (void)flightMode;
@@ -330,7 +367,7 @@ namespace sketchLayer
     void CRSFforArduino::telemetryWriteGPS(float latitude, float longitude, float altitude, float speed, float groundCourse, uint8_t satellites)
     {
 #if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_GPS_ENABLED > 0
-        _serialReceiver->telemetryWriteGPS(latitude, longitude, altitude, speed, groundCourse, satellites);
+        _serialReceiver.telemetryWriteGPS(latitude, longitude, altitude, speed, groundCourse, satellites);
 #else
         // Prevent compiler warnings
         (void)latitude;
@@ -339,6 +376,40 @@ namespace sketchLayer
         (void)speed;
         (void)groundCourse;
         (void)satellites;
+#endif
+    }
+
+    /**
+     * @brief Sets the name that your handset shows for this device in its device list.
+     * The device answers the handset's device pings on its own. This only changes what it says.
+     *
+     * @param name Up to 43 characters.
+     * @param serialNumber Your own serial number, if you have one.
+     * @param hardwareVersion Your own hardware version, if you have one.
+     */
+    void CRSFforArduino::setDeviceInfo(const char *name, uint32_t serialNumber, uint32_t hardwareVersion)
+    {
+#if CRSF_TELEMETRY_ENABLED > 0 && CRSF_TELEMETRY_DEVICE_INFO_ENABLED > 0
+        _serialReceiver.setDeviceInfo(name, serialNumber, hardwareVersion);
+#else
+        // Prevent compiler warnings
+        (void)name;
+        (void)serialNumber;
+        (void)hardwareVersion;
+#endif
+    }
+
+    /**
+     * @brief Puts your receiver into bind mode, without having to reach its bind button.
+     *
+     * @return true if the bind command is on its way to the receiver.
+     */
+    bool CRSFforArduino::bindReceiver()
+    {
+#if CRSF_TELEMETRY_ENABLED > 0 && CRSF_COMMANDS_ENABLED > 0
+        return _serialReceiver.bindReceiver();
+#else
+        return false;
 #endif
     }
 } // namespace sketchLayer
@@ -27,21 +27,32 @@
 
 #pragma once
 
-#include "Arduino.h"
+#include "CFA_Config.hpp"
 #include "SerialReceiver/SerialReceiver.hpp"
+#include "SerialReceiver/Bridge/Bridge.hpp"
+#include "SerialReceiver/Transmitter/Transmitter.hpp"
 
 namespace sketchLayer
 {
-    class CRSFforArduino : private serialReceiverLayer::SerialReceiver
+    class CRSFforArduino final
     {
       public:
         CRSFforArduino();
         CRSFforArduino(HardwareSerial *serialPort);
+        CRSFforArduino(hal::SerialTransport *transport);
         ~CRSFforArduino();
         bool begin();
         void end();
         void update();
 
+        // Health counter functions.
+        void getCounters(serialReceiverLayer::serialReceiverCounters_t *counters);
+        void resetCounters();
+
+        // Trace functions.
+        size_t getTraceDumpSize();
+        size_t dumpTrace(uint8_t *buffer, size_t size);
+
         // RC channel functions.
         uint16_t getChannel(uint8_t channel);
         uint16_t rcToUs(uint16_t rc);
@@ -62,9 +73,11 @@ namespace sketchLayer
         void telemetryWriteFlightMode(serialReceiverLayer::flightModeId_t flightMode);
         void telemetryWriteCustomFlightMode(const char *flightMode, bool armed = false);
         void telemetryWriteGPS(float latitude, float longitude, float altitude, float speed, float groundCourse, uint8_t satellites);
+        void setDeviceInfo(const char *name, uint32_t serialNumber = 0, uint32_t hardwareVersion = 0);
+        bool bindReceiver();
 
       private:
-        SerialReceiver *_serialReceiver;
+        serialReceiverLayer::SerialReceiver _serialReceiver;
     };
 } // namespace sketchLayer
 
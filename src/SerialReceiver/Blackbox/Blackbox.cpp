@@ -0,0 +1,218 @@
+/**
+ * @file Blackbox.cpp
+ * @author CRSF for Arduino contributors
+ * @brief A compact, delta encoded flight log of RC channels and link statistics.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Blackbox.hpp"
+
+namespace serialReceiverLayer
+{
+    BlackboxLogger::BlackboxLogger()
+    {
+        _sink = nullptr;
+        _keyframeInterval = BLACKBOX_KEYFRAME_INTERVAL;
+        _recordsSinceKeyframe = 0;
+        _keyframeDue = true;
+        _linkStatisticsDue = true;
+        _lastTimestamp = 0;
+        memset(_lastChannels, 0, sizeof(_lastChannels));
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    BlackboxLogger::~BlackboxLogger()
+    {
+    }
+
+    /**
+     * @brief Starts a new log and writes its header to sink.
+     *
+     * @param sink Where the log goes. It must outlive the logger, or end() must be called first.
+     * @param keyframeInterval Channel records between keyframes. Fewer keyframes give a smaller log,
+     * more keyframes lose less of it if part of the log gets damaged.
+     */
+    void BlackboxLogger::begin(BlackboxSink *sink, uint16_t keyframeInterval)
+    {
+        _sink = sink;
+        _keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+        _recordsSinceKeyframe = 0;
+        _keyframeDue = true;
+        _linkStatisticsDue = true;
+        _lastTimestamp = 0;
+        memset(_lastChannels, 0, sizeof(_lastChannels));
+        memset(&_statistics, 0, sizeof(_statistics));
+
+        const uint8_t header[BLACKBOX_HEADER_SIZE] = {
+            'C', 'F', 'A', 'B',
+            (uint8_t)BLACKBOX_VERSION, (uint8_t)(BLACKBOX_VERSION >> 8),
+            (uint8_t)crsfProtocol::RC_CHANNEL_COUNT,
+            0};
+        _write(header, sizeof(header));
+    }
+
+    void BlackboxLogger::end()
+    {
+        _sink = nullptr;
+    }
+
+    /**
+     * @brief Logs one set of RC channels. Call this once per received RC channels frame.
+     *
+     * @param channels crsfProtocol::RC_CHANNEL_COUNT raw channel values.
+     * @param failsafe Whether failsafe is active.
+     * @param timestamp micros() when the frame was received.
+     */
+    void BlackboxLogger::logRcChannels(const uint16_t *channels, bool failsafe, uint32_t timestamp)
+    {
+        if (_sink == nullptr)
+        {
+            return;
+        }
+
+        uint8_t record[BLACKBOX_RECORD_SIZE_MAX];
+        uint8_t *position = record;
+        const uint8_t flags = failsafe ? BLACKBOX_FAILSAFE_FLAG : 0;
+
+        if (_keyframeDue || _recordsSinceKeyframe >= _keyframeInterval)
+        {
+            *position++ = BLACKBOX_RECORD_KEYFRAME | flags;
+            position = _writeVarint(position, timestamp);
+            for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                position = _writeVarint(position, channels[i]);
+            }
+
+            _lastTimestamp = timestamp;
+            _recordsSinceKeyframe = 0;
+            _keyframeDue = false;
+            _linkStatisticsDue = true;
+            _statistics.keyframes++;
+        }
+        else
+        {
+            *position++ = BLACKBOX_RECORD_DELTA | flags;
+            position = _writeVarint(position, _timestampDelta(timestamp));
+
+            uint32_t changed = 0;
+            for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                if (channels[i] != _lastChannels[i])
+                {
+                    changed |= (1UL << i);
+                }
+            }
+
+            position = _writeVarint(position, changed);
+            for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                if (changed & (1UL << i))
+                {
+                    position = _writeVarint(position, _zigZag((int32_t)channels[i] - (int32_t)_lastChannels[i]));
+                }
+            }
+        }
+
+        memcpy(_lastChannels, channels, sizeof(_lastChannels));
+        _recordsSinceKeyframe++;
+        _statistics.channelRecords++;
+        _statistics.bytesRaw += sizeof(uint32_t) + sizeof(_lastChannels);
+
+        _write(record, (size_t)(position - record));
+    }
+
+    /**
+     * @brief Logs the link statistics, if they changed since they were last logged.
+     *
+     * @param timestamp micros() when the link statistics were received.
+     */
+    void BlackboxLogger::logLinkStatistics(const link_statistics_t *linkStatistics, uint32_t timestamp)
+    {
+        if (_sink == nullptr)
+        {
+            return;
+        }
+
+        _statistics.bytesRaw += sizeof(uint32_t) + sizeof(link_statistics_t);
+
+        if (!_linkStatisticsDue &&
+            linkStatistics->rssi == _lastLinkStatistics.rssi && linkStatistics->lqi == _lastLinkStatistics.lqi &&
+            linkStatistics->snr == _lastLinkStatistics.snr && linkStatistics->tx_power == _lastLinkStatistics.tx_power)
+        {
+            _statistics.linkStatisticsSkipped++;
+            return;
+        }
+
+        uint8_t record[BLACKBOX_RECORD_SIZE_MAX];
+        uint8_t *position = record;
+        *position++ = BLACKBOX_RECORD_LINK_STATISTICS;
+        position = _writeVarint(position, _timestampDelta(timestamp));
+        position = _writeVarint(position, _zigZag(linkStatistics->rssi));
+        position = _writeVarint(position, _zigZag(linkStatistics->lqi));
+        position = _writeVarint(position, _zigZag(linkStatistics->snr));
+        position = _writeVarint(position, _zigZag(linkStatistics->tx_power));
+
+        memcpy(&_lastLinkStatistics, linkStatistics, sizeof(link_statistics_t));
+        _linkStatisticsDue = false;
+        _statistics.linkStatisticsRecords++;
+
+        _write(record, (size_t)(position - record));
+    }
+
+    void BlackboxLogger::getStatistics(blackboxStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(blackboxStatistics_t));
+    }
+
+    /**
+     * @brief Returns the time since the previous record, and makes timestamp the previous record's time.
+     * Unsigned arithmetic keeps this right when micros() wraps around.
+     */
+    uint32_t BlackboxLogger::_timestampDelta(uint32_t timestamp)
+    {
+        const uint32_t delta = timestamp - _lastTimestamp;
+        _lastTimestamp = timestamp;
+        return delta;
+    }
+
+    void BlackboxLogger::_write(const uint8_t *data, size_t length)
+    {
+        _sink->write(data, length);
+        _statistics.bytesWritten += (uint32_t)length;
+    }
+
+    uint8_t *BlackboxLogger::_writeVarint(uint8_t *buffer, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            *buffer++ = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        *buffer++ = (uint8_t)value;
+        return buffer;
+    }
+
+    uint32_t BlackboxLogger::_zigZag(int32_t value)
+    {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+} // namespace serialReceiverLayer
@@ -0,0 +1,126 @@
+/**
+ * @file Blackbox.hpp
+ * @author CRSF for Arduino contributors
+ * @brief A compact, delta encoded flight log of RC channels and link statistics.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../CRSF/CRSF.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Blackbox log format
+A log is a header followed by records. Multi-byte header fields are little endian.
+Varints are unsigned LEB128 (7 bits per byte, least significant group first, high bit set on all but the last byte).
+Signed values are zig-zag encoded first, so that small negative numbers stay small.
+Header (8 bytes):
+- 4 bytes: "CFAB".
+- 2 bytes: format version (BLACKBOX_VERSION).
+- 1 byte: number of RC channels in each record.
+- 1 byte: reserved, 0.
+Each record starts with a tag byte. The low 7 bits are the record type. The high bit is set if failsafe was active.
+- BLACKBOX_RECORD_KEYFRAME: timestamp (varint, absolute micros()), then each channel (varint).
+- BLACKBOX_RECORD_DELTA: timestamp (varint, micros() since the previous record),
+  a mask of the channels that changed (varint, bit n = channel n), then each changed channel's difference from
+  the previous record (zig-zag varint), lowest channel first.
+- BLACKBOX_RECORD_LINK_STATISTICS: timestamp (varint, micros() since the previous record),
+  then RSSI, LQI, SNR and TX power (zig-zag varints). Only written when one of them changes.
+A keyframe is written every keyframeInterval channel records (BLACKBOX_KEYFRAME_INTERVAL by default, 0.2 s at 500 Hz), so that a log can be decoded from any keyframe onwards.
+The link statistics are written again after each keyframe, even if they did not change. */
+#define BLACKBOX_VERSION           1
+#define BLACKBOX_HEADER_SIZE       8
+#define BLACKBOX_RECORD_SIZE_MAX   (1 + 5 + 3 + (crsfProtocol::RC_CHANNEL_COUNT * 3))
+#define BLACKBOX_FAILSAFE_FLAG     0x80
+#define BLACKBOX_KEYFRAME_INTERVAL 100
+
+    typedef enum blackboxRecordType_e
+    {
+        BLACKBOX_RECORD_KEYFRAME = 1,
+        BLACKBOX_RECORD_DELTA,
+        BLACKBOX_RECORD_LINK_STATISTICS
+    } blackboxRecordType_t;
+
+    typedef struct blackboxStatistics_s
+    {
+        uint32_t channelRecords;        // RC channels records written, including keyframes.
+        uint32_t keyframes;             // Keyframes written.
+        uint32_t linkStatisticsRecords; // Link statistics records written.
+        uint32_t linkStatisticsSkipped; // Link statistics that were not written, because they had not changed.
+        uint32_t bytesWritten;          // Bytes passed to the sink, including the header.
+        uint32_t bytesRaw;              // Bytes the same frames take as plain structs (timestamp + values), for comparison.
+    } blackboxStatistics_t;
+
+    /**
+     * @brief Receives the encoded log from a BlackboxLogger. Implement this to write the log to an SD card,
+     * flash chip, file, etc. Each call holds one whole record (or the header), so a sink that buffers
+     * can flush on a record boundary. The pointer is only valid for the duration of the call.
+     */
+    class BlackboxSink
+    {
+      public:
+        virtual ~BlackboxSink()
+        {
+        }
+
+        virtual void write(const uint8_t *data, size_t length) = 0;
+    };
+
+    /**
+     * @brief Logs RC channels and link statistics at the full packet rate, in a few bytes per frame.
+     * Each channel set is stored as the difference from the one before it, and only for the channels that changed.
+     */
+    class BlackboxLogger final
+    {
+      public:
+        BlackboxLogger();
+        ~BlackboxLogger();
+
+        void begin(BlackboxSink *sink, uint16_t keyframeInterval = BLACKBOX_KEYFRAME_INTERVAL);
+        void end();
+
+        void logRcChannels(const uint16_t *channels, bool failsafe, uint32_t timestamp);
+        void logLinkStatistics(const link_statistics_t *linkStatistics, uint32_t timestamp);
+
+        void getStatistics(blackboxStatistics_t *statistics);
+
+      private:
+        BlackboxSink *_sink;
+        uint16_t _keyframeInterval;
+        uint16_t _recordsSinceKeyframe;
+        bool _keyframeDue;
+        bool _linkStatisticsDue;
+        uint32_t _lastTimestamp;
+        uint16_t _lastChannels[crsfProtocol::RC_CHANNEL_COUNT];
+        link_statistics_t _lastLinkStatistics;
+        blackboxStatistics_t _statistics;
+
+        uint32_t _timestampDelta(uint32_t timestamp);
+        void _write(const uint8_t *data, size_t length);
+
+        static uint8_t *_writeVarint(uint8_t *buffer, uint32_t value);
+        static uint32_t _zigZag(int32_t value);
+    };
+} // namespace serialReceiverLayer
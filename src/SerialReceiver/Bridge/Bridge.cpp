@@ -0,0 +1,312 @@
+/**
+ * @file Bridge.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This relays CRSF frames between a receiver and a flight controller, and can rewrite RC channels on the way.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Bridge.hpp"
+#include "../Transmitter/Transmitter.hpp"
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Construct a new Bridge object between a receiver and a flight controller.
+     * The ports are not deleted by the Bridge.
+     */
+    Bridge::Bridge(hal::SerialTransport *receiverPort, hal::SerialTransport *flightControllerPort)
+    {
+        memset(_framers, 0, sizeof(_framers));
+        _framers[BRIDGE_TO_FLIGHT_CONTROLLER].input = receiverPort;
+        _framers[BRIDGE_TO_FLIGHT_CONTROLLER].output = flightControllerPort;
+        _framers[BRIDGE_TO_RECEIVER].input = flightControllerPort;
+        _framers[BRIDGE_TO_RECEIVER].output = receiverPort;
+        _timeoutUs = 0;
+
+        _overrideMask = 0;
+        memset(_overrides, 0, sizeof(_overrides));
+    }
+
+    Bridge::~Bridge()
+    {
+    }
+
+    /**
+     * @brief Opens both ports at baudRate.
+     *
+     * @return false if either port is missing.
+     */
+    bool Bridge::begin(uint32_t baudRate)
+    {
+        if (_framers[BRIDGE_TO_FLIGHT_CONTROLLER].input == nullptr || _framers[BRIDGE_TO_RECEIVER].input == nullptr)
+        {
+            return false;
+        }
+
+        _framers[BRIDGE_TO_FLIGHT_CONTROLLER].input->begin(baudRate);
+        _framers[BRIDGE_TO_RECEIVER].input->begin(baudRate);
+
+        // The same frame timeout as the receiver role's decoder.
+        _timeoutUs = (1000000UL * 10) / (baudRate / (crsfProtocol::CRSF_FRAME_SIZE_MAX - 1));
+        _framers[BRIDGE_TO_FLIGHT_CONTROLLER].position = 0;
+        _framers[BRIDGE_TO_RECEIVER].position = 0;
+
+        resetStatistics();
+        return true;
+    }
+
+    void Bridge::end()
+    {
+        for (size_t i = 0; i < BRIDGE_DIRECTION_COUNT; i++)
+        {
+            if (_framers[i].input != nullptr)
+            {
+                _framers[i].input->flush();
+                _framers[i].input->end();
+            }
+        }
+    }
+
+    /**
+     * @brief Relays whatever has arrived on either port. Call this as often as possible, or whenever either port has data.
+     *
+     * @return The number of frames that were forwarded, in both directions.
+     */
+    size_t Bridge::update()
+    {
+        const uint32_t currentTime = micros();
+        size_t forwarded = _pump(&_framers[BRIDGE_TO_FLIGHT_CONTROLLER], currentTime);
+        forwarded += _pump(&_framers[BRIDGE_TO_RECEIVER], currentTime);
+        return forwarded;
+    }
+
+    /**
+     * @brief Forces channel to value in every RC channels frame that goes to the flight controller, until it is cleared.
+     * The value is in the same units as the frame carries, ie CRSF_RC_CHANNEL_MIN to CRSF_RC_CHANNEL_MAX.
+     * Overrides are applied after the RC Channels Callback, so they win.
+     */
+    void Bridge::setChannelOverride(uint8_t channel, uint16_t value)
+    {
+        if (channel < crsfProtocol::RC_CHANNEL_COUNT)
+        {
+            _overrides[channel] = value & 0x07FF;
+            _overrideMask |= (uint16_t)(1 << channel);
+        }
+    }
+
+    void Bridge::clearChannelOverride(uint8_t channel)
+    {
+        if (channel < crsfProtocol::RC_CHANNEL_COUNT)
+        {
+            _overrideMask &= (uint16_t)~(1 << channel);
+        }
+    }
+
+    void Bridge::clearChannelOverrides()
+    {
+        _overrideMask = 0;
+    }
+
+    /**
+     * @brief Sets a callback that sees, and can change, the channels of every RC channels frame that goes to the flight controller.
+     * It is called from update(), before the frame is written, so keep it short. Pass nullptr to remove it.
+     */
+    void Bridge::setRcChannelsCallback(bridgeRcChannelsCallback_t callback)
+    {
+        _rcChannelsCallback = callback;
+    }
+
+    void Bridge::getStatistics(bridgeDirection_t direction, bridgeStatistics_t *statistics)
+    {
+        if (direction < BRIDGE_DIRECTION_COUNT)
+        {
+            memcpy(statistics, &_framers[direction].statistics, sizeof(bridgeStatistics_t));
+        }
+    }
+
+    void Bridge::resetStatistics()
+    {
+        for (size_t i = 0; i < BRIDGE_DIRECTION_COUNT; i++)
+        {
+            memset(&_framers[i].statistics, 0, sizeof(bridgeStatistics_t));
+        }
+    }
+
+    /**
+     * @brief Reads everything that has arrived on one port, and forwards each frame the moment that it is complete.
+     */
+    size_t Bridge::_pump(framer_t *framer, uint32_t currentTime)
+    {
+        uint8_t buffer[BRIDGE_READ_SIZE];
+        size_t length;
+        size_t forwarded = 0;
+
+        do
+        {
+            length = framer->input->read(buffer, sizeof(buffer));
+            for (size_t i = 0; i < length; i++)
+            {
+                if (framer->position > 0 && currentTime - framer->startUs > _timeoutUs)
+                {
+                    framer->statistics.timeouts++;
+                    framer->position = 0;
+                }
+
+                if (framer->position == 0)
+                {
+                    framer->startUs = currentTime;
+                }
+
+                const uint8_t rxByte = buffer[i];
+                framer->frame[framer->position++] = rxByte;
+
+                if (framer->position == 2 && (rxByte < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC || rxByte > crsfProtocol::CRSF_FRAME_SIZE_MAX - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH))
+                {
+                    framer->statistics.lengthErrors++;
+                    framer->position = 0;
+                }
+                else if (framer->position > 2 && framer->position == framer->frame[1] + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH)
+                {
+                    if (_forward(framer))
+                    {
+                        forwarded++;
+                    }
+                    framer->position = 0;
+                }
+            }
+        } while (length == sizeof(buffer));
+
+        return forwarded;
+    }
+
+    /**
+     * @brief Checks the frame that has just been completed, rewrites its channels if it needs to, and writes it to the other port.
+     */
+    bool Bridge::_forward(framer_t *framer)
+    {
+        uint8_t *frame = framer->frame;
+        const uint8_t frameLength = frame[1];
+        const uint8_t type = frame[2];
+        const uint8_t payloadLength = frameLength - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        uint8_t *crc = frame + frameLength + 1;
+
+        if (_crc.calculate(type, frame + 3, payloadLength) != *crc)
+        {
+            framer->statistics.crcErrors++;
+            return false;
+        }
+
+        if (framer == &_framers[BRIDGE_TO_FLIGHT_CONTROLLER] && type == crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED &&
+            payloadLength == crsfProtocol::CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE && (_overrideMask != 0 || _rcChannelsCallback != nullptr))
+        {
+            if (_rewriteRcChannels(frame + 3))
+            {
+                *crc = _crc.calculate(type, frame + 3, payloadLength);
+                framer->statistics.framesRewritten++;
+            }
+        }
+
+        const size_t length = frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+        if (framer->output->write(frame, length) != length)
+        {
+            framer->statistics.framesDropped++;
+            return false;
+        }
+
+        framer->statistics.framesForwarded++;
+        return true;
+    }
+
+    /**
+     * @brief Applies the RC Channels Callback and the overrides to a packed RC channels payload, in place.
+     * Overrides on their own are patched straight into the packed bits, so the frame is not unpacked at all.
+     *
+     * @return true if any channel changed, ie the CRC has to be recalculated.
+     */
+    bool Bridge::_rewriteRcChannels(uint8_t *payload)
+    {
+        if (_rcChannelsCallback != nullptr)
+        {
+            uint16_t channels[crsfProtocol::RC_CHANNEL_COUNT];
+            uint32_t bits = 0;
+            uint8_t bitCount = 0;
+            const uint8_t *in = payload;
+            for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+            {
+                while (bitCount < 11)
+                {
+                    bits |= (uint32_t)*in++ << bitCount;
+                    bitCount += 8;
+                }
+                channels[i] = (uint16_t)(bits & 0x07FF);
+                bits >>= 11;
+                bitCount -= 11;
+            }
+
+            if (_rcChannelsCallback(channels))
+            {
+                for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+                {
+                    if (_overrideMask & (1 << i))
+                    {
+                        channels[i] = _overrides[i];
+                    }
+                }
+
+                Transmitter::packChannels(channels, crsfProtocol::RC_CHANNEL_COUNT, payload);
+                return true;
+            }
+        }
+
+        bool changed = false;
+        for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+        {
+            if ((_overrideMask & (1 << i)) == 0)
+            {
+                continue;
+            }
+
+            // Each channel spans two or three bytes, starting shift bits into the first.
+            const size_t bit = i * 11;
+            uint8_t *bytes = payload + (bit >> 3);
+            const uint8_t shift = bit & 7;
+            const bool threeBytes = shift > 5;
+
+            uint32_t word = bytes[0] | ((uint32_t)bytes[1] << 8) | (threeBytes ? (uint32_t)bytes[2] << 16 : 0);
+            if (((word >> shift) & 0x07FF) == _overrides[i])
+            {
+                continue;
+            }
+
+            word = (word & ~((uint32_t)0x07FF << shift)) | ((uint32_t)_overrides[i] << shift);
+            bytes[0] = (uint8_t)word;
+            bytes[1] = (uint8_t)(word >> 8);
+            if (threeBytes)
+            {
+                bytes[2] = (uint8_t)(word >> 16);
+            }
+            changed = true;
+        }
+
+        return changed;
+    }
+} // namespace serialReceiverLayer
@@ -0,0 +1,111 @@
+/**
+ * @file Bridge.hpp
+ * @author CRSF for Arduino contributors
+ * @brief This relays CRSF frames between a receiver and a flight controller, and can rewrite RC channels on the way.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../../hal/SerialTransport/SerialTransport.hpp"
+#include "../CRC/CRC.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Bridge Options
+- BRIDGE_READ_SIZE: Bytes taken from a port per read. Each frame is forwarded as soon as its last byte is taken,
+  so this only sets how many bytes are copied out of the driver at a time, not how long a frame waits. */
+#define BRIDGE_READ_SIZE 64
+
+    typedef enum bridgeDirection_e
+    {
+        BRIDGE_TO_FLIGHT_CONTROLLER = 0, // RC channels and link statistics, from the receiver.
+        BRIDGE_TO_RECEIVER = 1,          // Telemetry, from the flight controller.
+        BRIDGE_DIRECTION_COUNT = 2
+    } bridgeDirection_t;
+
+    typedef struct bridgeStatistics_s
+    {
+        uint32_t framesForwarded; // Frames with a valid CRC that the other port accepted.
+        uint32_t framesDropped;   // Frames with a valid CRC that the other port did not accept in full.
+        uint32_t framesRewritten; // RC channels frames whose channels were changed on the way (towards the flight controller only).
+        uint32_t crcErrors;       // Frames whose CRC did not match. These are not forwarded.
+        uint32_t lengthErrors;    // Frames whose length byte was out of range. These are dropped as soon as the length byte arrives.
+        uint32_t timeouts;        // Partial frames that were dropped because the rest of them never arrived.
+    } bridgeStatistics_t;
+
+    /* Function pointer for the RC Channels Callback. rcChannels holds all 16 channels of the frame that is being forwarded.
+    Change any of them in place and return true, and the frame is repacked and its CRC recalculated before it goes on.
+    Return false to forward the frame exactly as it came in. */
+    typedef bool (*bridgeRcChannelsCallback_t)(uint16_t *rcChannels);
+
+    /**
+     * @brief Relays CRSF frames between a receiver and a flight controller (eg on a companion MCU that sits between the two).
+     * Frames are checked, and each one is written to the other port as soon as its last byte has been read,
+     * instead of after the rest of the read or on the next call to update(). Frames with a bad CRC are dropped.
+     * RC channels frames can be rewritten on the way, with overrides for single channels or with a callback.
+     */
+    class Bridge final
+    {
+      public:
+        Bridge(hal::SerialTransport *receiverPort, hal::SerialTransport *flightControllerPort);
+        ~Bridge();
+
+        bool begin(uint32_t baudRate = crsfProtocol::BAUD_RATE);
+        void end();
+
+        size_t update();
+
+        void setChannelOverride(uint8_t channel, uint16_t value);
+        void clearChannelOverride(uint8_t channel);
+        void clearChannelOverrides();
+        void setRcChannelsCallback(bridgeRcChannelsCallback_t callback);
+
+        void getStatistics(bridgeDirection_t direction, bridgeStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        typedef struct framer_s
+        {
+            hal::SerialTransport *input;
+            hal::SerialTransport *output;
+            uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+            uint8_t position;
+            uint32_t startUs;
+            bridgeStatistics_t statistics;
+        } framer_t;
+
+        genericCrc::GenericCRC _crc;
+        framer_t _framers[BRIDGE_DIRECTION_COUNT];
+        uint32_t _timeoutUs;
+
+        uint16_t _overrideMask;
+        uint16_t _overrides[crsfProtocol::RC_CHANNEL_COUNT];
+        bridgeRcChannelsCallback_t _rcChannelsCallback = nullptr;
+
+        size_t _pump(framer_t *framer, uint32_t currentTime);
+        bool _forward(framer_t *framer);
+        bool _rewriteRcChannels(uint8_t *payload);
+    };
+} // namespace serialReceiverLayer
@@ -25,53 +25,44 @@
  */
 
 #include "CRC.hpp"
-#include "stdlib.h"
 
 namespace genericCrc
 {
-    GenericCRC::GenericCRC()
-    {
 #if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SPEED)
-        // Allocate memory for the CRC8 DVB S2 table.
-        crc_8_dvb_s2_table = (uint8_t *)malloc(256 * sizeof(uint8_t));
+    /* Shifts the eight bits of crc through the polynomial. This is one table entry, and is worked out by the compiler. */
+    static constexpr uint8_t crc_8_entry(uint8_t crc, uint8_t polynomial, uint8_t bits = 8)
+    {
+        return bits == 0 ? crc : crc_8_entry((crc & 0x80) ? (uint8_t)((crc << 1) ^ polynomial) : (uint8_t)(crc << 1), polynomial, bits - 1);
+    }
 
-        // Generate the CRC8 DVB S2 table.
-        for (uint16_t i = 0; i < 256; i++)
-        {
-            uint8_t crc = i;
-            for (uint8_t j = 0; j < 8; j++)
-            {
-                if (crc & 0x80)
-                {
-                    crc = (crc << 1) ^ 0xd5;
-                }
-                else
-                {
-                    crc <<= 1;
-                }
-            }
-            crc_8_dvb_s2_table[i] = crc & 0xff;
-        }
+#define CRC_8_ENTRIES_4(polynomial, i)  crc_8_entry((i), polynomial), crc_8_entry((i) + 1, polynomial), crc_8_entry((i) + 2, polynomial), crc_8_entry((i) + 3, polynomial)
+#define CRC_8_ENTRIES_16(polynomial, i) CRC_8_ENTRIES_4(polynomial, (i)), CRC_8_ENTRIES_4(polynomial, (i) + 4), CRC_8_ENTRIES_4(polynomial, (i) + 8), CRC_8_ENTRIES_4(polynomial, (i) + 12)
+#define CRC_8_ENTRIES_64(polynomial, i) CRC_8_ENTRIES_16(polynomial, (i)), CRC_8_ENTRIES_16(polynomial, (i) + 16), CRC_8_ENTRIES_16(polynomial, (i) + 32), CRC_8_ENTRIES_16(polynomial, (i) + 48)
+#define CRC_8_TABLE(polynomial)         CRC_8_ENTRIES_64(polynomial, 0), CRC_8_ENTRIES_64(polynomial, 64), CRC_8_ENTRIES_64(polynomial, 128), CRC_8_ENTRIES_64(polynomial, 192)
+
+    /* The CRC8 DVB S2 table (and the CRC8 0xBA table, for the inner CRC of command frames) are generated at compile time.
+    They are the same for every instance, and nothing writes to them, so any number of threads can share them. */
+    const uint8_t GenericCRC::crc_8_dvb_s2_table[256] = {CRC_8_TABLE(0xd5)};
+    const uint8_t GenericCRC::crc_8_ba_table[256] = {CRC_8_TABLE(0xba)};
 #endif
+
+    GenericCRC::GenericCRC()
+    {
     }
 
     GenericCRC::~GenericCRC()
     {
-#if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SPEED)
-        // Free the memory allocated for the CRC8 DVB S2 table.
-        free(crc_8_dvb_s2_table);
-#endif
     }
 
 #if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SIZE)
-    uint8_t GenericCRC::crc_8_dvb_s2(uint8_t crc, uint8_t data)
+    uint8_t GenericCRC::crc_8_ba(uint8_t crc, uint8_t data)
     {
         crc ^= data;
         for (uint8_t i = 0; i < 8; i++)
         {
             if (crc & 0x80)
             {
-                crc = (crc << 1) ^ 0xd5;
+                crc = (crc << 1) ^ 0xba;
             }
             else
             {
@@ -82,56 +73,32 @@ namespace genericCrc
     }
 #endif
 
-    uint8_t GenericCRC::calculate(uint8_t start, uint8_t *data, uint8_t length)
+    /**
+     * @brief Calculates the CRC8 (polynomial 0xBA) that command frames carry inside their payload,
+     * over length bytes of data. For a command frame, data starts at the frame type and ends just before the inner CRC.
+     * This is not on the receive hot path, so it is not inlined.
+     */
+    uint8_t GenericCRC::calculateCommand(uint8_t *data, uint8_t length)
     {
+        uint8_t crc = 0;
 #if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SPEED)
-        // start is the first byte of the data to be GenericCRC'd.
-        // data is a pointer to the data to be GenericCRC'd.
-
-        // Calculate the CRC8 DVB S2 value.
-        uint8_t crc = crc_8_dvb_s2_table[0 ^ start];
         for (uint8_t i = 0; i < length; i++)
         {
-            crc = crc_8_dvb_s2_table[crc ^ data[i]];
+            crc = crc_8_ba_table[crc ^ data[i]];
         }
-
-        // Return the CRC8 DVB S2 value.
-        return crc;
 #elif (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SIZE)
-        uint8_t crc = crc_8_dvb_s2(0, start);
         for (uint8_t i = 0; i < length; i++)
         {
-            crc = crc_8_dvb_s2(crc, data[i]);
+            crc = crc_8_ba(crc, data[i]);
         }
-        return crc;
-#elif (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_HARDWARE)
+#else
+        (void)data;
+        (void)length;
 #endif
-    }
-
-    uint8_t GenericCRC::calculate(uint8_t offset, uint8_t start, uint8_t *data, uint8_t length)
-    {
-        (void)start;
-#if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SPEED)
-        // start is the first byte of the data to be GenericCRC'd.
-        // data is a pointer to the data to be GenericCRC'd.
-
-        // Calculate the CRC8 DVB S2 value.
-        uint8_t crc = crc_8_dvb_s2_table[0 ^ data[offset]];
-        for (uint8_t i = offset + 1; i < length; i++)
-        {
-            crc = crc_8_dvb_s2_table[crc ^ data[i]];
-        }
-
-        // Return the CRC8 DVB S2 value.
-        return crc;
-#elif (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SIZE)
-        uint8_t crc = crc_8_dvb_s2(0, data[offset]);
-        for (uint8_t i = offset + 1; i < length; i++)
-        {
-            crc = crc_8_dvb_s2(crc, data[i]);
-        }
         return crc;
-#elif (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_HARDWARE)
-#endif
     }
 } // namespace genericCrc
+
+#if CRSF_INLINE_HOT_PATH == 0
+#include "CRCInline.hpp"
+#endif
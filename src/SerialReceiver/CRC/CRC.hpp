@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "../../CFA_Config.hpp"
 #include "stdint.h"
 
 namespace genericCrc
@@ -34,20 +35,27 @@ namespace genericCrc
 #define CRC_OPTIMISATION_SIZE     1
 #define CRC_OPTIMISATION_HARDWARE 2
 
-    class GenericCRC
+    class GenericCRC final
     {
       public:
         GenericCRC();
-        virtual ~GenericCRC();
+        ~GenericCRC();
 
         uint8_t calculate(uint8_t start, uint8_t *data, uint8_t length);
         uint8_t calculate(uint8_t offset, uint8_t start, uint8_t *data, uint8_t length);
+        uint8_t calculateCommand(uint8_t *data, uint8_t length);
 
       private:
 #if (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SPEED)
-        uint8_t *crc_8_dvb_s2_table;
+        static const uint8_t crc_8_dvb_s2_table[256];
+        static const uint8_t crc_8_ba_table[256];
 #elif (CRC_OPTIMISATION_LEVEL == CRC_OPTIMISATION_SIZE)
         uint8_t crc_8_dvb_s2(uint8_t crc, uint8_t data);
+        uint8_t crc_8_ba(uint8_t crc, uint8_t data);
 #endif
     };
 } // namespace genericCrc
+
+#if CRSF_INLINE_HOT_PATH > 0
+#include "CRCInline.hpp"
+#endif
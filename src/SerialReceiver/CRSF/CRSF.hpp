@@ -26,7 +26,10 @@
 
 #pragma once
 
+#include "../../CFA_Config.hpp"
 #include "../CRC/CRC.hpp"
+#include "../FrameRouter/FrameRouter.hpp"
+#include "../Trace/Trace.hpp"
 #include "CRSFProtocol.hpp"
 
 namespace serialReceiverLayer
@@ -53,27 +56,350 @@ namespace serialReceiverLayer
     };
     // #endif
 
-    class CRSF
+    typedef struct crsfCounters_s
+    {
+        uint32_t rcChannelsFrames;     // RC channels frames with a valid CRC.
+        uint32_t linkStatisticsFrames; // Link statistics frames with a valid CRC.
+        uint32_t otherFrames;          // Frames of any other type with a valid CRC.
+        uint32_t crcErrors;            // Whole frames whose CRC did not match.
+        uint32_t lengthErrors;         // Frames whose length byte was out of range. These are dropped as soon as the length byte arrives.
+        uint32_t timeouts;             // Partial frames that were dropped because the frame time ran out (ie the decoder resynchronised).
+        uint32_t commandCrcErrors;     // Command frames whose outer CRC matched, but whose inner CRC did not.
+    } crsfCounters_t;
+
+    /**
+     * @brief Increments a health counter, unless Config turns the health counters off.
+     */
+    template <class Config>
+    inline void incrementHealthCounter(uint32_t &counter)
+    {
+        CRSF_IF_CONSTEXPR(Config::healthCountersEnabled)
+        {
+            counter++;
+        }
+    }
+
+    /**
+     * @brief Decodes CRSF frames one byte at a time.
+     *
+     * @tparam Config The compile-time configuration. See crsfForArduinoConfig::DefaultConfig.
+     */
+    template <class Config = crsfForArduinoConfig::DefaultConfig>
+    class BasicCRSF final
     {
       public:
-        CRSF();
-        virtual ~CRSF();
+        BasicCRSF();
+        ~BasicCRSF();
         void begin();
         void end();
         void setFrameTime(uint32_t baudRate, uint8_t packetCount = 10);
         bool receiveFrames(uint8_t rxByte);
+        bool receiveFrames(uint8_t rxByte, uint32_t currentTime);
+        bool isIdle();
+        uint8_t getFrameType();
         void getFailSafe(bool *failSafe);
-        void getRcChannels(uint16_t *rcChannels);
-        void getLinkStatistics(link_statistics_t *linkStats);
+        bool getRcChannels(uint16_t *rcChannels);
+        bool getLinkStatistics(link_statistics_t *linkStats);
+        bool getDevicePing(uint8_t *origin);
+        const uint8_t *getParameterRequest();
+        const uint8_t *getCommand();
+        void getCounters(crsfCounters_t *crsfCounters);
+        void resetCounters();
+        BasicTrace<Config> *getTrace();
+        void setFrameRouter(FrameRouter *router);
 
       private:
         bool rcFrameReceived;
+        bool linkStatisticsReceived;
+        bool devicePingReceived;
+        uint8_t devicePingOrigin;
+        bool parameterRequestReceived;
+        uint8_t parameterRequest[Config::parametersEnabled ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1]; // Only one unused byte is kept when parameters are disabled.
+        bool commandReceived;
+        uint8_t command[Config::commandsEnabled ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1]; // Only one unused byte is kept when commands are disabled.
+        uint8_t framePosition;
+        uint8_t frameType;
+        uint32_t frameStartTime;
         uint16_t frameCount;
         uint32_t timePerFrame;
         crsfProtocol::frame_t rxFrame;
         crsfProtocol::frame_t rcChannelsFrame;
         link_statistics_t linkStatistics;
-        genericCrc::GenericCRC *crc8;
+        genericCrc::GenericCRC crc8;
+        crsfCounters_t counters;
+        BasicTrace<Config> trace;
+        FrameRouter *frameRouter = nullptr;
         uint8_t calculateFrameCRC();
     };
+
+    typedef BasicCRSF<> CRSF;
+
+    template <class Config>
+    BasicCRSF<Config>::BasicCRSF()
+    {
+        memset(&counters, 0, sizeof(counters));
+    }
+
+    template <class Config>
+    BasicCRSF<Config>::~BasicCRSF()
+    {
+    }
+
+    template <class Config>
+    void BasicCRSF<Config>::begin()
+    {
+        rcFrameReceived = false;
+        linkStatisticsReceived = false;
+        devicePingReceived = false;
+        devicePingOrigin = 0;
+        parameterRequestReceived = false;
+        commandReceived = false;
+        frameCount = 0;
+        timePerFrame = 0;
+        framePosition = 0;
+        frameType = 0;
+        frameStartTime = 0;
+        memset(&counters, 0, sizeof(counters));
+
+        // #ifdef USE_DMA
+        //         memset_dma(rxFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        //         memset_dma(rcChannelsFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        // #else
+        memset(rxFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        memset(rcChannelsFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        // #endif
+    }
+
+    template <class Config>
+    void BasicCRSF<Config>::end()
+    {
+        // #ifdef USE_DMA
+        //         memset_dma(rcChannelsFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        //         memset_dma(rxFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        // #else
+        memset(rcChannelsFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        memset(rxFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        // #endif
+
+        timePerFrame = 0;
+        frameCount = 0;
+        rcFrameReceived = false;
+        linkStatisticsReceived = false;
+        devicePingReceived = false;
+        parameterRequestReceived = false;
+        commandReceived = false;
+        framePosition = 0;
+    }
+
+    template <class Config>
+    void BasicCRSF<Config>::setFrameTime(uint32_t baudRate, uint8_t packetCount)
+    {
+        timePerFrame = ((1000000 * packetCount) / (baudRate / (crsfProtocol::CRSF_FRAME_SIZE_MAX - 1)));
+    }
+
+    /**
+     * @brief Returns true when the decoder is between frames, ie the next byte that it receives starts a new frame.
+     * Two decoders that are both idle decode the bytes that follow in exactly the same way.
+     */
+    template <class Config>
+    bool BasicCRSF<Config>::isIdle()
+    {
+        return framePosition == 0;
+    }
+
+    /**
+     * @brief Returns the type of the last frame that receiveFrames() completed, or 0 if its CRC did not match.
+     */
+    template <class Config>
+    uint8_t BasicCRSF<Config>::getFrameType()
+    {
+        return frameType;
+    }
+
+    /**
+     * @brief Sets failSafe if the last link statistics show a weak link (see CRSF_FAILSAFE_LQI_THRESHOLD).
+     * Without link statistics in the configuration there is nothing to judge the link by, so failSafe is false.
+     */
+    template <class Config>
+    void BasicCRSF<Config>::getFailSafe(bool *failSafe)
+    {
+        CRSF_IF_CONSTEXPR(!Config::linkStatisticsEnabled)
+        {
+            *failSafe = false;
+            return;
+        }
+
+        if (linkStatistics.lqi <= CRSF_FAILSAFE_LQI_THRESHOLD || linkStatistics.rssi >= CRSF_FAILSAFE_RSSI_THRESHOLD)
+        {
+            *failSafe = true;
+        }
+        else
+        {
+            *failSafe = false;
+        }
+    }
+
+    /**
+     * @brief Unpacks the most recent RC channels frame into rcChannels.
+     *
+     * @return true if a new RC channels frame was unpacked since the last call.
+     */
+    template <class Config>
+    bool BasicCRSF<Config>::getRcChannels(uint16_t *rcChannels)
+    {
+        if (rcFrameReceived)
+        {
+            rcFrameReceived = false;
+            if (rcChannelsFrame.frame.type == crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED)
+            {
+                // Unpack RC Channels.
+                const crsfProtocol::rcChannelsPacked_t *rcChannelsPacked = (crsfProtocol::rcChannelsPacked_t *)&rcChannelsFrame.frame.payload;
+
+                rcChannels[crsfProtocol::RC_CHANNEL_ROLL] = rcChannelsPacked->channel0;
+                rcChannels[crsfProtocol::RC_CHANNEL_PITCH] = rcChannelsPacked->channel1;
+                rcChannels[crsfProtocol::RC_CHANNEL_THROTTLE] = rcChannelsPacked->channel2;
+                rcChannels[crsfProtocol::RC_CHANNEL_YAW] = rcChannelsPacked->channel3;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX1] = rcChannelsPacked->channel4;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX2] = rcChannelsPacked->channel5;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX3] = rcChannelsPacked->channel6;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX4] = rcChannelsPacked->channel7;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX5] = rcChannelsPacked->channel8;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX6] = rcChannelsPacked->channel9;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX7] = rcChannelsPacked->channel10;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX8] = rcChannelsPacked->channel11;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX9] = rcChannelsPacked->channel12;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX10] = rcChannelsPacked->channel13;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX11] = rcChannelsPacked->channel14;
+                rcChannels[crsfProtocol::RC_CHANNEL_AUX12] = rcChannelsPacked->channel15;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Copies the most recent link statistics into linkStats.
+     *
+     * @return true if new link statistics were received since the last call.
+     */
+    template <class Config>
+    bool BasicCRSF<Config>::getLinkStatistics(link_statistics_t *linkStats)
+    {
+        CRSF_IF_CONSTEXPR(Config::linkStatisticsEnabled)
+        {
+            /* Copy the link statistics into the output structure. */
+            memcpy(linkStats, &linkStatistics, sizeof(link_statistics_t));
+
+            const bool received = linkStatisticsReceived;
+            linkStatisticsReceived = false;
+            return received;
+        }
+
+        (void)linkStats;
+        return false;
+    }
+
+    /**
+     * @brief Reports a device ping that was addressed to the flight controller, or to every device.
+     *
+     * @param origin Set to the address of the device that sent the ping, which is where the answer goes.
+     * @return true if a ping was received since the last call.
+     */
+    template <class Config>
+    bool BasicCRSF<Config>::getDevicePing(uint8_t *origin)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryEnabled && Config::telemetryDeviceInfoEnabled)
+        {
+            const bool received = devicePingReceived;
+            devicePingReceived = false;
+            *origin = devicePingOrigin;
+            return received;
+        }
+
+        (void)origin;
+        return false;
+    }
+
+    /**
+     * @brief Returns the most recent parameter read or write request (the whole frame) that was addressed to the flight controller,
+     * or nullptr if there has not been one since the last call. The request stays valid until the next one is received.
+     */
+    template <class Config>
+    const uint8_t *BasicCRSF<Config>::getParameterRequest()
+    {
+        CRSF_IF_CONSTEXPR(Config::parametersEnabled)
+        {
+            if (parameterRequestReceived)
+            {
+                parameterRequestReceived = false;
+                return parameterRequest;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns the most recent command frame (the whole frame) that was addressed to the flight controller,
+     * or to every device, and whose inner CRC matched. Returns nullptr if there has not been one since the last call.
+     * The frame stays valid until the next command is received.
+     */
+    template <class Config>
+    const uint8_t *BasicCRSF<Config>::getCommand()
+    {
+        CRSF_IF_CONSTEXPR(Config::commandsEnabled)
+        {
+            if (commandReceived)
+            {
+                commandReceived = false;
+                return command;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Copies the health counters into crsfCounters in one go.
+     * Call this from the same context as receiveFrames(), so that the copy is consistent.
+     */
+    template <class Config>
+    void BasicCRSF<Config>::getCounters(crsfCounters_t *crsfCounters)
+    {
+        memcpy(crsfCounters, &counters, sizeof(crsfCounters_t));
+    }
+
+    template <class Config>
+    void BasicCRSF<Config>::resetCounters()
+    {
+        memset(&counters, 0, sizeof(counters));
+    }
+
+    /**
+     * @brief Returns the decoder's trace, so that the layers above can record their own events into the same timeline.
+     */
+    template <class Config>
+    BasicTrace<Config> *BasicCRSF<Config>::getTrace()
+    {
+        return &trace;
+    }
+
+    /**
+     * @brief Hands every frame with a valid CRC to router, as soon as it is decoded and before it is used here.
+     * This needs frameRouterEnabled in the configuration. Pass nullptr to stop routing.
+     */
+    template <class Config>
+    void BasicCRSF<Config>::setFrameRouter(FrameRouter *router)
+    {
+        frameRouter = router;
+    }
+} // namespace serialReceiverLayer
+
+#include "CRSFInline.hpp"
+
+namespace serialReceiverLayer
+{
+    // The default configuration is compiled once, in CRSF.cpp.
+    extern template class BasicCRSF<crsfForArduinoConfig::DefaultConfig>;
 } // namespace serialReceiverLayer
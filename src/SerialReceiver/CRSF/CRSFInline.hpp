@@ -0,0 +1,225 @@
+/**
+ * @file CRSFInline.hpp
+ * @author CRSF for Arduino contributors
+ * @brief The CRSF frame decoder's per-byte hot path. This is compiled into CRSF.cpp, or inlined into SerialReceiver::processFrames() when CRSF_INLINE_HOT_PATH is enabled.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "CRSF.hpp"
+
+namespace serialReceiverLayer
+{
+    template <class Config>
+    CRSF_HOT_PATH uint8_t BasicCRSF<Config>::calculateFrameCRC()
+    {
+        return crc8.calculate(rxFrame.frame.type, rxFrame.frame.payload, rxFrame.frame.frameLength - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+    }
+
+    template <class Config>
+    CRSF_HOT_PATH bool BasicCRSF<Config>::receiveFrames(uint8_t rxByte)
+    {
+        return receiveFrames(rxByte, micros());
+    }
+
+    /**
+     * @brief Decodes one byte, using a timestamp that the caller took with micros().
+     * Bytes that were read from the transport together can share one timestamp,
+     * which keeps the call to micros() out of the per-byte loop.
+     *
+     * @return true if a whole frame was received, whether or not its CRC was valid.
+     */
+    template <class Config>
+    CRSF_HOT_PATH bool BasicCRSF<Config>::receiveFrames(uint8_t rxByte, uint32_t currentTime)
+    {
+        // Reset the frame position if the frame time has elapsed.
+        if (currentTime - frameStartTime > timePerFrame)
+        {
+            if (framePosition > 0)
+            {
+                incrementHealthCounter<Config>(counters.timeouts);
+                trace.record(TRACE_EVENT_RESYNC, TRACE_RESYNC_TIMEOUT, framePosition, currentTime);
+            }
+
+            framePosition = 0;
+
+            // This compensates for micros() overflow.
+            if (currentTime < frameStartTime)
+            {
+                frameStartTime = currentTime;
+            }
+        }
+
+        // Reset the frame start time if the frame position is 0.
+        if (framePosition == 0)
+        {
+            frameStartTime = currentTime;
+            trace.record(TRACE_EVENT_FRAME_START, 0, 0, currentTime);
+        }
+
+        // Assume the full frame lenthg is 5 bytes until the frame length byte is received.
+        const int fullFrameLength = framePosition < 3 ? 5 : min(rxFrame.frame.frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH, (int)crsfProtocol::CRSF_FRAME_SIZE_MAX);
+
+        if (framePosition < fullFrameLength)
+        {
+            rxFrame.raw[framePosition] = rxByte;
+            framePosition++;
+
+            // A length byte that is out of range cannot start a valid frame. Drop it now, instead of waiting for the frame time to run out.
+            if (framePosition == 2 && (rxFrame.frame.frameLength < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC || rxFrame.frame.frameLength > crsfProtocol::CRSF_FRAME_SIZE_MAX - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH))
+            {
+                incrementHealthCounter<Config>(counters.lengthErrors);
+                trace.record(TRACE_EVENT_RESYNC, TRACE_RESYNC_LENGTH, rxFrame.frame.frameLength, currentTime);
+                framePosition = 0;
+                return false;
+            }
+
+            if (framePosition >= fullFrameLength)
+            {
+                const uint8_t crc = calculateFrameCRC();
+
+                if (crc == rxFrame.raw[fullFrameLength - 1])
+                {
+                    frameType = rxFrame.frame.type;
+                    trace.record(TRACE_EVENT_FRAME_DECODED, rxFrame.frame.type, rxFrame.frame.frameLength, currentTime);
+
+                    CRSF_IF_CONSTEXPR(Config::frameRouterEnabled)
+                    {
+                        if (frameRouter != nullptr)
+                        {
+                            frameRouter->dispatch(&rxFrame, currentTime);
+                        }
+                    }
+
+                    switch (rxFrame.frame.type)
+                    {
+                        case crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
+                            incrementHealthCounter<Config>(counters.rcChannelsFrames);
+                            if (rxFrame.frame.deviceAddress == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER)
+                            {
+                                // #ifdef USE_DMA
+                                // #ifdef __SAMD51__
+                                //                                 memcpy(&rcChannelsFrame, &rxFrame, crsfProtocol::CRSF_FRAME_SIZE_MAX); // ◄ This is a workaround for the crash on SAMD51.
+                                // #else
+                                //                                 memcpy_dma(&rcChannelsFrame, &rxFrame, crsfProtocol::CRSF_FRAME_SIZE_MAX); // ◄ This is the line that causes the crash on SAMD51.
+                                // #endif
+                                // #else
+                                memcpy(&rcChannelsFrame, &rxFrame, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+                                // #endif
+                                rcFrameReceived = true;
+                            }
+                            break;
+
+                        case crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS:
+                            incrementHealthCounter<Config>(counters.linkStatisticsFrames);
+                            CRSF_IF_CONSTEXPR(Config::linkStatisticsEnabled)
+                            {
+                                if ((rxFrame.frame.deviceAddress == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER) && (rxFrame.frame.frameLength == CRSF_FRAME_ORIGIN_DEST_SIZE + crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE))
+                                {
+                                    const crsfProtocol::crsf_payload_link_statistics_t *linkStatisticsPayload = (const crsfProtocol::crsf_payload_link_statistics_t *)&rxFrame.frame.payload;
+
+                                    /* Decode the link statistics. */
+                                    linkStatistics.rssi = (linkStatisticsPayload->active_antenna ? linkStatisticsPayload->uplink_rssi_2 : linkStatisticsPayload->uplink_rssi_1);
+                                    linkStatistics.lqi = linkStatisticsPayload->uplink_link_quality;
+                                    linkStatistics.snr = linkStatisticsPayload->uplink_snr;
+                                    linkStatistics.tx_power = (linkStatisticsPayload->uplink_tx_power < 9) ? tx_power_table[linkStatisticsPayload->uplink_tx_power] : 0;
+                                    linkStatisticsReceived = true;
+                                }
+                            }
+                            break;
+
+                        case crsfProtocol::CRSF_FRAMETYPE_DEVICE_PING:
+                            incrementHealthCounter<Config>(counters.otherFrames);
+                            CRSF_IF_CONSTEXPR(Config::telemetryEnabled && Config::telemetryDeviceInfoEnabled)
+                            {
+                                // Pings are extended frames: the payload starts with the destination and origin addresses.
+                                if (rxFrame.frame.frameLength >= crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC + crsfProtocol::CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE &&
+                                    (rxFrame.frame.payload[0] == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER || rxFrame.frame.payload[0] == crsfProtocol::CRSF_ADDRESS_BROADCAST))
+                                {
+                                    devicePingOrigin = rxFrame.frame.payload[1];
+                                    devicePingReceived = true;
+                                }
+                            }
+                            break;
+
+                        case crsfProtocol::CRSF_FRAMETYPE_PARAMETER_READ:
+                        case crsfProtocol::CRSF_FRAMETYPE_PARAMETER_WRITE:
+                            incrementHealthCounter<Config>(counters.otherFrames);
+                            CRSF_IF_CONSTEXPR(Config::parametersEnabled)
+                            {
+                                // Keep the request for the parameter server, which answers it after this frame.
+                                if (rxFrame.frame.frameLength >= crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC + crsfProtocol::CRSF_FRAME_PARAMETER_REQUEST_PAYLOAD_SIZE &&
+                                    rxFrame.frame.payload[0] == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER)
+                                {
+                                    memcpy(parameterRequest, rxFrame.raw, fullFrameLength);
+                                    parameterRequestReceived = true;
+                                }
+                            }
+                            break;
+
+                        case crsfProtocol::CRSF_FRAMETYPE_COMMAND:
+                            incrementHealthCounter<Config>(counters.otherFrames);
+                            CRSF_IF_CONSTEXPR(Config::commandsEnabled)
+                            {
+                                // The inner CRC sits just before the frame's CRC, and covers the frame type to the end of the command's data.
+                                if (rxFrame.frame.frameLength >= crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC + crsfProtocol::CRSF_FRAME_COMMAND_PAYLOAD_SIZE_MIN &&
+                                    (rxFrame.frame.payload[0] == crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER || rxFrame.frame.payload[0] == crsfProtocol::CRSF_ADDRESS_BROADCAST))
+                                {
+                                    if (crc8.calculateCommand(&rxFrame.raw[2], rxFrame.frame.frameLength - 2) == rxFrame.raw[rxFrame.frame.frameLength])
+                                    {
+                                        memcpy(command, rxFrame.raw, fullFrameLength);
+                                        commandReceived = true;
+                                    }
+                                    else
+                                    {
+                                        incrementHealthCounter<Config>(counters.commandCrcErrors);
+                                    }
+                                }
+                            }
+                            break;
+
+                        default:
+                            incrementHealthCounter<Config>(counters.otherFrames);
+                            break;
+                    }
+                }
+                else
+                {
+                    frameType = 0;
+                    incrementHealthCounter<Config>(counters.crcErrors);
+                    trace.record(TRACE_EVENT_CRC_ERROR, rxFrame.frame.type, rxFrame.frame.frameLength, currentTime);
+                }
+                // #ifdef USE_DMA
+                //                 memset_dma(&rxFrame, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX); // ◄ This line works fine on both SAMD21 and SAMD51.
+                // #else
+                memset(rxFrame.raw, 0, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+                // #endif
+                framePosition = 0;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace serialReceiverLayer
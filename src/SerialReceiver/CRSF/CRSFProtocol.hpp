@@ -71,12 +71,59 @@ namespace crsfProtocol
         CRSF_FRAME_BARO_ALTITUDE_PAYLOAD_SIZE = 4, // TBS is 2, ExpressLRS is 4 (combines vario)
         CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE = 8,
         CRSF_FRAME_DEVICE_INFO_PAYLOAD_SIZE = 48,
+        CRSF_FRAME_DEVICE_INFO_FIELDS_SIZE = 14, // Serial number, hardware and software versions, parameter count and parameter protocol version. These follow the name.
+        CRSF_FRAME_DEVICE_PING_PAYLOAD_SIZE = 2, // Destination and origin.
+        CRSF_FRAME_PARAMETER_REQUEST_PAYLOAD_SIZE = 4, // Destination, origin, parameter number, and the chunk number (reads) or the first byte of the value (writes).
+        CRSF_FRAME_COMMAND_PAYLOAD_SIZE_MIN = 5, // Destination, origin, command, subcommand and the inner CRC. The subcommand's data sits before the inner CRC.
+        CRSF_FRAME_COMMAND_SPEED_PROPOSAL_SIZE = 5, // Port and baud rate (uint32, big endian).
+        CRSF_FRAME_COMMAND_SPEED_RESPONSE_SIZE = 2, // Port and whether the proposal was accepted.
         CRSF_FRAME_FLIGHT_MODE_PAYLOAD_SIZE = 16,
         CRSF_FRAME_HEARTBEAT_PAYLOAD_SIZE = 2,
         CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE = 10,
         CRSF_FRAME_LINK_STATISTICS_TX_PAYLOAD_SIZE = 6,
         CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE = 22,
-        CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE = 6
+        CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE = 6,
+        CRSF_FRAME_RADIO_ID_TIMING_PAYLOAD_SIZE = 11 // Destination, origin, subtype, interval and offset.
+    };
+
+    // Subtypes of the Radio ID frame, which TX modules send to the handset.
+    enum radioIdSubtype_e
+    {
+        CRSF_RADIO_ID_TIMING_CORRECTION = 0x10, // The module's RF packet interval and how early the handset's RC frames arrive, both in 0.1 us.
+    };
+
+    // Commands, in the first byte after the addresses of a command frame.
+    enum command_e
+    {
+        CRSF_COMMAND_FC = 0x01,
+        CRSF_COMMAND_BLUETOOTH = 0x03,
+        CRSF_COMMAND_OSD = 0x05,
+        CRSF_COMMAND_VTX = 0x08,
+        CRSF_COMMAND_LED = 0x09,
+        CRSF_COMMAND_GENERAL = 0x0A,
+        CRSF_COMMAND_RX = 0x10,
+        CRSF_COMMAND_ACK = 0xFF // Answers a command. The data is the command, the subcommand, whether it was done, and some text.
+    };
+
+    // Subcommands, in the byte after the command.
+    enum subCommand_e
+    {
+        CRSF_COMMAND_FC_FORCE_DISARM = 0x01,
+        CRSF_COMMAND_FC_SCALE_CHANNEL = 0x02,
+        CRSF_COMMAND_GENERAL_SPEED_PROPOSAL = 0x70, // A device asks to change the baud rate of one of its ports.
+        CRSF_COMMAND_GENERAL_SPEED_RESPONSE = 0x71, // The answer to a speed proposal.
+        CRSF_COMMAND_RX_BIND = 0x01,                // Puts the receiver into bind mode.
+        CRSF_COMMAND_RX_CANCEL_BIND = 0x02,
+        CRSF_COMMAND_RX_SET_BIND_ID = 0x03
+    };
+
+    // Resolution field of the subset RC channels frame (bits 5 and 6 of its first payload byte).
+    enum subsetRcResolution_e
+    {
+        CRSF_SUBSET_RC_RESOLUTION_10B = 0,
+        CRSF_SUBSET_RC_RESOLUTION_11B = 1,
+        CRSF_SUBSET_RC_RESOLUTION_12B = 2,
+        CRSF_SUBSET_RC_RESOLUTION_13B = 3
     };
 
     enum frameLength_e
@@ -111,6 +158,7 @@ namespace crsfProtocol
         CRSF_FRAMETYPE_PARAMETER_READ = 0x2C,
         CRSF_FRAMETYPE_PARAMETER_WRITE = 0x2D,
         CRSF_FRAMETYPE_COMMAND = 0x32,
+        CRSF_FRAMETYPE_RADIO_ID = 0x3A,
 
         CRSF_FRAMETYPE_MSP_REQ = 0x7A,
         CRSF_FRAMETYPE_MSP_RESP = 0x7B,
@@ -0,0 +1,587 @@
+/**
+ * @file Capture.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Reads and writes timestamped captures of the raw bytes received from a CRSF receiver.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Capture.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+namespace serialReceiverLayer
+{
+    static void writeU16LE(uint8_t *buffer, uint16_t value)
+    {
+        buffer[0] = (uint8_t)value;
+        buffer[1] = (uint8_t)(value >> 8);
+    }
+
+    static void writeU32LE(uint8_t *buffer, uint32_t value)
+    {
+        writeU16LE(buffer, (uint16_t)value);
+        writeU16LE(buffer + 2, (uint16_t)(value >> 16));
+    }
+
+    static void writeU64LE(uint8_t *buffer, uint64_t value)
+    {
+        writeU32LE(buffer, (uint32_t)value);
+        writeU32LE(buffer + 4, (uint32_t)(value >> 32));
+    }
+
+    static uint16_t readU16LE(const uint8_t *buffer)
+    {
+        return (uint16_t)(buffer[0] | (buffer[1] << 8));
+    }
+
+    static uint32_t readU32LE(const uint8_t *buffer)
+    {
+        return (uint32_t)readU16LE(buffer) | ((uint32_t)readU16LE(buffer + 2) << 16);
+    }
+
+    static uint64_t readU64LE(const uint8_t *buffer)
+    {
+        return (uint64_t)readU32LE(buffer) | ((uint64_t)readU32LE(buffer + 4) << 32);
+    }
+
+    CaptureWriter::CaptureWriter()
+    {
+        _file = nullptr;
+        _position = 0;
+        _indexed = false;
+    }
+
+    CaptureWriter::~CaptureWriter()
+    {
+        end();
+    }
+
+    /**
+     * @brief Creates (or replaces) the capture file at path and writes its header.
+     *
+     * @param indexed Decode the capture as it is written, and append an index to it in end().
+     * This costs a little CPU time while writing, and a few bytes per chunk of memory until end().
+     */
+    bool CaptureWriter::begin(const char *path, uint32_t baudRate, bool indexed)
+    {
+        end();
+
+        _file = fopen(path, "wb");
+        if (_file == nullptr)
+        {
+            return false;
+        }
+
+        uint8_t header[CAPTURE_HEADER_SIZE];
+        memset(header, 0, sizeof(header));
+        memcpy(header, "CFAC", 4);
+        writeU16LE(header + 4, CAPTURE_VERSION);
+        writeU32LE(header + 8, baudRate);
+
+        if (fwrite(header, 1, sizeof(header), _file) != sizeof(header))
+        {
+            fclose(_file);
+            _file = nullptr;
+            return false;
+        }
+
+        _position = CAPTURE_HEADER_SIZE;
+        _indexed = indexed;
+        _segments.clear();
+        _entries.clear();
+        _decoder.begin();
+        _decoder.setFrameTime(baudRate > 0 ? baudRate : (uint32_t)crsfProtocol::BAUD_RATE, 10);
+        return true;
+    }
+
+    /**
+     * @brief Writes the index (if the capture is indexed) and closes the file.
+     *
+     * @return false if anything could not be written.
+     */
+    bool CaptureWriter::end()
+    {
+        if (_file == nullptr)
+        {
+            return true;
+        }
+
+        bool written = !_indexed || _writeIndex();
+        written = fclose(_file) == 0 && written;
+        _file = nullptr;
+
+        _segments.clear();
+        _segments.shrink_to_fit();
+        _entries.clear();
+        _entries.shrink_to_fit();
+        return written;
+    }
+
+    /**
+     * @brief Appends the bytes from one read of the serial port. Chunks longer than CAPTURE_CHUNK_SIZE_MAX are split.
+     */
+    bool CaptureWriter::writeChunk(uint64_t timestampUs, const uint8_t *data, size_t length)
+    {
+        if (_file == nullptr)
+        {
+            return false;
+        }
+
+        do
+        {
+            const uint16_t chunkLength = (uint16_t)(length < CAPTURE_CHUNK_SIZE_MAX ? length : CAPTURE_CHUNK_SIZE_MAX);
+            uint8_t header[CAPTURE_CHUNK_HEADER_SIZE];
+            writeU64LE(header, timestampUs);
+            writeU16LE(header + 8, chunkLength);
+
+            if (_indexed)
+            {
+                _index(timestampUs, data, chunkLength);
+            }
+
+            if (fwrite(header, 1, sizeof(header), _file) != sizeof(header) || fwrite(data, 1, chunkLength, _file) != chunkLength)
+            {
+                return false;
+            }
+
+            _position += CAPTURE_CHUNK_HEADER_SIZE + chunkLength;
+            data += chunkLength;
+            length -= chunkLength;
+        } while (length > 0);
+
+        return true;
+    }
+
+    /**
+     * @brief Adds the chunk about to be written at _position to the index.
+     * A chunk that arrives while the decoder is between frames gets an entry, and can start a new segment.
+     */
+    void CaptureWriter::_index(uint64_t timestampUs, const uint8_t *data, uint16_t length)
+    {
+        if (_decoder.isIdle())
+        {
+            if (_segments.empty() || timestampUs - _segments.back().firstTimestampUs >= CAPTURE_INDEX_SEGMENT_US ||
+                _position - _segments.back().offset > UINT32_MAX)
+            {
+                captureIndexSegment_t segment;
+                memset(&segment, 0, sizeof(segment));
+                segment.firstTimestampUs = timestampUs;
+                segment.offset = _position;
+                segment.firstEntry = (uint32_t)_entries.size();
+                segment.lqiMin = -1;
+                segment.rssiMax = -1;
+                _segments.push_back(segment);
+            }
+
+            captureIndexSegment_t *segment = &_segments.back();
+            indexEntry_t entry;
+            entry.timeUs = (uint32_t)(timestampUs - segment->firstTimestampUs);
+            entry.offset = (uint32_t)(_position - segment->offset);
+            _entries.push_back(entry);
+            segment->entryCount++;
+        }
+
+        captureIndexSegment_t *segment = &_segments.back();
+        segment->lastTimestampUs = timestampUs;
+
+        crsfCounters_t before;
+        _decoder.getCounters(&before);
+
+        uint16_t rcChannels[crsfProtocol::RC_CHANNEL_COUNT];
+        link_statistics_t linkStatistics;
+        for (uint16_t i = 0; i < length; i++)
+        {
+            if (_decoder.receiveFrames(data[i], (uint32_t)timestampUs))
+            {
+                _decoder.getRcChannels(rcChannels);
+                if (_decoder.getLinkStatistics(&linkStatistics))
+                {
+                    segment->lqiMin = segment->lqiMin < 0 ? linkStatistics.lqi : min(segment->lqiMin, linkStatistics.lqi);
+                    segment->rssiMax = max(segment->rssiMax, linkStatistics.rssi);
+                }
+            }
+        }
+
+        crsfCounters_t after;
+        _decoder.getCounters(&after);
+        segment->rcChannelsFrames += after.rcChannelsFrames - before.rcChannelsFrames;
+        segment->linkStatisticsFrames += after.linkStatisticsFrames - before.linkStatisticsFrames;
+        segment->crcErrors += after.crcErrors - before.crcErrors;
+    }
+
+    bool CaptureWriter::_writeIndex()
+    {
+        const uint64_t indexOffset = _position;
+        uint8_t buffer[CAPTURE_INDEX_SEGMENT_SIZE];
+
+        for (size_t i = 0; i < _segments.size(); i++)
+        {
+            const captureIndexSegment_t *segment = &_segments[i];
+            writeU64LE(buffer, segment->firstTimestampUs);
+            writeU64LE(buffer + 8, segment->lastTimestampUs);
+            writeU64LE(buffer + 16, segment->offset);
+            writeU32LE(buffer + 24, segment->firstEntry);
+            writeU32LE(buffer + 28, segment->entryCount);
+            writeU32LE(buffer + 32, segment->rcChannelsFrames);
+            writeU32LE(buffer + 36, segment->linkStatisticsFrames);
+            writeU32LE(buffer + 40, segment->crcErrors);
+            writeU16LE(buffer + 44, (uint16_t)segment->lqiMin);
+            writeU16LE(buffer + 46, (uint16_t)segment->rssiMax);
+            if (fwrite(buffer, 1, CAPTURE_INDEX_SEGMENT_SIZE, _file) != CAPTURE_INDEX_SEGMENT_SIZE)
+            {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < _entries.size(); i++)
+        {
+            writeU32LE(buffer, _entries[i].timeUs);
+            writeU32LE(buffer + 4, _entries[i].offset);
+            if (fwrite(buffer, 1, CAPTURE_INDEX_ENTRY_SIZE, _file) != CAPTURE_INDEX_ENTRY_SIZE)
+            {
+                return false;
+            }
+        }
+
+        memset(buffer, 0, CAPTURE_INDEX_TRAILER_SIZE);
+        memcpy(buffer, "CFAI", 4);
+        writeU32LE(buffer + 4, (uint32_t)_segments.size());
+        writeU32LE(buffer + 8, (uint32_t)_entries.size());
+        writeU64LE(buffer + 16, indexOffset);
+        return fwrite(buffer, 1, CAPTURE_INDEX_TRAILER_SIZE, _file) == CAPTURE_INDEX_TRAILER_SIZE;
+    }
+
+    CaptureReader::CaptureReader(const uint8_t *data, size_t size)
+    {
+        _data = data;
+        _size = size;
+        _position = 0;
+        _baudRate = 0;
+        _segments = nullptr;
+        _entries = nullptr;
+        _segmentCount = 0;
+        _entryCount = 0;
+    }
+
+    /**
+     * @brief Checks the header, and finds the index if there is one. Call this before next().
+     *
+     * @return false if this is not a capture, or is from a newer version of the format.
+     */
+    bool CaptureReader::readHeader()
+    {
+        if (_data == nullptr || _size < CAPTURE_HEADER_SIZE || memcmp(_data, "CFAC", 4) != 0)
+        {
+            return false;
+        }
+
+        const uint16_t version = readU16LE(_data + 4);
+        if (version == 0 || version > CAPTURE_VERSION)
+        {
+            return false;
+        }
+
+        _baudRate = readU32LE(_data + 8);
+        _position = CAPTURE_HEADER_SIZE;
+
+        // The index is only trusted if the trailer accounts for every byte after the chunks.
+        if (_size >= CAPTURE_HEADER_SIZE + CAPTURE_INDEX_TRAILER_SIZE)
+        {
+            const uint8_t *trailer = _data + _size - CAPTURE_INDEX_TRAILER_SIZE;
+            const uint64_t segmentCount = readU32LE(trailer + 4);
+            const uint64_t entryCount = readU32LE(trailer + 8);
+            const uint64_t indexOffset = readU64LE(trailer + 16);
+
+            if (memcmp(trailer, "CFAI", 4) == 0 && indexOffset >= CAPTURE_HEADER_SIZE && indexOffset < _size &&
+                _size - indexOffset == segmentCount * CAPTURE_INDEX_SEGMENT_SIZE + entryCount * CAPTURE_INDEX_ENTRY_SIZE + CAPTURE_INDEX_TRAILER_SIZE)
+            {
+                _segments = _data + indexOffset;
+                _entries = _segments + segmentCount * CAPTURE_INDEX_SEGMENT_SIZE;
+                _segmentCount = (uint32_t)segmentCount;
+                _entryCount = (uint32_t)entryCount;
+                _size = (size_t)indexOffset;
+            }
+        }
+
+        return true;
+    }
+
+    uint32_t CaptureReader::getBaudRate()
+    {
+        return _baudRate;
+    }
+
+    /**
+     * @brief Moves on to the next chunk.
+     *
+     * @return false at the end of the capture. A chunk that was cut short (eg because the capture was still being written) ends it too.
+     */
+    bool CaptureReader::next(captureChunk_t *chunk)
+    {
+        if (_position + CAPTURE_CHUNK_HEADER_SIZE > _size)
+        {
+            return false;
+        }
+
+        const uint16_t length = readU16LE(_data + _position + 8);
+        if (_position + CAPTURE_CHUNK_HEADER_SIZE + length > _size)
+        {
+            return false;
+        }
+
+        chunk->timestampUs = readU64LE(_data + _position);
+        chunk->length = length;
+        chunk->data = _data + _position + CAPTURE_CHUNK_HEADER_SIZE;
+        _position += CAPTURE_CHUNK_HEADER_SIZE + length;
+        return true;
+    }
+
+    /**
+     * @brief Returns the offset of the next chunk from the start of the capture.
+     */
+    size_t CaptureReader::getPosition()
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Moves to the chunk at position, which must be an offset that getPosition() returned earlier.
+     */
+    void CaptureReader::setPosition(size_t position)
+    {
+        _position = position;
+    }
+
+    /**
+     * @brief Returns the offset just past the last chunk, ie where the index starts (if there is one).
+     */
+    size_t CaptureReader::getEnd()
+    {
+        return _size;
+    }
+
+    bool CaptureReader::hasIndex()
+    {
+        return _segments != nullptr;
+    }
+
+    uint32_t CaptureReader::getSegmentCount()
+    {
+        return _segmentCount;
+    }
+
+    bool CaptureReader::getSegment(uint32_t index, captureIndexSegment_t *segment)
+    {
+        if (index >= _segmentCount)
+        {
+            return false;
+        }
+
+        const uint8_t *buffer = _segments + (size_t)index * CAPTURE_INDEX_SEGMENT_SIZE;
+        segment->firstTimestampUs = readU64LE(buffer);
+        segment->lastTimestampUs = readU64LE(buffer + 8);
+        segment->offset = readU64LE(buffer + 16);
+        segment->firstEntry = readU32LE(buffer + 24);
+        segment->entryCount = readU32LE(buffer + 28);
+        segment->rcChannelsFrames = readU32LE(buffer + 32);
+        segment->linkStatisticsFrames = readU32LE(buffer + 36);
+        segment->crcErrors = readU32LE(buffer + 40);
+        segment->lqiMin = (int16_t)readU16LE(buffer + 44);
+        segment->rssiMax = (int16_t)readU16LE(buffer + 46);
+        return true;
+    }
+
+    /**
+     * @brief Gets the time of the first chunk.
+     *
+     * @return false if the capture has no chunks.
+     */
+    bool CaptureReader::getStartTime(uint64_t *timestampUs)
+    {
+        if (_size < CAPTURE_HEADER_SIZE + CAPTURE_CHUNK_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        *timestampUs = readU64LE(_data + CAPTURE_HEADER_SIZE);
+        return true;
+    }
+
+    /**
+     * @brief Moves to the first chunk at or after timestampUs that starts a frame, so that a new decoder can start there.
+     * With an index this is two binary searches. Without one, the chunks are walked from the start,
+     * and the chunk that the reader stops at may be part way through a frame.
+     *
+     * @return false if there is no such chunk. The reader is then at the end of the capture.
+     */
+    bool CaptureReader::seek(uint64_t timestampUs)
+    {
+        captureChunk_t chunk;
+
+        if (!hasIndex())
+        {
+            _position = CAPTURE_HEADER_SIZE;
+            size_t position = _position;
+            while (next(&chunk))
+            {
+                if (chunk.timestampUs >= timestampUs)
+                {
+                    _position = position;
+                    return true;
+                }
+                position = _position;
+            }
+            return false;
+        }
+
+        // The first segment that ends at or after timestampUs.
+        captureIndexSegment_t segment;
+        uint32_t low = 0;
+        uint32_t high = _segmentCount;
+        while (low < high)
+        {
+            const uint32_t middle = low + (high - low) / 2;
+            getSegment(middle, &segment);
+            if (segment.lastTimestampUs < timestampUs)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        // Its first entry at or after timestampUs. If the only chunks after timestampUs are part way through a frame, use the next segment.
+        for (uint32_t i = low; i < _segmentCount; i++)
+        {
+            getSegment(i, &segment);
+
+            uint32_t first = 0;
+            uint32_t last = segment.entryCount;
+            while (first < last)
+            {
+                const uint32_t middle = first + (last - first) / 2;
+                uint32_t timeUs;
+                uint32_t offset;
+                _getEntry(segment.firstEntry + middle, &timeUs, &offset);
+                if (segment.firstTimestampUs + timeUs < timestampUs)
+                {
+                    first = middle + 1;
+                }
+                else
+                {
+                    last = middle;
+                }
+            }
+
+            if (first < segment.entryCount)
+            {
+                uint32_t timeUs;
+                uint32_t offset;
+                _getEntry(segment.firstEntry + first, &timeUs, &offset);
+                _position = (size_t)(segment.offset + offset);
+                return true;
+            }
+        }
+
+        _position = _size;
+        return false;
+    }
+
+    void CaptureReader::_getEntry(uint32_t index, uint32_t *timeUs, uint32_t *offset)
+    {
+        const uint8_t *buffer = _entries + (size_t)min(index, _entryCount - 1) * CAPTURE_INDEX_ENTRY_SIZE;
+        *timeUs = readU32LE(buffer);
+        *offset = readU32LE(buffer + 4);
+    }
+
+    MappedFile::MappedFile()
+    {
+        _data = nullptr;
+        _size = 0;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const char *path)
+    {
+        close();
+
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void *data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        // The file is read once, front to back. Let the kernel read ahead aggressively.
+        madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+
+        _data = (const uint8_t *)data;
+        _size = (size_t)status.st_size;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_data != nullptr)
+        {
+            munmap((void *)_data, _size);
+            _data = nullptr;
+            _size = 0;
+        }
+    }
+
+    const uint8_t *MappedFile::getData()
+    {
+        return _data;
+    }
+
+    size_t MappedFile::getSize()
+    {
+        return _size;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,196 @@
+/**
+ * @file Capture.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Reads and writes timestamped captures of the raw bytes received from a CRSF receiver.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../CRSF/CRSF.hpp"
+#include "stdio.h"
+#include <vector>
+
+namespace serialReceiverLayer
+{
+/* Capture file format
+A capture is a header followed by chunks. Each chunk holds the bytes that one read from the serial port returned,
+with the time that they arrived, so that the decoder sees the same timing when the capture is played back.
+All fields are little endian.
+Header (16 bytes):
+- 4 bytes: "CFAC".
+- 2 bytes: format version (CAPTURE_VERSION).
+- 2 bytes: reserved, 0.
+- 4 bytes: the baud rate of the serial port.
+- 4 bytes: reserved, 0.
+Each chunk: timestamp in microseconds (8 bytes), length (2 bytes), then length bytes of data.
+
+From version 2, CaptureWriter::end() appends an index after the last chunk:
+- One entry per segment (CAPTURE_INDEX_SEGMENT_SIZE bytes each), in the order of captureIndexSegment_t.
+  A new segment starts every CAPTURE_INDEX_SEGMENT_US, and holds that stretch's summary statistics.
+- One entry per chunk that starts a frame (CAPTURE_INDEX_ENTRY_SIZE bytes each): its time (4 bytes) and its offset (4 bytes),
+  both relative to the start of its segment. A decoder that starts at one of these chunks decodes the same frames from there
+  on as one that started at the beginning of the capture.
+- Trailer (CAPTURE_INDEX_TRAILER_SIZE bytes): "CFAI", the number of segments (4 bytes), the number of entries (4 bytes),
+  4 reserved bytes, and the offset of the index (8 bytes).
+A capture that was cut short, or written without an index, has no trailer. It still reads, but cannot seek quickly. */
+#define CAPTURE_VERSION            2
+#define CAPTURE_HEADER_SIZE        16
+#define CAPTURE_CHUNK_HEADER_SIZE  10
+#define CAPTURE_CHUNK_SIZE_MAX     0xFFFF
+#define CAPTURE_INDEX_SEGMENT_US   1000000
+#define CAPTURE_INDEX_SEGMENT_SIZE 48
+#define CAPTURE_INDEX_ENTRY_SIZE   8
+#define CAPTURE_INDEX_TRAILER_SIZE 24
+
+    /**
+     * @brief The decoder configuration that captures are decoded with. It needs RC channels, link statistics and the
+     * health counters, whatever the receiver that made the capture was built with, and nothing else.
+     */
+    struct CaptureDecoderConfig : crsfForArduinoConfig::DefaultConfig
+    {
+        static constexpr bool rcEnabled = true;
+        static constexpr bool flightModesEnabled = false;
+        static constexpr bool linkStatisticsEnabled = true;
+        static constexpr bool telemetryEnabled = false;
+        static constexpr bool healthCountersEnabled = true;
+        static constexpr bool traceEnabled = false;
+        static constexpr bool blackboxEnabled = false;
+    };
+
+    typedef struct captureChunk_s
+    {
+        uint64_t timestampUs; // When the bytes arrived, in microseconds.
+        const uint8_t *data;  // Points into the capture. Only valid while the capture is.
+        uint16_t length;
+    } captureChunk_t;
+
+    typedef struct captureIndexSegment_s
+    {
+        uint64_t firstTimestampUs;     // Time of the segment's first chunk.
+        uint64_t lastTimestampUs;      // Time of the segment's last chunk.
+        uint64_t offset;               // Offset of the segment's first chunk, which always starts a frame.
+        uint32_t firstEntry;           // Index of the segment's first entry.
+        uint32_t entryCount;           // Chunks in the segment that start a frame.
+        uint32_t rcChannelsFrames;     // RC channels frames with a valid CRC.
+        uint32_t linkStatisticsFrames; // Link statistics frames with a valid CRC.
+        uint32_t crcErrors;            // Frames whose CRC did not match.
+        int16_t lqiMin;                // Worst uplink link quality (%), or -1 if there were no link statistics.
+        int16_t rssiMax;               // Weakest uplink RSSI (-dBm), or -1 if there were no link statistics.
+    } captureIndexSegment_t;
+
+    /**
+     * @brief Writes a capture file, one chunk at a time, and (unless told not to) builds its index on the way.
+     */
+    class CaptureWriter
+    {
+      public:
+        CaptureWriter();
+        ~CaptureWriter();
+
+        bool begin(const char *path, uint32_t baudRate = crsfProtocol::BAUD_RATE, bool indexed = true);
+        bool end();
+
+        bool writeChunk(uint64_t timestampUs, const uint8_t *data, size_t length);
+
+      private:
+        typedef struct indexEntry_s
+        {
+            uint32_t timeUs;
+            uint32_t offset;
+        } indexEntry_t;
+
+        FILE *_file;
+        uint64_t _position;
+        bool _indexed;
+        BasicCRSF<CaptureDecoderConfig> _decoder;
+        std::vector<captureIndexSegment_t> _segments;
+        std::vector<indexEntry_t> _entries;
+
+        void _index(uint64_t timestampUs, const uint8_t *data, uint16_t length);
+        bool _writeIndex();
+    };
+
+    /**
+     * @brief Walks the chunks of a capture that is already in memory (eg from a MappedFile).
+     * Nothing is copied. If the capture has an index, seek() jumps straight to a point in time.
+     */
+    class CaptureReader
+    {
+      public:
+        CaptureReader(const uint8_t *data, size_t size);
+
+        bool readHeader();
+        uint32_t getBaudRate();
+
+        bool next(captureChunk_t *chunk);
+        size_t getPosition();
+        void setPosition(size_t position);
+        size_t getEnd();
+
+        bool hasIndex();
+        uint32_t getSegmentCount();
+        bool getSegment(uint32_t index, captureIndexSegment_t *segment);
+        bool getStartTime(uint64_t *timestampUs);
+        bool seek(uint64_t timestampUs);
+
+      private:
+        const uint8_t *_data;
+        size_t _size;
+        size_t _position;
+        uint32_t _baudRate;
+
+        const uint8_t *_segments;
+        const uint8_t *_entries;
+        uint32_t _segmentCount;
+        uint32_t _entryCount;
+
+        void _getEntry(uint32_t index, uint32_t *timeUs, uint32_t *offset);
+    };
+
+    /**
+     * @brief Maps a whole file into memory, read-only. The kernel pages it in as it is read,
+     * so large files cost neither a copy nor a read() per block.
+     */
+    class MappedFile
+    {
+      public:
+        MappedFile();
+        ~MappedFile();
+
+        bool open(const char *path);
+        void close();
+
+        const uint8_t *getData();
+        size_t getSize();
+
+      private:
+        const uint8_t *_data;
+        size_t _size;
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
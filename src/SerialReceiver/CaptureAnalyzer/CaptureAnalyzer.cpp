@@ -0,0 +1,316 @@
+/**
+ * @file CaptureAnalyzer.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes captures in parallel and sums up the link quality, RSSI, packet rate, errors and failsafes in each of them.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "CaptureAnalyzer.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Construct a new Capture Analyzer.
+     *
+     * @param threadCount The number of threads to analyse captures on. 0 uses one thread per CPU.
+     */
+    CaptureAnalyzer::CaptureAnalyzer(unsigned threadCount)
+        : _pool(threadCount)
+    {
+        _paths = nullptr;
+        _perFile = nullptr;
+        _fromUs = 0;
+        _toUs = UINT64_MAX;
+    }
+
+    CaptureAnalyzer::~CaptureAnalyzer()
+    {
+    }
+
+    /**
+     * @brief Limits analyze() to part of each capture, eg from minute 37 to minute 40.
+     * The times are relative to the first chunk of each capture.
+     */
+    void CaptureAnalyzer::setTimeRange(uint64_t fromUs, uint64_t toUs)
+    {
+        _fromUs = fromUs;
+        _toUs = toUs;
+    }
+
+    /**
+     * @brief Analyses every capture in paths, spread over the analyzer's threads, and adds them all up into total.
+     *
+     * @param perFile count statistics, one for each path. Captures that cannot be read have invalidFiles set to 1.
+     * @param total The sum of the valid captures. May be nullptr.
+     */
+    void CaptureAnalyzer::analyze(const char *const *paths, size_t count, captureStatistics_t *perFile, captureStatistics_t *total)
+    {
+        _paths = paths;
+        _perFile = perFile;
+        _pool.run(count, _analyzeTask, this);
+
+        if (total != nullptr)
+        {
+            // Merge in path order, so that the total does not depend on which thread finished first.
+            memset(total, 0, sizeof(captureStatistics_t));
+            for (size_t i = 0; i < count; i++)
+            {
+                merge(total, &perFile[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Maps the capture at path into memory and analyses it.
+     */
+    bool CaptureAnalyzer::analyzeFile(const char *path, captureStatistics_t *statistics, uint64_t fromUs, uint64_t toUs)
+    {
+        MappedFile file;
+        if (!file.open(path))
+        {
+            memset(statistics, 0, sizeof(captureStatistics_t));
+            statistics->invalidFiles = 1;
+            return false;
+        }
+
+        return analyzeBuffer(file.getData(), file.getSize(), statistics, fromUs, toUs);
+    }
+
+    /**
+     * @brief Plays a capture through a CRSF decoder, chunk by chunk with the timestamps that were captured,
+     * so that frame timeouts happen just as they did on the receiver.
+     *
+     * @param fromUs, toUs The part of the capture to analyse, relative to its first chunk.
+     * If the capture has an index, the decoder starts right at fromUs instead of decoding everything before it.
+     * @return false if data is not a capture.
+     */
+    bool CaptureAnalyzer::analyzeBuffer(const uint8_t *data, size_t size, captureStatistics_t *statistics, uint64_t fromUs, uint64_t toUs)
+    {
+        memset(statistics, 0, sizeof(captureStatistics_t));
+
+        CaptureReader reader(data, size);
+        if (!reader.readHeader())
+        {
+            statistics->invalidFiles = 1;
+            return false;
+        }
+
+        uint64_t startUs = 0;
+        reader.getStartTime(&startUs);
+        if (fromUs > 0)
+        {
+            reader.seek(startUs + fromUs);
+        }
+
+        BasicCRSF<CaptureDecoderConfig> crsf;
+        crsf.begin();
+        crsf.setFrameTime(reader.getBaudRate() > 0 ? reader.getBaudRate() : (uint32_t)crsfProtocol::BAUD_RATE, 10);
+
+        uint16_t rcChannels[crsfProtocol::RC_CHANNEL_COUNT];
+        link_statistics_t linkStatistics;
+        captureChunk_t chunk;
+
+        bool started = false;
+        uint64_t firstUs = 0;
+        uint64_t lastUs = 0;
+        bool haveRcChannels = false;
+        uint64_t lastRcUs = 0;
+        bool failsafe = false;
+        uint64_t failsafeStartUs = 0;
+
+        while (reader.next(&chunk))
+        {
+            if (toUs != UINT64_MAX && chunk.timestampUs - startUs > toUs)
+            {
+                break;
+            }
+
+            if (!started)
+            {
+                firstUs = chunk.timestampUs;
+                started = true;
+            }
+            lastUs = chunk.timestampUs;
+
+            statistics->chunks++;
+            statistics->bytes += chunk.length;
+
+            const uint32_t currentTime = (uint32_t)chunk.timestampUs;
+            for (uint16_t i = 0; i < chunk.length; i++)
+            {
+                if (!crsf.receiveFrames(chunk.data[i], currentTime))
+                {
+                    continue;
+                }
+
+                if (crsf.getRcChannels(rcChannels))
+                {
+                    if (haveRcChannels && chunk.timestampUs - lastRcUs > statistics->maxRcGapUs)
+                    {
+                        statistics->maxRcGapUs = (uint32_t)min(chunk.timestampUs - lastRcUs, (uint64_t)UINT32_MAX);
+                    }
+                    haveRcChannels = true;
+                    lastRcUs = chunk.timestampUs;
+                }
+
+                if (crsf.getLinkStatistics(&linkStatistics))
+                {
+                    if (statistics->linkSamples == 0)
+                    {
+                        statistics->lqiMin = statistics->lqiMax = linkStatistics.lqi;
+                        statistics->rssiMin = statistics->rssiMax = linkStatistics.rssi;
+                    }
+                    statistics->linkSamples++;
+                    statistics->lqiSum += (uint16_t)linkStatistics.lqi;
+                    statistics->rssiSum += (uint16_t)linkStatistics.rssi;
+                    statistics->lqiMin = min(statistics->lqiMin, linkStatistics.lqi);
+                    statistics->lqiMax = max(statistics->lqiMax, linkStatistics.lqi);
+                    statistics->rssiMin = min(statistics->rssiMin, linkStatistics.rssi);
+                    statistics->rssiMax = max(statistics->rssiMax, linkStatistics.rssi);
+
+                    bool nowFailsafe;
+                    crsf.getFailSafe(&nowFailsafe);
+                    if (nowFailsafe && !failsafe)
+                    {
+                        statistics->failsafeEvents++;
+                        failsafeStartUs = chunk.timestampUs;
+                    }
+                    else if (!nowFailsafe && failsafe)
+                    {
+                        statistics->failsafeUs += chunk.timestampUs - failsafeStartUs;
+                    }
+                    failsafe = nowFailsafe;
+                }
+            }
+        }
+
+        if (failsafe)
+        {
+            statistics->failsafeUs += lastUs - failsafeStartUs;
+        }
+
+        crsfCounters_t counters;
+        crsf.getCounters(&counters);
+        statistics->rcChannelsFrames = counters.rcChannelsFrames;
+        statistics->linkStatisticsFrames = counters.linkStatisticsFrames;
+        statistics->otherFrames = counters.otherFrames;
+        statistics->crcErrors = counters.crcErrors;
+        statistics->lengthErrors = counters.lengthErrors;
+        statistics->timeouts = counters.timeouts;
+
+        statistics->files = 1;
+        statistics->durationUs = lastUs - firstUs;
+        return true;
+    }
+
+    /**
+     * @brief Adds statistics into total. Invalid captures only add to invalidFiles.
+     * Start total off zeroed.
+     */
+    void CaptureAnalyzer::merge(captureStatistics_t *total, const captureStatistics_t *statistics)
+    {
+        total->invalidFiles += statistics->invalidFiles;
+        if (statistics->files == 0)
+        {
+            return;
+        }
+
+        if (statistics->linkSamples > 0)
+        {
+            if (total->linkSamples == 0)
+            {
+                total->lqiMin = statistics->lqiMin;
+                total->lqiMax = statistics->lqiMax;
+                total->rssiMin = statistics->rssiMin;
+                total->rssiMax = statistics->rssiMax;
+            }
+            else
+            {
+                total->lqiMin = min(total->lqiMin, statistics->lqiMin);
+                total->lqiMax = max(total->lqiMax, statistics->lqiMax);
+                total->rssiMin = min(total->rssiMin, statistics->rssiMin);
+                total->rssiMax = max(total->rssiMax, statistics->rssiMax);
+            }
+        }
+
+        total->files += statistics->files;
+        total->bytes += statistics->bytes;
+        total->chunks += statistics->chunks;
+        total->durationUs += statistics->durationUs;
+        total->rcChannelsFrames += statistics->rcChannelsFrames;
+        total->linkStatisticsFrames += statistics->linkStatisticsFrames;
+        total->otherFrames += statistics->otherFrames;
+        total->crcErrors += statistics->crcErrors;
+        total->lengthErrors += statistics->lengthErrors;
+        total->timeouts += statistics->timeouts;
+        total->linkSamples += statistics->linkSamples;
+        total->lqiSum += statistics->lqiSum;
+        total->rssiSum += statistics->rssiSum;
+        total->failsafeEvents += statistics->failsafeEvents;
+        total->failsafeUs += statistics->failsafeUs;
+        total->maxRcGapUs = max(total->maxRcGapUs, statistics->maxRcGapUs);
+    }
+
+    /**
+     * @brief Returns the mean RC channels frame rate in Hz. For a total, this is the mean over all the captured time.
+     */
+    float CaptureAnalyzer::getPacketRate(const captureStatistics_t *statistics)
+    {
+        return statistics->durationUs > 0 ? (float)((double)statistics->rcChannelsFrames * 1000000.0 / (double)statistics->durationUs) : 0.0F;
+    }
+
+    float CaptureAnalyzer::getMeanLqi(const captureStatistics_t *statistics)
+    {
+        return statistics->linkSamples > 0 ? (float)((double)statistics->lqiSum / (double)statistics->linkSamples) : 0.0F;
+    }
+
+    float CaptureAnalyzer::getMeanRssi(const captureStatistics_t *statistics)
+    {
+        return statistics->linkSamples > 0 ? (float)((double)statistics->rssiSum / (double)statistics->linkSamples) : 0.0F;
+    }
+
+    /**
+     * @brief Returns the fraction of frames that were lost to CRC errors, length errors and timeouts.
+     */
+    float CaptureAnalyzer::getErrorRate(const captureStatistics_t *statistics)
+    {
+        const uint64_t errors = statistics->crcErrors + statistics->lengthErrors + statistics->timeouts;
+        const uint64_t frames = statistics->rcChannelsFrames + statistics->linkStatisticsFrames + statistics->otherFrames + errors;
+        return frames > 0 ? (float)((double)errors / (double)frames) : 0.0F;
+    }
+
+    ThreadPool *CaptureAnalyzer::getThreadPool()
+    {
+        return &_pool;
+    }
+
+    void CaptureAnalyzer::_analyzeTask(void *context, size_t index, unsigned worker)
+    {
+        (void)worker;
+        CaptureAnalyzer *analyzer = (CaptureAnalyzer *)context;
+        analyzeFile(analyzer->_paths[index], &analyzer->_perFile[index], analyzer->_fromUs, analyzer->_toUs);
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
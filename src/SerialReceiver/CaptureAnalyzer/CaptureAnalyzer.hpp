@@ -0,0 +1,94 @@
+/**
+ * @file CaptureAnalyzer.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes captures in parallel and sums up the link quality, RSSI, packet rate, errors and failsafes in each of them.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../CaptureDecoder/CaptureDecoder.hpp"
+
+namespace serialReceiverLayer
+{
+    typedef struct captureStatistics_s
+    {
+        uint32_t files;                 // Captures that were analysed. 1 for a single capture, or the number of valid captures in a total.
+        uint32_t invalidFiles;          // Captures that could not be opened or are not captures.
+        uint64_t bytes;                 // Bytes received.
+        uint64_t chunks;                // Reads from the serial port.
+        uint64_t durationUs;            // Time from the first chunk to the last.
+        uint64_t rcChannelsFrames;      // RC channels frames with a valid CRC.
+        uint64_t linkStatisticsFrames;  // Link statistics frames with a valid CRC.
+        uint64_t otherFrames;           // Frames of any other type with a valid CRC.
+        uint64_t crcErrors;             // Whole frames whose CRC did not match.
+        uint64_t lengthErrors;          // Frames whose length byte was out of range.
+        uint64_t timeouts;              // Partial frames that were dropped when the frame time ran out.
+        uint64_t linkSamples;           // Link statistics that were decoded. The LQ and RSSI figures below are over these.
+        uint64_t lqiSum;                // Sum of the uplink link quality (%), for the mean.
+        uint64_t rssiSum;               // Sum of the uplink RSSI (-dBm), for the mean.
+        int16_t lqiMin;                 // Worst link quality.
+        int16_t lqiMax;                 // Best link quality.
+        int16_t rssiMin;                // Strongest RSSI (-dBm).
+        int16_t rssiMax;                // Weakest RSSI (-dBm).
+        uint32_t failsafeEvents;        // Times that the link statistics crossed the failsafe thresholds in CFA_Config.hpp.
+        uint64_t failsafeUs;            // Time spent in failsafe.
+        uint32_t maxRcGapUs;            // Longest time between two RC channels frames.
+    } captureStatistics_t;
+
+    class CaptureAnalyzer
+    {
+      public:
+        CaptureAnalyzer(unsigned threadCount = 0);
+        ~CaptureAnalyzer();
+
+        void setTimeRange(uint64_t fromUs, uint64_t toUs = UINT64_MAX);
+        void analyze(const char *const *paths, size_t count, captureStatistics_t *perFile, captureStatistics_t *total);
+
+        static bool analyzeFile(const char *path, captureStatistics_t *statistics, uint64_t fromUs = 0, uint64_t toUs = UINT64_MAX);
+        static bool analyzeBuffer(const uint8_t *data, size_t size, captureStatistics_t *statistics, uint64_t fromUs = 0, uint64_t toUs = UINT64_MAX);
+        static void merge(captureStatistics_t *total, const captureStatistics_t *statistics);
+
+        static float getPacketRate(const captureStatistics_t *statistics);
+        static float getMeanLqi(const captureStatistics_t *statistics);
+        static float getMeanRssi(const captureStatistics_t *statistics);
+        static float getErrorRate(const captureStatistics_t *statistics);
+
+        ThreadPool *getThreadPool();
+
+      private:
+        ThreadPool _pool;
+
+        const char *const *_paths;
+        captureStatistics_t *_perFile;
+        uint64_t _fromUs;
+        uint64_t _toUs;
+
+        static void _analyzeTask(void *context, size_t index, unsigned worker);
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,411 @@
+/**
+ * @file CaptureDecoder.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes one large capture on several threads, with exactly the same results as decoding it from start to end.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "CaptureDecoder.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Construct a new Capture Decoder.
+     *
+     * @param threadCount The number of threads to decode on. 0 uses one thread per CPU.
+     * @param segmentSize The number of bytes of capture in each task.
+     */
+    CaptureDecoder::CaptureDecoder(unsigned threadCount, size_t segmentSize)
+        : _pool(threadCount)
+    {
+        _segmentSize = segmentSize > 0 ? segmentSize : CAPTURE_DECODER_SEGMENT_SIZE;
+        memset(&_statistics, 0, sizeof(_statistics));
+        _data = nullptr;
+        _baudRate = crsfProtocol::BAUD_RATE;
+        _segments = nullptr;
+    }
+
+    CaptureDecoder::~CaptureDecoder()
+    {
+    }
+
+    /**
+     * @brief Decodes a capture on the decoder's threads, and hands every RC channels and link statistics frame to sink in capture order.
+     *
+     * @param counters The decoder's health counters at the end of the capture.
+     * @return false if data is not a capture.
+     */
+    bool CaptureDecoder::decode(const uint8_t *data, size_t size, CaptureDecoderSink *sink, crsfCounters_t *counters)
+    {
+        memset(counters, 0, sizeof(crsfCounters_t));
+
+        CaptureReader reader(data, size);
+        if (!reader.readHeader())
+        {
+            return false;
+        }
+
+        _data = data;
+        _baudRate = reader.getBaudRate() > 0 ? reader.getBaudRate() : (uint32_t)crsfProtocol::BAUD_RATE;
+
+        std::vector<size_t> starts;
+        _split(size, &starts);
+        const size_t segmentCount = starts.size() - 1;
+        const size_t batchSize = min((size_t)_pool.getThreadCount() * CAPTURE_DECODER_BATCH_SEGMENTS, segmentCount);
+
+        // The decoder that has been running since the start of the capture, as decodeSerial() would.
+        decoder_t decoder;
+        _beginDecoder(&decoder, _baudRate);
+
+        _segments = new segment_t[batchSize];
+        for (size_t batchBegin = 0; batchBegin < segmentCount; batchBegin += batchSize)
+        {
+            const size_t count = min(batchSize, segmentCount - batchBegin);
+            for (size_t i = 0; i < count; i++)
+            {
+                _segments[i].begin = starts[batchBegin + i];
+                _segments[i].end = starts[batchBegin + i + 1];
+            }
+
+            _pool.run(count, _decodeTask, this);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                _reconcile(&_segments[i], &decoder, sink, counters);
+            }
+        }
+
+        delete[] _segments;
+        _segments = nullptr;
+        _statistics.segments += (uint32_t)segmentCount;
+        return true;
+    }
+
+    /**
+     * @brief Decodes a capture from start to end with one decoder, on the calling thread. This is what decode() has to match.
+     */
+    bool CaptureDecoder::decodeSerial(const uint8_t *data, size_t size, CaptureDecoderSink *sink, crsfCounters_t *counters)
+    {
+        memset(counters, 0, sizeof(crsfCounters_t));
+
+        CaptureReader reader(data, size);
+        if (!reader.readHeader())
+        {
+            return false;
+        }
+
+        decoder_t decoder;
+        _beginDecoder(&decoder, reader.getBaudRate() > 0 ? reader.getBaudRate() : (uint32_t)crsfProtocol::BAUD_RATE);
+
+        std::vector<frame_t> frames;
+        captureChunk_t chunk;
+        while (reader.next(&chunk))
+        {
+            const size_t offset = (size_t)(chunk.data - data);
+            for (uint16_t i = 0; i < chunk.length; i++)
+            {
+                _receive(&decoder, chunk.data[i], offset + i, chunk.timestampUs, &frames);
+            }
+
+            _emit(sink, &frames, 0);
+            frames.clear();
+        }
+
+        decoder.getCounters(counters);
+        return true;
+    }
+
+    void CaptureDecoder::getStatistics(captureDecoderStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(captureDecoderStatistics_t));
+    }
+
+    void CaptureDecoder::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    ThreadPool *CaptureDecoder::getThreadPool()
+    {
+        return &_pool;
+    }
+
+    /**
+     * @brief Decodes one segment with a fresh decoder, remembering where it was between frames near the start.
+     */
+    void CaptureDecoder::_decodeTask(void *context, size_t index, unsigned worker)
+    {
+        (void)worker;
+        CaptureDecoder *captureDecoder = (CaptureDecoder *)context;
+        segment_t *segment = &captureDecoder->_segments[index];
+
+        segment->frames.clear();
+        segment->syncPointCount = 0;
+        _beginDecoder(&segment->decoder, captureDecoder->_baudRate);
+
+        CaptureReader reader(captureDecoder->_data, segment->end);
+        reader.setPosition(segment->begin);
+
+        captureChunk_t chunk;
+        while (reader.next(&chunk))
+        {
+            const size_t offset = (size_t)(chunk.data - captureDecoder->_data);
+            for (uint16_t i = 0; i < chunk.length; i++)
+            {
+                if (segment->syncPointCount < CAPTURE_DECODER_SYNC_POINTS && segment->decoder.isIdle())
+                {
+                    syncPoint_t *syncPoint = &segment->syncPoints[segment->syncPointCount++];
+                    syncPoint->offset = offset + i;
+                    syncPoint->frameIndex = segment->frames.size();
+                    segment->decoder.getCounters(&syncPoint->counters);
+                }
+
+                _receive(&segment->decoder, chunk.data[i], offset + i, chunk.timestampUs, &segment->frames);
+            }
+        }
+    }
+
+    void CaptureDecoder::_beginDecoder(decoder_t *decoder, uint32_t baudRate)
+    {
+        decoder->begin();
+        decoder->setFrameTime(baudRate, 10);
+    }
+
+    /**
+     * @brief Returns true if chunk starts with a whole frame whose CRC is valid.
+     */
+    bool CaptureDecoder::_startsWithFrame(const captureChunk_t *chunk)
+    {
+        if (chunk->length < crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH)
+        {
+            return false;
+        }
+
+        const uint8_t frameLength = chunk->data[1];
+        const size_t frameSize = frameLength + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH;
+        if (frameLength < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC || frameSize > crsfProtocol::CRSF_FRAME_SIZE_MAX || frameSize > chunk->length)
+        {
+            return false;
+        }
+
+        genericCrc::GenericCRC crc;
+        return crc.calculate(chunk->data[2], (uint8_t *)chunk->data + 3, frameLength - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC) == chunk->data[frameSize - 1];
+    }
+
+    void CaptureDecoder::_receive(decoder_t *decoder, uint8_t rxByte, size_t offset, uint64_t timestampUs, std::vector<frame_t> *frames)
+    {
+        if (!decoder->receiveFrames(rxByte, (uint32_t)timestampUs))
+        {
+            return;
+        }
+
+        frame_t frame;
+        frame.offset = offset;
+        frame.timestampUs = timestampUs;
+
+        if (decoder->getRcChannels(frame.rcChannels))
+        {
+            frame.isRcChannels = true;
+            frames->push_back(frame);
+        }
+
+        if (decoder->getLinkStatistics(&frame.linkStatistics))
+        {
+            frame.isRcChannels = false;
+            frames->push_back(frame);
+        }
+    }
+
+    void CaptureDecoder::_emit(CaptureDecoderSink *sink, const std::vector<frame_t> *frames, size_t first)
+    {
+        for (size_t i = first; i < frames->size(); i++)
+        {
+            const frame_t *frame = &(*frames)[i];
+            if (frame->isRcChannels)
+            {
+                sink->onRcChannels(frame->offset, frame->timestampUs, frame->rcChannels);
+            }
+            else
+            {
+                sink->onLinkStatistics(frame->offset, frame->timestampUs, &frame->linkStatistics);
+            }
+        }
+    }
+
+    /**
+     * @brief Adds counters, less subtract (if it is not nullptr), into total.
+     */
+    void CaptureDecoder::_addCounters(crsfCounters_t *total, const crsfCounters_t *counters, const crsfCounters_t *subtract)
+    {
+        crsfCounters_t zero;
+        memset(&zero, 0, sizeof(zero));
+        if (subtract == nullptr)
+        {
+            subtract = &zero;
+        }
+
+        total->rcChannelsFrames += counters->rcChannelsFrames - subtract->rcChannelsFrames;
+        total->linkStatisticsFrames += counters->linkStatisticsFrames - subtract->linkStatisticsFrames;
+        total->otherFrames += counters->otherFrames - subtract->otherFrames;
+        total->crcErrors += counters->crcErrors - subtract->crcErrors;
+        total->lengthErrors += counters->lengthErrors - subtract->lengthErrors;
+        total->timeouts += counters->timeouts - subtract->timeouts;
+        total->commandCrcErrors += counters->commandCrcErrors - subtract->commandCrcErrors;
+    }
+
+    /**
+     * @brief Splits the capture into segments of about _segmentSize bytes. If the capture has an index, the segments start
+     * where the index's segments do. Otherwise, each one starts at a chunk that begins with a valid frame,
+     * if there is one within CAPTURE_DECODER_SEARCH_CHUNKS chunks.
+     *
+     * @param starts Receives the offset of the first chunk of each segment, followed by the end of the last chunk.
+     */
+    void CaptureDecoder::_split(size_t size, std::vector<size_t> *starts)
+    {
+        CaptureReader reader(_data, size);
+        reader.readHeader();
+        starts->push_back(reader.getPosition());
+
+        // The index already knows which chunks start a frame.
+        if (reader.hasIndex())
+        {
+            captureIndexSegment_t segment;
+            for (uint32_t i = 1; reader.getSegment(i, &segment); i++)
+            {
+                if (segment.offset - starts->back() >= _segmentSize)
+                {
+                    starts->push_back((size_t)segment.offset);
+                }
+            }
+
+            starts->push_back(reader.getEnd());
+            return;
+        }
+
+        size_t bytes = 0;
+        size_t searched = 0;
+        size_t fallback = 0;
+        captureChunk_t chunk;
+        for (;;)
+        {
+            const size_t position = reader.getPosition();
+            if (!reader.next(&chunk))
+            {
+                starts->push_back(position);
+                break;
+            }
+
+            if (bytes >= _segmentSize)
+            {
+                if (searched == 0)
+                {
+                    fallback = position;
+                }
+
+                if (_startsWithFrame(&chunk))
+                {
+                    starts->push_back(position);
+                    bytes = 0;
+                    searched = 0;
+                }
+                else if (++searched > CAPTURE_DECODER_SEARCH_CHUNKS)
+                {
+                    starts->push_back(fallback);
+                    bytes = position - fallback;
+                    searched = 0;
+                }
+            }
+
+            bytes += CAPTURE_CHUNK_HEADER_SIZE + chunk.length;
+        }
+    }
+
+    /**
+     * @brief Carries decoder (which has decoded everything before segment) on into segment, until it is between frames at
+     * one of the segment's sync points. Everything that the segment decoded from there on is then exactly what decoder
+     * would have decoded, so those frames and counters are used as they are, and decoder takes on the segment's end state.
+     */
+    void CaptureDecoder::_reconcile(segment_t *segment, decoder_t *decoder, CaptureDecoderSink *sink, crsfCounters_t *counters)
+    {
+        decoder->resetCounters();
+
+        std::vector<frame_t> frames;
+        const syncPoint_t *syncPoint = nullptr;
+        size_t sync = 0;
+        size_t redecoded = 0;
+
+        CaptureReader reader(_data, segment->end);
+        reader.setPosition(segment->begin);
+
+        captureChunk_t chunk;
+        while (syncPoint == nullptr && reader.next(&chunk))
+        {
+            const size_t offset = (size_t)(chunk.data - _data);
+            for (uint16_t i = 0; i < chunk.length; i++)
+            {
+                while (sync < segment->syncPointCount && segment->syncPoints[sync].offset < offset + i)
+                {
+                    sync++;
+                }
+
+                if (sync < segment->syncPointCount && segment->syncPoints[sync].offset == offset + i && decoder->isIdle())
+                {
+                    syncPoint = &segment->syncPoints[sync];
+                    break;
+                }
+
+                _receive(decoder, chunk.data[i], offset + i, chunk.timestampUs, &frames);
+                redecoded++;
+            }
+        }
+
+        crsfCounters_t decoderCounters;
+        decoder->getCounters(&decoderCounters);
+        _addCounters(counters, &decoderCounters, nullptr);
+        _emit(sink, &frames, 0);
+
+        if (syncPoint != nullptr)
+        {
+            crsfCounters_t segmentCounters;
+            segment->decoder.getCounters(&segmentCounters);
+            _addCounters(counters, &segmentCounters, &syncPoint->counters);
+            _emit(sink, &segment->frames, syncPoint->frameIndex);
+            *decoder = segment->decoder;
+
+            if (redecoded > 0)
+            {
+                _statistics.reconciled++;
+            }
+        }
+        else
+        {
+            _statistics.redecoded++;
+        }
+
+        _statistics.bytesRedecoded += redecoded;
+        segment->frames.clear();
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,140 @@
+/**
+ * @file CaptureDecoder.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes one large capture on several threads, with exactly the same results as decoding it from start to end.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../CRSF/CRSF.hpp"
+#include "../Capture/Capture.hpp"
+#include "../ThreadPool/ThreadPool.hpp"
+#include <vector>
+
+namespace serialReceiverLayer
+{
+#define CAPTURE_DECODER_SEGMENT_SIZE   (1024 * 1024) // Bytes of capture that each task decodes.
+#define CAPTURE_DECODER_BATCH_SEGMENTS 4             // Segments per thread that are decoded before their frames are handed over.
+#define CAPTURE_DECODER_SEARCH_CHUNKS  64            // Chunks searched past a segment's nominal start for one that starts with a valid frame.
+#define CAPTURE_DECODER_SYNC_POINTS    256           // Frame boundaries near its start that each segment remembers for reconciliation.
+
+    /**
+     * @brief Receives the frames that a CaptureDecoder decodes, in capture order, on the thread that called decode().
+     * offset is where the last byte of the frame is in the capture. The pointers are only valid for the duration of the call.
+     */
+    class CaptureDecoderSink
+    {
+      public:
+        virtual ~CaptureDecoderSink()
+        {
+        }
+
+        virtual void onRcChannels(uint64_t offset, uint64_t timestampUs, const uint16_t *rcChannels) = 0;
+        virtual void onLinkStatistics(uint64_t offset, uint64_t timestampUs, const link_statistics_t *linkStatistics) = 0;
+    };
+
+    typedef struct captureDecoderStatistics_s
+    {
+        uint32_t segments;       // Segments that the captures were split into.
+        uint32_t reconciled;     // Segments that started part way through a frame, and whose first frames were decoded again.
+        uint32_t redecoded;      // Segments that never lined up with the frames before them, and were decoded again in full.
+        uint64_t bytesRedecoded; // Bytes that were decoded a second time while reconciling.
+    } captureDecoderStatistics_t;
+
+    /**
+     * @brief Decodes a capture in segments, one per task on a ThreadPool.
+     * A segment starts at a chunk that the capture's index says starts a frame or, without an index, at a chunk that begins
+     * with a valid frame. A decoder that has been running since the start of the capture is (almost always) between frames there too. Each segment is decoded from there by its own decoder, as if
+     * nothing came before it. Then, in capture order, the decoder that finished the previous segment carries on into the
+     * segment until both decoders are between frames at the same byte. From there on they decode identically,
+     * so only the bytes before that point (usually none) are decoded twice, and the frames and counters
+     * come out exactly as decodeSerial() gives them.
+     */
+    class CaptureDecoder
+    {
+      public:
+        CaptureDecoder(unsigned threadCount = 0, size_t segmentSize = CAPTURE_DECODER_SEGMENT_SIZE);
+        ~CaptureDecoder();
+
+        bool decode(const uint8_t *data, size_t size, CaptureDecoderSink *sink, crsfCounters_t *counters);
+        static bool decodeSerial(const uint8_t *data, size_t size, CaptureDecoderSink *sink, crsfCounters_t *counters);
+
+        void getStatistics(captureDecoderStatistics_t *statistics);
+        void resetStatistics();
+        ThreadPool *getThreadPool();
+
+      private:
+        typedef BasicCRSF<CaptureDecoderConfig> decoder_t;
+
+        typedef struct frame_s
+        {
+            uint64_t offset;
+            uint64_t timestampUs;
+            bool isRcChannels; // Otherwise, link statistics.
+            uint16_t rcChannels[crsfProtocol::RC_CHANNEL_COUNT];
+            link_statistics_t linkStatistics;
+        } frame_t;
+
+        typedef struct syncPoint_s
+        {
+            size_t offset;           // The byte that the decoder was about to receive, between frames.
+            size_t frameIndex;       // The number of frames that the segment had decoded by then.
+            crsfCounters_t counters; // The segment's counters by then.
+        } syncPoint_t;
+
+        typedef struct segment_s
+        {
+            size_t begin; // Offset of the segment's first chunk.
+            size_t end;   // Offset of the chunk after its last one.
+            std::vector<frame_t> frames;
+            syncPoint_t syncPoints[CAPTURE_DECODER_SYNC_POINTS];
+            size_t syncPointCount;
+            decoder_t decoder; // The decoder's state at the end of the segment.
+        } segment_t;
+
+        ThreadPool _pool;
+        size_t _segmentSize;
+        captureDecoderStatistics_t _statistics;
+
+        const uint8_t *_data;
+        uint32_t _baudRate;
+        segment_t *_segments;
+        size_t _batchBegin;
+
+        static void _decodeTask(void *context, size_t index, unsigned worker);
+        static void _beginDecoder(decoder_t *decoder, uint32_t baudRate);
+        static bool _startsWithFrame(const captureChunk_t *chunk);
+        static void _receive(decoder_t *decoder, uint8_t rxByte, size_t offset, uint64_t timestampUs, std::vector<frame_t> *frames);
+        static void _emit(CaptureDecoderSink *sink, const std::vector<frame_t> *frames, size_t first);
+        static void _addCounters(crsfCounters_t *total, const crsfCounters_t *counters, const crsfCounters_t *subtract);
+
+        void _split(size_t size, std::vector<size_t> *starts);
+        void _reconcile(segment_t *segment, decoder_t *decoder, CaptureDecoderSink *sink, crsfCounters_t *counters);
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
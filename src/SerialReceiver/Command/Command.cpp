@@ -0,0 +1,144 @@
+/**
+ * @file Command.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This encodes and decodes CRSF command frames, which carry a second CRC inside their payload.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Command.hpp"
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Encodes command into frame, with both CRCs.
+     *
+     * @param frame At least crsfProtocol::CRSF_FRAME_SIZE_MAX bytes.
+     * @return The length of the whole frame, or 0 if the command's data does not fit in one frame.
+     */
+    uint8_t CommandFrame::encode(const command_t *command, uint8_t *frame)
+    {
+        if (command->dataLength > COMMAND_DATA_SIZE_MAX || (command->dataLength > 0 && command->data == nullptr))
+        {
+            return 0;
+        }
+
+        genericCrc::GenericCRC crc;
+        const uint8_t payloadLength = crsfProtocol::CRSF_FRAME_COMMAND_PAYLOAD_SIZE_MIN + command->dataLength;
+        frame[0] = crsfProtocol::CRSF_SYNC_BYTE;
+        frame[1] = payloadLength + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        frame[2] = crsfProtocol::CRSF_FRAMETYPE_COMMAND;
+        frame[3] = command->destination;
+        frame[4] = command->origin;
+        frame[5] = command->command;
+        frame[6] = command->subCommand;
+        if (command->dataLength > 0)
+        {
+            memcpy(&frame[7], command->data, command->dataLength);
+        }
+
+        // The inner CRC covers the frame type to the end of the data. The outer CRC then covers the inner CRC too.
+        const uint8_t innerCrcPosition = 7 + command->dataLength;
+        frame[innerCrcPosition] = crc.calculateCommand(&frame[2], innerCrcPosition - 2);
+        frame[innerCrcPosition + 1] = crc.calculate(2, frame[2], frame, innerCrcPosition + 1);
+        return innerCrcPosition + 2;
+    }
+
+    /**
+     * @brief Decodes a command frame that has already passed its outer CRC, and checks its inner CRC.
+     *
+     * @param frame The whole frame, from its sync byte to its CRC.
+     * @param command Filled in with the frame's fields. command->data points into frame.
+     * @return true if frame is a command frame, it is long enough, and its inner CRC matches.
+     */
+    bool CommandFrame::decode(const uint8_t *frame, command_t *command)
+    {
+        if (frame[2] != crsfProtocol::CRSF_FRAMETYPE_COMMAND ||
+            frame[1] < crsfProtocol::CRSF_FRAME_COMMAND_PAYLOAD_SIZE_MIN + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC ||
+            frame[1] > crsfProtocol::CRSF_PAYLOAD_SIZE_MAX + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC)
+        {
+            return false;
+        }
+
+        genericCrc::GenericCRC crc;
+        const uint8_t innerCrcPosition = frame[1];
+        if (crc.calculateCommand((uint8_t *)&frame[2], innerCrcPosition - 2) != frame[innerCrcPosition])
+        {
+            return false;
+        }
+
+        command->destination = frame[3];
+        command->origin = frame[4];
+        command->command = frame[5];
+        command->subCommand = frame[6];
+        command->data = &frame[7];
+        command->dataLength = innerCrcPosition - 7;
+        return true;
+    }
+
+    /**
+     * @brief Encodes a proposal to run port at baudRate. The device at destination answers with a speed response.
+     */
+    uint8_t CommandFrame::encodeSpeedProposal(uint8_t destination, uint8_t origin, uint8_t port, uint32_t baudRate, uint8_t *frame)
+    {
+        const uint8_t data[crsfProtocol::CRSF_FRAME_COMMAND_SPEED_PROPOSAL_SIZE] = {
+            port,
+            (uint8_t)(baudRate >> 24), (uint8_t)(baudRate >> 16), (uint8_t)(baudRate >> 8), (uint8_t)baudRate};
+        const command_t command = {destination, origin, crsfProtocol::CRSF_COMMAND_GENERAL, crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_PROPOSAL,
+                                   data, sizeof(data)};
+        return encode(&command, frame);
+    }
+
+    uint8_t CommandFrame::encodeSpeedResponse(uint8_t destination, uint8_t origin, uint8_t port, bool accepted, uint8_t *frame)
+    {
+        const uint8_t data[crsfProtocol::CRSF_FRAME_COMMAND_SPEED_RESPONSE_SIZE] = {port, (uint8_t)(accepted ? 1 : 0)};
+        const command_t command = {destination, origin, crsfProtocol::CRSF_COMMAND_GENERAL, crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_RESPONSE,
+                                   data, sizeof(data)};
+        return encode(&command, frame);
+    }
+
+    /**
+     * @brief Encodes a command that puts the receiver at destination into bind mode.
+     */
+    uint8_t CommandFrame::encodeBind(uint8_t destination, uint8_t origin, uint8_t *frame)
+    {
+        const command_t command = {destination, origin, crsfProtocol::CRSF_COMMAND_RX, crsfProtocol::CRSF_COMMAND_RX_BIND, nullptr, 0};
+        return encode(&command, frame);
+    }
+
+    /**
+     * @brief Reads the port and the baud rate out of a decoded speed proposal.
+     *
+     * @return false if command is not a speed proposal, or it is too short.
+     */
+    bool CommandFrame::decodeSpeedProposal(const command_t *command, uint8_t *port, uint32_t *baudRate)
+    {
+        if (command->command != crsfProtocol::CRSF_COMMAND_GENERAL || command->subCommand != crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_PROPOSAL ||
+            command->dataLength < crsfProtocol::CRSF_FRAME_COMMAND_SPEED_PROPOSAL_SIZE)
+        {
+            return false;
+        }
+
+        *port = command->data[0];
+        *baudRate = ((uint32_t)command->data[1] << 24) | ((uint32_t)command->data[2] << 16) | ((uint32_t)command->data[3] << 8) | command->data[4];
+        return true;
+    }
+} // namespace serialReceiverLayer
@@ -0,0 +1,65 @@
+/**
+ * @file Command.hpp
+ * @author CRSF for Arduino contributors
+ * @brief This encodes and decodes CRSF command frames, which carry a second CRC inside their payload.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../CRC/CRC.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Command frames
+A command frame is an extended frame: sync byte, length, CRSF_FRAMETYPE_COMMAND, destination, origin, command, subcommand,
+the subcommand's data, the inner CRC, then the frame's own CRC.
+The inner CRC is a CRC8 with the polynomial 0xBA (not the DVB S2 polynomial of the outer CRC), over the frame type to the end of the data. */
+#define COMMAND_DATA_SIZE_MAX (crsfProtocol::CRSF_PAYLOAD_SIZE_MAX - crsfProtocol::CRSF_FRAME_COMMAND_PAYLOAD_SIZE_MIN)
+
+    typedef struct command_s
+    {
+        uint8_t destination;
+        uint8_t origin;
+        uint8_t command;    // See crsfProtocol::command_e.
+        uint8_t subCommand; // See crsfProtocol::subCommand_e.
+        const uint8_t *data;
+        uint8_t dataLength;
+    } command_t;
+
+    /**
+     * @brief Encodes and decodes command frames, inner CRC included.
+     */
+    class CommandFrame final
+    {
+      public:
+        static uint8_t encode(const command_t *command, uint8_t *frame);
+        static bool decode(const uint8_t *frame, command_t *command);
+
+        static uint8_t encodeSpeedProposal(uint8_t destination, uint8_t origin, uint8_t port, uint32_t baudRate, uint8_t *frame);
+        static uint8_t encodeSpeedResponse(uint8_t destination, uint8_t origin, uint8_t port, bool accepted, uint8_t *frame);
+        static uint8_t encodeBind(uint8_t destination, uint8_t origin, uint8_t *frame);
+        static bool decodeSpeedProposal(const command_t *command, uint8_t *port, uint32_t *baudRate);
+    };
+} // namespace serialReceiverLayer
@@ -0,0 +1,413 @@
+/**
+ * @file DisplayPort.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Streams an OSD character grid to the handset over the telemetry downlink, as DisplayPort frames.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "DisplayPort.hpp"
+
+namespace serialReceiverLayer
+{
+    /* Where the fields of a DisplayPort frame sit. The row or the spans follow the header, and the CRC follows them. */
+    enum displayPortFrameField_e
+    {
+        DISPLAYPORT_FRAME_DESTINATION = 3,
+        DISPLAYPORT_FRAME_ORIGIN = 4,
+        DISPLAYPORT_FRAME_SUBCOMMAND = 5,
+        DISPLAYPORT_FRAME_HEADER_SIZE = 6,
+        DISPLAYPORT_FRAME_SPANS_END = crsfProtocol::CRSF_FRAME_SIZE_MAX - crsfProtocol::CRSF_FRAME_LENGTH_CRC
+    };
+
+    /**
+     * @brief Construct a new DisplayPort. The first frame that it sends clears the handset's canvas.
+     *
+     * @param rows How many rows the handset's canvas has, up to DISPLAYPORT_ROWS_MAX.
+     * @param columns How many columns the handset's canvas has, up to DISPLAYPORT_COLUMNS_MAX.
+     * @param byteRate How many bytes per second DisplayPort frames may take from the downlink.
+     */
+    DisplayPort::DisplayPort(uint8_t rows, uint8_t columns, uint16_t byteRate)
+    {
+        _rows = rows > 0 && rows <= DISPLAYPORT_ROWS_MAX ? rows : DISPLAYPORT_ROWS_MAX;
+        _columns = columns > 0 && columns <= DISPLAYPORT_COLUMNS_MAX ? columns : DISPLAYPORT_COLUMNS_MAX;
+        _encoding = DISPLAYPORT_ENCODING_ROWS;
+        memset(_screen, ' ', sizeof(_screen));
+        memset(_target, ' ', sizeof(_target));
+        _scanPosition = 0;
+        setByteRate(byteRate);
+        _budgetStarted = false;
+        _budgetTime = 0;
+        setRefreshInterval(DISPLAYPORT_REFRESH_INTERVAL);
+        _lastRefreshTime = 0;
+        _refreshRow = 0;
+        _frameLength = 0;
+        memset(_frame, 0, sizeof(_frame));
+        memset(&_statistics, 0, sizeof(_statistics));
+        redraw();
+    }
+
+    DisplayPort::~DisplayPort()
+    {
+    }
+
+    uint8_t DisplayPort::getRows()
+    {
+        return _rows;
+    }
+
+    uint8_t DisplayPort::getColumns()
+    {
+        return _columns;
+    }
+
+    /**
+     * @brief Sets how many bytes per second DisplayPort frames may take from the downlink.
+     * Leave room for the other telemetry: the downlink carries a few hundred bytes per second at most.
+     */
+    void DisplayPort::setByteRate(uint16_t byteRate)
+    {
+        _byteRate = byteRate > 0 ? byteRate : 1;
+    }
+
+    /**
+     * @brief Sets how often one row is sent again, whether it changed or not, in milliseconds.
+     * This repairs the canvas after the handset misses a frame, because frames are not acknowledged. 0 turns it off.
+     * Refreshes only go out when nothing has changed, and they come out of the same byte budget.
+     */
+    void DisplayPort::setRefreshInterval(uint32_t interval)
+    {
+        _refreshInterval = interval * 1000;
+    }
+
+    /**
+     * @brief Chooses how changes are sent. See displayPortEncoding_t.
+     * Only choose DISPLAYPORT_ENCODING_SPANS if your handset understands DISPLAYPORT_SUBCOMMAND_SPANS frames.
+     */
+    void DisplayPort::setEncoding(displayPortEncoding_t encoding)
+    {
+        _encoding = encoding;
+    }
+
+    /**
+     * @brief Blanks the screen that you draw on. The handset keeps showing the last flushed screen until flush().
+     */
+    void DisplayPort::clear()
+    {
+        memset(_screen, ' ', sizeof(_screen));
+    }
+
+    /**
+     * @brief Writes text at a row and column. Text that runs past the end of the row is cut off.
+     */
+    void DisplayPort::write(uint8_t row, uint8_t column, const char *text)
+    {
+        if (row >= _rows || text == nullptr)
+        {
+            return;
+        }
+
+        while (*text != '\0' && column < _columns)
+        {
+            _screen[row][column++] = *text++;
+        }
+    }
+
+    void DisplayPort::write(uint8_t row, uint8_t column, char character)
+    {
+        if (row < _rows && column < _columns)
+        {
+            _screen[row][column] = character;
+        }
+    }
+
+    /**
+     * @brief Makes the screen that you have drawn the one that the handset is sent.
+     * Only the rows (or spans) that differ from what the handset was last sent go out.
+     */
+    void DisplayPort::flush()
+    {
+        memcpy(_target, _screen, sizeof(_target));
+        _changesPending = true;
+    }
+
+    /**
+     * @brief Clears the handset's canvas and sends the whole screen again, eg. after the handset opened its canvas.
+     */
+    void DisplayPort::redraw()
+    {
+        memset(_shown, ' ', sizeof(_shown));
+        _clearPending = true;
+        _changesPending = true;
+    }
+
+    /**
+     * @brief Returns true when the handset has been sent everything up to the last flush().
+     */
+    bool DisplayPort::isIdle()
+    {
+        return !_clearPending && !_changesPending;
+    }
+
+    /**
+     * @brief Builds the next DisplayPort frame, if there is something to send and the byte budget allows it.
+     * Call this once per telemetry slot.
+     *
+     * @param currentTime The time in microseconds, from micros().
+     * @return The length of the frame that getFrame() holds, or 0 if there is nothing to send.
+     */
+    uint8_t DisplayPort::update(uint32_t currentTime)
+    {
+        if (!_budgetStarted)
+        {
+            _budgetStarted = true;
+            _budgetTime = currentTime;
+            _lastRefreshTime = currentTime;
+        }
+
+        // The budget is spent until some time in the future.
+        if ((int32_t)(_budgetTime - currentTime) > 0)
+        {
+            if (_clearPending || _changesPending)
+            {
+                _statistics.throttledSlots++;
+            }
+
+            return 0;
+        }
+
+        _frameLength = 0;
+        if (_clearPending)
+        {
+            _buildClear();
+        }
+        else if (_changesPending && _encoding == DISPLAYPORT_ENCODING_SPANS)
+        {
+            _buildSpans();
+        }
+        else if (_changesPending)
+        {
+            _buildRows();
+        }
+
+        if (_frameLength == 0 && _refreshInterval > 0 && currentTime - _lastRefreshTime >= _refreshInterval)
+        {
+            _lastRefreshTime = currentTime;
+            _buildRefresh(_refreshRow);
+            _refreshRow = (_refreshRow + 1) % _rows;
+        }
+
+        if (_frameLength == 0)
+        {
+            return 0;
+        }
+
+        // Unused budget does not pile up: an idle screen may only send one frame at once when it changes.
+        if ((int32_t)(currentTime - _budgetTime) > 0)
+        {
+            _budgetTime = currentTime;
+        }
+
+        _budgetTime += (uint32_t)_frameLength * 1000000 / _byteRate;
+        _statistics.frames++;
+        _statistics.bytes += _frameLength;
+        return _frameLength;
+    }
+
+    /**
+     * @brief Returns the frame that the last update() built. It stays valid until the next call to update().
+     */
+    const uint8_t *DisplayPort::getFrame()
+    {
+        return _frame;
+    }
+
+    void DisplayPort::getStatistics(displayPortStatistics_t *statistics)
+    {
+        if (statistics != nullptr)
+        {
+            *statistics = _statistics;
+        }
+    }
+
+    void DisplayPort::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    void DisplayPort::_buildClear()
+    {
+        _frameLength = DISPLAYPORT_FRAME_HEADER_SIZE;
+        _finishFrame(DISPLAYPORT_SUBCOMMAND_CLEAR);
+        _clearPending = false;
+    }
+
+    void DisplayPort::_buildRows()
+    {
+        uint8_t row;
+        if (!_findRow(&row))
+        {
+            _changesPending = false;
+            return;
+        }
+
+        _frameLength = DISPLAYPORT_FRAME_HEADER_SIZE;
+        _appendRow(row);
+        _finishFrame(DISPLAYPORT_SUBCOMMAND_UPDATE);
+        _scanPosition = (uint16_t)((row + 1) % _rows) * _columns;
+        _statistics.updates++;
+        _statistics.characters += _columns;
+
+        // Looking ahead lets isIdle() say so as soon as the last row that changed has gone out.
+        _changesPending = _findRow(&row);
+    }
+
+    void DisplayPort::_buildSpans()
+    {
+        uint8_t row;
+        uint8_t column;
+        uint8_t length;
+
+        _frameLength = DISPLAYPORT_FRAME_HEADER_SIZE;
+        while (_frameLength + DISPLAYPORT_SPAN_HEADER_SIZE < DISPLAYPORT_FRAME_SPANS_END)
+        {
+            if (!_findSpan(DISPLAYPORT_FRAME_SPANS_END - _frameLength - DISPLAYPORT_SPAN_HEADER_SIZE, &row, &column, &length))
+            {
+                _changesPending = false;
+                break;
+            }
+
+            _appendSpan(row, column, length);
+            _scanPosition = ((uint16_t)row * _columns + column + length) % ((uint16_t)_rows * _columns);
+            _statistics.updates++;
+            _statistics.characters += length;
+        }
+
+        if (_frameLength == DISPLAYPORT_FRAME_HEADER_SIZE)
+        {
+            _frameLength = 0;
+            return;
+        }
+
+        _finishFrame(DISPLAYPORT_SUBCOMMAND_SPANS);
+    }
+
+    void DisplayPort::_buildRefresh(uint8_t row)
+    {
+        _frameLength = DISPLAYPORT_FRAME_HEADER_SIZE;
+        if (_encoding == DISPLAYPORT_ENCODING_SPANS)
+        {
+            _appendSpan(row, 0, _columns);
+            _finishFrame(DISPLAYPORT_SUBCOMMAND_SPANS);
+        }
+        else
+        {
+            _appendRow(row);
+            _finishFrame(DISPLAYPORT_SUBCOMMAND_UPDATE);
+        }
+
+        _statistics.refreshes++;
+    }
+
+    /**
+     * @brief Finds the next row that has a character that the handset has not been sent, starting at the scan position.
+     */
+    bool DisplayPort::_findRow(uint8_t *row)
+    {
+        const uint8_t first = (uint8_t)(_scanPosition / _columns);
+        for (uint8_t checked = 0; checked < _rows; checked++)
+        {
+            const uint8_t r = (first + checked) % _rows;
+            if (memcmp(_target[r], _shown[r], _columns) != 0)
+            {
+                *row = r;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Finds the next span of characters that the handset has not been sent, starting at the scan position.
+     * A span goes on past unchanged characters as long as sending them is no longer than starting a new span.
+     */
+    bool DisplayPort::_findSpan(uint8_t maxLength, uint8_t *row, uint8_t *column, uint8_t *length)
+    {
+        const uint16_t cells = (uint16_t)_rows * _columns;
+        for (uint16_t checked = 0; checked < cells; checked++)
+        {
+            const uint16_t position = (_scanPosition + checked) % cells;
+            const uint8_t r = position / _columns;
+            const uint8_t c = position % _columns;
+            if (_target[r][c] == _shown[r][c])
+            {
+                continue;
+            }
+
+            uint8_t lastChanged = c;
+            for (uint8_t end = c + 1; end < _columns && end - c < maxLength && end - lastChanged <= DISPLAYPORT_SPAN_HEADER_SIZE; end++)
+            {
+                if (_target[r][end] != _shown[r][end])
+                {
+                    lastChanged = end;
+                }
+            }
+
+            *row = r;
+            *column = c;
+            *length = lastChanged - c + 1;
+            return true;
+        }
+
+        return false;
+    }
+
+    void DisplayPort::_appendRow(uint8_t row)
+    {
+        _frame[_frameLength++] = row;
+        memcpy(&_frame[_frameLength], _target[row], _columns);
+        memcpy(_shown[row], _target[row], _columns);
+        _frameLength += _columns;
+    }
+
+    void DisplayPort::_appendSpan(uint8_t row, uint8_t column, uint8_t length)
+    {
+        _frame[_frameLength++] = row;
+        _frame[_frameLength++] = column;
+        _frame[_frameLength++] = length;
+        memcpy(&_frame[_frameLength], &_target[row][column], length);
+        memcpy(&_shown[row][column], &_target[row][column], length);
+        _frameLength += length;
+    }
+
+    void DisplayPort::_finishFrame(uint8_t subcommand)
+    {
+        _frame[0] = crsfProtocol::CRSF_SYNC_BYTE;
+        _frame[1] = _frameLength - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH + crsfProtocol::CRSF_FRAME_LENGTH_CRC;
+        _frame[2] = crsfProtocol::CRSF_FRAMETYPE_DISPLAYPORT_CMD;
+        _frame[DISPLAYPORT_FRAME_DESTINATION] = crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER;
+        _frame[DISPLAYPORT_FRAME_ORIGIN] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+        _frame[DISPLAYPORT_FRAME_SUBCOMMAND] = subcommand;
+        _frame[_frameLength] = _crc.calculate(2, _frame[2], _frame, _frameLength);
+        _frameLength++;
+    }
+} // namespace serialReceiverLayer
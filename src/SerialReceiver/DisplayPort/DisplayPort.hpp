@@ -0,0 +1,144 @@
+/**
+ * @file DisplayPort.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Streams an OSD character grid to the handset over the telemetry downlink, as DisplayPort frames.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../CRC/CRC.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* DisplayPort protocol
+DisplayPort frames go from the flight controller to the handset. They are extended frames: destination, origin, subcommand,
+then what the subcommand carries:
+- DISPLAYPORT_SUBCOMMAND_UPDATE: a row, then that row's characters from its first column, one per column of the canvas.
+- DISPLAYPORT_SUBCOMMAND_CLEAR: nothing. The handset blanks its whole canvas.
+- DISPLAYPORT_SUBCOMMAND_SPANS: one or more spans, one after the other. A span is its row, its column and its length,
+  then that many characters, which replace what the canvas has there. Spans never run on to the next row.
+Rows and columns count from 0, at the top left. UPDATE and CLEAR are numbered and laid out as Betaflight sends them, so
+any handset that shows a Betaflight canvas understands them. SPANS is not part of that protocol: it is this library's own,
+and only a handset script that is written for it can read it. Handsets that do not know it ignore it, or misread it. */
+#define DISPLAYPORT_ROWS_MAX         8
+#define DISPLAYPORT_COLUMNS_MAX      32
+#define DISPLAYPORT_SPAN_HEADER_SIZE 3    // Row, column and length.
+#define DISPLAYPORT_REFRESH_INTERVAL 1000 // How often one row is sent again, whether it changed or not, in milliseconds.
+
+    typedef enum displayPortSubcommand_e
+    {
+        DISPLAYPORT_SUBCOMMAND_UPDATE = 0x01,
+        DISPLAYPORT_SUBCOMMAND_CLEAR = 0x02,
+        DISPLAYPORT_SUBCOMMAND_SPANS = 0x10 // Not standard. See above.
+    } displayPortSubcommand_t;
+
+    typedef enum displayPortEncoding_e
+    {
+        DISPLAYPORT_ENCODING_ROWS = 0, // Each row that changed goes out whole, in an UPDATE frame of its own. Every handset understands this.
+        DISPLAYPORT_ENCODING_SPANS     // Only the characters that changed go out, in SPANS frames. Needs a handset that understands them.
+    } displayPortEncoding_t;
+
+    typedef struct displayPortStatistics_s
+    {
+        uint32_t frames;         // Frames handed to telemetry.
+        uint32_t bytes;          // Bytes in those frames, from the sync byte to the CRC.
+        uint32_t updates;        // Rows (or spans, with DISPLAYPORT_ENCODING_SPANS) that were sent, not counting refreshes.
+        uint32_t characters;     // Characters in those. This includes the unchanged ones in a row, or that join two changes into one span.
+        uint32_t refreshes;      // Rows that were sent again, to repair frames that the handset missed.
+        uint32_t throttledSlots; // Telemetry slots that were left to the other telemetry, because the byte budget was spent.
+    } displayPortStatistics_t;
+
+    /**
+     * @brief Keeps a grid of characters for the handset's canvas, and sends only what changed.
+     * You draw with clear() and write(), then call flush() when the screen is complete, so that a half drawn screen never goes out.
+     * By default, each row that differs from what the handset was last sent goes out in a standard UPDATE frame, one per
+     * telemetry slot. If your handset understands SPANS frames, setEncoding(DISPLAYPORT_ENCODING_SPANS) sends only the
+     * characters that changed instead: they are gathered into spans (unchanged characters join two spans when that is
+     * shorter than a new span), and packed into as few frames as they fit in.
+     * The downlink only carries a few hundred bytes per second, so frames are held back to stay within a byte budget.
+     */
+    class DisplayPort final
+    {
+      public:
+        DisplayPort(uint8_t rows = DISPLAYPORT_ROWS_MAX, uint8_t columns = DISPLAYPORT_COLUMNS_MAX, uint16_t byteRate = CRSF_DISPLAYPORT_BYTE_RATE);
+        ~DisplayPort();
+
+        uint8_t getRows();
+        uint8_t getColumns();
+        void setByteRate(uint16_t byteRate);
+        void setRefreshInterval(uint32_t interval);
+        void setEncoding(displayPortEncoding_t encoding);
+
+        void clear();
+        void write(uint8_t row, uint8_t column, const char *text);
+        void write(uint8_t row, uint8_t column, char character);
+        void flush();
+        void redraw();
+        bool isIdle();
+
+        uint8_t update(uint32_t currentTime);
+        const uint8_t *getFrame();
+
+        void getStatistics(displayPortStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        uint8_t _rows;
+        uint8_t _columns;
+        displayPortEncoding_t _encoding;
+
+        // What you draw on, what was there at the last flush(), and what the handset has been sent.
+        char _screen[DISPLAYPORT_ROWS_MAX][DISPLAYPORT_COLUMNS_MAX];
+        char _target[DISPLAYPORT_ROWS_MAX][DISPLAYPORT_COLUMNS_MAX];
+        char _shown[DISPLAYPORT_ROWS_MAX][DISPLAYPORT_COLUMNS_MAX];
+        bool _clearPending;
+        bool _changesPending;
+        uint16_t _scanPosition; // Where the search for the next span starts, so that every part of the screen gets its turn.
+
+        // The byte budget. Each frame moves the time that the budget is spent until on by the frame's share of a second.
+        uint16_t _byteRate;
+        bool _budgetStarted;
+        uint32_t _budgetTime;
+
+        uint32_t _refreshInterval; // In microseconds. 0 turns refreshing off.
+        uint32_t _lastRefreshTime;
+        uint8_t _refreshRow;
+
+        genericCrc::GenericCRC _crc;
+        uint8_t _frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        uint8_t _frameLength;
+        displayPortStatistics_t _statistics;
+
+        void _buildClear();
+        void _buildRows();
+        void _buildSpans();
+        void _buildRefresh(uint8_t row);
+        bool _findRow(uint8_t *row);
+        bool _findSpan(uint8_t maxLength, uint8_t *row, uint8_t *column, uint8_t *length);
+        void _appendRow(uint8_t row);
+        void _appendSpan(uint8_t row, uint8_t column, uint8_t length);
+        void _finishFrame(uint8_t subcommand);
+    };
+} // namespace serialReceiverLayer
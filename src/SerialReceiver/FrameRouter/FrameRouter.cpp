@@ -0,0 +1,125 @@
+/**
+ * @file FrameRouter.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This passes each decoded CRSF frame on to every sink whose route matches it.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "FrameRouter.hpp"
+
+namespace serialReceiverLayer
+{
+    FrameRouter::FrameRouter()
+    {
+        clearRoutes();
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    FrameRouter::~FrameRouter()
+    {
+    }
+
+    /**
+     * @brief Sends every frame of the given types, whose address matches addressMask and address, to sink.
+     * A sink can have several routes, eg one per address. Pass no types (or a typeCount of 0) to take every type.
+     *
+     * @return The route's number, for removeRoute(), or FRAME_ROUTER_NO_ROUTE if there is no sink or the table is full.
+     */
+    int8_t FrameRouter::addRoute(FrameSink *sink, const uint8_t *types, uint8_t typeCount, uint8_t addressMask, uint8_t address)
+    {
+        if (sink == nullptr)
+        {
+            return FRAME_ROUTER_NO_ROUTE;
+        }
+
+        for (int8_t i = 0; i < FRAME_ROUTER_ROUTE_COUNT; i++)
+        {
+            if (_routes[i].sink != nullptr)
+            {
+                continue;
+            }
+
+            _routes[i].sink = sink;
+            _routes[i].addressMask = addressMask;
+            _routes[i].address = address & addressMask;
+
+            const frameRouteMask_t bit = (frameRouteMask_t)((frameRouteMask_t)1 << i);
+            if (types == nullptr || typeCount == 0)
+            {
+                for (size_t type = 0; type < FRAME_ROUTER_TYPE_COUNT; type++)
+                {
+                    _routesByType[type] |= bit;
+                }
+            }
+            else
+            {
+                for (uint8_t j = 0; j < typeCount; j++)
+                {
+                    _routesByType[types[j]] |= bit;
+                }
+            }
+
+            return i;
+        }
+
+        return FRAME_ROUTER_NO_ROUTE;
+    }
+
+    /**
+     * @brief Sends every frame of one type, whose address matches addressMask and address, to sink.
+     */
+    int8_t FrameRouter::addRoute(FrameSink *sink, uint8_t type, uint8_t addressMask, uint8_t address)
+    {
+        return addRoute(sink, &type, 1, addressMask, address);
+    }
+
+    void FrameRouter::removeRoute(int8_t route)
+    {
+        if (route < 0 || route >= FRAME_ROUTER_ROUTE_COUNT)
+        {
+            return;
+        }
+
+        const frameRouteMask_t keep = (frameRouteMask_t) ~((frameRouteMask_t)1 << route);
+        for (size_t type = 0; type < FRAME_ROUTER_TYPE_COUNT; type++)
+        {
+            _routesByType[type] &= keep;
+        }
+        _routes[route].sink = nullptr;
+    }
+
+    void FrameRouter::clearRoutes()
+    {
+        memset(_routes, 0, sizeof(_routes));
+        memset(_routesByType, 0, sizeof(_routesByType));
+    }
+
+    void FrameRouter::getStatistics(frameRouterStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(frameRouterStatistics_t));
+    }
+
+    void FrameRouter::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+} // namespace serialReceiverLayer
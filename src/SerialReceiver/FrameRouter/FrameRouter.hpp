@@ -0,0 +1,138 @@
+/**
+ * @file FrameRouter.hpp
+ * @author CRSF for Arduino contributors
+ * @brief This passes each decoded CRSF frame on to every sink whose route matches it.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Frame Router
+Each route pairs a FrameSink with the frame types and the addresses that it wants.
+A frame's address matches a route when (address & addressMask) == address value, so an addressMask of 0 takes every address.
+The router keeps one bit per route for each of the 256 frame types, so a frame only costs a table lookup
+plus one call for each sink that takes it, however many routes there are. */
+#define FRAME_ROUTER_ROUTE_COUNT CRSF_FRAME_ROUTER_ROUTE_COUNT
+#define FRAME_ROUTER_TYPE_COUNT  256
+#define FRAME_ROUTER_NO_ROUTE    -1
+
+#if FRAME_ROUTER_ROUTE_COUNT == 8
+    typedef uint8_t frameRouteMask_t;
+#elif FRAME_ROUTER_ROUTE_COUNT == 16
+    typedef uint16_t frameRouteMask_t;
+#elif FRAME_ROUTER_ROUTE_COUNT == 32
+    typedef uint32_t frameRouteMask_t;
+#else
+#error "CRSF_FRAME_ROUTER_ROUTE_COUNT must be 8, 16 or 32."
+#endif
+
+    typedef struct frameRouterStatistics_s
+    {
+        uint32_t frames;         // Frames passed to dispatch().
+        uint32_t unroutedFrames; // Frames that no route took.
+        uint32_t deliveries;     // Calls to FrameSink::onFrame(), ie frames times the sinks that took them.
+    } frameRouterStatistics_t;
+
+    /**
+     * @brief Receives frames from a FrameRouter. Implement this for each consumer (eg a logger, an OSD or a bridge).
+     * The frame is the decoder's own buffer, so nothing is copied for any sink. It has already passed its CRC check,
+     * and it is only valid for the duration of the call. Copy out whatever is needed later.
+     * onFrame() is called from the decoder, so keep it short.
+     */
+    class FrameSink
+    {
+      public:
+        virtual ~FrameSink()
+        {
+        }
+
+        virtual void onFrame(const crsfProtocol::frame_t *frame, uint32_t timestamp) = 0;
+    };
+
+    /**
+     * @brief Passes each frame on to every sink whose route matches the frame's type and address.
+     * The routes live in a fixed-size table, so the router never allocates.
+     */
+    class FrameRouter final
+    {
+      public:
+        FrameRouter();
+        ~FrameRouter();
+
+        int8_t addRoute(FrameSink *sink, const uint8_t *types = nullptr, uint8_t typeCount = 0, uint8_t addressMask = 0, uint8_t address = 0);
+        int8_t addRoute(FrameSink *sink, uint8_t type, uint8_t addressMask = 0, uint8_t address = 0);
+        void removeRoute(int8_t route);
+        void clearRoutes();
+
+        void dispatch(const crsfProtocol::frame_t *frame, uint32_t timestamp);
+
+        void getStatistics(frameRouterStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        typedef struct route_s
+        {
+            FrameSink *sink;
+            uint8_t addressMask;
+            uint8_t address;
+        } route_t;
+
+        route_t _routes[FRAME_ROUTER_ROUTE_COUNT];
+        frameRouteMask_t _routesByType[FRAME_ROUTER_TYPE_COUNT];
+        frameRouterStatistics_t _statistics;
+    };
+
+    /**
+     * @brief Hands frame to each sink whose route matches it, in the order that the routes were added.
+     * This is called by the decoder for every frame with a valid CRC, so it is kept inline.
+     */
+    inline void FrameRouter::dispatch(const crsfProtocol::frame_t *frame, uint32_t timestamp)
+    {
+        const uint8_t deviceAddress = frame->frame.deviceAddress;
+        frameRouteMask_t routes = _routesByType[frame->frame.type];
+        bool routed = false;
+
+        _statistics.frames++;
+        while (routes != 0)
+        {
+            const route_t *route = &_routes[__builtin_ctzl((unsigned long)routes)];
+            routes &= (frameRouteMask_t)(routes - 1);
+
+            if ((deviceAddress & route->addressMask) == route->address)
+            {
+                route->sink->onFrame(frame, timestamp);
+                _statistics.deliveries++;
+                routed = true;
+            }
+        }
+
+        if (!routed)
+        {
+            _statistics.unroutedFrames++;
+        }
+    }
+} // namespace serialReceiverLayer
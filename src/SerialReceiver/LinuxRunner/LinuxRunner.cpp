@@ -0,0 +1,305 @@
+/**
+ * @file LinuxRunner.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Runs the Serial Receiver layer on a Linux host, waking up only when the serial port has data.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LinuxRunner.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "errno.h"
+#include "malloc.h"
+#include "pthread.h"
+#include "sched.h"
+#include "sys/mman.h"
+#include "time.h"
+
+namespace serialReceiverLayer
+{
+    static uint64_t monotonicNanoseconds()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+    }
+
+    /* Touches a block of stack, so that the pages are already mapped (and locked, with mlockall())
+    before the receive loop needs them. noinline stops the compiler from folding this into the caller's frame. */
+    __attribute__((noinline)) static void prefaultStack()
+    {
+        volatile uint8_t stack[LINUX_RUNNER_PREFAULT_STACK_SIZE];
+        for (size_t i = 0; i < sizeof(stack); i += 4096)
+        {
+            stack[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Construct a new Linux Runner object.
+     *
+     * @param receiver A Serial Receiver that was constructed with port, and whose begin() has been called.
+     * @param port The serial port that the receiver reads from.
+     */
+    LinuxRunner::LinuxRunner(SerialReceiver *receiver, hal::LinuxSerial *port)
+    {
+        _receiver = receiver;
+        _port = port;
+        _nextWakeNs = 0;
+        memset(&_realTimeStatus, 0, sizeof(_realTimeStatus));
+        resetStatistics();
+    }
+
+    LinuxRunner::~LinuxRunner()
+    {
+    }
+
+    /**
+     * @brief Applies real-time options to the calling thread, so call this from the thread that runs the receiver.
+     * Each option is attempted on its own. If the process is not permitted to use one (eg SCHED_FIFO without
+     * CAP_SYS_NICE, or mlockall() over RLIMIT_MEMLOCK), it is skipped and the runner carries on without it.
+     *
+     * @param options The options to apply.
+     * @return true if every requested option was applied. Use getRealTimeStatus() to find out which ones were.
+     */
+    bool LinuxRunner::setOptions(const linuxRunnerOptions_t *options)
+    {
+        memcpy(&_options, options, sizeof(linuxRunnerOptions_t));
+        memset(&_realTimeStatus, 0, sizeof(_realTimeStatus));
+        _nextWakeNs = 0;
+
+        bool applied = true;
+
+        if (_options.cpu >= 0)
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(_options.cpu, &cpuSet);
+            _realTimeStatus.cpuPinned = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+            applied &= _realTimeStatus.cpuPinned;
+        }
+
+        if (_options.lockMemory)
+        {
+            _realTimeStatus.memoryLocked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+            applied &= _realTimeStatus.memoryLocked;
+
+            if (_realTimeStatus.memoryLocked)
+            {
+                // Keep freed memory in the heap, so that a later malloc() does not fault new pages in.
+                mallopt(M_TRIM_THRESHOLD, -1);
+                mallopt(M_MMAP_MAX, 0);
+            }
+        }
+
+        if (_options.prefault)
+        {
+            prefaultStack();
+            memset(_wakeLatencyHistogram, 0, sizeof(_wakeLatencyHistogram));
+            _realTimeStatus.prefaulted = true;
+        }
+
+        if (_options.priority > 0)
+        {
+            struct sched_param parameters;
+            memset(&parameters, 0, sizeof(parameters));
+            parameters.sched_priority = constrain(_options.priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+            _realTimeStatus.fifoScheduling = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+            applied &= _realTimeStatus.fifoScheduling;
+        }
+
+        return applied;
+    }
+
+    void LinuxRunner::getRealTimeStatus(linuxRunnerRealTimeStatus_t *status)
+    {
+        memcpy(status, &_realTimeStatus, sizeof(linuxRunnerRealTimeStatus_t));
+    }
+
+    /**
+     * @brief Sleeps until the serial port has data (or, with options.periodUs set, until the next period), then decodes it.
+     *
+     * @param timeoutMs How long to wait for data, in milliseconds. -1 waits forever. Not used in periodic mode.
+     * @return false if the serial port is closed.
+     */
+    bool LinuxRunner::runOnce(int timeoutMs)
+    {
+        if (!_port->isOpen())
+        {
+            return false;
+        }
+
+        if (_options.periodUs > 0)
+        {
+            _waitForNextPeriod();
+
+            hal::linuxSerialStatistics_t portStatistics;
+            _port->getStatistics(&portStatistics);
+            const uint32_t bytesBefore = portStatistics.bytesRead;
+
+            const uint64_t wakeTime = monotonicNanoseconds();
+            _receiver->processFrames();
+            const uint64_t latency = monotonicNanoseconds() - wakeTime;
+
+            _port->getStatistics(&portStatistics);
+            if (portStatistics.bytesRead != bytesBefore)
+            {
+                _recordDecodeLatency(latency);
+            }
+        }
+        else if (_port->waitForData(timeoutMs))
+        {
+            const uint64_t wakeTime = monotonicNanoseconds();
+            _receiver->processFrames();
+            _recordDecodeLatency(monotonicNanoseconds() - wakeTime);
+        }
+        else
+        {
+            // Keep the RC channels callback running at least once per timeout, just like update() on a microcontroller.
+            _receiver->processFrames();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Runs the receiver until keepRunning is cleared (eg from a signal handler) or the port closes.
+     *
+     * @param keepRunning The flag to watch.
+     * @param timeoutMs How often keepRunning is checked when no data is arriving, in milliseconds.
+     */
+    void LinuxRunner::run(volatile bool *keepRunning, int timeoutMs)
+    {
+        while (*keepRunning)
+        {
+            if (!runOnce(timeoutMs))
+            {
+                break;
+            }
+        }
+    }
+
+    void LinuxRunner::getStatistics(linuxRunnerStatistics_t *statistics)
+    {
+        hal::linuxSerialStatistics_t portStatistics;
+        _port->getStatistics(&portStatistics);
+
+        const uint64_t elapsedNs = monotonicNanoseconds() - _statisticsStartNs;
+
+        statistics->elapsedUs = elapsedNs / 1000ULL;
+        statistics->readCalls = portStatistics.readCalls;
+        statistics->bytesRead = portStatistics.bytesRead;
+        statistics->readCallsPerSecond = elapsedNs > 0 ? (float)portStatistics.readCalls * 1.0e9F / (float)elapsedNs : 0.0F;
+        statistics->decodeCount = _decodeCount;
+        statistics->decodeLatencyMeanUs = _decodeCount > 0 ? (uint32_t)((_decodeLatencyTotalNs / _decodeCount) / 1000ULL) : 0;
+        statistics->decodeLatencyMaxUs = (uint32_t)(_decodeLatencyMaxNs / 1000ULL);
+        statistics->wakeCount = _wakeCount;
+        statistics->wakeLatencyP50Us = _wakeLatencyPercentileUs(500);
+        statistics->wakeLatencyP99Us = _wakeLatencyPercentileUs(990);
+        statistics->wakeLatencyP999Us = _wakeLatencyPercentileUs(999);
+        statistics->wakeLatencyMaxUs = (uint32_t)(_wakeLatencyMaxNs / 1000ULL);
+    }
+
+    void LinuxRunner::resetStatistics()
+    {
+        _port->resetStatistics();
+        _statisticsStartNs = monotonicNanoseconds();
+        _decodeCount = 0;
+        _decodeLatencyTotalNs = 0;
+        _decodeLatencyMaxNs = 0;
+        memset(_wakeLatencyHistogram, 0, sizeof(_wakeLatencyHistogram));
+        _wakeCount = 0;
+        _wakeLatencyMaxNs = 0;
+    }
+
+    void LinuxRunner::_recordDecodeLatency(uint64_t latencyNs)
+    {
+        _decodeCount++;
+        _decodeLatencyTotalNs += latencyNs;
+        if (latencyNs > _decodeLatencyMaxNs)
+        {
+            _decodeLatencyMaxNs = latencyNs;
+        }
+    }
+
+    /* Sleeps until an absolute deadline, then records how late the thread actually woke up.
+    If the loop fell more than a period behind, the missed periods are skipped rather than run back to back. */
+    void LinuxRunner::_waitForNextPeriod()
+    {
+        const uint64_t periodNs = (uint64_t)_options.periodUs * 1000ULL;
+
+        if (_nextWakeNs == 0)
+        {
+            _nextWakeNs = monotonicNanoseconds() + periodNs;
+        }
+
+        struct timespec deadline;
+        deadline.tv_sec = (time_t)(_nextWakeNs / 1000000000ULL);
+        deadline.tv_nsec = (long)(_nextWakeNs % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+        {
+            // Interrupted by a signal. The deadline is absolute, so simply sleep again.
+        }
+
+        const uint64_t now = monotonicNanoseconds();
+        const uint64_t latency = now > _nextWakeNs ? now - _nextWakeNs : 0;
+
+        const uint32_t bucket = min((uint32_t)(latency / 1000ULL), (uint32_t)(LINUX_RUNNER_HISTOGRAM_BUCKETS - 1));
+        _wakeLatencyHistogram[bucket]++;
+        _wakeCount++;
+        if (latency > _wakeLatencyMaxNs)
+        {
+            _wakeLatencyMaxNs = latency;
+        }
+
+        _nextWakeNs += periodNs;
+        if (_nextWakeNs <= now)
+        {
+            _nextWakeNs = now + periodNs;
+        }
+    }
+
+    /* Reads a percentile off the wake latency histogram. perMille is the percentile times ten, eg 999 for p99.9. */
+    uint32_t LinuxRunner::_wakeLatencyPercentileUs(uint32_t perMille)
+    {
+        if (_wakeCount == 0)
+        {
+            return 0;
+        }
+
+        const uint64_t target = ((uint64_t)_wakeCount * perMille + 999) / 1000;
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < LINUX_RUNNER_HISTOGRAM_BUCKETS; i++)
+        {
+            count += _wakeLatencyHistogram[i];
+            if (count >= target)
+            {
+                return i;
+            }
+        }
+
+        return LINUX_RUNNER_HISTOGRAM_BUCKETS - 1;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,110 @@
+/**
+ * @file LinuxRunner.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Runs the Serial Receiver layer on a Linux host, waking up only when the serial port has data.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../../hal/LinuxSerial/LinuxSerial.hpp"
+#include "../SerialReceiver.hpp"
+
+namespace serialReceiverLayer
+{
+#define LINUX_RUNNER_HISTOGRAM_BUCKETS   10000       // 1 us per bucket, up to 10 ms. The last bucket counts every wake-up that was later than that.
+#define LINUX_RUNNER_PREFAULT_STACK_SIZE (64 * 1024) // Stack touched by prefaulting, so that deep calls never page fault.
+
+    typedef struct linuxRunnerOptions_s
+    {
+        int cpu = -1;            // CPU to pin the runner's thread to, or -1 to let the scheduler choose.
+        int priority = 0;        // SCHED_FIFO priority (1 to 99), or 0 to keep the normal scheduler.
+        bool lockMemory = false; // Lock all current and future memory into RAM with mlockall().
+        bool prefault = false;   // Touch the stack and the runner's buffers up front, so the loop never page faults.
+        uint32_t periodUs = 0;   // Wake up every periodUs instead of waiting for data. Wake latency is only measured in this mode.
+    } linuxRunnerOptions_t;
+
+    typedef struct linuxRunnerRealTimeStatus_s
+    {
+        bool cpuPinned;      // The thread is pinned to options.cpu.
+        bool fifoScheduling; // The thread runs under SCHED_FIFO at options.priority.
+        bool memoryLocked;   // mlockall() succeeded.
+        bool prefaulted;     // The stack and buffers have been touched.
+    } linuxRunnerRealTimeStatus_t;
+
+    typedef struct linuxRunnerStatistics_s
+    {
+        uint64_t elapsedUs;           // Time since the statistics were last reset.
+        uint32_t readCalls;           // read() system calls made by the serial port.
+        uint32_t bytesRead;           // Bytes received by the serial port.
+        float readCallsPerSecond;     // readCalls / elapsed time.
+        uint32_t decodeCount;         // Wake-ups that had at least one byte to decode.
+        uint32_t decodeLatencyMeanUs; // Mean time from waking up to processFrames() returning.
+        uint32_t decodeLatencyMaxUs;  // Worst time from waking up to processFrames() returning.
+        uint32_t wakeCount;           // Periodic wake-ups recorded in the wake latency histogram.
+        uint32_t wakeLatencyP50Us;    // Median lateness of a periodic wake-up.
+        uint32_t wakeLatencyP99Us;    // 99th percentile lateness of a periodic wake-up.
+        uint32_t wakeLatencyP999Us;   // 99.9th percentile lateness of a periodic wake-up.
+        uint32_t wakeLatencyMaxUs;    // Worst lateness of a periodic wake-up.
+    } linuxRunnerStatistics_t;
+
+    class LinuxRunner
+    {
+      public:
+        LinuxRunner(SerialReceiver *receiver, hal::LinuxSerial *port);
+        ~LinuxRunner();
+
+        bool setOptions(const linuxRunnerOptions_t *options);
+        void getRealTimeStatus(linuxRunnerRealTimeStatus_t *status);
+
+        bool runOnce(int timeoutMs);
+        void run(volatile bool *keepRunning, int timeoutMs = 100);
+
+        void getStatistics(linuxRunnerStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        SerialReceiver *_receiver;
+        hal::LinuxSerial *_port;
+        linuxRunnerOptions_t _options;
+        linuxRunnerRealTimeStatus_t _realTimeStatus;
+        uint64_t _nextWakeNs;
+
+        uint64_t _statisticsStartNs;
+        uint32_t _decodeCount;
+        uint64_t _decodeLatencyTotalNs;
+        uint64_t _decodeLatencyMaxNs;
+        uint32_t _wakeLatencyHistogram[LINUX_RUNNER_HISTOGRAM_BUCKETS];
+        uint32_t _wakeCount;
+        uint64_t _wakeLatencyMaxNs;
+
+        void _recordDecodeLatency(uint64_t latencyNs);
+        void _waitForNextPeriod();
+        uint32_t _wakeLatencyPercentileUs(uint32_t perMille);
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
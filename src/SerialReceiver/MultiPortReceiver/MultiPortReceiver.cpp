@@ -0,0 +1,36 @@
+/**
+ * @file MultiPortReceiver.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes CRSF from many serial ports at once on a Linux host, using epoll.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "MultiPortReceiver.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+namespace serialReceiverLayer
+{
+    template class BasicMultiPortReceiver<crsfForArduinoConfig::DefaultConfig>;
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
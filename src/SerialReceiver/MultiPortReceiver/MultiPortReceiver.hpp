@@ -0,0 +1,429 @@
+/**
+ * @file MultiPortReceiver.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Decodes CRSF from many serial ports at once on a Linux host, using epoll.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../../hal/LinuxSerial/LinuxSerial.hpp"
+#include "../CRSF/CRSF.hpp"
+#include "../SerialReceiver.hpp"
+#include "errno.h"
+#include "sys/epoll.h"
+#include "time.h"
+#include "unistd.h"
+
+namespace serialReceiverLayer
+{
+#define MULTIPORT_RECEIVER_PORTS_MAX 64
+#define MULTIPORT_RECEIVER_READ_SIZE 4096
+
+    /**
+     * @brief Receives decoded records from a MultiPortReceiver.
+     * Implement this to forward records to a logger, a network socket, shared memory, etc.
+     * The pointers are only valid for the duration of the call.
+     */
+    class MultiPortSink
+    {
+      public:
+        virtual ~MultiPortSink()
+        {
+        }
+
+        virtual void onRcChannels(uint8_t port, uint64_t timestampUs, const rcChannels_t *rcChannels) = 0;
+        virtual void onLinkStatistics(uint8_t port, uint64_t timestampUs, const link_statistics_t *linkStatistics) = 0;
+    };
+
+    typedef struct multiPortStatistics_s
+    {
+        uint32_t waits;        // epoll_wait() calls.
+        uint32_t readCalls;    // read() calls across all ports.
+        uint64_t bytesRead;    // Bytes read across all ports.
+        uint32_t rcFrames;     // RC channels records passed to the sink.
+        uint32_t linkFrames;   // Link statistics records passed to the sink.
+        uint32_t portsClosed;  // Ports that were dropped after a read error or hang-up.
+    } multiPortStatistics_t;
+
+    /**
+     * @brief Decodes CRSF from many serial ports at once, each with its own decoder.
+     *
+     * @tparam Config The compile-time configuration. See crsfForArduinoConfig::DefaultConfig.
+     */
+    template <class Config = crsfForArduinoConfig::DefaultConfig>
+    class BasicMultiPortReceiver final
+    {
+      public:
+        BasicMultiPortReceiver(MultiPortSink *sink);
+        ~BasicMultiPortReceiver();
+
+        bool begin();
+        void end();
+
+        int addPort(hal::LinuxSerial *serialPort);
+        bool removePort(uint8_t port);
+        uint8_t getPortCount();
+
+        int poll(int timeoutMs);
+        void run(volatile bool *keepRunning, int timeoutMs = 100);
+
+        void getStatistics(multiPortStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        typedef struct port_s
+        {
+            hal::LinuxSerial *serialPort;
+            int fd;
+            BasicCRSF<Config> crsf;
+            rcChannels_t rcChannels;
+            link_statistics_t linkStatistics;
+        } port_t;
+
+        MultiPortSink *_sink;
+        int _epollFd;
+        port_t _ports[MULTIPORT_RECEIVER_PORTS_MAX];
+        uint8_t _portCount;
+        uint8_t _readBuffer[MULTIPORT_RECEIVER_READ_SIZE];
+        multiPortStatistics_t _statistics;
+
+        static uint64_t _monotonicMicroseconds();
+        void _dropPort(uint8_t port);
+        int _decode(uint8_t port, const uint8_t *data, size_t length, uint64_t timestampUs);
+    };
+
+    typedef BasicMultiPortReceiver<> MultiPortReceiver;
+
+    template <class Config>
+    uint64_t BasicMultiPortReceiver<Config>::_monotonicMicroseconds()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((uint64_t)now.tv_sec * 1000000ULL) + ((uint64_t)now.tv_nsec / 1000ULL);
+    }
+
+    /**
+     * @brief Construct a new Multi Port Receiver object.
+     *
+     * @param sink Where decoded RC channels and link statistics are sent.
+     */
+    template <class Config>
+    BasicMultiPortReceiver<Config>::BasicMultiPortReceiver(MultiPortSink *sink)
+    {
+        _sink = sink;
+        _epollFd = -1;
+        _portCount = 0;
+
+        for (size_t i = 0; i < MULTIPORT_RECEIVER_PORTS_MAX; i++)
+        {
+            _ports[i].serialPort = nullptr;
+            _ports[i].fd = -1;
+        }
+
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    template <class Config>
+    BasicMultiPortReceiver<Config>::~BasicMultiPortReceiver()
+    {
+        end();
+    }
+
+    template <class Config>
+    bool BasicMultiPortReceiver<Config>::begin()
+    {
+        if (_epollFd < 0)
+        {
+            _epollFd = epoll_create1(EPOLL_CLOEXEC);
+        }
+
+        return _epollFd >= 0;
+    }
+
+    template <class Config>
+    void BasicMultiPortReceiver<Config>::end()
+    {
+        for (uint8_t i = 0; i < MULTIPORT_RECEIVER_PORTS_MAX; i++)
+        {
+            removePort(i);
+        }
+
+        if (_epollFd >= 0)
+        {
+            close(_epollFd);
+            _epollFd = -1;
+        }
+    }
+
+    /**
+     * @brief Adds a serial port to the set of monitored ports, with its own CRSF decoder.
+     * The serial port must already be open (ie its begin() has been called). It is not closed by this class.
+     *
+     * @param serialPort The serial port to monitor.
+     * @return The port number that is passed to the sink, or -1 if the port could not be added.
+     */
+    template <class Config>
+    int BasicMultiPortReceiver<Config>::addPort(hal::LinuxSerial *serialPort)
+    {
+        if (_epollFd < 0 || serialPort == nullptr || !serialPort->isOpen())
+        {
+            return -1;
+        }
+
+        for (uint8_t i = 0; i < MULTIPORT_RECEIVER_PORTS_MAX; i++)
+        {
+            port_t *port = &_ports[i];
+            if (port->fd >= 0)
+            {
+                continue;
+            }
+
+            struct epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.u32 = i;
+
+            if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, serialPort->getFileDescriptor(), &event) != 0)
+            {
+                return -1;
+            }
+
+            port->serialPort = serialPort;
+            port->fd = serialPort->getFileDescriptor();
+            port->crsf.begin();
+            port->crsf.setFrameTime(crsfProtocol::BAUD_RATE, 10);
+
+            port->rcChannels.valid = false;
+            port->rcChannels.failsafe = false;
+            memset(port->rcChannels.value, 0, sizeof(port->rcChannels.value));
+
+            _portCount++;
+            return i;
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief Stops monitoring a port. The serial port itself is left open.
+     *
+     * @param port The port number returned by addPort().
+     * @return true if the port was being monitored.
+     */
+    template <class Config>
+    bool BasicMultiPortReceiver<Config>::removePort(uint8_t port)
+    {
+        if (port >= MULTIPORT_RECEIVER_PORTS_MAX || _ports[port].fd < 0)
+        {
+            return false;
+        }
+
+        if (_epollFd >= 0)
+        {
+            epoll_ctl(_epollFd, EPOLL_CTL_DEL, _ports[port].fd, nullptr);
+        }
+
+        _ports[port].crsf.end();
+        _ports[port].serialPort = nullptr;
+        _ports[port].fd = -1;
+        _portCount--;
+
+        return true;
+    }
+
+    template <class Config>
+    uint8_t BasicMultiPortReceiver<Config>::getPortCount()
+    {
+        return _portCount;
+    }
+
+    /**
+     * @brief Waits for any port to have data, then decodes everything that has arrived.
+     * Each ready port is drained with as few read() calls as possible.
+     *
+     * @param timeoutMs How long to wait, in milliseconds. -1 waits forever.
+     * @return The number of records passed to the sink, or -1 on error.
+     */
+    template <class Config>
+    int BasicMultiPortReceiver<Config>::poll(int timeoutMs)
+    {
+        struct epoll_event events[MULTIPORT_RECEIVER_PORTS_MAX];
+
+        const int eventCount = epoll_wait(_epollFd, events, MULTIPORT_RECEIVER_PORTS_MAX, timeoutMs);
+        _statistics.waits++;
+
+        if (eventCount < 0)
+        {
+            return errno == EINTR ? 0 : -1;
+        }
+
+        const uint64_t timestampUs = _monotonicMicroseconds();
+        int records = 0;
+
+        for (int i = 0; i < eventCount; i++)
+        {
+            const uint8_t index = (uint8_t)events[i].data.u32;
+            if (index >= MULTIPORT_RECEIVER_PORTS_MAX || _ports[index].fd < 0)
+            {
+                continue;
+            }
+
+            bool dropPort = false;
+
+            if (events[i].events & EPOLLIN)
+            {
+                while (true)
+                {
+                    const ssize_t result = read(_ports[index].fd, _readBuffer, MULTIPORT_RECEIVER_READ_SIZE);
+                    _statistics.readCalls++;
+
+                    if (result > 0)
+                    {
+                        _statistics.bytesRead += (uint64_t)result;
+                        records += _decode(index, _readBuffer, (size_t)result, timestampUs);
+
+                        // A short read means the kernel buffer is empty. Don't spend a system call finding that out.
+                        if (result < MULTIPORT_RECEIVER_READ_SIZE)
+                        {
+                            break;
+                        }
+                    }
+                    else if (result < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    else if (result < 0 && errno == EAGAIN)
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        dropPort = true;
+                        break;
+                    }
+                }
+            }
+            else if (events[i].events & (EPOLLHUP | EPOLLERR))
+            {
+                dropPort = true;
+            }
+
+            if (dropPort)
+            {
+                _dropPort(index);
+            }
+        }
+
+        return records;
+    }
+
+    /**
+     * @brief Polls the ports until keepRunning is cleared, eg from a signal handler.
+     */
+    template <class Config>
+    void BasicMultiPortReceiver<Config>::run(volatile bool *keepRunning, int timeoutMs)
+    {
+        while (*keepRunning && _portCount > 0)
+        {
+            if (poll(timeoutMs) < 0)
+            {
+                break;
+            }
+        }
+    }
+
+    template <class Config>
+    void BasicMultiPortReceiver<Config>::getStatistics(multiPortStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(multiPortStatistics_t));
+    }
+
+    template <class Config>
+    void BasicMultiPortReceiver<Config>::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    template <class Config>
+    void BasicMultiPortReceiver<Config>::_dropPort(uint8_t port)
+    {
+        if (removePort(port))
+        {
+            _statistics.portsClosed++;
+        }
+    }
+
+    template <class Config>
+    int BasicMultiPortReceiver<Config>::_decode(uint8_t index, const uint8_t *data, size_t length, uint64_t timestampUs)
+    {
+        port_t *port = &_ports[index];
+        int records = 0;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            if (!port->crsf.receiveFrames(data[i], (uint32_t)timestampUs))
+            {
+                continue;
+            }
+
+            CRSF_IF_CONSTEXPR(Config::rcEnabled)
+            {
+                if (port->crsf.getRcChannels(port->rcChannels.value))
+                {
+                    port->rcChannels.valid = true;
+                    port->crsf.getFailSafe(&port->rcChannels.failsafe);
+
+                    if (_sink != nullptr)
+                    {
+                        _sink->onRcChannels(index, timestampUs, &port->rcChannels);
+                    }
+
+                    _statistics.rcFrames++;
+                    records++;
+                }
+            }
+
+            CRSF_IF_CONSTEXPR(Config::linkStatisticsEnabled)
+            {
+                if (port->crsf.getLinkStatistics(&port->linkStatistics))
+                {
+                    if (_sink != nullptr)
+                    {
+                        _sink->onLinkStatistics(index, timestampUs, &port->linkStatistics);
+                    }
+
+                    _statistics.linkFrames++;
+                    records++;
+                }
+            }
+        }
+
+        return records;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,447 @@
+/**
+ * @file Parameters.cpp
+ * @author CRSF for Arduino contributors
+ * @brief This serves settings to the handset's device menu, one chunk of one entry at a time.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Parameters.hpp"
+
+namespace serialReceiverLayer
+{
+    /* Where the fields of a PARAMETER_SETTINGS_ENTRY frame sit. The chunk follows the header. */
+    enum parameterReplyField_e
+    {
+        PARAMETER_REPLY_DESTINATION = 3,
+        PARAMETER_REPLY_ORIGIN = 4,
+        PARAMETER_REPLY_NUMBER = 5,
+        PARAMETER_REPLY_CHUNKS_REMAINING = 6,
+        PARAMETER_REPLY_HEADER_SIZE = 7
+    };
+
+    /**
+     * @brief Construct a new Parameter Server.
+     *
+     * @param parameters The table of parameters. It must outlive the server.
+     * @param count How many parameters are in the table. The handset numbers them 1 to count.
+     * @param rootName The name of the root folder (parameter 0).
+     */
+    ParameterServer::ParameterServer(const parameterDescriptor_t *parameters, uint8_t count, const char *rootName)
+    {
+        _parameters = parameters;
+        _count = parameters != nullptr ? count : 0;
+        _rootName = rootName != nullptr ? rootName : PARAMETER_ROOT_NAME;
+        _replyLength = 0;
+        _windowStart = 0;
+        _position = 0;
+        memset(_reply, 0, sizeof(_reply));
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    ParameterServer::~ParameterServer()
+    {
+    }
+
+    /**
+     * @brief Returns how many parameters the server has. This is the parameter count in the device info frame.
+     */
+    uint8_t ParameterServer::getParameterCount()
+    {
+        return _count;
+    }
+
+    /**
+     * @brief Sets a function that is called each time the handset changes a parameter.
+     */
+    void ParameterServer::setWriteCallback(parameterWriteCallback_t callback)
+    {
+        _writeCallback = callback;
+    }
+
+    /**
+     * @brief Handles one PARAMETER_READ or PARAMETER_WRITE frame.
+     *
+     * @param request The whole frame, from its address byte to its CRC.
+     * @return The length of the reply that getReply() holds, or 0 if there is nothing to send.
+     */
+    uint8_t ParameterServer::handleRequest(const uint8_t *request)
+    {
+        if (request == nullptr)
+        {
+            return 0;
+        }
+
+        const uint8_t frameLength = request[1];
+        const uint8_t type = request[2];
+        const uint8_t *payload = &request[3];
+        if (frameLength < crsfProtocol::CRSF_FRAME_PARAMETER_REQUEST_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC)
+        {
+            _statistics.rejected++;
+            return 0;
+        }
+
+        // payload[0] is the destination (us), payload[1] is the origin (the handset or the transmitter module).
+        if (type == crsfProtocol::CRSF_FRAMETYPE_PARAMETER_READ)
+        {
+            return _read(payload[1], payload[2], payload[3]);
+        }
+
+        if (type == crsfProtocol::CRSF_FRAMETYPE_PARAMETER_WRITE)
+        {
+            const uint8_t valueLength = frameLength - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC - 3;
+            if (_write(payload[2], &payload[3], valueLength))
+            {
+                _statistics.writes++;
+            }
+            else
+            {
+                _statistics.rejected++;
+            }
+        }
+
+        // Writes are not answered. The handset reads the parameter again to see its new value.
+        return 0;
+    }
+
+    /**
+     * @brief Returns the reply to the last request. It stays valid until the next call to handleRequest().
+     */
+    const uint8_t *ParameterServer::getReply()
+    {
+        return _reply;
+    }
+
+    void ParameterServer::getStatistics(parameterServerStatistics_t *statistics)
+    {
+        if (statistics != nullptr)
+        {
+            *statistics = _statistics;
+        }
+    }
+
+    void ParameterServer::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    uint8_t ParameterServer::_read(uint8_t origin, uint8_t number, uint8_t chunk)
+    {
+        if (number > _count)
+        {
+            _statistics.rejected++;
+            return 0;
+        }
+
+        /* Serialise the whole entry, but only keep the bytes that fall inside the chunk that was asked for.
+        The position at the end is the size of the whole entry, which gives the number of chunks. */
+        _replyLength = PARAMETER_REPLY_HEADER_SIZE;
+        _windowStart = (uint16_t)chunk * PARAMETER_CHUNK_SIZE;
+        _position = 0;
+        _serialise(number);
+
+        const uint16_t chunks = (_position + PARAMETER_CHUNK_SIZE - 1) / PARAMETER_CHUNK_SIZE;
+        if (chunk >= chunks)
+        {
+            _statistics.rejected++;
+            return 0;
+        }
+
+        _reply[0] = crsfProtocol::CRSF_SYNC_BYTE;
+        _reply[1] = _replyLength - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH + crsfProtocol::CRSF_FRAME_LENGTH_CRC;
+        _reply[2] = crsfProtocol::CRSF_FRAMETYPE_PARAMETER_SETTINGS_ENTRY;
+        _reply[PARAMETER_REPLY_DESTINATION] = origin;
+        _reply[PARAMETER_REPLY_ORIGIN] = crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER;
+        _reply[PARAMETER_REPLY_NUMBER] = number;
+        _reply[PARAMETER_REPLY_CHUNKS_REMAINING] = (uint8_t)(chunks - chunk - 1);
+        _reply[_replyLength] = _crc.calculate(2, _reply[2], _reply, _replyLength);
+        _replyLength++;
+
+        _statistics.reads++;
+        return _replyLength;
+    }
+
+    bool ParameterServer::_write(uint8_t number, const uint8_t *value, uint8_t length)
+    {
+        if (number == PARAMETER_ROOT || number > _count)
+        {
+            return false;
+        }
+
+        const parameterDescriptor_t *parameter = &_parameters[number - 1];
+        int32_t newValue;
+        switch (parameter->type & ~PARAMETER_HIDDEN)
+        {
+            case PARAMETER_TYPE_UINT8:
+            case PARAMETER_TYPE_TEXT_SELECTION:
+            case PARAMETER_TYPE_COMMAND:
+                if (length < 1)
+                {
+                    return false;
+                }
+                newValue = value[0];
+                break;
+            case PARAMETER_TYPE_INT8:
+                if (length < 1)
+                {
+                    return false;
+                }
+                newValue = (int8_t)value[0];
+                break;
+            case PARAMETER_TYPE_UINT16:
+                if (length < 2)
+                {
+                    return false;
+                }
+                newValue = (uint16_t)((value[0] << 8) | value[1]);
+                break;
+            case PARAMETER_TYPE_INT16:
+                if (length < 2)
+                {
+                    return false;
+                }
+                newValue = (int16_t)((value[0] << 8) | value[1]);
+                break;
+            case PARAMETER_TYPE_FLOAT:
+                if (length < 4)
+                {
+                    return false;
+                }
+                newValue = (int32_t)(((uint32_t)value[0] << 24) | ((uint32_t)value[1] << 16) | ((uint32_t)value[2] << 8) | value[3]);
+                break;
+            default:
+                // Folders and info entries cannot be written.
+                return false;
+        }
+
+        if (parameter->value == nullptr)
+        {
+            return false;
+        }
+
+        _setValue(parameter, newValue);
+
+        if (_writeCallback != nullptr)
+        {
+            _writeCallback(number, parameter);
+        }
+        return true;
+    }
+
+    void ParameterServer::_serialise(uint8_t number)
+    {
+        if (number == PARAMETER_ROOT)
+        {
+            _put(PARAMETER_ROOT);
+            _put(PARAMETER_TYPE_FOLDER);
+            _putString(_rootName);
+            for (uint8_t i = 0; i < _count; i++)
+            {
+                if (_parameters[i].parent == PARAMETER_ROOT)
+                {
+                    _put(i + 1);
+                }
+            }
+            _put(PARAMETER_FOLDER_END);
+            return;
+        }
+
+        const parameterDescriptor_t *parameter = &_parameters[number - 1];
+        _put(parameter->parent);
+        _put(parameter->type);
+        _putString(parameter->name);
+
+        switch (parameter->type & ~PARAMETER_HIDDEN)
+        {
+            case PARAMETER_TYPE_UINT8:
+            case PARAMETER_TYPE_INT8:
+            case PARAMETER_TYPE_UINT16:
+            case PARAMETER_TYPE_INT16:
+            {
+                const uint8_t size = (parameter->type & ~PARAMETER_HIDDEN) >= PARAMETER_TYPE_UINT16 ? 2 : 1;
+                _putValue(_getValue(parameter), size);
+                _putValue(parameter->min, size);
+                _putValue(parameter->max, size);
+                _putValue(parameter->defaultValue, size);
+                _putString(parameter->text);
+                break;
+            }
+            case PARAMETER_TYPE_FLOAT:
+                _putValue(_getValue(parameter), 4);
+                _putValue(parameter->min, 4);
+                _putValue(parameter->max, 4);
+                _putValue(parameter->defaultValue, 4);
+                _put(parameter->decimals);
+                _putValue(parameter->step, 4);
+                _putString(parameter->text);
+                break;
+            case PARAMETER_TYPE_TEXT_SELECTION:
+            {
+                // The highest option is the number of separators in the options.
+                uint8_t max = 0;
+                for (const char *option = parameter->text; *option != '\0'; option++)
+                {
+                    max += *option == ';' ? 1 : 0;
+                }
+
+                _putString(parameter->text);
+                _put((uint8_t)_getValue(parameter));
+                _put(0);
+                _put(max);
+                _put((uint8_t)parameter->defaultValue);
+                _putString("");
+                break;
+            }
+            case PARAMETER_TYPE_FOLDER:
+                for (uint8_t i = 0; i < _count; i++)
+                {
+                    if (_parameters[i].parent == number)
+                    {
+                        _put(i + 1);
+                    }
+                }
+                _put(PARAMETER_FOLDER_END);
+                break;
+            case PARAMETER_TYPE_INFO:
+                _putString(parameter->text);
+                break;
+            case PARAMETER_TYPE_COMMAND:
+                _put((uint8_t)_getValue(parameter));
+                _put(PARAMETER_COMMAND_TIMEOUT);
+                _putString(parameter->text);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* Writes one byte of the entry, if it falls inside the window of the chunk that is being sent. */
+    void ParameterServer::_put(uint8_t value)
+    {
+        if (_position >= _windowStart && _position - _windowStart < PARAMETER_CHUNK_SIZE)
+        {
+            _reply[_replyLength++] = value;
+        }
+        _position++;
+    }
+
+    void ParameterServer::_putValue(int32_t value, uint8_t size)
+    {
+        for (uint8_t i = size; i > 0; i--)
+        {
+            _put((uint8_t)((uint32_t)value >> ((i - 1) * 8)));
+        }
+    }
+
+    void ParameterServer::_putString(const char *string)
+    {
+        if (string != nullptr)
+        {
+            while (*string != '\0')
+            {
+                _put((uint8_t)*string++);
+            }
+        }
+        _put('\0');
+    }
+
+    int32_t ParameterServer::_getValue(const parameterDescriptor_t *parameter)
+    {
+        if (parameter->value == nullptr)
+        {
+            return 0;
+        }
+
+        switch (parameter->type & ~PARAMETER_HIDDEN)
+        {
+            case PARAMETER_TYPE_UINT8:
+            case PARAMETER_TYPE_TEXT_SELECTION:
+            case PARAMETER_TYPE_COMMAND:
+                return *(uint8_t *)parameter->value;
+            case PARAMETER_TYPE_INT8:
+                return *(int8_t *)parameter->value;
+            case PARAMETER_TYPE_UINT16:
+                return *(uint16_t *)parameter->value;
+            case PARAMETER_TYPE_INT16:
+                return *(int16_t *)parameter->value;
+            case PARAMETER_TYPE_FLOAT:
+            {
+                float value = *(float *)parameter->value;
+                for (uint8_t i = 0; i < parameter->decimals; i++)
+                {
+                    value *= 10.0F;
+                }
+                return (int32_t)(value < 0 ? value - 0.5F : value + 0.5F);
+            }
+            default:
+                return 0;
+        }
+    }
+
+    /* Stores value in the parameter's variable. Numbers are clamped to the parameter's range. */
+    void ParameterServer::_setValue(const parameterDescriptor_t *parameter, int32_t value)
+    {
+        const uint8_t type = parameter->type & ~PARAMETER_HIDDEN;
+        if (type != PARAMETER_TYPE_TEXT_SELECTION && type != PARAMETER_TYPE_COMMAND)
+        {
+            value = value < parameter->min ? parameter->min : (value > parameter->max ? parameter->max : value);
+        }
+
+        switch (type)
+        {
+            case PARAMETER_TYPE_UINT8:
+            case PARAMETER_TYPE_COMMAND:
+                *(uint8_t *)parameter->value = (uint8_t)value;
+                break;
+            case PARAMETER_TYPE_TEXT_SELECTION:
+            {
+                uint8_t max = 0;
+                for (const char *option = parameter->text; *option != '\0'; option++)
+                {
+                    max += *option == ';' ? 1 : 0;
+                }
+                *(uint8_t *)parameter->value = (uint8_t)(value > max ? max : value);
+                break;
+            }
+            case PARAMETER_TYPE_INT8:
+                *(int8_t *)parameter->value = (int8_t)value;
+                break;
+            case PARAMETER_TYPE_UINT16:
+                *(uint16_t *)parameter->value = (uint16_t)value;
+                break;
+            case PARAMETER_TYPE_INT16:
+                *(int16_t *)parameter->value = (int16_t)value;
+                break;
+            case PARAMETER_TYPE_FLOAT:
+            {
+                float newValue = (float)value;
+                for (uint8_t i = 0; i < parameter->decimals; i++)
+                {
+                    newValue /= 10.0F;
+                }
+                *(float *)parameter->value = newValue;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+} // namespace serialReceiverLayer
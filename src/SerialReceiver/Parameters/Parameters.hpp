@@ -0,0 +1,199 @@
+/**
+ * @file Parameters.hpp
+ * @author CRSF for Arduino contributors
+ * @brief This serves settings to the handset's device menu, one chunk of one entry at a time.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../CRC/CRC.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Parameter protocol
+The handset reads each entry with PARAMETER_READ (destination, origin, parameter number, chunk number), and is answered with
+PARAMETER_SETTINGS_ENTRY (destination, origin, parameter number, chunks remaining, then up to PARAMETER_CHUNK_SIZE bytes of the entry).
+An entry is its parent folder's number, its type (with PARAMETER_HIDDEN set if it is hidden), its name, then what its type carries:
+- Numbers: value, minimum, maximum and default (each as wide as the type, big endian), then the unit.
+- PARAMETER_TYPE_FLOAT: value, minimum, maximum and default (int32, scaled by 10^decimals), decimals (uint8), step (int32), then the unit.
+- PARAMETER_TYPE_TEXT_SELECTION: the options ("Off;On"), then value, minimum, maximum and default (uint8), then the unit.
+- PARAMETER_TYPE_FOLDER: the numbers of its children, then PARAMETER_FOLDER_END.
+- PARAMETER_TYPE_INFO: the text.
+- PARAMETER_TYPE_COMMAND: the step (parameterCommandStep_t), the timeout (in 10 ms), then the text.
+Strings end with a zero. PARAMETER_WRITE (destination, origin, parameter number, value) changes one entry.
+Parameter 0 is the root folder, which holds every entry whose parent is 0. */
+#define PARAMETER_CHUNK_SIZE      (crsfProtocol::CRSF_PAYLOAD_SIZE_MAX - 2)
+#define PARAMETER_HIDDEN          0x80
+#define PARAMETER_ROOT            0
+#define PARAMETER_FOLDER_END      0xFF
+#define PARAMETER_ROOT_NAME       "Settings"
+#define PARAMETER_COMMAND_TIMEOUT 50                                        // How long the handset waits for a command to move on, in 10 ms.
+
+    typedef enum parameterType_e
+    {
+        PARAMETER_TYPE_UINT8 = 0,
+        PARAMETER_TYPE_INT8 = 1,
+        PARAMETER_TYPE_UINT16 = 2,
+        PARAMETER_TYPE_INT16 = 3,
+        PARAMETER_TYPE_FLOAT = 8,
+        PARAMETER_TYPE_TEXT_SELECTION = 9,
+        PARAMETER_TYPE_FOLDER = 11,
+        PARAMETER_TYPE_INFO = 12,
+        PARAMETER_TYPE_COMMAND = 13
+    } parameterType_t;
+
+    typedef enum parameterCommandStep_e
+    {
+        PARAMETER_COMMAND_READY = 0,
+        PARAMETER_COMMAND_START = 1,
+        PARAMETER_COMMAND_PROGRESS = 2,
+        PARAMETER_COMMAND_CONFIRMATION_NEEDED = 3,
+        PARAMETER_COMMAND_CONFIRM = 4,
+        PARAMETER_COMMAND_CANCEL = 5,
+        PARAMETER_COMMAND_POLL = 6
+    } parameterCommandStep_t;
+
+    /* Describes one entry in the handset's device menu. Build these with the parameterXxx() functions below,
+    in a const table, so that the table stays in flash (on ARM and ESP32 MCUs) and only the values live in RAM.
+    Parameter numbers start at 1, for the first entry in the table. */
+    typedef struct parameterDescriptor_s
+    {
+        const char *name;
+        const char *text;     // The unit of a number, the options of a text selection ("Off;On"), or the text of an info entry or a command.
+        void *value;          // The variable that holds the value, of the type that the parameterXxx() function took.
+        int32_t min;          // Floats are scaled by 10^decimals.
+        int32_t max;
+        int32_t defaultValue;
+        int32_t step;         // Floats only.
+        uint8_t decimals;     // Floats only.
+        uint8_t parent;       // The number of the folder that holds this entry, or PARAMETER_ROOT.
+        uint8_t type;         // parameterType_t, with PARAMETER_HIDDEN set to hide the entry.
+    } parameterDescriptor_t;
+
+    constexpr parameterDescriptor_t parameterFolder(const char *name, uint8_t parent = PARAMETER_ROOT)
+    {
+        return {name, "", nullptr, 0, 0, 0, 0, 0, parent, PARAMETER_TYPE_FOLDER};
+    }
+
+    constexpr parameterDescriptor_t parameterUint8(const char *name, uint8_t parent, uint8_t *value, uint8_t min, uint8_t max, uint8_t defaultValue, const char *unit = "")
+    {
+        return {name, unit, value, min, max, defaultValue, 0, 0, parent, PARAMETER_TYPE_UINT8};
+    }
+
+    constexpr parameterDescriptor_t parameterInt8(const char *name, uint8_t parent, int8_t *value, int8_t min, int8_t max, int8_t defaultValue, const char *unit = "")
+    {
+        return {name, unit, value, min, max, defaultValue, 0, 0, parent, PARAMETER_TYPE_INT8};
+    }
+
+    constexpr parameterDescriptor_t parameterUint16(const char *name, uint8_t parent, uint16_t *value, uint16_t min, uint16_t max, uint16_t defaultValue, const char *unit = "")
+    {
+        return {name, unit, value, min, max, defaultValue, 0, 0, parent, PARAMETER_TYPE_UINT16};
+    }
+
+    constexpr parameterDescriptor_t parameterInt16(const char *name, uint8_t parent, int16_t *value, int16_t min, int16_t max, int16_t defaultValue, const char *unit = "")
+    {
+        return {name, unit, value, min, max, defaultValue, 0, 0, parent, PARAMETER_TYPE_INT16};
+    }
+
+    /* min, max, defaultValue and step are scaled by 10^decimals, eg 150 with 2 decimals is 1.50. */
+    constexpr parameterDescriptor_t parameterFloat(const char *name, uint8_t parent, float *value, int32_t min, int32_t max, int32_t defaultValue, uint8_t decimals, int32_t step, const char *unit = "")
+    {
+        return {name, unit, value, min, max, defaultValue, step, decimals, parent, PARAMETER_TYPE_FLOAT};
+    }
+
+    /* value is the index of the chosen option in options, eg "Off;On". */
+    constexpr parameterDescriptor_t parameterSelection(const char *name, uint8_t parent, uint8_t *value, const char *options, uint8_t defaultValue = 0)
+    {
+        return {name, options, value, 0, 0, defaultValue, 0, 0, parent, PARAMETER_TYPE_TEXT_SELECTION};
+    }
+
+    constexpr parameterDescriptor_t parameterInfo(const char *name, uint8_t parent, const char *text)
+    {
+        return {name, text, nullptr, 0, 0, 0, 0, 0, parent, PARAMETER_TYPE_INFO};
+    }
+
+    /* step holds the command's parameterCommandStep_t. The write callback sees each step that the handset sends,
+    and sets step to say where the command has got to (eg back to PARAMETER_COMMAND_READY when it is done). */
+    constexpr parameterDescriptor_t parameterCommand(const char *name, uint8_t parent, uint8_t *step, const char *text = "")
+    {
+        return {name, text, step, 0, 0, 0, 0, 0, parent, PARAMETER_TYPE_COMMAND};
+    }
+
+    typedef struct parameterServerStatistics_s
+    {
+        uint32_t reads;    // Read requests that were answered.
+        uint32_t writes;   // Write requests that changed a value.
+        uint32_t rejected; // Requests for a parameter or a chunk that does not exist, and writes that were malformed or read only.
+    } parameterServerStatistics_t;
+
+    // Function pointer for the Parameter Write Callback. It is called after the new value has been stored in the parameter's variable.
+    typedef void (*parameterWriteCallback_t)(uint8_t number, const parameterDescriptor_t *parameter);
+
+    /**
+     * @brief Answers the handset's parameter reads and writes from a table of parameterDescriptor_t.
+     * Each read is answered by serialising the one entry again, and keeping only the bytes of the chunk that was asked for,
+     * so no entry is ever held whole. The server only needs RAM for one frame, however big the menu is.
+     */
+    class ParameterServer final
+    {
+      public:
+        ParameterServer(const parameterDescriptor_t *parameters, uint8_t count, const char *rootName = PARAMETER_ROOT_NAME);
+        ~ParameterServer();
+
+        uint8_t getParameterCount();
+        void setWriteCallback(parameterWriteCallback_t callback);
+
+        uint8_t handleRequest(const uint8_t *request);
+        const uint8_t *getReply();
+
+        void getStatistics(parameterServerStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        const parameterDescriptor_t *_parameters;
+        uint8_t _count;
+        const char *_rootName;
+        parameterWriteCallback_t _writeCallback = nullptr;
+        genericCrc::GenericCRC _crc;
+        parameterServerStatistics_t _statistics;
+
+        // The reply, and the window of the entry that is copied into it.
+        uint8_t _reply[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        uint8_t _replyLength;
+        uint16_t _windowStart;
+        uint16_t _position;
+
+        uint8_t _read(uint8_t origin, uint8_t number, uint8_t chunk);
+        bool _write(uint8_t number, const uint8_t *value, uint8_t length);
+
+        void _serialise(uint8_t number);
+        void _put(uint8_t value);
+        void _putValue(int32_t value, uint8_t size);
+        void _putString(const char *string);
+
+        int32_t _getValue(const parameterDescriptor_t *parameter);
+        void _setValue(const parameterDescriptor_t *parameter, int32_t value);
+    };
+} // namespace serialReceiverLayer
@@ -0,0 +1,327 @@
+/**
+ * @file Pcapng.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Writes decoded CRSF frames to pcapng files, which standard packet analysers can open.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Pcapng.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+namespace serialReceiverLayer
+{
+    /* Block types and option codes, from the pcapng specification. */
+    static const uint32_t sectionHeaderBlock = 0x0A0D0D0A;
+    static const uint32_t interfaceDescriptionBlock = 0x00000001;
+    static const uint32_t enhancedPacketBlock = 0x00000006;
+    static const uint32_t byteOrderMagic = 0x1A2B3C4D;
+
+    static const uint16_t optionEndOfOptions = 0;
+    static const uint16_t optionShbUserApplication = 4;
+    static const uint16_t optionIfName = 2;
+    static const uint16_t optionIfTimestampResolution = 9;
+    static const uint16_t optionEpbFlags = 2;
+
+    static void writeU16LE(uint8_t *buffer, uint16_t value)
+    {
+        buffer[0] = (uint8_t)value;
+        buffer[1] = (uint8_t)(value >> 8);
+    }
+
+    static void writeU32LE(uint8_t *buffer, uint32_t value)
+    {
+        writeU16LE(buffer, (uint16_t)value);
+        writeU16LE(buffer + 2, (uint16_t)(value >> 16));
+    }
+
+    static size_t padded(size_t length)
+    {
+        return (length + 3) & ~(size_t)3;
+    }
+
+    /**
+     * @brief Writes an option (code, length, value and padding) and returns its size.
+     */
+    static size_t writeOption(uint8_t *buffer, uint16_t code, const void *value, uint16_t length)
+    {
+        writeU16LE(buffer, code);
+        writeU16LE(buffer + 2, length);
+        if (length > 0)
+        {
+            memcpy(buffer + 4, value, length);
+        }
+        memset(buffer + 4 + length, 0, padded(length) - length);
+        return 4 + padded(length);
+    }
+
+    PcapngWriter::PcapngWriter()
+    {
+        _file = nullptr;
+        _length = 0;
+        _failed = false;
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    PcapngWriter::~PcapngWriter()
+    {
+        end();
+    }
+
+    /**
+     * @brief Creates (or replaces) the pcapng file at path, and writes its section header and its one interface.
+     *
+     * @param linkType The link type of the interface. Leave this as PCAPNG_LINKTYPE_USER0,
+     * unless that is already taken by another protocol in your analyser.
+     */
+    bool PcapngWriter::begin(const char *path, uint32_t linkType)
+    {
+        end();
+
+        _file = fopen(path, "wb");
+        if (_file == nullptr)
+        {
+            return false;
+        }
+
+        _length = 0;
+        _failed = false;
+        memset(&_statistics, 0, sizeof(_statistics));
+
+        // Section Header Block. The section length is unknown (-1), so that the file can be streamed.
+        const char *application = PCAPNG_APPLICATION_NAME;
+        uint8_t block[PCAPNG_BLOCK_SIZE_MAX];
+        size_t size = 24;
+        writeU32LE(block, sectionHeaderBlock);
+        writeU32LE(block + 8, byteOrderMagic);
+        writeU16LE(block + 12, 1);
+        writeU16LE(block + 14, 0);
+        memset(block + 16, 0xFF, 8);
+        size += writeOption(block + size, optionShbUserApplication, application, (uint16_t)strlen(application));
+        size += writeOption(block + size, optionEndOfOptions, nullptr, 0);
+        size += 4;
+        writeU32LE(block + 4, (uint32_t)size);
+        writeU32LE(block + size - 4, (uint32_t)size);
+        memcpy(_reserve(size), block, size);
+
+        // Interface Description Block, with microsecond timestamps.
+        const uint8_t timestampResolution = 6;
+        size = 16;
+        writeU32LE(block, interfaceDescriptionBlock);
+        writeU16LE(block + 8, (uint16_t)linkType);
+        writeU16LE(block + 10, 0);
+        writeU32LE(block + 12, crsfProtocol::CRSF_FRAME_SIZE_MAX);
+        size += writeOption(block + size, optionIfName, PCAPNG_INTERFACE_NAME, (uint16_t)strlen(PCAPNG_INTERFACE_NAME));
+        size += writeOption(block + size, optionIfTimestampResolution, &timestampResolution, 1);
+        size += writeOption(block + size, optionEndOfOptions, nullptr, 0);
+        size += 4;
+        writeU32LE(block + 4, (uint32_t)size);
+        writeU32LE(block + size - 4, (uint32_t)size);
+        memcpy(_reserve(size), block, size);
+
+        return _flush();
+    }
+
+    /**
+     * @brief Writes out what is left in the buffer and closes the file.
+     *
+     * @return false if anything could not be written.
+     */
+    bool PcapngWriter::end()
+    {
+        if (_file == nullptr)
+        {
+            return true;
+        }
+
+        bool written = _flush();
+        written = fclose(_file) == 0 && written;
+        _file = nullptr;
+        return written;
+    }
+
+    /**
+     * @brief Appends one frame as an Enhanced Packet Block.
+     *
+     * @param timestampUs When the frame arrived (or was sent), in microseconds since the Unix epoch if the analyser is to show wall clock time.
+     * @param frame The whole frame, from its address byte to its CRC.
+     * @param length The length of the frame, at most crsfProtocol::CRSF_FRAME_SIZE_MAX bytes.
+     * @return false if the file is not open, the frame is too long, or a previous write failed.
+     */
+    bool PcapngWriter::writeFrame(uint64_t timestampUs, const uint8_t *frame, uint8_t length, pcapngDirection_t direction)
+    {
+        if (_file == nullptr || _failed || length > crsfProtocol::CRSF_FRAME_SIZE_MAX)
+        {
+            return false;
+        }
+
+        const size_t size = 28 + padded(length) + (direction != PCAPNG_DIRECTION_UNKNOWN ? 8 : 0) + 4 + 4;
+        uint8_t *block = _reserve(size);
+        if (block == nullptr)
+        {
+            return false;
+        }
+
+        writeU32LE(block, enhancedPacketBlock);
+        writeU32LE(block + 4, (uint32_t)size);
+        writeU32LE(block + 8, 0);
+        writeU32LE(block + 12, (uint32_t)(timestampUs >> 32));
+        writeU32LE(block + 16, (uint32_t)timestampUs);
+        writeU32LE(block + 20, length);
+        writeU32LE(block + 24, length);
+
+        size_t position = 28;
+        memcpy(block + position, frame, length);
+        memset(block + position + length, 0, padded(length) - length);
+        position += padded(length);
+
+        if (direction != PCAPNG_DIRECTION_UNKNOWN)
+        {
+            const uint32_t flags = (uint32_t)direction;
+            writeU16LE(block + position, optionEpbFlags);
+            writeU16LE(block + position + 2, 4);
+            writeU32LE(block + position + 4, flags);
+            position += 8;
+        }
+
+        writeU32LE(block + position, 0);
+        writeU32LE(block + position + 4, (uint32_t)size);
+
+        _statistics.frames++;
+        return true;
+    }
+
+    /**
+     * @brief Decodes a capture (eg from a MappedFile) and writes every frame whose CRC matches, as an inbound frame.
+     * Frames are framed exactly as the receiver framed them, timeouts and all.
+     *
+     * @param timeOffsetUs Added to every timestamp. Captures are timed with micros(), so pass the wall clock time
+     * at which micros() was 0 to see wall clock time in the analyser.
+     * @return false if this is not a capture, or the pcapng file could not be written.
+     */
+    bool PcapngWriter::writeCapture(const uint8_t *capture, size_t size, uint64_t timeOffsetUs)
+    {
+        CaptureReader reader(capture, size);
+        if (_file == nullptr || !reader.readHeader())
+        {
+            return false;
+        }
+
+        BasicCRSF<CaptureDecoderConfig> decoder;
+        decoder.begin();
+        decoder.setFrameTime(reader.getBaudRate() > 0 ? reader.getBaudRate() : (uint32_t)crsfProtocol::BAUD_RATE, 10);
+
+        crsfCounters_t counters;
+        decoder.getCounters(&counters);
+
+        /* The decoder does not hand out the bytes of the frames that it decodes, so they are kept here as well,
+        at the same positions as in the decoder's own frame buffer. The decoder only starts a frame over when it is idle,
+        or when a frame times out, which can only happen on the first byte of a chunk with a new timestamp. */
+        uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        uint8_t framePosition = 0;
+        uint64_t lastTimestampUs = UINT64_MAX;
+
+        captureChunk_t chunk;
+        while (reader.next(&chunk))
+        {
+            for (uint16_t i = 0; i < chunk.length; i++)
+            {
+                if (decoder.isIdle() || framePosition >= crsfProtocol::CRSF_FRAME_SIZE_MAX)
+                {
+                    framePosition = 0;
+                }
+
+                frame[framePosition++] = chunk.data[i];
+                const bool received = decoder.receiveFrames(chunk.data[i], (uint32_t)chunk.timestampUs);
+
+                if (received || (i == 0 && chunk.timestampUs != lastTimestampUs))
+                {
+                    const uint32_t timeouts = counters.timeouts;
+                    const uint32_t crcErrors = counters.crcErrors;
+                    decoder.getCounters(&counters);
+
+                    if (counters.timeouts != timeouts)
+                    {
+                        frame[0] = chunk.data[i];
+                        framePosition = 1;
+                    }
+
+                    if (!received)
+                    {
+                        continue;
+                    }
+
+                    if (counters.crcErrors != crcErrors)
+                    {
+                        _statistics.crcErrors++;
+                    }
+                    else if (!writeFrame(chunk.timestampUs + timeOffsetUs, frame, framePosition, PCAPNG_DIRECTION_INBOUND))
+                    {
+                        return false;
+                    }
+
+                    framePosition = 0;
+                }
+            }
+
+            lastTimestampUs = chunk.timestampUs;
+        }
+
+        return !_failed;
+    }
+
+    void PcapngWriter::getStatistics(pcapngStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(pcapngStatistics_t));
+    }
+
+    /**
+     * @brief Makes room for size bytes at the end of the buffer, writing the buffer out first if they do not fit.
+     *
+     * @return Where to put the bytes, or nullptr if the buffer could not be written.
+     */
+    uint8_t *PcapngWriter::_reserve(size_t size)
+    {
+        if (_length + size > PCAPNG_BUFFER_SIZE && !_flush())
+        {
+            return nullptr;
+        }
+
+        uint8_t *block = _buffer + _length;
+        _length += size;
+        return block;
+    }
+
+    bool PcapngWriter::_flush()
+    {
+        if (_length > 0 && !_failed)
+        {
+            _failed = fwrite(_buffer, 1, _length, _file) != _length;
+            _statistics.bytesWritten += _length;
+        }
+
+        _length = 0;
+        return !_failed;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
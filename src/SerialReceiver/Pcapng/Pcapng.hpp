@@ -0,0 +1,97 @@
+/**
+ * @file Pcapng.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Writes decoded CRSF frames to pcapng files, which standard packet analysers can open.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../Capture/Capture.hpp"
+#include "stdio.h"
+
+namespace serialReceiverLayer
+{
+/* pcapng output
+A pcapng file is a Section Header Block, one Interface Description Block, and then one Enhanced Packet Block per frame.
+Each packet is a whole CRSF frame, from its address byte to its CRC, with the time that its last byte arrived (in microseconds)
+and its direction in the epb_flags option. CRSF has no link type of its own, so the interface uses a user link type
+(PCAPNG_LINKTYPE_USER0, 147). Wireshark shows these as raw bytes until it is given a dissector for them,
+such as the one that comes with the linux_pcapng_export example.
+- PCAPNG_BUFFER_SIZE: Blocks are built in a buffer of this size, which is written out whenever it fills up.
+  Nothing is allocated per frame.
+- PCAPNG_BLOCK_SIZE_MAX: The largest block that is written, ie an Enhanced Packet Block holding a 64 byte frame. */
+#define PCAPNG_LINKTYPE_USER0   147
+#define PCAPNG_BUFFER_SIZE      65536
+#define PCAPNG_BLOCK_SIZE_MAX   128
+#define PCAPNG_INTERFACE_NAME   "crsf"
+#define PCAPNG_APPLICATION_NAME "CRSF for Arduino " CRSFFORARDUINO_VERSION
+
+    typedef enum pcapngDirection_e
+    {
+        PCAPNG_DIRECTION_UNKNOWN = 0,
+        PCAPNG_DIRECTION_INBOUND = 1,  // Received, eg RC channels and link statistics from the receiver.
+        PCAPNG_DIRECTION_OUTBOUND = 2, // Sent, eg telemetry to the receiver.
+    } pcapngDirection_t;
+
+    typedef struct pcapngStatistics_s
+    {
+        uint64_t frames;       // Frames written.
+        uint64_t bytesWritten; // Bytes written to the file, headers included.
+        uint64_t crcErrors;    // Frames that were left out of exported captures, because their CRC did not match.
+    } pcapngStatistics_t;
+
+    /**
+     * @brief Streams CRSF frames into a pcapng file.
+     * Frames can be written one at a time, with writeFrame(), or a whole capture can be exported with writeCapture().
+     */
+    class PcapngWriter
+    {
+      public:
+        PcapngWriter();
+        ~PcapngWriter();
+
+        bool begin(const char *path, uint32_t linkType = PCAPNG_LINKTYPE_USER0);
+        bool end();
+
+        bool writeFrame(uint64_t timestampUs, const uint8_t *frame, uint8_t length, pcapngDirection_t direction);
+        bool writeCapture(const uint8_t *capture, size_t size, uint64_t timeOffsetUs = 0);
+
+        void getStatistics(pcapngStatistics_t *statistics);
+
+      private:
+        FILE *_file;
+        size_t _length;
+        bool _failed;
+        pcapngStatistics_t _statistics;
+        uint8_t _buffer[PCAPNG_BUFFER_SIZE];
+
+        uint8_t *_reserve(size_t size);
+        bool _flush();
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -57,247 +57,8 @@ namespace genericStreamBuffer
         memset(buffer, 0, bufferSizeMax);
         // #endif
     }
-
-    // Write signed integers in little endian
-    size_t SerialBuffer::write8(int8_t value)
-    {
-        if (bufferIndex + 1 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value;
-        bufferLength = bufferIndex;
-
-        return 1;
-    }
-
-    size_t SerialBuffer::write16(int16_t value)
-    {
-        if (bufferIndex + 2 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 2;
-    }
-
-    size_t SerialBuffer::write32(int32_t value)
-    {
-        if (bufferIndex + 4 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = (value >> 16) & 0xFF;
-        buffer[bufferIndex++] = (value >> 24) & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 4;
-    }
-
-    // Write unsigned integers in little endian
-    size_t SerialBuffer::writeU8(uint8_t value)
-    {
-        if (bufferIndex + 1 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value;
-        bufferLength = bufferIndex;
-
-        return 1;
-    }
-
-    size_t SerialBuffer::writeU16(uint16_t value)
-    {
-        if (bufferIndex + 2 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 2;
-    }
-
-    size_t SerialBuffer::writeU32(uint32_t value)
-    {
-        if (bufferIndex + 4 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = (value >> 16) & 0xFF;
-        buffer[bufferIndex++] = (value >> 24) & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 4;
-    }
-
-    // Write signed integers in big endian
-    size_t SerialBuffer::write8BE(int8_t value)
-    {
-        if (bufferIndex + 1 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value;
-        bufferLength = bufferIndex;
-
-        return 1;
-    }
-
-    size_t SerialBuffer::write16BE(int16_t value)
-    {
-        if (bufferIndex + 2 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = value & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 2;
-    }
-
-    size_t SerialBuffer::write32BE(int32_t value)
-    {
-        if (bufferIndex + 4 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = (value >> 24) & 0xFF;
-        buffer[bufferIndex++] = (value >> 16) & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = value & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 4;
-    }
-
-    // Write unsigned integers in big endian
-    size_t SerialBuffer::writeU8BE(uint8_t value)
-    {
-        if (bufferIndex + 1 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = value;
-        bufferLength = bufferIndex;
-
-        return 1;
-    }
-
-    size_t SerialBuffer::writeU16BE(uint16_t value)
-    {
-        if (bufferIndex + 2 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = value & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 2;
-    }
-
-    size_t SerialBuffer::writeU24BE(uint32_t value)
-    {
-        if (bufferIndex + 3 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = (value >> 16) & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = value & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 3;
-    }
-
-    size_t SerialBuffer::writeU32BE(uint32_t value)
-    {
-        if (bufferIndex + 4 > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        buffer[bufferIndex++] = (value >> 24) & 0xFF;
-        buffer[bufferIndex++] = (value >> 16) & 0xFF;
-        buffer[bufferIndex++] = (value >> 8) & 0xFF;
-        buffer[bufferIndex++] = value & 0xFF;
-        bufferLength = bufferIndex;
-
-        return 4;
-    }
-
-    // Write a string
-    size_t SerialBuffer::writeString(const char *string)
-    {
-        size_t length = strlen(string);
-
-        if (bufferIndex + length > bufferSizeMax)
-        {
-            return 0;
-        }
-
-        memcpy(buffer + bufferIndex, string, length);
-        bufferIndex += length;
-        bufferLength = bufferIndex;
-
-        return length;
-    }
-
-    // Get the current buffer length
-    size_t SerialBuffer::getLength()
-    {
-        return bufferLength;
-    }
-
-    // Get the maximum buffer size
-    size_t SerialBuffer::getMaxSize()
-    {
-        return bufferSizeMax;
-    }
-
-    // Get the current buffer index
-    size_t SerialBuffer::getIndex()
-    {
-        return bufferIndex;
-    }
-
-    // Get the byte at the specified index
-    uint8_t SerialBuffer::getByte(size_t index)
-    {
-        if (index >= bufferSizeMax)
-        {
-            return 0;
-        }
-
-        return buffer[index];
-    }
-
-    // Get the buffer
-    uint8_t *SerialBuffer::getBuffer()
-    {
-        return buffer;
-    }
 } // namespace genericStreamBuffer
+
+#if CRSF_INLINE_HOT_PATH == 0
+#include "SerialBufferInline.hpp"
+#endif
@@ -26,12 +26,13 @@
 
 #pragma once
 
+#include "../../CFA_Config.hpp"
 #include "stddef.h"
 #include "stdint.h"
 
 namespace genericStreamBuffer
 {
-    class SerialBuffer
+    class SerialBuffer final
     {
       public:
         SerialBuffer(size_t size = 64);
@@ -85,3 +86,7 @@ namespace genericStreamBuffer
         uint8_t *buffer;
     };
 } // namespace genericStreamBuffer
+
+#if CRSF_INLINE_HOT_PATH > 0
+#include "SerialBufferInline.hpp"
+#endif
@@ -0,0 +1,276 @@
+/**
+ * @file SerialBufferInline.hpp
+ * @author CRSF for Arduino contributors
+ * @brief The SerialBuffer writers. These are compiled into SerialBuffer.cpp, or inlined into their callers when CRSF_INLINE_HOT_PATH is enabled.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "SerialBuffer.hpp"
+#include "string.h"
+
+namespace genericStreamBuffer
+{
+    // Write signed integers in little endian
+    CRSF_HOT_PATH size_t SerialBuffer::write8(int8_t value)
+    {
+        if (bufferIndex + 1 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value;
+        bufferLength = bufferIndex;
+
+        return 1;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::write16(int16_t value)
+    {
+        if (bufferIndex + 2 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 2;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::write32(int32_t value)
+    {
+        if (bufferIndex + 4 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = (value >> 16) & 0xFF;
+        buffer[bufferIndex++] = (value >> 24) & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 4;
+    }
+
+    // Write unsigned integers in little endian
+    CRSF_HOT_PATH size_t SerialBuffer::writeU8(uint8_t value)
+    {
+        if (bufferIndex + 1 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value;
+        bufferLength = bufferIndex;
+
+        return 1;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::writeU16(uint16_t value)
+    {
+        if (bufferIndex + 2 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 2;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::writeU32(uint32_t value)
+    {
+        if (bufferIndex + 4 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = (value >> 16) & 0xFF;
+        buffer[bufferIndex++] = (value >> 24) & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 4;
+    }
+
+    // Write signed integers in big endian
+    CRSF_HOT_PATH size_t SerialBuffer::write8BE(int8_t value)
+    {
+        if (bufferIndex + 1 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value;
+        bufferLength = bufferIndex;
+
+        return 1;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::write16BE(int16_t value)
+    {
+        if (bufferIndex + 2 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = value & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 2;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::write32BE(int32_t value)
+    {
+        if (bufferIndex + 4 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = (value >> 24) & 0xFF;
+        buffer[bufferIndex++] = (value >> 16) & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = value & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 4;
+    }
+
+    // Write unsigned integers in big endian
+    CRSF_HOT_PATH size_t SerialBuffer::writeU8BE(uint8_t value)
+    {
+        if (bufferIndex + 1 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = value;
+        bufferLength = bufferIndex;
+
+        return 1;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::writeU16BE(uint16_t value)
+    {
+        if (bufferIndex + 2 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = value & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 2;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::writeU24BE(uint32_t value)
+    {
+        if (bufferIndex + 3 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = (value >> 16) & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = value & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 3;
+    }
+
+    CRSF_HOT_PATH size_t SerialBuffer::writeU32BE(uint32_t value)
+    {
+        if (bufferIndex + 4 > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        buffer[bufferIndex++] = (value >> 24) & 0xFF;
+        buffer[bufferIndex++] = (value >> 16) & 0xFF;
+        buffer[bufferIndex++] = (value >> 8) & 0xFF;
+        buffer[bufferIndex++] = value & 0xFF;
+        bufferLength = bufferIndex;
+
+        return 4;
+    }
+
+    // Write a string
+    CRSF_HOT_PATH size_t SerialBuffer::writeString(const char *string)
+    {
+        size_t length = strlen(string);
+
+        if (bufferIndex + length > bufferSizeMax)
+        {
+            return 0;
+        }
+
+        memcpy(buffer + bufferIndex, string, length);
+        bufferIndex += length;
+        bufferLength = bufferIndex;
+
+        return length;
+    }
+
+    // Get the current buffer length
+    CRSF_HOT_PATH size_t SerialBuffer::getLength()
+    {
+        return bufferLength;
+    }
+
+    // Get the maximum buffer size
+    CRSF_HOT_PATH size_t SerialBuffer::getMaxSize()
+    {
+        return bufferSizeMax;
+    }
+
+    // Get the current buffer index
+    CRSF_HOT_PATH size_t SerialBuffer::getIndex()
+    {
+        return bufferIndex;
+    }
+
+    // Get the byte at the specified index
+    CRSF_HOT_PATH uint8_t SerialBuffer::getByte(size_t index)
+    {
+        if (index >= bufferSizeMax)
+        {
+            return 0;
+        }
+
+        return buffer[index];
+    }
+
+    // Get the buffer
+    CRSF_HOT_PATH uint8_t *SerialBuffer::getBuffer()
+    {
+        return buffer;
+    }
+} // namespace genericStreamBuffer
@@ -27,12 +27,19 @@
 #pragma once
 
 #include "../CFA_Config.hpp"
-#include "Arduino.h"
+#include "../hal/CompatibilityTable/CompatibilityTable.hpp"
+#include "../hal/SerialTransport/SerialTransport.hpp"
+#include "Blackbox/Blackbox.hpp"
 #include "CRSF/CRSF.hpp"
+#include "Command/Command.hpp"
+#include "DisplayPort/DisplayPort.hpp"
+#include "Parameters/Parameters.hpp"
 #include "Telemetry/Telemetry.hpp"
 
 namespace serialReceiverLayer
 {
+#define SERIAL_RECEIVER_READ_SIZE 64 // Bytes taken from the transport per read. One full size CRSF frame.
+
     typedef enum flightModeId_e
     {
         FLIGHT_MODE_DISARMED = 0,
@@ -54,6 +61,28 @@ namespace serialReceiverLayer
         uint16_t value[crsfProtocol::RC_CHANNEL_COUNT];
     } rcChannels_t;
 
+    typedef struct serialReceiverCounters_s
+    {
+        crsfCounters_t crsf;              // The decoder's counters.
+        uint32_t bytesReceived;           // Bytes read from the transport by processFrames().
+        uint32_t uartOverruns;            // Received bytes that the UART or its driver lost. Only counted by transports that can tell.
+        uint32_t bytesDiscarded;          // Received bytes that were thrown away when the receive buffer was flushed.
+        uint32_t telemetryFramesSent;     // Telemetry frames that the transport accepted.
+        uint32_t telemetryFramesDropped;  // Telemetry frames that the transport did not accept in full.
+        uint32_t telemetryQueueFull;      // Answers (eg device info, parameter replies, commands) that were not sent, because TELEMETRY_QUEUE_SIZE frames were already waiting.
+        uint32_t devicePings;             // Device pings for this flight controller (or for every device). Each is answered with a device info frame.
+        uint32_t commands;                // Command frames for this flight controller (or for every device) whose inner CRC matched.
+        uint32_t baudRateChanges;         // Speed proposals that were accepted, and switched to.
+        uint32_t baudRateFallbacks;       // Falls back to 420000 baud, after going CRSF_BAUD_RATE_FALLBACK_TIMEOUT without RC channels or link statistics.
+        uint32_t halfDuplexSlotsMissed;   // RC channels frames whose telemetry slot was passed up, because more bytes were already arriving.
+        uint32_t halfDuplexFramesDropped; // Telemetry frames that were dropped, because they would not have fit in the gap before the next RC channels frame.
+        uint32_t echoBytes;               // Bytes of our own telemetry that came back on the shared wire, and were kept from the decoder.
+        uint32_t collisions;              // Telemetry frames whose echo did not match what was sent, ie another device was transmitting at the same time.
+        uint32_t rcChannelsCallbacks;     // RC channels callback invocations.
+        uint32_t linkStatisticsCallbacks; // Link statistics callback invocations.
+        uint32_t flightModeCallbacks;     // Flight mode callback invocations.
+    } serialReceiverCounters_t;
+
     // Function pointer for RC Channels Callback
     typedef void (*rcChannelsCallback_t)(rcChannels_t *);
 
@@ -63,70 +92,92 @@ namespace serialReceiverLayer
     // Function pointer for Link Statistics Callback
     typedef void (*linkStatisticsCallback_t)(link_statistics_t);
 
-    class SerialReceiver
+    // Function pointer for Command Callback
+    typedef void (*commandCallback_t)(const command_t *);
+
+    // Function pointer for Speed Proposal Callback. Return true to accept the proposed baud rate.
+    typedef bool (*speedProposalCallback_t)(uint8_t port, uint32_t baudRate);
+
+    /**
+     * @brief Reads CRSF frames from a serial transport, and hands the RC channels, link statistics
+     * and flight modes to your callbacks. It also sends telemetry back to the receiver.
+     *
+     * @tparam Config The compile-time configuration. See crsfForArduinoConfig::DefaultConfig.
+     */
+    template <class Config = crsfForArduinoConfig::DefaultConfig>
+    class BasicSerialReceiver final
     {
+        static_assert(!Config::flightModesEnabled || Config::rcEnabled,
+                      "flightModesEnabled is set, but rcEnabled is not. Flight Modes require RC to be enabled.");
+        static_assert(!Config::baudRateNegotiationEnabled || (Config::commandsEnabled && Config::telemetryEnabled),
+                      "baudRateNegotiationEnabled is set, but commandsEnabled or telemetryEnabled is not. The speed proposal is answered with a command, in a telemetry slot.");
+        static_assert(!Config::telemetryEnabled || Config::telemetryAttitudeEnabled || Config::telemetryBaroAltitudeEnabled || Config::telemetryBatteryEnabled || Config::telemetryFlightModeEnabled || Config::telemetryGpsEnabled,
+                      "All telemetry options are disabled. Set telemetryEnabled to false to disable telemetry instead.");
+
       public:
-        SerialReceiver();
-        SerialReceiver(HardwareSerial *hwUartPort);
-        virtual ~SerialReceiver();
+        BasicSerialReceiver();
+        BasicSerialReceiver(HardwareSerial *hwUartPort);
+        BasicSerialReceiver(hal::SerialTransport *transport);
+        ~BasicSerialReceiver();
 
         bool begin();
         void end();
 
-#if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0 || CRSF_LINK_STATISTICS_ENABLED > 0
         void processFrames();
-#endif
 
-#if CRSF_LINK_STATISTICS_ENABLED > 0
+        void getCounters(serialReceiverCounters_t *counters);
+        void resetCounters();
+
+        size_t getTraceDumpSize();
+        size_t dumpTrace(uint8_t *buffer, size_t size);
+        void clearTrace();
+
+        void setBlackbox(BlackboxLogger *blackbox);
+        void setFrameRouter(FrameRouter *router);
+
         void setLinkStatisticsCallback(linkStatisticsCallback_t callback);
-#endif
 
-#if CRSF_RC_ENABLED > 0
         void setRcChannelsCallback(rcChannelsCallback_t callback);
         uint16_t getChannel(uint8_t channel);
         uint16_t rcToUs(uint16_t rc);
         uint16_t usToRc(uint16_t us);
         uint16_t readRcChannel(uint8_t channel, bool raw = false);
 
-#if CRSF_FLIGHTMODES_ENABLED > 0
         bool setFlightMode(flightModeId_t flightMode, uint8_t channel, uint16_t min, uint16_t max);
         void setFlightModeCallback(flightModeCallback_t callback);
         void handleFlightMode();
-#endif
-#endif
 
-#if CRSF_TELEMETRY_ENABLED > 0
         void telemetryWriteAttitude(int16_t roll, int16_t pitch, int16_t yaw);
         void telemetryWriteBaroAltitude(uint16_t altitude, int16_t vario);
         void telemetryWriteBattery(float voltage, float current, uint32_t fuel, uint8_t percent);
         void telemetryWriteFlightMode(flightModeId_t flightMode);
         void telemetryWriteCustomFlightMode(const char *flightMode, bool armed = true);
         void telemetryWriteGPS(float latitude, float longitude, float altitude, float speed, float groundCourse, uint8_t satellites);
-#endif
+        void setDeviceInfo(const char *name, uint32_t serialNumber = 0, uint32_t hardwareVersion = 0, uint32_t softwareVersion = TELEMETRY_DEVICE_SOFTWARE_VERSION);
+        void setParameterServer(ParameterServer *server);
+        void setDisplayPort(DisplayPort *displayPort);
+
+        void setCommandCallback(commandCallback_t callback);
+        void setSpeedProposalCallback(speedProposalCallback_t callback);
+        bool sendCommand(const command_t *command);
+        bool bindReceiver();
+        uint32_t getBaudRate();
 
       private:
-        CRSF *crsf;
-        HardwareSerial *_uart;
+        BasicCRSF<Config> crsf;
+        hal::SerialTransport *_transport;
+        bool _ownsTransport;
 
-#if CRSF_TELEMETRY_ENABLED > 0
-        Telemetry *telemetry;
-#endif
+        BasicTelemetry<Config> telemetry;
 
-#if CRSF_RC_ENABLED > 0
-        rcChannels_t *_rcChannels = nullptr;
+        rcChannels_t _rcChannels;
         rcChannelsCallback_t _rcChannelsCallback = nullptr;
-#endif
 
-#if CRSF_TELEMETRY_ENABLED > 0
         const char *flightModeStr = "ACRO";
-#endif
 
-#if CRSF_LINK_STATISTICS_ENABLED > 0
         link_statistics_t _linkStatistics;
         linkStatisticsCallback_t _linkStatisticsCallback = nullptr;
-#endif
 
-#if CRSF_RC_ENABLED > 0 && CRSF_FLIGHTMODES_ENABLED > 0
         typedef struct flightMode_s
         {
             uint8_t channel = 0;
@@ -134,12 +185,978 @@ namespace serialReceiverLayer
             uint16_t max = 0;
         } flightMode_t;
 
-        flightMode_t *_flightModes = nullptr;
+        // Only one unused entry is kept when flight modes are disabled.
+        flightMode_t _flightModes[Config::flightModesEnabled ? FLIGHT_MODE_COUNT : 1];
         flightModeCallback_t _flightModeCallback = nullptr;
+
+        BlackboxLogger *_blackbox = nullptr;
+        ParameterServer *_parameterServer = nullptr;
+        DisplayPort *_displayPort = nullptr;
+
+        commandCallback_t _commandCallback = nullptr;
+        speedProposalCallback_t _speedProposalCallback = nullptr;
+        uint8_t _commandFrame[Config::commandsEnabled ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1]; // Where commands are encoded before telemetry copies them into its queue.
+
+        uint32_t _baudRate = crsfProtocol::BAUD_RATE;
+        uint32_t _pendingBaudRate = 0; // Switched to once the answer to its speed proposal has gone out.
+        uint32_t _lastFrameTime = 0;   // When the last RC channels or link statistics frame arrived, in microseconds. Used to fall back to 420000 baud.
+        bool _pendingBaudRateSent = false;
+
+        /* Half duplex timing, in microseconds. The receiver sends a burst of frames once per RC period, with RC channels last,
+        and telemetry has to be off the wire before the next burst starts. The period is the shorter of the last two intervals
+        between bursts, so that one lost burst does not make the gap look twice as long. */
+        bool _lineIdle = true;
+        uint32_t _drainedTime = 0; // When a read last emptied the transport.
+        uint32_t _burstStartTime = 0;
+        uint32_t _burstInterval = 0;
+        uint32_t _burstPeriod = 0;
+
+        // The telemetry frame that is expected back on the shared wire, and how much of it has come back so far.
+        uint8_t _echo[Config::halfDuplexEnabled && Config::halfDuplexEcho ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1];
+        uint8_t _echoLength = 0;
+        uint8_t _echoPosition = 0;
+
+        serialReceiverCounters_t _counters;
+        uint32_t _uartOverrunsAtReset;
+
+        void _discardReceivedBytes();
+        void _handleCommand(const uint8_t *frame);
+        bool _isAcceptedSpeedResponse(const uint8_t *frame);
+        void _setBaudRate(uint32_t baudRate);
+        uint32_t _wireTime(uint8_t length);
+        void _halfDuplexBurstStarted(uint32_t burstStartTime);
+        bool _halfDuplexSlotOpen(bool bytesWaiting);
+        bool _halfDuplexFrameFits(uint8_t length);
+    };
+
+    typedef BasicSerialReceiver<> SerialReceiver;
+
+    template <class Config>
+    BasicSerialReceiver<Config>::BasicSerialReceiver()
+    {
+        _transport = nullptr;
+        _ownsTransport = true;
+
+#if defined(ARDUINO_ARCH_STM32)
+#if defined(HAVE_HWSERIAL1)
+        _transport = new hal::StreamTransport<decltype(Serial1)>(&Serial1);
+#elif defined(HAVE_HWSERIAL2)
+        _transport = new hal::StreamTransport<decltype(Serial2)>(&Serial2);
+#elif defined(HAVE_HWSERIAL3)
+        _transport = new hal::StreamTransport<decltype(Serial3)>(&Serial3);
+#endif
+#elif defined(__linux__) && !defined(ARDUINO)
+        // There is no default serial port on Linux hosts. Pass a hal::LinuxSerial instead.
+#else
+        _transport = new hal::StreamTransport<decltype(Serial1)>(&Serial1);
 #endif
 
-#if CRSF_RC_ENABLED > 0 || CRSF_TELEMETRY_ENABLED > 0
-        void flushRemainingFrames();
+        _rcChannels.valid = false;
+        _rcChannels.failsafe = false;
+        memset(_rcChannels.value, 0, sizeof(_rcChannels.value));
+
+        memset(&_counters, 0, sizeof(_counters));
+        _uartOverrunsAtReset = 0;
+    }
+
+    template <class Config>
+    BasicSerialReceiver<Config>::BasicSerialReceiver(HardwareSerial *hwUartPort)
+    {
+        _transport = hwUartPort != nullptr ? new hal::StreamTransport<HardwareSerial>(hwUartPort) : nullptr;
+        _ownsTransport = true;
+
+        _rcChannels.valid = false;
+        _rcChannels.failsafe = false;
+        memset(_rcChannels.value, 0, sizeof(_rcChannels.value));
+
+        memset(&_counters, 0, sizeof(_counters));
+        _uartOverrunsAtReset = 0;
+    }
+
+    /**
+     * @brief Construct a new Serial Receiver object that reads from any transport,
+     * such as a USB CDC or PIO UART wrapped in a hal::StreamTransport, or a host transport like hal::LinuxSerial.
+     * The transport is not deleted by the Serial Receiver.
+     */
+    template <class Config>
+    BasicSerialReceiver<Config>::BasicSerialReceiver(hal::SerialTransport *transport)
+    {
+        _transport = transport;
+        _ownsTransport = false;
+
+        _rcChannels.valid = false;
+        _rcChannels.failsafe = false;
+        memset(_rcChannels.value, 0, sizeof(_rcChannels.value));
+
+        memset(&_counters, 0, sizeof(_counters));
+        _uartOverrunsAtReset = 0;
+    }
+
+    template <class Config>
+    BasicSerialReceiver<Config>::~BasicSerialReceiver()
+    {
+        if (_ownsTransport)
+        {
+            delete _transport;
+        }
+        _transport = nullptr;
+    }
+
+    template <class Config>
+    bool BasicSerialReceiver<Config>::begin()
+    {
+#if CRSF_DEBUG_ENABLED > 0
+        // Debug.
+        CRSF_DEBUG_SERIAL_PORT.print("[Serial Receiver | INFO]: Initialising... ");
 #endif
-    };
+        // _uart->enterCriticalSection();
+
+        if (_transport == nullptr)
+        {
+#if CRSF_DEBUG_ENABLED > 0
+            // Debug.
+            CRSF_DEBUG_SERIAL_PORT.println("\r\n[Serial Receiver | FATAL ERROR]: No serial port was given.");
+#endif
+            return false;
+        }
+
+#if CRSF_RC_INITIALISE_CHANNELS > 0
+        // Initialize the RC Channels.
+        // Arm is set to 178 (1000us) to prevent the FC from arming.
+        // Throttle is set to 172 (988us) to prevent the ESCs from arming. All other channels are set to 992 (1500us).
+        for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+        {
+#if CRSF_RC_INITIALISE_ARMCHANNEL > 0 && CRSF_RC_INITIALISE_THROTTLECHANNEL > 0
+            if (i == crsfProtocol::RC_CHANNEL_AUX1 || i == crsfProtocol::RC_CHANNEL_THROTTLE)
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_MIN;
+            }
+            else
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_CENTER;
+            }
+
+#elif CRSF_RC_INITIALISE_ARMCHANNEL > 0
+            if (i == crsfProtocol::RC_CHANNEL_AUX1)
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_MIN;
+            }
+            else
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_CENTER;
+            }
+
+#elif CRSF_RC_INITIALISE_THROTTLECHANNEL > 0
+            if (i == crsfProtocol::RC_CHANNEL_THROTTLE)
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_MIN;
+            }
+            else
+            {
+                _rcChannels.value[i] = CRSF_RC_CHANNEL_CENTER;
+            }
+#else
+            _rcChannels.value[i] = CRSF_RC_CHANNEL_CENTER;
+#endif
+        }
+#endif
+
+        hal::CompatibilityTable ct;
+        if (!ct.isDevboardCompatible(ct.getDevboardName()))
+        {
+            // _uart->exitCriticalSection();
+
+#if CRSF_DEBUG_ENABLED > 0
+            // Debug.
+            CRSF_DEBUG_SERIAL_PORT.println("\r\n[Serial Receiver | FATAL ERROR]: Devboard is not compatible with CRSF Protocol.");
+#endif
+            return false;
+        }
+
+        // Initialize the CRSF Protocol.
+        crsf.begin();
+        crsf.setFrameTime(crsfProtocol::BAUD_RATE, 10);
+        _transport->begin(crsfProtocol::BAUD_RATE);
+        _baudRate = crsfProtocol::BAUD_RATE;
+        _pendingBaudRate = 0;
+        _pendingBaudRateSent = false;
+        _lastFrameTime = micros();
+        _lineIdle = true;
+        _drainedTime = micros();
+        _burstStartTime = 0;
+        _burstInterval = 0;
+        _burstPeriod = 0;
+        _echoLength = 0;
+        _echoPosition = 0;
+
+        // Initialise telemetry.
+        telemetry.begin();
+
+        // Start counting from here. The bytes that are flushed below are counted as discarded.
+        resetCounters();
+
+        // _uart->exitCriticalSection();
+
+        // Clear the UART buffer.
+        _transport->flush();
+        _discardReceivedBytes();
+
+#if CRSF_DEBUG_ENABLED > 0
+        // Debug.
+        CRSF_DEBUG_SERIAL_PORT.println("Done.");
+#endif
+        return true;
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::end()
+    {
+        _transport->flush();
+        _discardReceivedBytes();
+
+        // _uart->enterCriticalSection();
+        _transport->end();
+        // _uart->clearUART();
+
+        crsf.end();
+        telemetry.end();
+        // _uart->exitCriticalSection();
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::processFrames()
+    {
+        uint8_t buffer[SERIAL_RECEIVER_READ_SIZE];
+        size_t length;
+
+        // Read in chunks until the transport runs dry. A short read means there is nothing left for now.
+        do
+        {
+            // Anything that the read leaves behind arrived after it started.
+            uint32_t readTime = 0;
+            CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled)
+            {
+                readTime = micros();
+            }
+
+            length = _transport->read(buffer, sizeof(buffer));
+            const uint32_t currentTime = micros();
+
+            CRSF_IF_CONSTEXPR(Config::healthCountersEnabled)
+            {
+                _counters.bytesReceived += length;
+            }
+
+            for (size_t i = 0; i < length; i++)
+            {
+                // Bytes come off a shared wire in the order that they went on, so the echo of a telemetry frame arrives before anything else does.
+                CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled && Config::halfDuplexEcho)
+                {
+                    if (_echoPosition < _echoLength)
+                    {
+                        if (buffer[i] == _echo[_echoPosition])
+                        {
+                            _echoPosition++;
+                            incrementHealthCounter<Config>(_counters.echoBytes);
+                            continue;
+                        }
+
+                        // The rest of the echo is garbled. It goes to the decoder, which resynchronises on it.
+                        incrementHealthCounter<Config>(_counters.collisions);
+                        _echoLength = 0;
+                    }
+                }
+
+                CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled)
+                {
+                    if (_lineIdle)
+                    {
+                        /* This byte was not there when the transport was last emptied. Taking that as the start of the burst
+                        is as early as it could have been, which keeps a late read from making the gap look longer than it is. */
+                        _halfDuplexBurstStarted(_drainedTime - _wireTime(1));
+                    }
+                }
+
+                if (!crsf.receiveFrames(buffer[i], currentTime))
+                {
+                    continue;
+                }
+
+                // Handle link statistics.
+                CRSF_IF_CONSTEXPR(Config::linkStatisticsEnabled)
+                {
+                    if (crsf.getLinkStatistics(&_linkStatistics))
+                    {
+                        CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+                        {
+                            _lastFrameTime = currentTime;
+                        }
+
+                        CRSF_IF_CONSTEXPR(Config::blackboxEnabled)
+                        {
+                            if (_blackbox != nullptr)
+                            {
+                                _blackbox->logLinkStatistics(&_linkStatistics, currentTime);
+                            }
+                        }
+
+                        if (_linkStatisticsCallback != nullptr)
+                        {
+                            incrementHealthCounter<Config>(_counters.linkStatisticsCallbacks);
+                            crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_START, TRACE_CALLBACK_LINK_STATISTICS, 0);
+                            _linkStatisticsCallback(_linkStatistics);
+                            crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_END, TRACE_CALLBACK_LINK_STATISTICS, 0);
+                        }
+                    }
+                }
+
+                CRSF_IF_CONSTEXPR(Config::commandsEnabled)
+                {
+                    const uint8_t *command = crsf.getCommand();
+                    if (command != nullptr)
+                    {
+                        _handleCommand(command);
+                    }
+                }
+
+                // Check if it is time to send telemetry.
+                CRSF_IF_CONSTEXPR(Config::telemetryEnabled)
+                {
+                    uint8_t pingOrigin;
+                    if (crsf.getDevicePing(&pingOrigin))
+                    {
+                        incrementHealthCounter<Config>(_counters.devicePings);
+                        if (!telemetry.queueDeviceInfo(pingOrigin))
+                        {
+                            incrementHealthCounter<Config>(_counters.telemetryQueueFull);
+                        }
+                    }
+
+                    CRSF_IF_CONSTEXPR(Config::parametersEnabled)
+                    {
+                        const uint8_t *parameterRequest = crsf.getParameterRequest();
+                        if (parameterRequest != nullptr && _parameterServer != nullptr)
+                        {
+                            const uint8_t replyLength = _parameterServer->handleRequest(parameterRequest);
+                            if (replyLength > 0 && !telemetry.queueFrame(_parameterServer->getReply(), replyLength))
+                            {
+                                incrementHealthCounter<Config>(_counters.telemetryQueueFull);
+                            }
+                        }
+                    }
+
+                    bool slotOpen = true;
+                    CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled)
+                    {
+                        slotOpen = _halfDuplexSlotOpen(i + 1 < length);
+                    }
+
+                    CRSF_IF_CONSTEXPR(Config::displayPortEnabled)
+                    {
+                        // The screen waits for a slot that nothing else has asked for, so it never takes the place of a ping's answer or a command.
+                        if (slotOpen && _displayPort != nullptr && !telemetry.hasQueuedFrame())
+                        {
+                            const uint8_t screenLength = _displayPort->update(currentTime);
+                            if (screenLength > 0)
+                            {
+                                telemetry.queueFrame(_displayPort->getFrame(), screenLength);
+                            }
+                        }
+                    }
+
+                    if (slotOpen && telemetry.update())
+                    {
+                        uint8_t frameLength;
+                        const uint8_t *frame = telemetry.getFrame(&frameLength);
+                        bool sent = false;
+
+                        // The switch follows the answer that accepts it, which is told apart by what it says, not by where it was queued from.
+                        bool acceptsSpeedProposal = false;
+                        CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+                        {
+                            acceptsSpeedProposal = _pendingBaudRate != 0 && _isAcceptedSpeedResponse(frame);
+                        }
+
+                        CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled)
+                        {
+                            if (!_halfDuplexFrameFits(frameLength))
+                            {
+                                telemetry.discardFrame();
+                                incrementHealthCounter<Config>(_counters.halfDuplexFramesDropped);
+                                slotOpen = false;
+                            }
+                        }
+
+                        if (slotOpen)
+                        {
+                            CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled && Config::halfDuplexEcho)
+                            {
+                                memcpy(_echo, frame, frameLength);
+                                _echoLength = frameLength;
+                                _echoPosition = 0;
+                            }
+
+                            sent = telemetry.sendTelemetryData(_transport, crsf.getTrace());
+                            if (sent)
+                            {
+                                incrementHealthCounter<Config>(_counters.telemetryFramesSent);
+                            }
+                            else
+                            {
+                                incrementHealthCounter<Config>(_counters.telemetryFramesDropped);
+                            }
+                        }
+
+                        // The switch waits for the answer to the speed proposal. If the answer could not go out, the receiver never switches either.
+                        CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+                        {
+                            if (acceptsSpeedProposal)
+                            {
+                                _pendingBaudRateSent = sent;
+                                if (!sent)
+                                {
+                                    _pendingBaudRate = 0;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            CRSF_IF_CONSTEXPR(Config::halfDuplexEnabled)
+            {
+                if (length < sizeof(buffer))
+                {
+                    _drainedTime = readTime;
+                }
+            }
+        } while (length == sizeof(buffer));
+
+        // Update the RC Channels.
+        CRSF_IF_CONSTEXPR(Config::rcEnabled)
+        {
+            crsf.getFailSafe(&_rcChannels.failsafe);
+            if (crsf.getRcChannels(_rcChannels.value))
+            {
+                CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+                {
+                    _lastFrameTime = micros();
+                }
+
+                CRSF_IF_CONSTEXPR(Config::blackboxEnabled)
+                {
+                    if (_blackbox != nullptr)
+                    {
+                        _blackbox->logRcChannels(_rcChannels.value, _rcChannels.failsafe, micros());
+                    }
+                }
+            }
+
+            if (_rcChannelsCallback != nullptr)
+            {
+                incrementHealthCounter<Config>(_counters.rcChannelsCallbacks);
+                crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_START, TRACE_CALLBACK_RC_CHANNELS, 0);
+                _rcChannelsCallback(&_rcChannels);
+                crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_END, TRACE_CALLBACK_RC_CHANNELS, 0);
+            }
+        }
+
+        /* Switch once the answer to a speed proposal has gone out, and fall back to 420000 baud when the link goes quiet.
+        Only RC channels and link statistics count: at the wrong baud rate, noise still passes the CRC every few hundred frames. */
+        CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+        {
+            if (_pendingBaudRate != 0 && _pendingBaudRateSent)
+            {
+                // The answer went out in this call's telemetry slot. Let its last byte leave the UART before switching.
+                _transport->flush();
+                _setBaudRate(_pendingBaudRate);
+                _pendingBaudRate = 0;
+                _pendingBaudRateSent = false;
+                incrementHealthCounter<Config>(_counters.baudRateChanges);
+            }
+            else if (_baudRate != crsfProtocol::BAUD_RATE && micros() - _lastFrameTime > Config::baudRateFallbackTimeout * 1000UL)
+            {
+                _setBaudRate(crsfProtocol::BAUD_RATE);
+                incrementHealthCounter<Config>(_counters.baudRateFallbacks);
+            }
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::setLinkStatisticsCallback(linkStatisticsCallback_t callback)
+    {
+        _linkStatisticsCallback = callback;
+    }
+
+    /**
+     * @brief Copies all of the health counters into counters in one go.
+     * Call this from the same context as processFrames(), so that the copy is consistent.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::getCounters(serialReceiverCounters_t *counters)
+    {
+        memcpy(counters, &_counters, sizeof(serialReceiverCounters_t));
+        crsf.getCounters(&counters->crsf);
+
+        CRSF_IF_CONSTEXPR(Config::healthCountersEnabled)
+        {
+            if (_transport != nullptr)
+            {
+                counters->uartOverruns = _transport->getOverrunCount() - _uartOverrunsAtReset;
+            }
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::resetCounters()
+    {
+        memset(&_counters, 0, sizeof(_counters));
+        crsf.resetCounters();
+        _uartOverrunsAtReset = _transport != nullptr ? _transport->getOverrunCount() : 0;
+    }
+
+    /**
+     * @brief Returns the number of bytes that dumpTrace() needs, or 0 if tracing is disabled.
+     */
+    template <class Config>
+    size_t BasicSerialReceiver<Config>::getTraceDumpSize()
+    {
+        return crsf.getTrace()->getDumpSize();
+    }
+
+    /**
+     * @brief Writes a binary dump of the trace into buffer. See Trace.hpp for the format.
+     * Write it out over a serial port or to a file, and turn it into a timeline with the linux_trace example.
+     *
+     * @return The number of bytes written, or 0 if tracing is disabled.
+     */
+    template <class Config>
+    size_t BasicSerialReceiver<Config>::dumpTrace(uint8_t *buffer, size_t size)
+    {
+        return crsf.getTrace()->dump(buffer, size);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::clearTrace()
+    {
+        crsf.getTrace()->clear();
+    }
+
+    /**
+     * @brief Logs every RC channels frame, and every change in link statistics, to blackbox.
+     * This needs blackboxEnabled in the configuration. Pass nullptr to stop logging.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setBlackbox(BlackboxLogger *blackbox)
+    {
+        _blackbox = blackbox;
+    }
+
+    /**
+     * @brief Passes every frame with a valid CRC to router, which hands it on to each sink whose route matches it.
+     * This needs frameRouterEnabled in the configuration. Pass nullptr to stop routing.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setFrameRouter(FrameRouter *router)
+    {
+        crsf.setFrameRouter(router);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::_discardReceivedBytes()
+    {
+        uint8_t buffer[SERIAL_RECEIVER_READ_SIZE];
+        size_t length;
+        while ((length = _transport->read(buffer, sizeof(buffer))) > 0)
+        {
+            CRSF_IF_CONSTEXPR(Config::healthCountersEnabled)
+            {
+                _counters.bytesDiscarded += length;
+            }
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::setRcChannelsCallback(rcChannelsCallback_t callback)
+    {
+        _rcChannelsCallback = callback;
+    }
+
+    template <class Config>
+    uint16_t BasicSerialReceiver<Config>::readRcChannel(uint8_t channel, bool raw)
+    {
+        if (channel <= 15)
+        {
+            if (raw == true)
+            {
+                return _rcChannels.value[channel];
+            }
+            else
+            {
+                /* Convert RC value from raw to microseconds.
+                - Mininum: 172 (988us)
+                - Middle: 992 (1500us)
+                - Maximum: 1811 (2012us)
+                - Scale factor = (2012 - 988) / (1811 - 172) = 0.62477120195241
+                - Offset = 988 - 172 * 0.62477120195241 = 880.53935326418548
+                */
+                return (uint16_t)((_rcChannels.value[channel] * 0.62477120195241F) + 881);
+            }
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    template <class Config>
+    uint16_t BasicSerialReceiver<Config>::getChannel(uint8_t channel)
+    {
+        return readRcChannel(channel, true);
+    }
+
+    template <class Config>
+    uint16_t BasicSerialReceiver<Config>::rcToUs(uint16_t rc)
+    {
+        return (uint16_t)((rc * 0.62477120195241F) + 881);
+    }
+
+    template <class Config>
+    uint16_t BasicSerialReceiver<Config>::usToRc(uint16_t us)
+    {
+        return (uint16_t)((us - 881) / 0.62477120195241F);
+    }
+
+    template <class Config>
+    bool BasicSerialReceiver<Config>::setFlightMode(flightModeId_t flightMode, uint8_t channel, uint16_t min, uint16_t max)
+    {
+        if (Config::flightModesEnabled && flightMode < FLIGHT_MODE_COUNT && channel <= 15)
+        {
+            _flightModes[flightMode].channel = channel;
+            _flightModes[flightMode].min = min;
+            _flightModes[flightMode].max = max;
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::setFlightModeCallback(flightModeCallback_t callback)
+    {
+        _flightModeCallback = callback;
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::handleFlightMode()
+    {
+        CRSF_IF_CONSTEXPR(Config::flightModesEnabled)
+        {
+            if (_flightModeCallback != nullptr)
+            {
+                for (size_t i = 0; i < (size_t)FLIGHT_MODE_COUNT; i++)
+                {
+                    if (_rcChannels.value[_flightModes[i].channel] >= _flightModes[i].min && _rcChannels.value[_flightModes[i].channel] <= _flightModes[i].max)
+                    {
+                        incrementHealthCounter<Config>(_counters.flightModeCallbacks);
+                        crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_START, TRACE_CALLBACK_FLIGHT_MODE, (uint16_t)i);
+                        _flightModeCallback((flightModeId_t)i);
+                        crsf.getTrace()->recordNow(TRACE_EVENT_CALLBACK_END, TRACE_CALLBACK_FLIGHT_MODE, (uint16_t)i);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteAttitude(int16_t roll, int16_t pitch, int16_t yaw)
+    {
+        telemetry.setAttitudeData(roll, pitch, yaw);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteBaroAltitude(uint16_t altitude, int16_t vario)
+    {
+        telemetry.setBaroAltitudeData(altitude, vario);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteBattery(float voltage, float current, uint32_t fuel, uint8_t percent)
+    {
+        telemetry.setBatteryData(voltage, current, fuel, percent);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteFlightMode(flightModeId_t flightModeId)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryFlightModeEnabled)
+        {
+            switch (flightModeId)
+            {
+                case FLIGHT_MODE_FAILSAFE:
+                    flightModeStr = "!FS!";
+                    break;
+                case FLIGHT_MODE_GPS_RESCUE:
+                    flightModeStr = "RTH";
+                    break;
+                case FLIGHT_MODE_PASSTHROUGH:
+                    flightModeStr = "MANU";
+                    break;
+                case FLIGHT_MODE_ANGLE:
+                    flightModeStr = "STAB";
+                    break;
+                case FLIGHT_MODE_HORIZON:
+                    flightModeStr = "HOR";
+                    break;
+                case FLIGHT_MODE_AIRMODE:
+                    flightModeStr = "AIR";
+                    break;
+                default:
+                    flightModeStr = "ACRO";
+                    break;
+            }
+
+            // Serial.println(flightModeStr);
+            telemetry.setFlightModeData(flightModeStr, (bool)(flightModeId == FLIGHT_MODE_DISARMED ? true : false));
+        }
+        else
+        {
+            (void)flightModeId;
+        }
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteCustomFlightMode(const char *flightModeStr, bool armed)
+    {
+        telemetry.setFlightModeData(flightModeStr, armed);
+    }
+
+    template <class Config>
+    void BasicSerialReceiver<Config>::telemetryWriteGPS(float latitude, float longitude, float altitude, float speed, float groundCourse, uint8_t satellites)
+    {
+        telemetry.setGPSData(latitude, longitude, altitude, speed, groundCourse, satellites);
+    }
+
+    /**
+     * @brief Sets the name, serial number and versions that the flight controller answers device pings with.
+     * Handsets show the name in their device list. By default, it is CRSF_TELEMETRY_DEVICE_NAME.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setDeviceInfo(const char *name, uint32_t serialNumber, uint32_t hardwareVersion, uint32_t softwareVersion)
+    {
+        telemetry.setDeviceInfo(name, serialNumber, hardwareVersion, softwareVersion);
+    }
+
+    /**
+     * @brief Answers the handset's parameter reads and writes from server, so its settings show up in the handset's device menu.
+     * This needs parametersEnabled in the configuration. Pass nullptr to stop answering.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setParameterServer(ParameterServer *server)
+    {
+        _parameterServer = server;
+        telemetry.setParameterCount(server != nullptr ? server->getParameterCount() : 0);
+    }
+
+    /**
+     * @brief Sends displayPort's screen to the handset's canvas, a changed row (or a few changed spans) at a time.
+     * This needs displayPortEnabled in the configuration. Pass nullptr to stop sending.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setDisplayPort(DisplayPort *displayPort)
+    {
+        _displayPort = displayPort;
+    }
+
+    /**
+     * @brief Sets a function that is called with each command frame for the flight controller that is not answered here,
+     * ie everything but speed proposals. This needs commandsEnabled in the configuration.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setCommandCallback(commandCallback_t callback)
+    {
+        _commandCallback = callback;
+    }
+
+    /**
+     * @brief Sets a function that decides whether to accept the receiver's proposals to change the baud rate.
+     * Only proposals from 420000 baud up to baudRateMax get this far. Without a callback, all of those are accepted.
+     * Every proposal is turned down unless baudRateNegotiationEnabled is set in the configuration.
+     */
+    template <class Config>
+    void BasicSerialReceiver<Config>::setSpeedProposalCallback(speedProposalCallback_t callback)
+    {
+        _speedProposalCallback = callback;
+    }
+
+    /**
+     * @brief Sends command in the next free telemetry slot, in place of a telemetry frame.
+     * This needs commandsEnabled and telemetryEnabled in the configuration.
+     *
+     * @return false if commands are disabled, the command's data does not fit in one frame, or TELEMETRY_QUEUE_SIZE
+     * frames are already waiting to be sent.
+     */
+    template <class Config>
+    bool BasicSerialReceiver<Config>::sendCommand(const command_t *command)
+    {
+        CRSF_IF_CONSTEXPR(Config::commandsEnabled && Config::telemetryEnabled)
+        {
+            const uint8_t length = CommandFrame::encode(command, _commandFrame);
+            if (length > 0)
+            {
+                if (telemetry.queueFrame(_commandFrame, length))
+                {
+                    return true;
+                }
+                incrementHealthCounter<Config>(_counters.telemetryQueueFull);
+            }
+        }
+
+        (void)command;
+        return false;
+    }
+
+    /**
+     * @brief Puts the receiver into bind mode, with a bind command in the next free telemetry slot.
+     *
+     * @return false if the command could not be queued. See sendCommand().
+     */
+    template <class Config>
+    bool BasicSerialReceiver<Config>::bindReceiver()
+    {
+        const command_t command = {crsfProtocol::CRSF_ADDRESS_CRSF_RECEIVER, crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER,
+                                   crsfProtocol::CRSF_COMMAND_RX, crsfProtocol::CRSF_COMMAND_RX_BIND, nullptr, 0};
+        return sendCommand(&command);
+    }
+
+    /**
+     * @brief Returns the baud rate that the link runs at. This is 420000, unless the receiver has negotiated a faster one.
+     */
+    template <class Config>
+    uint32_t BasicSerialReceiver<Config>::getBaudRate()
+    {
+        return _baudRate;
+    }
+
+    /* Switches the UART and every timing that depends on the baud rate, without starting the decoder or telemetry again. */
+    template <class Config>
+    void BasicSerialReceiver<Config>::_setBaudRate(uint32_t baudRate)
+    {
+        _transport->setBaudRate(baudRate);
+        crsf.setFrameTime(baudRate, 10);
+        _baudRate = baudRate;
+        _lastFrameTime = micros();
+    }
+
+    /* How long length bytes take on the wire at the current baud rate, in microseconds. Each byte is 10 bits long, with its start and stop bits. */
+    template <class Config>
+    uint32_t BasicSerialReceiver<Config>::_wireTime(uint8_t length)
+    {
+        return (uint32_t)length * 10000000UL / _baudRate;
+    }
+
+    /* Times the start of the receiver's burst of frames, and the interval since the last one. */
+    template <class Config>
+    void BasicSerialReceiver<Config>::_halfDuplexBurstStarted(uint32_t burstStartTime)
+    {
+        const uint32_t interval = burstStartTime - _burstStartTime;
+        _burstPeriod = interval < _burstInterval ? interval : _burstInterval;
+        _burstInterval = interval;
+        _burstStartTime = burstStartTime;
+        _lineIdle = false;
+    }
+
+    /* Half duplex telemetry only goes out in the gap after an RC channels frame, as that ends the receiver's burst.
+    The gap is passed up if more bytes are already arriving, because the line is not free. */
+    template <class Config>
+    bool BasicSerialReceiver<Config>::_halfDuplexSlotOpen(bool bytesWaiting)
+    {
+        if (crsf.getFrameType() != crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED)
+        {
+            return false;
+        }
+
+        // Whatever arrives next starts the next burst.
+        _lineIdle = true;
+
+        if (bytesWaiting)
+        {
+            incrementHealthCounter<Config>(_counters.halfDuplexSlotsMissed);
+            return false;
+        }
+
+        return true;
+    }
+
+    /* A frame fits if it can be sent now, with a turnaround on either side of it, and be off the wire before the next burst
+    is due. Nothing is sent until the receiver's period is known. */
+    template <class Config>
+    bool BasicSerialReceiver<Config>::_halfDuplexFrameFits(uint8_t length)
+    {
+        const uint32_t needed = (micros() - _burstStartTime) + 2 * Config::halfDuplexTurnaround + _wireTime(length);
+        return needed <= _burstPeriod;
+    }
+
+    /* Answers speed proposals, and passes every other command to the command callback. */
+    template <class Config>
+    void BasicSerialReceiver<Config>::_handleCommand(const uint8_t *frame)
+    {
+        command_t command;
+        if (!CommandFrame::decode(frame, &command))
+        {
+            return;
+        }
+        incrementHealthCounter<Config>(_counters.commands);
+
+        uint8_t port;
+        uint32_t baudRate;
+        if (CommandFrame::decodeSpeedProposal(&command, &port, &baudRate))
+        {
+            bool accepted = false;
+            CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+            {
+                accepted = baudRate >= crsfProtocol::BAUD_RATE && baudRate <= Config::baudRateMax &&
+                           (_speedProposalCallback == nullptr || _speedProposalCallback(port, baudRate));
+
+                // A proposal for the rate that is already in use is accepted, but there is nothing to switch.
+                _pendingBaudRate = accepted && baudRate != _baudRate ? baudRate : 0;
+                _pendingBaudRateSent = false;
+            }
+
+            CRSF_IF_CONSTEXPR(Config::telemetryEnabled)
+            {
+                const uint8_t length = CommandFrame::encodeSpeedResponse(command.origin, crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER, port, accepted, _commandFrame);
+                if (!telemetry.queueFrame(_commandFrame, length))
+                {
+                    // The receiver will not hear that the proposal was accepted, so it stays at the rate it is at.
+                    incrementHealthCounter<Config>(_counters.telemetryQueueFull);
+                    CRSF_IF_CONSTEXPR(Config::baudRateNegotiationEnabled)
+                    {
+                        _pendingBaudRate = 0;
+                    }
+                }
+            }
+            return;
+        }
+
+        if (_commandCallback != nullptr)
+        {
+            _commandCallback(&command);
+        }
+    }
+
+    /* True if frame is an answer to a speed proposal that accepts it. */
+    template <class Config>
+    bool BasicSerialReceiver<Config>::_isAcceptedSpeedResponse(const uint8_t *frame)
+    {
+        command_t command;
+        return CommandFrame::decode(frame, &command) && command.command == crsfProtocol::CRSF_COMMAND_GENERAL && command.subCommand == crsfProtocol::CRSF_COMMAND_GENERAL_SPEED_RESPONSE &&
+               command.dataLength >= crsfProtocol::CRSF_FRAME_COMMAND_SPEED_RESPONSE_SIZE && command.data[1] != 0;
+    }
+
+    // The default configuration is compiled once, in SerialReceiver.cpp.
+    extern template class BasicSerialReceiver<crsfForArduinoConfig::DefaultConfig>;
 } // namespace serialReceiverLayer
@@ -0,0 +1,353 @@
+/**
+ * @file SharedMemory.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Publishes decoded RC channels and link statistics to other processes through POSIX shared memory.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SharedMemory.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "time.h"
+#include "unistd.h"
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Returns CLOCK_MONOTONIC in nanoseconds. This clock is shared by every process on the host,
+     * so readers can compare it with a record's timestamp to find out how old the record is.
+     */
+    uint64_t sharedMemoryTimestampNs()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+    }
+
+    /* Seqlock write and read. The fences keep the record's contents from being reordered
+    across the sequence number updates on either side. */
+    template <typename T>
+    static void seqlockWrite(std::atomic<uint32_t> *sequence, uint64_t *timestampDestination, T *destination, const T *source)
+    {
+        const uint32_t start = sequence->load(std::memory_order_relaxed);
+        sequence->store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        *timestampDestination = sharedMemoryTimestampNs();
+        memcpy((void *)destination, (const void *)source, sizeof(T));
+
+        sequence->store(start + 2, std::memory_order_release);
+    }
+
+    /* Empties a record that a publisher may have left half written, eg because it crashed while writing.
+    The sequence number ends up even, and higher than before, so readers see a new (empty) record instead of waiting for ever. */
+    template <typename T>
+    static void seqlockReset(std::atomic<uint32_t> *sequence, uint64_t *timestampDestination, T *destination)
+    {
+        const uint32_t start = sequence->load(std::memory_order_relaxed) | 1;
+        sequence->store(start, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        *timestampDestination = 0;
+        memset((void *)destination, 0, sizeof(T));
+
+        sequence->store(start + 1, std::memory_order_release);
+    }
+
+    template <typename T>
+    static bool seqlockRead(const std::atomic<uint32_t> *sequence, const uint64_t *timestampSource, const T *source, T *destination, uint64_t *timestampNs, uint32_t *sequenceOut)
+    {
+        const uint32_t start = sequence->load(std::memory_order_acquire);
+        if (start & 1)
+        {
+            return false;
+        }
+
+        const uint64_t timestamp = *timestampSource;
+        memcpy((void *)destination, (const void *)source, sizeof(T));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence->load(std::memory_order_relaxed) != start)
+        {
+            return false;
+        }
+
+        if (timestampNs != nullptr)
+        {
+            *timestampNs = timestamp;
+        }
+
+        if (sequenceOut != nullptr)
+        {
+            *sequenceOut = start / 2;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Construct a new Shared Memory Publisher object.
+     *
+     * @param name The POSIX shared memory name, eg "/crsf_for_arduino". Readers must use the same name.
+     */
+    SharedMemoryPublisher::SharedMemoryPublisher(const char *name)
+    {
+        _name = name;
+        _segment = nullptr;
+    }
+
+    SharedMemoryPublisher::~SharedMemoryPublisher()
+    {
+        end();
+    }
+
+    /**
+     * @brief Creates (or re-uses) the shared memory segment and maps it.
+     * The records in a re-used segment are emptied, because the last publisher may have stopped halfway through writing one.
+     *
+     * @return true if the segment is ready to publish to.
+     */
+    bool SharedMemoryPublisher::begin()
+    {
+        if (_segment != nullptr)
+        {
+            return true;
+        }
+
+        const int fd = shm_open(_name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        if (ftruncate(fd, sizeof(sharedMemorySegment_t)) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void *mapping = mmap(nullptr, sizeof(sharedMemorySegment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        _segment = (sharedMemorySegment_t *)mapping;
+        seqlockReset(&_segment->rcChannels.sequence, &_segment->rcChannels.timestampNs, &_segment->rcChannels.rcChannels);
+        seqlockReset(&_segment->linkStatistics.sequence, &_segment->linkStatistics.timestampNs, &_segment->linkStatistics.linkStatistics);
+
+        /* Readers check the magic number last, so it is written last. */
+        _segment->version = SHARED_MEMORY_VERSION;
+        _segment->size = sizeof(sharedMemorySegment_t);
+        std::atomic_thread_fence(std::memory_order_release);
+        _segment->magic = SHARED_MEMORY_MAGIC;
+
+        return true;
+    }
+
+    /**
+     * @brief Unmaps the segment.
+     *
+     * @param unlink If true, the segment's name is removed as well. Readers that have it mapped keep the last values.
+     */
+    void SharedMemoryPublisher::end(bool unlink)
+    {
+        if (_segment != nullptr)
+        {
+            munmap(_segment, sizeof(sharedMemorySegment_t));
+            _segment = nullptr;
+
+            if (unlink)
+            {
+                shm_unlink(_name);
+            }
+        }
+    }
+
+    void SharedMemoryPublisher::publishRcChannels(const rcChannels_t *rcChannels)
+    {
+        if (_segment != nullptr)
+        {
+            seqlockWrite(&_segment->rcChannels.sequence, &_segment->rcChannels.timestampNs, &_segment->rcChannels.rcChannels, rcChannels);
+        }
+    }
+
+    void SharedMemoryPublisher::publishLinkStatistics(const link_statistics_t *linkStatistics)
+    {
+        if (_segment != nullptr)
+        {
+            seqlockWrite(&_segment->linkStatistics.sequence, &_segment->linkStatistics.timestampNs, &_segment->linkStatistics.linkStatistics, linkStatistics);
+        }
+    }
+
+    /**
+     * @brief Construct a new Shared Memory Reader object.
+     *
+     * @param name The POSIX shared memory name that the publisher uses.
+     */
+    SharedMemoryReader::SharedMemoryReader(const char *name)
+    {
+        _name = name;
+        _segment = nullptr;
+    }
+
+    SharedMemoryReader::~SharedMemoryReader()
+    {
+        end();
+    }
+
+    /**
+     * @brief Maps the publisher's segment read-only.
+     *
+     * @return false if the publisher has not created the segment yet, or if it was built with a different layout.
+     */
+    bool SharedMemoryReader::begin()
+    {
+        if (_segment != nullptr)
+        {
+            return true;
+        }
+
+        const int fd = shm_open(_name, O_RDONLY | O_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(sharedMemorySegment_t))
+        {
+            close(fd);
+            return false;
+        }
+
+        void *mapping = mmap(nullptr, sizeof(sharedMemorySegment_t), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        const sharedMemorySegment_t *segment = (const sharedMemorySegment_t *)mapping;
+        const uint32_t magic = segment->magic;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (magic != SHARED_MEMORY_MAGIC || segment->version != SHARED_MEMORY_VERSION || segment->size != sizeof(sharedMemorySegment_t))
+        {
+            munmap(mapping, sizeof(sharedMemorySegment_t));
+            return false;
+        }
+
+        _segment = segment;
+        return true;
+    }
+
+    void SharedMemoryReader::end()
+    {
+        if (_segment != nullptr)
+        {
+            munmap((void *)_segment, sizeof(sharedMemorySegment_t));
+            _segment = nullptr;
+        }
+    }
+
+    /**
+     * @brief Takes a single snapshot of the RC channels. This never waits or retries,
+     * so it fails if the publisher happened to be writing at the same time.
+     *
+     * @param rcChannels Where the snapshot is copied to.
+     * @param timestampNs If not null, receives the time the record was published (see sharedMemoryTimestampNs()).
+     * @param sequence If not null, receives the number of records published so far. Use this to tell whether the record is new.
+     * @return true if the snapshot is consistent.
+     */
+    bool SharedMemoryReader::tryReadRcChannels(rcChannels_t *rcChannels, uint64_t *timestampNs, uint32_t *sequence)
+    {
+        if (_segment == nullptr)
+        {
+            return false;
+        }
+
+        return seqlockRead(&_segment->rcChannels.sequence, &_segment->rcChannels.timestampNs, &_segment->rcChannels.rcChannels, rcChannels, timestampNs, sequence);
+    }
+
+    bool SharedMemoryReader::tryReadLinkStatistics(link_statistics_t *linkStatistics, uint64_t *timestampNs, uint32_t *sequence)
+    {
+        if (_segment == nullptr)
+        {
+            return false;
+        }
+
+        return seqlockRead(&_segment->linkStatistics.sequence, &_segment->linkStatistics.timestampNs, &_segment->linkStatistics.linkStatistics, linkStatistics, timestampNs, sequence);
+    }
+
+    /**
+     * @brief Takes a snapshot of the RC channels, retrying up to SHARED_MEMORY_READ_RETRIES times if the publisher was writing.
+     */
+    bool SharedMemoryReader::readRcChannels(rcChannels_t *rcChannels, uint64_t *timestampNs, uint32_t *sequence)
+    {
+        for (int i = 0; i < SHARED_MEMORY_READ_RETRIES; i++)
+        {
+            if (tryReadRcChannels(rcChannels, timestampNs, sequence))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool SharedMemoryReader::readLinkStatistics(link_statistics_t *linkStatistics, uint64_t *timestampNs, uint32_t *sequence)
+    {
+        for (int i = 0; i < SHARED_MEMORY_READ_RETRIES; i++)
+        {
+            if (tryReadLinkStatistics(linkStatistics, timestampNs, sequence))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Returns the number of RC channels records published so far, without copying anything.
+     * Poll this to find out cheaply when there is a new record.
+     */
+    uint32_t SharedMemoryReader::getRcChannelsSequence()
+    {
+        return _segment != nullptr ? _segment->rcChannels.sequence.load(std::memory_order_acquire) / 2 : 0;
+    }
+
+    uint32_t SharedMemoryReader::getLinkStatisticsSequence()
+    {
+        return _segment != nullptr ? _segment->linkStatistics.sequence.load(std::memory_order_acquire) / 2 : 0;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
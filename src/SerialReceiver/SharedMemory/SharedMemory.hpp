@@ -0,0 +1,114 @@
+/**
+ * @file SharedMemory.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Publishes decoded RC channels and link statistics to other processes through POSIX shared memory.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../CRSF/CRSF.hpp"
+#include "../SerialReceiver.hpp"
+#include <atomic>
+
+namespace serialReceiverLayer
+{
+#define SHARED_MEMORY_DEFAULT_NAME "/crsf_for_arduino"
+#define SHARED_MEMORY_MAGIC        0x43525346 // "CRSF"
+#define SHARED_MEMORY_VERSION      1
+#define SHARED_MEMORY_READ_RETRIES 16
+
+    /* A record guarded by a seqlock. The sequence number is odd while the publisher is writing,
+    and even once the record is complete. Readers copy the record, then check that the sequence number
+    is even and has not changed. Readers never write to the segment, so they cannot hold up the publisher. */
+    typedef struct sharedRcChannels_s
+    {
+        std::atomic<uint32_t> sequence;
+        uint64_t timestampNs;
+        rcChannels_t rcChannels;
+    } sharedRcChannels_t;
+
+    typedef struct sharedLinkStatistics_s
+    {
+        std::atomic<uint32_t> sequence;
+        uint64_t timestampNs;
+        link_statistics_t linkStatistics;
+    } sharedLinkStatistics_t;
+
+    /* The layout of the shared memory segment. Each record sits on its own cache line,
+    so that publishing RC channels does not disturb readers of the link statistics and vice versa. */
+    typedef struct sharedMemorySegment_s
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;
+        alignas(64) sharedRcChannels_t rcChannels;
+        alignas(64) sharedLinkStatistics_t linkStatistics;
+    } sharedMemorySegment_t;
+
+    class SharedMemoryPublisher
+    {
+      public:
+        SharedMemoryPublisher(const char *name = SHARED_MEMORY_DEFAULT_NAME);
+        ~SharedMemoryPublisher();
+
+        bool begin();
+        void end(bool unlink = true);
+
+        void publishRcChannels(const rcChannels_t *rcChannels);
+        void publishLinkStatistics(const link_statistics_t *linkStatistics);
+
+      private:
+        const char *_name;
+        sharedMemorySegment_t *_segment;
+    };
+
+    class SharedMemoryReader
+    {
+      public:
+        SharedMemoryReader(const char *name = SHARED_MEMORY_DEFAULT_NAME);
+        ~SharedMemoryReader();
+
+        bool begin();
+        void end();
+
+        bool tryReadRcChannels(rcChannels_t *rcChannels, uint64_t *timestampNs = nullptr, uint32_t *sequence = nullptr);
+        bool tryReadLinkStatistics(link_statistics_t *linkStatistics, uint64_t *timestampNs = nullptr, uint32_t *sequence = nullptr);
+        bool readRcChannels(rcChannels_t *rcChannels, uint64_t *timestampNs = nullptr, uint32_t *sequence = nullptr);
+        bool readLinkStatistics(link_statistics_t *linkStatistics, uint64_t *timestampNs = nullptr, uint32_t *sequence = nullptr);
+
+        uint32_t getRcChannelsSequence();
+        uint32_t getLinkStatisticsSequence();
+
+      private:
+        const char *_name;
+        const sharedMemorySegment_t *_segment;
+    };
+
+    uint64_t sharedMemoryTimestampNs();
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
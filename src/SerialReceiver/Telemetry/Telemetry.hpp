@@ -26,19 +26,42 @@
 
 #pragma once
 
-#include "Arduino.h"
+#include "../../CFA_Config.hpp"
 
+#include "../../hal/SerialTransport/SerialTransport.hpp"
 #include "../CRC/CRC.hpp"
 #include "../CRSF/CRSFProtocol.hpp"
 #include "../SerialBuffer/SerialBuffer.hpp"
+#include "../Trace/Trace.hpp"
 
 namespace serialReceiverLayer
 {
-    class Telemetry : private genericCrc::GenericCRC, private genericStreamBuffer::SerialBuffer
+/* Device Info
+- TELEMETRY_DEVICE_NAME_SIZE_MAX: The longest name that fits in a device info frame, not counting its terminating zero.
+- TELEMETRY_DEVICE_SOFTWARE_VERSION: The software version that the device info frame reports by default, ie this library's version
+  as 0x00MMmmpp (major, minor, patch).
+- TELEMETRY_DEVICE_PARAMETER_VERSION: The parameter protocol version that the device info frame reports. */
+#define TELEMETRY_DEVICE_NAME_SIZE_MAX     (crsfProtocol::CRSF_PAYLOAD_SIZE_MAX - crsfProtocol::CRSF_FRAME_DEVICE_INFO_FIELDS_SIZE - 1)
+#define TELEMETRY_DEVICE_SOFTWARE_VERSION  (((uint32_t)CRSFFORARDUINO_VERSION_MAJOR << 16) | ((uint32_t)CRSFFORARDUINO_VERSION_MINOR << 8) | CRSFFORARDUINO_VERSION_PATCH)
+#define TELEMETRY_DEVICE_PARAMETER_VERSION 0
+
+/* Queued Frames
+- TELEMETRY_QUEUE_SIZE: How many frames (eg answers to the handset) can wait for a telemetry slot at once. Each one takes
+  CRSF_FRAME_SIZE_MAX bytes. A configuration that never answers the handset has no queue at all. */
+#define TELEMETRY_QUEUE_SIZE 4
+
+    /**
+     * @brief Builds telemetry frames and sends them back to the receiver.
+     *
+     * @tparam Config The compile-time configuration. See crsfForArduinoConfig::DefaultConfig.
+     * @tparam Enabled Selects the no-op version below when Config disables telemetry.
+     */
+    template <class Config = crsfForArduinoConfig::DefaultConfig, bool Enabled = Config::telemetryEnabled>
+    class BasicTelemetry final
     {
       public:
-        Telemetry();
-        ~Telemetry();
+        BasicTelemetry();
+        ~BasicTelemetry();
 
         void begin();
         void end();
@@ -52,10 +75,39 @@ namespace serialReceiverLayer
         void setGPSData(float latitude, float longitude, float altitude, float speed, float course, uint8_t satellites);
         // void setVarioData(float vario);
 
-        void sendTelemetryData(HardwareSerial *db);
+        void setDeviceInfo(const char *name, uint32_t serialNumber = 0, uint32_t hardwareVersion = 0, uint32_t softwareVersion = TELEMETRY_DEVICE_SOFTWARE_VERSION);
+        bool queueDeviceInfo(uint8_t destination);
+        void setParameterCount(uint8_t count);
+        bool queueFrame(const uint8_t *frame, uint8_t length);
+        bool hasQueuedFrame();
+
+        const uint8_t *getFrame(uint8_t *length);
+        void discardFrame();
+        bool sendTelemetryData(hal::SerialTransport *db, BasicTrace<Config> *trace = nullptr);
 
       private:
+        genericCrc::GenericCRC _crc;
+        genericStreamBuffer::SerialBuffer _buffer;
+
+        // The device info frame is built whenever the device info changes, and sent as it is whenever a ping asks for it.
+        genericStreamBuffer::SerialBuffer _deviceInfoFrame;
+        char _deviceName[(Config::telemetryDeviceInfoEnabled ? TELEMETRY_DEVICE_NAME_SIZE_MAX : 0) + 1];
+        uint32_t _deviceSerialNumber;
+        uint32_t _deviceHardwareVersion;
+        uint32_t _deviceSoftwareVersion;
+        uint8_t _deviceParameterCount;
+
+        // Frames that go in the next slots instead of the scheduled ones, eg answers to the handset, oldest first.
+        // DisplayPort only queues its screen while nothing else waits, so it needs one place at most.
+        static constexpr uint8_t _queueSize = (Config::telemetryDeviceInfoEnabled || Config::parametersEnabled || Config::commandsEnabled) ? TELEMETRY_QUEUE_SIZE : (Config::displayPortEnabled ? 1 : 0);
+        uint8_t _queuedFrames[_queueSize ? _queueSize : 1][_queueSize ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1];
+        uint8_t _queuedFrameLengths[_queueSize ? _queueSize : 1];
+        uint8_t _queueHead;
+        uint8_t _queueCount;
+        bool _sendingQueuedFrame;
+
         uint8_t _telemetryFrameScheduleCount;
+        uint8_t _telemetryFrameScheduleIndex;
         uint8_t _telemetryFrameSchedule[crsfProtocol::CRSF_TELEMETRY_FRAME_SCHEDULE_MAX];
         crsfProtocol::telemetryData_t _telemetryData;
 
@@ -67,8 +119,661 @@ namespace serialReceiverLayer
         void _appendBatterySensorData();
         void _appendFlightModeData();
         void _appendGPSData();
+        void _buildDeviceInfoFrame(uint8_t destination);
         // void _appendHeartbeatData();
         // void _appendVarioData();
         void _finaliseFrame();
     };
+
+    /**
+     * @brief Stands in for telemetry when a configuration disables it,
+     * so that a receiver without telemetry carries neither its buffers nor its code.
+     */
+    template <class Config>
+    class BasicTelemetry<Config, false> final
+    {
+      public:
+        void begin()
+        {
+        }
+
+        void end()
+        {
+        }
+
+        bool update()
+        {
+            return false;
+        }
+
+        void setAttitudeData(int16_t roll, int16_t pitch, int16_t yaw)
+        {
+            (void)roll;
+            (void)pitch;
+            (void)yaw;
+        }
+
+        void setBaroAltitudeData(uint16_t altitude, int16_t vario)
+        {
+            (void)altitude;
+            (void)vario;
+        }
+
+        void setBatteryData(float voltage, float current, uint32_t capacity, uint8_t percent)
+        {
+            (void)voltage;
+            (void)current;
+            (void)capacity;
+            (void)percent;
+        }
+
+        void setFlightModeData(const char *flightMode, bool armed = false)
+        {
+            (void)flightMode;
+            (void)armed;
+        }
+
+        void setGPSData(float latitude, float longitude, float altitude, float speed, float course, uint8_t satellites)
+        {
+            (void)latitude;
+            (void)longitude;
+            (void)altitude;
+            (void)speed;
+            (void)course;
+            (void)satellites;
+        }
+
+        void setDeviceInfo(const char *name, uint32_t serialNumber = 0, uint32_t hardwareVersion = 0, uint32_t softwareVersion = TELEMETRY_DEVICE_SOFTWARE_VERSION)
+        {
+            (void)name;
+            (void)serialNumber;
+            (void)hardwareVersion;
+            (void)softwareVersion;
+        }
+
+        bool queueDeviceInfo(uint8_t destination)
+        {
+            (void)destination;
+            return false;
+        }
+
+        void setParameterCount(uint8_t count)
+        {
+            (void)count;
+        }
+
+        bool queueFrame(const uint8_t *frame, uint8_t length)
+        {
+            (void)frame;
+            (void)length;
+            return false;
+        }
+
+        bool hasQueuedFrame()
+        {
+            return false;
+        }
+
+        const uint8_t *getFrame(uint8_t *length)
+        {
+            *length = 0;
+            return nullptr;
+        }
+
+        void discardFrame()
+        {
+        }
+
+        bool sendTelemetryData(hal::SerialTransport *db, BasicTrace<Config> *trace = nullptr)
+        {
+            (void)db;
+            (void)trace;
+            return false;
+        }
+    };
+
+    typedef BasicTelemetry<> Telemetry;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795F
+#endif
+
+    template <class Config, bool Enabled>
+    BasicTelemetry<Config, Enabled>::BasicTelemetry() :
+        _crc(), _buffer(crsfProtocol::CRSF_FRAME_SIZE_MAX), _deviceInfoFrame(Config::telemetryDeviceInfoEnabled ? crsfProtocol::CRSF_FRAME_SIZE_MAX : 1)
+    {
+        _telemetryFrameScheduleCount = 0;
+        _telemetryFrameScheduleIndex = 0;
+        memset(_telemetryFrameSchedule, 0, sizeof(_telemetryFrameSchedule));
+        memset(&_telemetryData, 0, sizeof(_telemetryData));
+
+        memset(_deviceName, 0, sizeof(_deviceName));
+        CRSF_IF_CONSTEXPR(Config::telemetryDeviceInfoEnabled)
+        {
+            strncpy(_deviceName, CRSF_TELEMETRY_DEVICE_NAME, TELEMETRY_DEVICE_NAME_SIZE_MAX);
+        }
+        _deviceSerialNumber = 0;
+        _deviceHardwareVersion = 0;
+        _deviceSoftwareVersion = TELEMETRY_DEVICE_SOFTWARE_VERSION;
+        _deviceParameterCount = 0;
+        memset(_queuedFrameLengths, 0, sizeof(_queuedFrameLengths));
+        _queueHead = 0;
+        _queueCount = 0;
+        _sendingQueuedFrame = false;
+    }
+
+    template <class Config, bool Enabled>
+    BasicTelemetry<Config, Enabled>::~BasicTelemetry()
+    {
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::begin()
+    {
+        _buffer.reset();
+
+        uint8_t index = 0;
+        CRSF_IF_CONSTEXPR(Config::telemetryAttitudeEnabled)
+        {
+            _telemetryFrameSchedule[index++] = (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_ATTITUDE_INDEX);
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryBaroAltitudeEnabled)
+        {
+            _telemetryFrameSchedule[index++] = (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_BARO_ALTITUDE_INDEX);
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryBatteryEnabled)
+        {
+            _telemetryFrameSchedule[index++] = (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_BATTERY_SENSOR_INDEX);
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryFlightModeEnabled)
+        {
+            _telemetryFrameSchedule[index++] = (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_FLIGHT_MODE_INDEX);
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryGpsEnabled)
+        {
+            _telemetryFrameSchedule[index++] = (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_GPS_INDEX);
+        }
+
+        _telemetryFrameScheduleCount = index;
+
+        // Handsets ask for the device info when they look for devices, and it does not change, so it is built once here.
+        _queueHead = 0;
+        _queueCount = 0;
+        _sendingQueuedFrame = false;
+        CRSF_IF_CONSTEXPR(Config::telemetryDeviceInfoEnabled)
+        {
+            _buildDeviceInfoFrame(crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER);
+        }
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::end()
+    {
+        _buffer.reset();
+    }
+
+    template <class Config, bool Enabled>
+    bool BasicTelemetry<Config, Enabled>::update()
+    {
+        bool sendFrame = false;
+
+        if (_queueCount != 0)
+        {
+            // The oldest queued frame (eg the answer to a ping) takes this slot. The schedule is not moved on, so the frame that was due goes in the next slot.
+            _sendingQueuedFrame = true;
+            return true;
+        }
+
+        const uint8_t currentSchedule = _telemetryFrameSchedule[_telemetryFrameScheduleIndex];
+
+        CRSF_IF_CONSTEXPR(Config::telemetryAttitudeEnabled)
+        {
+            if (currentSchedule & (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_ATTITUDE_INDEX))
+            {
+                _initialiseFrame();
+                _appendAttitudeData();
+                _finaliseFrame();
+                sendFrame = true;
+            }
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryBaroAltitudeEnabled)
+        {
+            if (currentSchedule & (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_BARO_ALTITUDE_INDEX))
+            {
+                _initialiseFrame();
+                _appendBaroAltitudeData();
+                _finaliseFrame();
+                sendFrame = true;
+            }
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryBatteryEnabled)
+        {
+            if (currentSchedule & (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_BATTERY_SENSOR_INDEX))
+            {
+                _initialiseFrame();
+                _appendBatterySensorData();
+                _finaliseFrame();
+                sendFrame = true;
+            }
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryFlightModeEnabled)
+        {
+            if (currentSchedule & (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_FLIGHT_MODE_INDEX))
+            {
+                _initialiseFrame();
+                _appendFlightModeData();
+                _finaliseFrame();
+                sendFrame = true;
+            }
+        }
+
+        CRSF_IF_CONSTEXPR(Config::telemetryGpsEnabled)
+        {
+            if (currentSchedule & (1 << crsfProtocol::CRSF_TELEMETRY_FRAME_GPS_INDEX))
+            {
+                _initialiseFrame();
+                _appendGPSData();
+                _finaliseFrame();
+                sendFrame = true;
+            }
+        }
+
+        _telemetryFrameScheduleIndex = (_telemetryFrameScheduleIndex + 1) % _telemetryFrameScheduleCount;
+
+        return sendFrame;
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setAttitudeData(int16_t roll, int16_t pitch, int16_t yaw)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryAttitudeEnabled)
+        {
+            _telemetryData.attitude.roll = _decidegreeToRadians(roll);
+            _telemetryData.attitude.pitch = -_decidegreeToRadians(pitch);
+            _telemetryData.attitude.yaw = _decidegreeToRadians(yaw);
+        }
+        else
+        {
+            (void)roll;
+            (void)pitch;
+            (void)yaw;
+        }
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setBaroAltitudeData(uint16_t altitude, int16_t vario)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryBaroAltitudeEnabled)
+        {
+            _telemetryData.baroAltitude.altitude = altitude + 10000;
+            _telemetryData.baroAltitude.vario = vario;
+        }
+        else
+        {
+            (void)altitude;
+            (void)vario;
+        }
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setBatteryData(float voltage, float current, uint32_t capacity, uint8_t percent)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryBatteryEnabled)
+        {
+            _telemetryData.battery.voltage = (voltage + 5) / 10;
+            _telemetryData.battery.current = current / 10;
+            _telemetryData.battery.capacity = capacity;
+            _telemetryData.battery.percent = percent;
+        }
+        else
+        {
+            (void)voltage;
+            (void)current;
+            (void)capacity;
+            (void)percent;
+        }
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setFlightModeData(const char *flightMode, bool armed)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryFlightModeEnabled)
+        {
+            size_t length = strlen(flightMode);
+            memset(_telemetryData.flightMode.flightMode, 0, sizeof(_telemetryData.flightMode.flightMode));
+            memcpy(_telemetryData.flightMode.flightMode, flightMode, length);
+
+            if (armed)
+            {
+                strcat(_telemetryData.flightMode.flightMode, "*");
+            }
+        }
+        else
+        {
+            (void)flightMode;
+        }
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setGPSData(float latitude, float longitude, float altitude, float speed, float course, uint8_t satellites)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryGpsEnabled)
+        {
+            _telemetryData.gps.latitude = latitude * 10000000;
+            _telemetryData.gps.longitude = longitude * 10000000;
+            _telemetryData.gps.altitude = (constrain(altitude, 0, 5000 * 100) / 100) + 1000;
+            _telemetryData.gps.speed = ((speed * 36 + 50) / 100);
+            _telemetryData.gps.groundCourse = (course * 100);
+            _telemetryData.gps.satellites = satellites;
+        }
+        else
+        {
+            (void)latitude;
+            (void)longitude;
+            (void)altitude;
+            (void)speed;
+            (void)course;
+            (void)satellites;
+        }
+    }
+
+    /**
+     * @brief Sets what the device info frame says about this device. Handsets show the name in their device list.
+     * The name is cut short at TELEMETRY_DEVICE_NAME_SIZE_MAX characters.
+     */
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setDeviceInfo(const char *name, uint32_t serialNumber, uint32_t hardwareVersion, uint32_t softwareVersion)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryDeviceInfoEnabled)
+        {
+            memset(_deviceName, 0, sizeof(_deviceName));
+            strncpy(_deviceName, name, TELEMETRY_DEVICE_NAME_SIZE_MAX);
+            _deviceSerialNumber = serialNumber;
+            _deviceHardwareVersion = hardwareVersion;
+            _deviceSoftwareVersion = softwareVersion;
+            _buildDeviceInfoFrame(crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER);
+        }
+        else
+        {
+            (void)name;
+            (void)serialNumber;
+            (void)hardwareVersion;
+            (void)softwareVersion;
+        }
+    }
+
+    /**
+     * @brief Queues the device info frame for destination (the device that sent the ping). See queueFrame().
+     * Only the destination and the CRC are rewritten, and only when the destination changes.
+     *
+     * @return false if the queue is full, or if the device info frame is disabled.
+     */
+    template <class Config, bool Enabled>
+    bool BasicTelemetry<Config, Enabled>::queueDeviceInfo(uint8_t destination)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryDeviceInfoEnabled)
+        {
+            uint8_t *buffer = _deviceInfoFrame.getBuffer();
+            const uint8_t length = _deviceInfoFrame.getLength();
+            if (buffer[3] != destination)
+            {
+                buffer[3] = destination;
+                buffer[length - 1] = _crc.calculate(2, buffer[2], buffer, length - 1);
+            }
+            return queueFrame(buffer, length);
+        }
+        else
+        {
+            (void)destination;
+            return false;
+        }
+    }
+
+    /**
+     * @brief Sets the number of parameters that the device info frame reports, ie the entries that the handset can read.
+     */
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::setParameterCount(uint8_t count)
+    {
+        CRSF_IF_CONSTEXPR(Config::telemetryDeviceInfoEnabled)
+        {
+            _deviceParameterCount = count;
+            _buildDeviceInfoFrame(crsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER);
+        }
+        else
+        {
+            (void)count;
+        }
+    }
+
+    /**
+     * @brief Sends frame (a whole frame, CRC and all) in a telemetry slot, instead of the frame that is due.
+     * Queued frames go out in the order they were queued, one per slot. frame is copied, so its buffer can be reused
+     * straight away.
+     *
+     * @return false if the queue is full (or the configuration has none), or frame is too long. Nothing is queued then.
+     */
+    template <class Config, bool Enabled>
+    bool BasicTelemetry<Config, Enabled>::queueFrame(const uint8_t *frame, uint8_t length)
+    {
+        if (_queueCount >= _queueSize || length > crsfProtocol::CRSF_FRAME_SIZE_MAX)
+        {
+            return false;
+        }
+
+        uint8_t tail = (uint8_t)(_queueHead + _queueCount);
+        if (tail >= _queueSize)
+        {
+            tail -= _queueSize;
+        }
+
+        memcpy(_queuedFrames[tail], frame, length);
+        _queuedFrameLengths[tail] = length;
+        _queueCount++;
+        return true;
+    }
+
+    /**
+     * @brief Returns true if a queued frame is waiting for a telemetry slot.
+     */
+    template <class Config, bool Enabled>
+    bool BasicTelemetry<Config, Enabled>::hasQueuedFrame()
+    {
+        return _queueCount != 0;
+    }
+
+    /**
+     * @brief Returns the frame that update() got ready, without sending it.
+     *
+     * @param length Receives the length of the whole frame, CRC and all.
+     */
+    template <class Config, bool Enabled>
+    const uint8_t *BasicTelemetry<Config, Enabled>::getFrame(uint8_t *length)
+    {
+        if (_sendingQueuedFrame)
+        {
+            *length = _queuedFrameLengths[_queueHead];
+            return _queuedFrames[_queueHead];
+        }
+
+        *length = (uint8_t)_buffer.getLength();
+        return _buffer.getBuffer();
+    }
+
+    /**
+     * @brief Gives up the frame that update() got ready, as if it had been sent.
+     * A queued frame is taken off the queue, and the slot after this one goes to the next queued frame, or back to the schedule.
+     */
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::discardFrame()
+    {
+        if (_sendingQueuedFrame)
+        {
+            _queueHead = (uint8_t)(_queueHead + 1 < _queueSize ? _queueHead + 1 : 0);
+            _queueCount--;
+            _sendingQueuedFrame = false;
+        }
+    }
+
+    /**
+     * @brief Writes the frame that update() built to db.
+     *
+     * @param trace If not nullptr, the start and end of the transmission are recorded here.
+     * @return true if db accepted the whole frame.
+     */
+    template <class Config, bool Enabled>
+    bool BasicTelemetry<Config, Enabled>::sendTelemetryData(hal::SerialTransport *db, BasicTrace<Config> *trace)
+    {
+        uint8_t length;
+        const uint8_t *buffer = getFrame(&length);
+        discardFrame();
+
+        if (trace != nullptr)
+        {
+            trace->recordNow(TRACE_EVENT_TELEMETRY_TX_START, buffer[2], (uint16_t)length);
+        }
+
+        const size_t written = db->write(buffer, length);
+
+        if (trace != nullptr)
+        {
+            trace->recordNow(TRACE_EVENT_TELEMETRY_TX_END, buffer[2], (uint16_t)written);
+        }
+
+        return written == length;
+    }
+
+    template <class Config, bool Enabled>
+    int16_t BasicTelemetry<Config, Enabled>::_decidegreeToRadians(int16_t decidegrees)
+    {
+        /* convert angle in decidegree to radians/10000 with reducing angle to +/-180 degree range */
+        while (decidegrees > 18000)
+        {
+            decidegrees -= 36000;
+        }
+        while (decidegrees < -18000)
+        {
+            decidegrees += 36000;
+        }
+        return (int16_t)((PI / 180.0F) * 1000.0F * decidegrees);
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_initialiseFrame()
+    {
+        _buffer.reset();
+        _buffer.writeU8(crsfProtocol::CRSF_SYNC_BYTE);
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_appendAttitudeData()
+    {
+        _buffer.writeU8(crsfProtocol::CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+        _buffer.writeU8(crsfProtocol::CRSF_FRAMETYPE_ATTITUDE);
+
+        _buffer.writeU16BE(_telemetryData.attitude.pitch);
+        _buffer.writeU16BE(_telemetryData.attitude.roll);
+        _buffer.writeU16BE(_telemetryData.attitude.yaw);
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_appendBaroAltitudeData()
+    {
+        _buffer.writeU8(crsfProtocol::CRSF_FRAME_BARO_ALTITUDE_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+        _buffer.writeU8(crsfProtocol::CRSF_FRAMETYPE_BARO_ALTITUDE);
+
+        _buffer.writeU16BE(_telemetryData.baroAltitude.altitude);
+        _buffer.writeU16BE(_telemetryData.baroAltitude.vario);
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_appendBatterySensorData()
+    {
+        _buffer.writeU8(crsfProtocol::CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+        _buffer.writeU8(crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR);
+
+        _buffer.writeU16BE(_telemetryData.battery.voltage);
+        _buffer.writeU16BE(_telemetryData.battery.current);
+        _buffer.writeU24BE(_telemetryData.battery.capacity);
+        _buffer.writeU8(_telemetryData.battery.percent);
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_appendFlightModeData()
+    {
+        // Return if the length of the flight mode string is greater than the flight mode payload size.
+        size_t length = strlen(_telemetryData.flightMode.flightMode) + 1;
+        if (length > crsfProtocol::CRSF_FRAME_FLIGHT_MODE_PAYLOAD_SIZE)
+        {
+            return;
+        }
+
+        _buffer.writeU8(length + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+        _buffer.writeU8(crsfProtocol::CRSF_FRAMETYPE_FLIGHT_MODE);
+
+        _buffer.writeString(_telemetryData.flightMode.flightMode);
+
+        _buffer.writeU8('\0');
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_appendGPSData()
+    {
+        _buffer.writeU8(crsfProtocol::CRSF_FRAME_GPS_PAYLOAD_SIZE + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC);
+        _buffer.writeU8(crsfProtocol::CRSF_FRAMETYPE_GPS);
+
+        _buffer.write32BE(_telemetryData.gps.latitude);
+        _buffer.write32BE(_telemetryData.gps.longitude);
+        _buffer.writeU16BE(_telemetryData.gps.speed);
+        _buffer.writeU16BE(_telemetryData.gps.groundCourse);
+        _buffer.writeU16BE(_telemetryData.gps.altitude);
+        _buffer.writeU8(_telemetryData.gps.satellites);
+    }
+
+    /**
+     * @brief Encodes the device info frame. It is an extended frame: the destination and origin addresses come first.
+     */
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_buildDeviceInfoFrame(uint8_t destination)
+    {
+        _deviceInfoFrame.reset();
+        _deviceInfoFrame.writeU8(crsfProtocol::CRSF_SYNC_BYTE);
+        _deviceInfoFrame.writeU8(0); // The frame length, which is filled in below.
+        _deviceInfoFrame.writeU8(crsfProtocol::CRSF_FRAMETYPE_DEVICE_INFO);
+        _deviceInfoFrame.writeU8(destination);
+        _deviceInfoFrame.writeU8(crsfProtocol::CRSF_ADDRESS_FLIGHT_CONTROLLER);
+
+        _deviceInfoFrame.writeString(_deviceName);
+        _deviceInfoFrame.writeU8('\0');
+        _deviceInfoFrame.writeU32BE(_deviceSerialNumber);
+        _deviceInfoFrame.writeU32BE(_deviceHardwareVersion);
+        _deviceInfoFrame.writeU32BE(_deviceSoftwareVersion);
+        _deviceInfoFrame.writeU8(_deviceParameterCount);
+        _deviceInfoFrame.writeU8(TELEMETRY_DEVICE_PARAMETER_VERSION);
+
+        uint8_t *buffer = _deviceInfoFrame.getBuffer();
+        const uint8_t length = _deviceInfoFrame.getLength();
+        buffer[1] = length - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH + crsfProtocol::CRSF_FRAME_LENGTH_CRC;
+        _deviceInfoFrame.writeU8(_crc.calculate(2, buffer[2], buffer, length));
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTelemetry<Config, Enabled>::_finaliseFrame()
+    {
+        uint8_t *buffer = _buffer.getBuffer();
+        uint8_t length = _buffer.getLength();
+        uint8_t crc = _crc.calculate(2, buffer[2], buffer, length);
+
+        _buffer.writeU8(crc);
+    }
+
+    // The default configuration is compiled once, in Telemetry.cpp.
+    extern template class BasicTelemetry<crsfForArduinoConfig::DefaultConfig>;
 } // namespace serialReceiverLayer
@@ -0,0 +1,245 @@
+/**
+ * @file ThreadPool.cpp
+ * @author CRSF for Arduino contributors
+ * @brief A small work-stealing thread pool for the host tools that process many captures at once.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "ThreadPool.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+namespace serialReceiverLayer
+{
+    /**
+     * @brief Starts the pool's threads.
+     *
+     * @param threadCount The number of threads, including the one that calls run().
+     * 0 uses one thread per CPU.
+     */
+    ThreadPool::ThreadPool(unsigned threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+        }
+
+        _threadCount = constrain(threadCount, 1U, (unsigned)THREAD_POOL_THREADS_MAX);
+        _workers = new worker_t[_threadCount];
+        for (unsigned i = 0; i < _threadCount; i++)
+        {
+            _workers[i].begin = 0;
+            _workers[i].end = 0;
+            _workers[i].tasks = 0;
+            _workers[i].steals = 0;
+        }
+
+        _generation = 0;
+        _busy = 0;
+        _stopping = false;
+        _runs = 0;
+        _task = nullptr;
+        _context = nullptr;
+
+        // Thread 0 is whichever thread calls run().
+        _threads = new std::thread[_threadCount];
+        for (unsigned i = 1; i < _threadCount; i++)
+        {
+            _threads[i] = std::thread(&ThreadPool::_workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+
+        for (unsigned i = 1; i < _threadCount; i++)
+        {
+            _threads[i].join();
+        }
+
+        delete[] _threads;
+        delete[] _workers;
+    }
+
+    unsigned ThreadPool::getThreadCount()
+    {
+        return _threadCount;
+    }
+
+    /**
+     * @brief Runs task(context, index, worker) once for every index from 0 to count - 1, and returns when they have all finished.
+     * The tasks run in no particular order. Only one thread may call run() at a time.
+     */
+    void ThreadPool::run(size_t count, threadPoolTask_t task, void *context)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        _task = task;
+        _context = context;
+
+        for (unsigned i = 0; i < _threadCount; i++)
+        {
+            std::lock_guard<std::mutex> lock(_workers[i].mutex);
+            _workers[i].begin = count * i / _threadCount;
+            _workers[i].end = count * (i + 1) / _threadCount;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _busy = _threadCount;
+            _generation++;
+            _runs++;
+        }
+        _wake.notify_all();
+
+        _work(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _busy--;
+        _done.wait(lock, [this] { return _busy == 0; });
+    }
+
+    void ThreadPool::getStatistics(threadPoolStatistics_t *statistics)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        statistics->runs = _runs;
+        statistics->tasks = 0;
+        statistics->steals = 0;
+        for (unsigned i = 0; i < _threadCount; i++)
+        {
+            std::lock_guard<std::mutex> workerLock(_workers[i].mutex);
+            statistics->tasks += _workers[i].tasks;
+            statistics->steals += _workers[i].steals;
+        }
+    }
+
+    void ThreadPool::resetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _runs = 0;
+        for (unsigned i = 0; i < _threadCount; i++)
+        {
+            std::lock_guard<std::mutex> workerLock(_workers[i].mutex);
+            _workers[i].tasks = 0;
+            _workers[i].steals = 0;
+        }
+    }
+
+    void ThreadPool::_workerLoop(unsigned worker)
+    {
+        uint64_t generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this, generation] { return _stopping || _generation != generation; });
+                if (_stopping)
+                {
+                    return;
+                }
+                generation = _generation;
+            }
+
+            _work(worker);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy == 0)
+            {
+                _done.notify_one();
+            }
+        }
+    }
+
+    /**
+     * @brief Runs tasks from this worker's own range, then steals, until there is nothing left anywhere.
+     * No task creates new tasks, so once every range has been seen empty this worker can stop.
+     */
+    void ThreadPool::_work(unsigned worker)
+    {
+        size_t index;
+        do
+        {
+            while (_pop(worker, &index))
+            {
+                _task(_context, index, worker);
+            }
+        } while (_steal(worker));
+    }
+
+    bool ThreadPool::_pop(unsigned worker, size_t *index)
+    {
+        worker_t *self = &_workers[worker];
+        std::lock_guard<std::mutex> lock(self->mutex);
+        if (self->begin >= self->end)
+        {
+            return false;
+        }
+
+        *index = self->begin++;
+        self->tasks++;
+        return true;
+    }
+
+    /**
+     * @brief Moves the back half of another worker's remaining range (rounded up, so that a single task can be stolen too)
+     * into this worker's range. Victims are tried in turn, starting with the next worker, so that thieves spread out.
+     */
+    bool ThreadPool::_steal(unsigned worker)
+    {
+        for (unsigned i = 1; i < _threadCount; i++)
+        {
+            worker_t *victim = &_workers[(worker + i) % _threadCount];
+            size_t begin;
+            size_t end;
+            {
+                std::lock_guard<std::mutex> lock(victim->mutex);
+                if (victim->begin >= victim->end)
+                {
+                    continue;
+                }
+
+                end = victim->end;
+                begin = end - (end - victim->begin + 1) / 2;
+                victim->end = begin;
+            }
+
+            worker_t *self = &_workers[worker];
+            std::lock_guard<std::mutex> lock(self->mutex);
+            self->begin = begin;
+            self->end = end;
+            self->steals++;
+            return true;
+        }
+
+        return false;
+    }
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,110 @@
+/**
+ * @file ThreadPool.hpp
+ * @author CRSF for Arduino contributors
+ * @brief A small work-stealing thread pool for the host tools that process many captures at once.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace serialReceiverLayer
+{
+#define THREAD_POOL_THREADS_MAX 256
+
+    /**
+     * @brief One task of a ThreadPool run.
+     *
+     * @param context The context that was passed to ThreadPool::run().
+     * @param index The index of this task, from 0 to count - 1.
+     * @param worker The thread that runs it, from 0 to getThreadCount() - 1. Use it to index per-thread state without locking.
+     */
+    typedef void (*threadPoolTask_t)(void *context, size_t index, unsigned worker);
+
+    typedef struct threadPoolStatistics_s
+    {
+        uint64_t runs;   // Calls to run().
+        uint64_t tasks;  // Tasks run, across all threads.
+        uint64_t steals; // Times that an idle thread took half of another thread's remaining tasks.
+    } threadPoolStatistics_t;
+
+    /**
+     * @brief Runs a batch of independent tasks on a fixed set of threads.
+     * Each run() splits the task indices evenly between the threads. A thread that runs out of tasks steals
+     * the back half of the remaining range of another thread, so tasks of very different sizes (eg captures of
+     * very different lengths) still keep every thread busy until the end.
+     * The thread that calls run() works as thread 0, and the other threads sleep between runs.
+     */
+    class ThreadPool
+    {
+      public:
+        ThreadPool(unsigned threadCount = 0);
+        ~ThreadPool();
+
+        unsigned getThreadCount();
+
+        void run(size_t count, threadPoolTask_t task, void *context);
+
+        void getStatistics(threadPoolStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        // Each worker's range sits on its own cache line, so that the owner's pops do not slow down the other threads.
+        typedef struct alignas(64) worker_s
+        {
+            std::mutex mutex;
+            size_t begin; // The next task that the owner runs.
+            size_t end;   // One past the last task. Thieves take from this end.
+            uint64_t tasks;
+            uint64_t steals;
+        } worker_t;
+
+        unsigned _threadCount;
+        std::thread *_threads;
+        worker_t *_workers;
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        uint64_t _generation;
+        unsigned _busy;
+        bool _stopping;
+        uint64_t _runs;
+
+        threadPoolTask_t _task;
+        void *_context;
+
+        void _workerLoop(unsigned worker);
+        void _work(unsigned worker);
+        bool _pop(unsigned worker, size_t *index);
+        bool _steal(unsigned worker);
+    };
+} // namespace serialReceiverLayer
+
+#endif // __linux__ && !ARDUINO
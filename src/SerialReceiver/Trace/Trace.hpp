@@ -0,0 +1,259 @@
+/**
+ * @file Trace.hpp
+ * @author CRSF for Arduino contributors
+ * @brief A fixed size ring of compact binary events, for finding out when and in what order things happened in the receiver.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+namespace serialReceiverLayer
+{
+    typedef enum traceEventType_e
+    {
+        TRACE_EVENT_NONE = 0,
+        TRACE_EVENT_FRAME_START,        // The first byte of a frame arrived.
+        TRACE_EVENT_FRAME_DECODED,      // A frame with a valid CRC arrived. argument: frame type. data: frame length.
+        TRACE_EVENT_CRC_ERROR,          // A whole frame arrived, but its CRC did not match. argument: frame type. data: frame length.
+        TRACE_EVENT_RESYNC,             // A partial frame was dropped. argument: traceResyncReason_t. data: see traceResyncReason_t.
+        TRACE_EVENT_CALLBACK_START,     // argument: traceCallback_t.
+        TRACE_EVENT_CALLBACK_END,       // argument: traceCallback_t.
+        TRACE_EVENT_TELEMETRY_TX_START, // argument: frame type. data: frame length.
+        TRACE_EVENT_TELEMETRY_TX_END,   // argument: frame type. data: bytes that the transport accepted.
+        TRACE_EVENT_COUNT
+    } traceEventType_t;
+
+    typedef enum traceResyncReason_e
+    {
+        TRACE_RESYNC_TIMEOUT = 0, // The frame time ran out. data: the number of bytes that were dropped.
+        TRACE_RESYNC_LENGTH       // The length byte was out of range. data: the length byte.
+    } traceResyncReason_t;
+
+    typedef enum traceCallback_e
+    {
+        TRACE_CALLBACK_RC_CHANNELS = 0,
+        TRACE_CALLBACK_LINK_STATISTICS,
+        TRACE_CALLBACK_FLIGHT_MODE
+    } traceCallback_t;
+
+    typedef struct traceEvent_s
+    {
+        uint32_t timestamp; // micros() when the event happened.
+        uint8_t type;       // traceEventType_t.
+        uint8_t argument;   // Depends on type.
+        uint16_t data;      // Depends on type.
+    } traceEvent_t;
+
+/* Trace dump format
+A dump is a header followed by the events, oldest first. All fields are little endian.
+Header (16 bytes):
+- 4 bytes: "CFAT".
+- 2 bytes: format version (TRACE_DUMP_VERSION).
+- 2 bytes: size of each event in bytes (TRACE_DUMP_EVENT_SIZE).
+- 4 bytes: number of events that follow.
+- 4 bytes: number of older events that were overwritten before the dump was taken.
+Each event (8 bytes): timestamp (4 bytes), type (1 byte), argument (1 byte), data (2 bytes). */
+#define TRACE_DUMP_VERSION     1
+#define TRACE_DUMP_HEADER_SIZE 16
+#define TRACE_DUMP_EVENT_SIZE  8
+
+    /**
+     * @brief Records events into a fixed size ring. Recording an event is a handful of stores,
+     * so it can be done from the per-byte decode loop. When the ring is full, the oldest events are overwritten.
+     *
+     * @tparam Config The compile-time configuration. See crsfForArduinoConfig::DefaultConfig.
+     * @tparam Enabled Selects the no-op version below when Config disables tracing.
+     */
+    template <class Config = crsfForArduinoConfig::DefaultConfig, bool Enabled = Config::traceEnabled>
+    class BasicTrace final
+    {
+        static_assert(Config::traceEventCount > 0 && (Config::traceEventCount & (Config::traceEventCount - 1)) == 0,
+                      "traceEventCount must be a power of two.");
+
+      public:
+        BasicTrace();
+        ~BasicTrace();
+
+        void clear();
+
+        inline void record(traceEventType_t type, uint8_t argument, uint16_t data, uint32_t timestamp)
+        {
+            traceEvent_t &event = _events[_head & (Config::traceEventCount - 1)];
+            event.timestamp = timestamp;
+            event.type = (uint8_t)type;
+            event.argument = argument;
+            event.data = data;
+            _head++;
+        }
+
+        inline void recordNow(traceEventType_t type, uint8_t argument, uint16_t data)
+        {
+            record(type, argument, data, micros());
+        }
+
+        size_t getDumpSize();
+        size_t dump(uint8_t *buffer, size_t size);
+
+      private:
+        traceEvent_t _events[Config::traceEventCount];
+        uint32_t _head;
+
+        static uint8_t *_writeU16LE(uint8_t *buffer, uint16_t value);
+        static uint8_t *_writeU32LE(uint8_t *buffer, uint32_t value);
+    };
+
+    /**
+     * @brief Stands in for the trace when a configuration disables it. Recording compiles to nothing.
+     */
+    template <class Config>
+    class BasicTrace<Config, false> final
+    {
+      public:
+        void clear()
+        {
+        }
+
+        inline void record(traceEventType_t type, uint8_t argument, uint16_t data, uint32_t timestamp)
+        {
+            (void)type;
+            (void)argument;
+            (void)data;
+            (void)timestamp;
+        }
+
+        inline void recordNow(traceEventType_t type, uint8_t argument, uint16_t data)
+        {
+            (void)type;
+            (void)argument;
+            (void)data;
+        }
+
+        size_t getDumpSize()
+        {
+            return 0;
+        }
+
+        size_t dump(uint8_t *buffer, size_t size)
+        {
+            (void)buffer;
+            (void)size;
+            return 0;
+        }
+    };
+
+    typedef BasicTrace<> Trace;
+
+    template <class Config, bool Enabled>
+    BasicTrace<Config, Enabled>::BasicTrace()
+    {
+        clear();
+    }
+
+    template <class Config, bool Enabled>
+    BasicTrace<Config, Enabled>::~BasicTrace()
+    {
+    }
+
+    template <class Config, bool Enabled>
+    void BasicTrace<Config, Enabled>::clear()
+    {
+        memset(_events, 0, sizeof(_events));
+        _head = 0;
+    }
+
+    /**
+     * @brief Returns the number of bytes that dump() needs to hold every event in the ring.
+     */
+    template <class Config, bool Enabled>
+    size_t BasicTrace<Config, Enabled>::getDumpSize()
+    {
+        const uint32_t count = _head < Config::traceEventCount ? _head : (uint32_t)Config::traceEventCount;
+        return TRACE_DUMP_HEADER_SIZE + (count * TRACE_DUMP_EVENT_SIZE);
+    }
+
+    /**
+     * @brief Writes the events to buffer in the dump format above, oldest first.
+     * If buffer cannot hold all of them, the newest events that fit are written.
+     * Take the dump from the same context that records the events.
+     *
+     * @return The number of bytes written, or 0 if buffer cannot even hold the header.
+     */
+    template <class Config, bool Enabled>
+    size_t BasicTrace<Config, Enabled>::dump(uint8_t *buffer, size_t size)
+    {
+        if (size < TRACE_DUMP_HEADER_SIZE)
+        {
+            return 0;
+        }
+
+        uint32_t count = _head < Config::traceEventCount ? _head : (uint32_t)Config::traceEventCount;
+        const uint32_t fits = (uint32_t)((size - TRACE_DUMP_HEADER_SIZE) / TRACE_DUMP_EVENT_SIZE);
+        if (count > fits)
+        {
+            count = fits;
+        }
+
+        uint8_t *position = buffer;
+        *position++ = 'C';
+        *position++ = 'F';
+        *position++ = 'A';
+        *position++ = 'T';
+        position = _writeU16LE(position, TRACE_DUMP_VERSION);
+        position = _writeU16LE(position, TRACE_DUMP_EVENT_SIZE);
+        position = _writeU32LE(position, count);
+        position = _writeU32LE(position, _head - count);
+
+        for (uint32_t i = _head - count; i != _head; i++)
+        {
+            const traceEvent_t &event = _events[i & (Config::traceEventCount - 1)];
+            position = _writeU32LE(position, event.timestamp);
+            *position++ = event.type;
+            *position++ = event.argument;
+            position = _writeU16LE(position, event.data);
+        }
+
+        return (size_t)(position - buffer);
+    }
+
+    template <class Config, bool Enabled>
+    uint8_t *BasicTrace<Config, Enabled>::_writeU16LE(uint8_t *buffer, uint16_t value)
+    {
+        buffer[0] = (uint8_t)value;
+        buffer[1] = (uint8_t)(value >> 8);
+        return buffer + 2;
+    }
+
+    template <class Config, bool Enabled>
+    uint8_t *BasicTrace<Config, Enabled>::_writeU32LE(uint8_t *buffer, uint32_t value)
+    {
+        buffer[0] = (uint8_t)value;
+        buffer[1] = (uint8_t)(value >> 8);
+        buffer[2] = (uint8_t)(value >> 16);
+        buffer[3] = (uint8_t)(value >> 24);
+        return buffer + 4;
+    }
+
+    // The default configuration is compiled once, in Trace.cpp.
+    extern template class BasicTrace<crsfForArduinoConfig::DefaultConfig>;
+} // namespace serialReceiverLayer
@@ -0,0 +1,552 @@
+/**
+ * @file Transmitter.cpp
+ * @author CRSF for Arduino contributors
+ * @brief The transmitter role: drives a CRSF TX module from a handset or ground unit.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#include "Transmitter.hpp"
+
+namespace serialReceiverLayer
+{
+    static uint16_t readU16BE(const uint8_t *buffer)
+    {
+        return (uint16_t)((buffer[0] << 8) | buffer[1]);
+    }
+
+    static uint32_t readU24BE(const uint8_t *buffer)
+    {
+        return ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+    }
+
+    static uint32_t readU32BE(const uint8_t *buffer)
+    {
+        return ((uint32_t)readU16BE(buffer) << 16) | readU16BE(buffer + 2);
+    }
+
+    /**
+     * @brief Construct a new Transmitter object that talks to the TX module over transport.
+     * The transport is not deleted by the Transmitter.
+     */
+    Transmitter::Transmitter(hal::SerialTransport *transport)
+    {
+        _transport = transport;
+        _destination = crsfProtocol::CRSF_ADDRESS_CRSF_TRANSMITTER;
+        _subsetFirst = 0;
+        _subsetCount = 0;
+
+        // Sticks centred, throttle at its minimum.
+        for (size_t i = 0; i < crsfProtocol::RC_CHANNEL_COUNT; i++)
+        {
+            _channels[i] = CRSF_RC_CHANNEL_CENTER;
+        }
+        _channels[crsfProtocol::RC_CHANNEL_THROTTLE] = CRSF_RC_CHANNEL_MIN;
+
+        _ownIntervalTenths = 10000000UL / TRANSMITTER_PACKET_RATE_DEFAULT;
+        _intervalTenths = _ownIntervalTenths;
+        _fractionTenths = 0;
+        _pendingOffsetTenths = 0;
+        _lastOffsetTenths = 0;
+        _nextFrameUs = 0;
+        _lastCorrectionUs = 0;
+        _synchronised = false;
+
+        _rxPosition = 0;
+        _rxStartUs = 0;
+        _rxTimeoutUs = 0;
+
+        _telemetry = transmitterTelemetry_t();
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    Transmitter::~Transmitter()
+    {
+    }
+
+    /**
+     * @brief Opens the transport and starts sending RC channels frames at packetRate, until the module says otherwise.
+     *
+     * @param baudRate The baud rate of the module's CRSF port. ExpressLRS modules default to 400000 or higher, TBS to 400000.
+     * @return false if there is no transport.
+     */
+    bool Transmitter::begin(uint32_t baudRate, uint16_t packetRate)
+    {
+        if (_transport == nullptr)
+        {
+            return false;
+        }
+
+        _transport->begin(baudRate);
+
+        // The same frame timeout as the receiver role's decoder.
+        _rxTimeoutUs = (1000000UL * 10) / (baudRate / (crsfProtocol::CRSF_FRAME_SIZE_MAX - 1));
+        _rxPosition = 0;
+
+        _synchronised = false;
+        _pendingOffsetTenths = 0;
+        _lastOffsetTenths = 0;
+        _fractionTenths = 0;
+        setPacketRate(packetRate);
+        _nextFrameUs = micros();
+
+        _telemetry = transmitterTelemetry_t();
+        resetStatistics();
+        return true;
+    }
+
+    void Transmitter::end()
+    {
+        if (_transport != nullptr)
+        {
+            _transport->flush();
+            _transport->end();
+        }
+    }
+
+    /**
+     * @brief Sets the address that RC channels frames are sent to. This is CRSF_ADDRESS_CRSF_TRANSMITTER by default.
+     * Use CRSF_ADDRESS_FLIGHT_CONTROLLER to talk straight to a flight controller (or to the receiver role).
+     */
+    void Transmitter::setDestination(uint8_t address)
+    {
+        _destination = address;
+    }
+
+    /**
+     * @brief Sets the packet rate that is used until the module sends a timing correction,
+     * and whenever the module stops sending them.
+     */
+    void Transmitter::setPacketRate(uint16_t packetRate)
+    {
+        const uint32_t intervalUs = constrain((uint32_t)(1000000UL / (packetRate > 0 ? packetRate : 1)), (uint32_t)TRANSMITTER_PERIOD_MIN_US, (uint32_t)TRANSMITTER_PERIOD_MAX_US);
+        _ownIntervalTenths = intervalUs * 10;
+
+        if (!_synchronised)
+        {
+            _intervalTenths = _ownIntervalTenths;
+        }
+    }
+
+    /**
+     * @brief Sends subset RC channels frames, which carry only channelCount channels from firstChannel onwards,
+     * instead of all 16 channels. Pass a channelCount of 0 to go back to whole RC channels frames.
+     * The channels are sent at 11 bit resolution. Set them in the same units as for whole frames (172 to 1811):
+     * they are scaled to the subset frame's own units, half microseconds from 988 us, as they are sent.
+     */
+    void Transmitter::setSubset(uint8_t firstChannel, uint8_t channelCount)
+    {
+        _subsetFirst = firstChannel < crsfProtocol::RC_CHANNEL_COUNT ? firstChannel : 0;
+        _subsetCount = min(channelCount, (uint8_t)(crsfProtocol::RC_CHANNEL_COUNT - _subsetFirst));
+    }
+
+    void Transmitter::setChannel(uint8_t channel, uint16_t value)
+    {
+        if (channel < crsfProtocol::RC_CHANNEL_COUNT)
+        {
+            _channels[channel] = value;
+        }
+    }
+
+    void Transmitter::setChannels(const uint16_t *channels, uint8_t count)
+    {
+        memcpy(_channels, channels, min(count, (uint8_t)crsfProtocol::RC_CHANNEL_COUNT) * sizeof(uint16_t));
+    }
+
+    /**
+     * @brief Decodes whatever the module has sent, and sends an RC channels frame if one is due.
+     * Call this at least once per frame interval. getTimeUntilNextFrame() says how long the caller can sleep for.
+     *
+     * @return true if an RC channels frame was sent.
+     */
+    bool Transmitter::update()
+    {
+        const uint32_t currentTime = micros();
+        _receive(currentTime);
+
+        if (_synchronised && currentTime - _lastCorrectionUs > TRANSMITTER_SYNC_TIMEOUT_US)
+        {
+            _synchronised = false;
+            _intervalTenths = _ownIntervalTenths;
+            _pendingOffsetTenths = 0;
+        }
+
+        const int32_t lateness = (int32_t)(currentTime - _nextFrameUs);
+        if (lateness < 0)
+        {
+            return false;
+        }
+
+        if ((uint32_t)lateness * 10 >= _intervalTenths)
+        {
+            // A whole frame was missed. Start again from now, instead of sending a burst of frames to catch up.
+            _statistics.lateFrames++;
+            _nextFrameUs = currentTime;
+            _fractionTenths = 0;
+        }
+
+        const bool sent = _sendRcFrame();
+        _scheduleNextFrame();
+        return sent;
+    }
+
+    /**
+     * @brief Returns the time until the next RC channels frame is due, in microseconds. 0 means it is due now.
+     */
+    uint32_t Transmitter::getTimeUntilNextFrame()
+    {
+        const int32_t remaining = (int32_t)(_nextFrameUs - micros());
+        return remaining > 0 ? (uint32_t)remaining : 0;
+    }
+
+    /**
+     * @brief Returns true while the module is sending timing corrections, ie the frames follow the module's RF cycle.
+     */
+    bool Transmitter::isSynchronised()
+    {
+        return _synchronised;
+    }
+
+    uint32_t Transmitter::getIntervalUs()
+    {
+        return _intervalTenths / 10;
+    }
+
+    /**
+     * @brief Returns the offset from the most recent timing correction: how much earlier than the module wants them
+     * the RC channels frames arrived, in microseconds. It settles close to 0 once the frames are in phase.
+     */
+    int32_t Transmitter::getLastOffsetUs()
+    {
+        return _lastOffsetTenths / 10;
+    }
+
+    void Transmitter::getTelemetry(transmitterTelemetry_t *telemetry)
+    {
+        memcpy(telemetry, &_telemetry, sizeof(transmitterTelemetry_t));
+    }
+
+    void Transmitter::setTelemetryCallback(transmitterTelemetryCallback_t callback)
+    {
+        _telemetryCallback = callback;
+    }
+
+    void Transmitter::getStatistics(transmitterStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(transmitterStatistics_t));
+    }
+
+    void Transmitter::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    /**
+     * @brief Packs channels at 11 bits each, least significant bit first, as RC channels frames carry them.
+     * Each group of 8 channels fills exactly 11 bytes, so groups are packed with fixed shifts instead of bit by bit.
+     *
+     * @return The number of bytes written to buffer, ie (count * 11 + 7) / 8.
+     */
+    size_t Transmitter::packChannels(const uint16_t *channels, uint8_t count, uint8_t *buffer)
+    {
+        uint8_t *out = buffer;
+        uint8_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint16_t c0 = channels[i] & 0x07FF;
+            const uint16_t c1 = channels[i + 1] & 0x07FF;
+            const uint16_t c2 = channels[i + 2] & 0x07FF;
+            const uint16_t c3 = channels[i + 3] & 0x07FF;
+            const uint16_t c4 = channels[i + 4] & 0x07FF;
+            const uint16_t c5 = channels[i + 5] & 0x07FF;
+            const uint16_t c6 = channels[i + 6] & 0x07FF;
+            const uint16_t c7 = channels[i + 7] & 0x07FF;
+
+            out[0] = (uint8_t)c0;
+            out[1] = (uint8_t)((c0 >> 8) | (c1 << 3));
+            out[2] = (uint8_t)((c1 >> 5) | (c2 << 6));
+            out[3] = (uint8_t)(c2 >> 2);
+            out[4] = (uint8_t)((c2 >> 10) | (c3 << 1));
+            out[5] = (uint8_t)((c3 >> 7) | (c4 << 4));
+            out[6] = (uint8_t)((c4 >> 4) | (c5 << 7));
+            out[7] = (uint8_t)(c5 >> 1);
+            out[8] = (uint8_t)((c5 >> 9) | (c6 << 2));
+            out[9] = (uint8_t)((c6 >> 6) | (c7 << 5));
+            out[10] = (uint8_t)(c7 >> 3);
+            out += 11;
+        }
+
+        // Whatever is left over (subset frames only).
+        uint32_t bits = 0;
+        uint8_t bitCount = 0;
+        for (; i < count; i++)
+        {
+            bits |= (uint32_t)(channels[i] & 0x07FF) << bitCount;
+            bitCount += 11;
+            while (bitCount >= 8)
+            {
+                *out++ = (uint8_t)bits;
+                bits >>= 8;
+                bitCount -= 8;
+            }
+        }
+
+        if (bitCount > 0)
+        {
+            *out++ = (uint8_t)bits;
+        }
+
+        return (size_t)(out - buffer);
+    }
+
+    void Transmitter::_receive(uint32_t currentTime)
+    {
+        uint8_t buffer[TRANSMITTER_READ_SIZE];
+        size_t length;
+
+        do
+        {
+            length = _transport->read(buffer, sizeof(buffer));
+            for (size_t i = 0; i < length; i++)
+            {
+                _receiveByte(buffer[i], currentTime);
+            }
+        } while (length == sizeof(buffer));
+    }
+
+    void Transmitter::_receiveByte(uint8_t rxByte, uint32_t currentTime)
+    {
+        if (_rxPosition > 0 && currentTime - _rxStartUs > _rxTimeoutUs)
+        {
+            _statistics.timeouts++;
+            _rxPosition = 0;
+        }
+
+        if (_rxPosition == 0)
+        {
+            _rxStartUs = currentTime;
+        }
+
+        _rxFrame[_rxPosition++] = rxByte;
+
+        if (_rxPosition == 2 && (rxByte < crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC || rxByte > crsfProtocol::CRSF_FRAME_SIZE_MAX - crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS - crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH))
+        {
+            _statistics.lengthErrors++;
+            _rxPosition = 0;
+        }
+        else if (_rxPosition > 2 && _rxPosition == _rxFrame[1] + crsfProtocol::CRSF_FRAME_LENGTH_ADDRESS + crsfProtocol::CRSF_FRAME_LENGTH_FRAMELENGTH)
+        {
+            _decodeFrame(currentTime);
+            _rxPosition = 0;
+        }
+    }
+
+    void Transmitter::_decodeFrame(uint32_t currentTime)
+    {
+        const uint8_t frameLength = _rxFrame[1];
+        const uint8_t type = _rxFrame[2];
+        const uint8_t payloadLength = frameLength - crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        const uint8_t *payload = _rxFrame + 3;
+
+        if (_crc.calculate(type, _rxFrame + 3, payloadLength) != _rxFrame[frameLength + 1])
+        {
+            _statistics.crcErrors++;
+            return;
+        }
+
+        _statistics.telemetryFrames++;
+
+        switch (type)
+        {
+            case crsfProtocol::CRSF_FRAMETYPE_LINK_STATISTICS:
+                if (payloadLength >= crsfProtocol::CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE)
+                {
+                    _telemetry.linkStatistics.rssi = payload[4] ? payload[1] : payload[0];
+                    _telemetry.linkStatistics.lqi = payload[2];
+                    _telemetry.linkStatistics.snr = (int8_t)payload[3];
+                    _telemetry.linkStatistics.tx_power = payload[6] < 9 ? tx_power_table[payload[6]] : 0;
+                    _telemetry.downlinkRssi = payload[7];
+                    _telemetry.downlinkLqi = payload[8];
+                    _telemetry.downlinkSnr = (int8_t)payload[9];
+                }
+                break;
+
+            case crsfProtocol::CRSF_FRAMETYPE_BATTERY_SENSOR:
+                if (payloadLength >= crsfProtocol::CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE)
+                {
+                    _telemetry.battery.voltage = readU16BE(payload);
+                    _telemetry.battery.current = readU16BE(payload + 2);
+                    _telemetry.battery.capacity = readU24BE(payload + 4);
+                    _telemetry.battery.percent = payload[7];
+                }
+                break;
+
+            case crsfProtocol::CRSF_FRAMETYPE_GPS:
+                if (payloadLength >= crsfProtocol::CRSF_FRAME_GPS_PAYLOAD_SIZE)
+                {
+                    _telemetry.gps.latitude = (int32_t)readU32BE(payload);
+                    _telemetry.gps.longitude = (int32_t)readU32BE(payload + 4);
+                    _telemetry.gps.speed = readU16BE(payload + 8);
+                    _telemetry.gps.groundCourse = readU16BE(payload + 10);
+                    _telemetry.gps.altitude = readU16BE(payload + 12);
+                    _telemetry.gps.satellites = payload[14];
+                }
+                break;
+
+            case crsfProtocol::CRSF_FRAMETYPE_ATTITUDE:
+                if (payloadLength >= crsfProtocol::CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE)
+                {
+                    _telemetry.attitude.pitch = (int16_t)readU16BE(payload);
+                    _telemetry.attitude.roll = (int16_t)readU16BE(payload + 2);
+                    _telemetry.attitude.yaw = (int16_t)readU16BE(payload + 4);
+                }
+                break;
+
+            case crsfProtocol::CRSF_FRAMETYPE_BARO_ALTITUDE:
+                // TBS sends only the altitude, ExpressLRS adds the vertical speed.
+                if (payloadLength >= 2)
+                {
+                    _telemetry.baroAltitude.altitude = readU16BE(payload);
+                    _telemetry.baroAltitude.vario = payloadLength >= crsfProtocol::CRSF_FRAME_BARO_ALTITUDE_PAYLOAD_SIZE ? (int16_t)readU16BE(payload + 2) : 0;
+                }
+                break;
+
+            case crsfProtocol::CRSF_FRAMETYPE_FLIGHT_MODE:
+            {
+                const uint8_t length = min(payloadLength, (uint8_t)crsfProtocol::CRSF_FRAME_FLIGHT_MODE_PAYLOAD_SIZE);
+                memcpy(_telemetry.flightMode, payload, length);
+                _telemetry.flightMode[length] = '\0';
+                break;
+            }
+
+            case crsfProtocol::CRSF_FRAMETYPE_RADIO_ID:
+                if (payloadLength >= crsfProtocol::CRSF_FRAME_RADIO_ID_TIMING_PAYLOAD_SIZE && payload[2] == crsfProtocol::CRSF_RADIO_ID_TIMING_CORRECTION)
+                {
+                    _applyTimingCorrection(payload + 3, currentTime);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (_telemetryCallback != nullptr)
+        {
+            _telemetryCallback(type, &_telemetry);
+        }
+    }
+
+    /**
+     * @brief Takes on the module's RF packet interval, and queues up its offset to be worked off over the next few frames.
+     * Each correction replaces the last one, because the module measures the offset afresh each time.
+     */
+    void Transmitter::_applyTimingCorrection(const uint8_t *payload, uint32_t currentTime)
+    {
+        const uint32_t intervalTenths = readU32BE(payload);
+        const int32_t offsetTenths = (int32_t)readU32BE(payload + 4);
+
+        if (intervalTenths < TRANSMITTER_PERIOD_MIN_US * 10 || intervalTenths > TRANSMITTER_PERIOD_MAX_US * 10)
+        {
+            return;
+        }
+
+        _statistics.timingCorrections++;
+        _intervalTenths = intervalTenths;
+        _pendingOffsetTenths = offsetTenths;
+        _lastOffsetTenths = offsetTenths;
+        _lastCorrectionUs = currentTime;
+        _synchronised = true;
+    }
+
+    /**
+     * @brief Converts a channel from RC channels frame units (172 to 1811, ie 988 us to 2012 us) to 11 bit subset frame units,
+     * which receivers decode as us = value / 2 + 988. Values outside that range are clamped to it.
+     */
+    uint16_t Transmitter::toSubsetValue(uint16_t value)
+    {
+        if (value <= CRSF_RC_CHANNEL_MIN)
+        {
+            return 0;
+        }
+
+        const uint32_t scaled = ((uint32_t)(value - CRSF_RC_CHANNEL_MIN) * 2048 + (CRSF_RC_CHANNEL_MAX - CRSF_RC_CHANNEL_MIN) / 2) / (CRSF_RC_CHANNEL_MAX - CRSF_RC_CHANNEL_MIN);
+        return scaled < 0x07FF ? (uint16_t)scaled : 0x07FF;
+    }
+
+    bool Transmitter::_sendRcFrame()
+    {
+        uint8_t frame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        uint8_t payloadLength;
+
+        if (_subsetCount == 0)
+        {
+            frame[2] = crsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+            payloadLength = (uint8_t)packChannels(_channels, crsfProtocol::RC_CHANNEL_COUNT, frame + 3);
+        }
+        else
+        {
+            frame[2] = crsfProtocol::CRSF_FRAMETYPE_SUBSET_RC_CHANNELS_PACKED;
+            frame[3] = (uint8_t)(_subsetFirst | (crsfProtocol::CRSF_SUBSET_RC_RESOLUTION_11B << 5));
+
+            uint16_t subsetChannels[crsfProtocol::RC_CHANNEL_COUNT];
+            for (uint8_t i = 0; i < _subsetCount; i++)
+            {
+                subsetChannels[i] = toSubsetValue(_channels[_subsetFirst + i]);
+            }
+            payloadLength = (uint8_t)(1 + packChannels(subsetChannels, _subsetCount, frame + 4));
+        }
+
+        frame[0] = _destination;
+        frame[1] = payloadLength + crsfProtocol::CRSF_FRAME_LENGTH_TYPE_CRC;
+        frame[3 + payloadLength] = _crc.calculate(frame[2], frame + 3, payloadLength);
+
+        const size_t length = payloadLength + crsfProtocol::CRSF_FRAME_LENGTH_NON_PAYLOAD;
+        if (_transport->write(frame, length) != length)
+        {
+            _statistics.rcFramesDropped++;
+            return false;
+        }
+
+        _statistics.rcFramesSent++;
+        return true;
+    }
+
+    /**
+     * @brief Moves the send time on by one interval. While there is an offset left to work off, the interval is
+     * stretched (frames arrive too early) or shrunk (too late) by up to 1/TRANSMITTER_SLEW_DIVISOR of itself.
+     */
+    void Transmitter::_scheduleNextFrame()
+    {
+        int32_t interval = (int32_t)_intervalTenths;
+        if (_pendingOffsetTenths != 0)
+        {
+            const int32_t limit = (int32_t)(_intervalTenths / TRANSMITTER_SLEW_DIVISOR);
+            const int32_t slew = constrain(_pendingOffsetTenths, -limit, limit);
+            interval += slew;
+            _pendingOffsetTenths -= slew;
+        }
+
+        _fractionTenths += (uint32_t)interval;
+        _nextFrameUs += _fractionTenths / 10;
+        _fractionTenths %= 10;
+    }
+} // namespace serialReceiverLayer
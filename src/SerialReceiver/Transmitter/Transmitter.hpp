@@ -0,0 +1,151 @@
+/**
+ * @file Transmitter.hpp
+ * @author CRSF for Arduino contributors
+ * @brief The transmitter role: drives a CRSF TX module from a handset or ground unit.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ * 
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+#include "../../hal/SerialTransport/SerialTransport.hpp"
+#include "../CRC/CRC.hpp"
+#include "../CRSF/CRSF.hpp"
+#include "../CRSF/CRSFProtocol.hpp"
+
+namespace serialReceiverLayer
+{
+/* Transmitter Options
+- TRANSMITTER_PACKET_RATE_DEFAULT: RC frames per second, until the TX module sends its first timing correction.
+- TRANSMITTER_PERIOD_MIN_US and TRANSMITTER_PERIOD_MAX_US: Timing corrections that ask for an interval outside this range are ignored.
+- TRANSMITTER_SLEW_DIVISOR: While a timing offset is being worked off, each interval is stretched or shrunk
+  by at most 1/TRANSMITTER_SLEW_DIVISOR of itself, so that the frame rate never jumps.
+- TRANSMITTER_SYNC_TIMEOUT_US: Without a timing correction for this long, the transmitter goes back to its own packet rate.
+- TRANSMITTER_READ_SIZE: Bytes taken from the transport per read. */
+#define TRANSMITTER_PACKET_RATE_DEFAULT 250
+#define TRANSMITTER_PERIOD_MIN_US       250
+#define TRANSMITTER_PERIOD_MAX_US       50000
+#define TRANSMITTER_SLEW_DIVISOR        64
+#define TRANSMITTER_SYNC_TIMEOUT_US     1000000
+#define TRANSMITTER_READ_SIZE           64
+
+    typedef struct transmitterTelemetry_s
+    {
+        link_statistics_t linkStatistics;              // Uplink, in the same form as the receiver role reports it.
+        uint8_t downlinkRssi;                          // Downlink RSSI (-dBm).
+        uint8_t downlinkLqi;                           // Downlink link quality (%).
+        int8_t downlinkSnr;                            // Downlink signal-to-noise ratio (dB).
+        crsfProtocol::attitudeData_t attitude;         // Radians * 10000, as sent.
+        crsfProtocol::baroAltitudeData_t baroAltitude; // As sent, see baroAltitudeData_t.
+        crsfProtocol::batterySensorData_t battery;     // Voltage and current in 0.1 V and 0.1 A, capacity in mAh.
+        crsfProtocol::gpsData_t gps;                   // Degrees * 10^7, km/h * 10, degrees * 100, metres + 1000.
+        char flightMode[crsfProtocol::CRSF_FRAME_FLIGHT_MODE_PAYLOAD_SIZE + 1];
+    } transmitterTelemetry_t;
+
+    typedef struct transmitterStatistics_s
+    {
+        uint32_t rcFramesSent;      // RC channels frames that the transport accepted.
+        uint32_t rcFramesDropped;   // RC channels frames that the transport did not accept in full.
+        uint32_t lateFrames;        // Times that update() was called more than a whole interval late, and the schedule started over.
+        uint32_t telemetryFrames;   // Frames with a valid CRC received from the module, timing corrections included.
+        uint32_t timingCorrections; // Timing correction frames received.
+        uint32_t crcErrors;         // Received frames whose CRC did not match.
+        uint32_t lengthErrors;      // Received frames whose length byte was out of range.
+        uint32_t timeouts;          // Partial frames that were dropped because the rest of them never arrived.
+    } transmitterStatistics_t;
+
+    // Function pointer for the Telemetry Callback. frameType is the type of the frame that was just decoded.
+    typedef void (*transmitterTelemetryCallback_t)(uint8_t frameType, const transmitterTelemetry_t *telemetry);
+
+    /**
+     * @brief Sends RC channels frames to a CRSF TX module (eg ExpressLRS or TBS), and decodes the telemetry that comes back.
+     * Call update() often. It sends a frame whenever one is due, at the module's own RF packet interval once the module
+     * has sent a timing correction, and shifts the frames in time until they arrive when the module wants them.
+     */
+    class Transmitter final
+    {
+      public:
+        Transmitter(hal::SerialTransport *transport);
+        ~Transmitter();
+
+        bool begin(uint32_t baudRate = crsfProtocol::BAUD_RATE, uint16_t packetRate = TRANSMITTER_PACKET_RATE_DEFAULT);
+        void end();
+
+        void setDestination(uint8_t address);
+        void setPacketRate(uint16_t packetRate);
+        void setSubset(uint8_t firstChannel, uint8_t channelCount);
+
+        void setChannel(uint8_t channel, uint16_t value);
+        void setChannels(const uint16_t *channels, uint8_t count = crsfProtocol::RC_CHANNEL_COUNT);
+
+        bool update();
+        uint32_t getTimeUntilNextFrame();
+
+        bool isSynchronised();
+        uint32_t getIntervalUs();
+        int32_t getLastOffsetUs();
+
+        void getTelemetry(transmitterTelemetry_t *telemetry);
+        void setTelemetryCallback(transmitterTelemetryCallback_t callback);
+
+        void getStatistics(transmitterStatistics_t *statistics);
+        void resetStatistics();
+
+        static size_t packChannels(const uint16_t *channels, uint8_t count, uint8_t *buffer);
+        static uint16_t toSubsetValue(uint16_t value);
+
+      private:
+        hal::SerialTransport *_transport;
+        genericCrc::GenericCRC _crc;
+        uint8_t _destination;
+        uint8_t _subsetFirst;
+        uint8_t _subsetCount;
+        uint16_t _channels[crsfProtocol::RC_CHANNEL_COUNT];
+
+        // Send schedule. Intervals and offsets are kept in 0.1 us, as the module reports them.
+        uint32_t _ownIntervalTenths;
+        uint32_t _intervalTenths;
+        uint32_t _fractionTenths;
+        int32_t _pendingOffsetTenths;
+        int32_t _lastOffsetTenths;
+        uint32_t _nextFrameUs;
+        uint32_t _lastCorrectionUs;
+        bool _synchronised;
+
+        // Receive state.
+        uint8_t _rxFrame[crsfProtocol::CRSF_FRAME_SIZE_MAX];
+        uint8_t _rxPosition;
+        uint32_t _rxStartUs;
+        uint32_t _rxTimeoutUs;
+
+        transmitterTelemetry_t _telemetry;
+        transmitterTelemetryCallback_t _telemetryCallback = nullptr;
+        transmitterStatistics_t _statistics;
+
+        void _receive(uint32_t currentTime);
+        void _receiveByte(uint8_t rxByte, uint32_t currentTime);
+        void _decodeFrame(uint32_t currentTime);
+        void _applyTimingCorrection(const uint8_t *payload, uint32_t currentTime);
+        bool _sendRcFrame();
+        void _scheduleNextFrame();
+    };
+} // namespace serialReceiverLayer
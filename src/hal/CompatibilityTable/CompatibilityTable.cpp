@@ -26,7 +26,6 @@
 
 #include "CompatibilityTable.hpp"
 #include "../../CFA_Config.hpp"
-#include "Arduino.h"
 
 namespace hal
 {
@@ -562,6 +561,10 @@ as two separate boards. To prevent a false negative, check for both boards. */
         device.type.devboard = DEVBOARD_IS_PERMISSIVELY_INCOMPATIBLE_UNKNOWN_BOARD_AND_CHIP;
 #endif
 
+// Linux hosts. Serial ports are provided by hal::LinuxSerial.
+#elif defined(__linux__) && !defined(ARDUINO)
+        device.type.devboard = DEVBOARD_LINUX_HOST;
+
 #else // Unsupported architecture
 #error "Unsupported architecture. CRSF for Arduino only supports the ESP32, SAMD, and Teensy architectures."
         device.type.devboard = DEVBOARD_IS_INCOMPATIBLE;
@@ -28,11 +28,11 @@
 
 namespace hal
 {
-    class CompatibilityTable
+    class CompatibilityTable final
     {
       public:
         CompatibilityTable();
-        virtual ~CompatibilityTable();
+        ~CompatibilityTable();
 
         bool isDevboardCompatible(const char *name);
         const char *getDevboardName();
@@ -239,6 +239,9 @@ namespace hal
             DEVBOARD_TEENSY_40,
             DEVBOARD_TEENSY_41,
 
+            // Linux hosts (companion computers, ground stations and test rigs).
+            DEVBOARD_LINUX_HOST,
+
             DEVBOARD_COUNT
         } ct_devboards_t;
 
@@ -365,6 +368,7 @@ namespace hal
             "STM32F401RC",
             "STM32F401RD",
             "STM32F401RE",
+            "STM32F405RG",
             "STM32F407VE",
             "STM32F407VG",
             "STM32F410C8",
@@ -412,6 +416,7 @@ namespace hal
             "Teensy 3.5",
             "Teensy 3.6",
             "Teensy 4.0",
-            "Teensy 4.1"};
+            "Teensy 4.1",
+            "Linux host"};
     };
 } // namespace hal
@@ -0,0 +1,73 @@
+/**
+ * @file LinuxCompat.cpp
+ * @author CRSF for Arduino contributors
+ * @brief The subset of the Arduino API that CRSF for Arduino needs when it is built on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LinuxCompat.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "errno.h"
+#include "time.h"
+
+static uint64_t monotonicMicroseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000ULL) + ((uint64_t)now.tv_nsec / 1000ULL);
+}
+
+unsigned long micros()
+{
+    return (uint32_t)monotonicMicroseconds();
+}
+
+unsigned long millis()
+{
+    return (uint32_t)(monotonicMicroseconds() / 1000ULL);
+}
+
+void delay(unsigned long ms)
+{
+    struct timespec duration;
+    duration.tv_sec = ms / 1000;
+    duration.tv_nsec = (ms % 1000) * 1000000L;
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR)
+    {
+        // Interrupted by a signal. Sleep for the remaining time.
+    }
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    struct timespec duration;
+    duration.tv_sec = us / 1000000;
+    duration.tv_nsec = (us % 1000000) * 1000L;
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR)
+    {
+        // Interrupted by a signal. Sleep for the remaining time.
+    }
+}
+
+#endif // __linux__ && !ARDUINO
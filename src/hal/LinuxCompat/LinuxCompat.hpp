@@ -0,0 +1,84 @@
+/**
+ * @file LinuxCompat.hpp
+ * @author CRSF for Arduino contributors
+ * @brief The subset of the Arduino API that CRSF for Arduino needs when it is built on a Linux host.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "stddef.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Timing functions.
+These behave like their Arduino counterparts, including wrapping around at 32 bits. */
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+/* Arduino's min() and constrain() are macros.
+These are templates instead, so that they do not collide with std::min() in host code. */
+template <typename T, typename U>
+inline T min(T a, U b)
+{
+    return (b < a) ? (T)b : a;
+}
+
+template <typename T, typename U>
+inline T max(T a, U b)
+{
+    return (a < b) ? (T)b : a;
+}
+
+template <typename T, typename L, typename H>
+inline T constrain(T amount, L low, H high)
+{
+    return (amount < low) ? (T)low : ((amount > high) ? (T)high : amount);
+}
+
+/**
+ * @brief Mirrors the parts of Arduino's HardwareSerial class that CRSF for Arduino uses,
+ * so that code written against HardwareSerial also builds on a host.
+ * Host transports (such as hal::LinuxSerial) implement hal::SerialTransport instead.
+ */
+class HardwareSerial
+{
+  public:
+    virtual ~HardwareSerial()
+    {
+    }
+
+    virtual void begin(unsigned long baudRate) = 0;
+    virtual void end() = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual size_t write(uint8_t data) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+    virtual void flush() = 0;
+};
+
+#endif // __linux__ && !ARDUINO
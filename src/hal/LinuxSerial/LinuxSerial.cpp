@@ -0,0 +1,313 @@
+/**
+ * @file LinuxSerial.cpp
+ * @author CRSF for Arduino contributors
+ * @brief A termios2 based serial port for running CRSF for Arduino on Linux hosts.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LinuxSerial.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+/* termios2 lives in the kernel headers and clashes with glibc's termios.h,
+so termios.h (and tcdrain() et al) must not be used in this file. */
+#include "asm/termbits.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "linux/serial.h"
+#include "poll.h"
+#include "sys/ioctl.h"
+#include "unistd.h"
+
+namespace hal
+{
+    /**
+     * @brief Construct a new Linux Serial object that opens the given tty device in begin().
+     *
+     * @param device The path to the tty device, eg "/dev/ttyAMA0" or "/dev/ttyUSB0".
+     */
+    LinuxSerial::LinuxSerial(const char *device)
+    {
+        _device = device;
+        _fd = -1;
+        _ownsFileDescriptor = true;
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    /**
+     * @brief Construct a new Linux Serial object around a file descriptor that is already open,
+     * such as the slave side of a pseudo-terminal pair from openpty().
+     * The file descriptor is not closed by end().
+     *
+     * @param fileDescriptor The open file descriptor.
+     */
+    LinuxSerial::LinuxSerial(int fileDescriptor)
+    {
+        _device = nullptr;
+        _fd = fileDescriptor;
+        _ownsFileDescriptor = false;
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    LinuxSerial::~LinuxSerial()
+    {
+        end();
+    }
+
+    /**
+     * @brief Opens (if needed) and configures the serial port.
+     * Use isOpen() afterwards to check whether this succeeded.
+     *
+     * @param baudRate Any baud rate the UART supports, including non-standard rates such as 420000.
+     */
+    void LinuxSerial::begin(unsigned long baudRate)
+    {
+        if (_ownsFileDescriptor && _fd < 0 && _device != nullptr)
+        {
+            _fd = open(_device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+            if (_fd < 0)
+            {
+                return;
+            }
+        }
+        else if (_fd >= 0)
+        {
+            fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) | O_NONBLOCK);
+        }
+
+        if (_fd >= 0 && !_configure(baudRate))
+        {
+            if (_ownsFileDescriptor)
+            {
+                close(_fd);
+            }
+            _fd = -1;
+        }
+    }
+
+    void LinuxSerial::end()
+    {
+        if (_fd >= 0 && _ownsFileDescriptor)
+        {
+            close(_fd);
+            _fd = -1;
+        }
+    }
+
+    /**
+     * @brief Reconfigures the open port for baudRate, without closing it. Anything that has been received but not read is discarded.
+     */
+    void LinuxSerial::setBaudRate(unsigned long baudRate)
+    {
+        if (_fd >= 0)
+        {
+            _configure(baudRate);
+        }
+    }
+
+    /**
+     * @brief Reads whatever has arrived, straight into buffer, with a single non-blocking read() call.
+     * A burst of bytes therefore costs one system call instead of one per byte.
+     */
+    size_t LinuxSerial::read(uint8_t *buffer, size_t size)
+    {
+        if (_fd < 0)
+        {
+            return 0;
+        }
+
+        ssize_t result;
+        do
+        {
+            result = ::read(_fd, buffer, size);
+            _statistics.readCalls++;
+        } while (result < 0 && errno == EINTR);
+
+        if (result <= 0)
+        {
+            _statistics.emptyReads++;
+            return 0;
+        }
+
+        _statistics.bytesRead += (uint32_t)result;
+        return (size_t)result;
+    }
+
+    size_t LinuxSerial::write(const uint8_t *buffer, size_t size)
+    {
+        if (_fd < 0)
+        {
+            return 0;
+        }
+
+        size_t written = 0;
+        while (written < size)
+        {
+            const ssize_t result = ::write(_fd, buffer + written, size - written);
+            _statistics.writeCalls++;
+
+            if (result > 0)
+            {
+                written += (size_t)result;
+            }
+            else if (result < 0 && errno == EAGAIN)
+            {
+                // The kernel's transmit buffer is full. Wait briefly for it to drain, otherwise drop the rest.
+                struct pollfd pfd = {_fd, POLLOUT, 0};
+                if (poll(&pfd, 1, 10) <= 0)
+                {
+                    break;
+                }
+            }
+            else if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        _statistics.bytesWritten += written;
+        return written;
+    }
+
+    /**
+     * @brief Waits until all transmitted bytes have left the UART (the equivalent of tcdrain()).
+     */
+    void LinuxSerial::flush()
+    {
+        if (_fd >= 0)
+        {
+            ioctl(_fd, TCSBRK, 1);
+        }
+    }
+
+    /**
+     * @brief Returns the UART's hardware overruns plus the bytes that the tty layer dropped because its buffer was full,
+     * as counted by the driver since the port was opened. Pseudo-terminals and USB adapters without these counts return 0.
+     */
+    uint32_t LinuxSerial::getOverrunCount()
+    {
+        struct serial_icounter_struct counts;
+        if (_fd < 0 || ioctl(_fd, TIOCGICOUNT, &counts) != 0)
+        {
+            return 0;
+        }
+
+        return (uint32_t)counts.overrun + (uint32_t)counts.buf_overrun;
+    }
+
+    bool LinuxSerial::isOpen()
+    {
+        return _fd >= 0;
+    }
+
+    int LinuxSerial::getFileDescriptor()
+    {
+        return _fd;
+    }
+
+    /**
+     * @brief Blocks until there is data to read or the timeout expires.
+     *
+     * @param timeoutMs The timeout in milliseconds. -1 waits forever.
+     * @return true if there is data to read.
+     */
+    bool LinuxSerial::waitForData(int timeoutMs)
+    {
+        if (_fd < 0)
+        {
+            return false;
+        }
+
+        struct pollfd pfd = {_fd, POLLIN, 0};
+        if (poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN))
+        {
+            _statistics.wakeups++;
+            return true;
+        }
+
+        return false;
+    }
+
+    void LinuxSerial::getStatistics(linuxSerialStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(linuxSerialStatistics_t));
+    }
+
+    void LinuxSerial::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    bool LinuxSerial::_configure(unsigned long baudRate)
+    {
+        struct termios2 tio;
+        if (ioctl(_fd, TCGETS2, &tio) != 0)
+        {
+            return false;
+        }
+
+        /* Raw mode: 8N1, no flow control, no line discipline processing. */
+        tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+        tio.c_oflag &= ~OPOST;
+        tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+        tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+        tio.c_cflag |= CS8 | CREAD | CLOCAL;
+
+        /* Custom baud rate. BOTHER takes the rate from c_ispeed/c_ospeed as-is,
+        which is how rates such as 420000 are reached. */
+        tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+        tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+        tio.c_ispeed = baudRate;
+        tio.c_ospeed = baudRate;
+
+        /* VMIN = 0 and VTIME = 0 make read() return whatever has arrived immediately.
+        The inter-byte timer is never used, so a frame is handed over as soon as poll() wakes up. */
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+
+        if (ioctl(_fd, TCSETS2, &tio) != 0)
+        {
+            return false;
+        }
+
+        /* USB serial adapters batch received bytes for up to 16 ms by default.
+        Ask the driver to hand them over straight away. Pseudo-terminals and
+        some drivers do not support this, which is fine. */
+        struct serial_struct serial;
+        if (ioctl(_fd, TIOCGSERIAL, &serial) == 0)
+        {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            ioctl(_fd, TIOCSSERIAL, &serial);
+        }
+
+        // Discard anything that arrived before the port was configured.
+        ioctl(_fd, TCFLSH, TCIFLUSH);
+
+        return true;
+    }
+} // namespace hal
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,80 @@
+/**
+ * @file LinuxSerial.hpp
+ * @author CRSF for Arduino contributors
+ * @brief A termios2 based serial port for running CRSF for Arduino on Linux hosts.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../SerialTransport/SerialTransport.hpp"
+
+namespace hal
+{
+    typedef struct linuxSerialStatistics_s
+    {
+        uint32_t readCalls;    // Number of read() system calls, including the ones that returned no data.
+        uint32_t emptyReads;   // Number of read() system calls that returned no data.
+        uint32_t bytesRead;    // Number of bytes received.
+        uint32_t writeCalls;   // Number of write() system calls.
+        uint32_t bytesWritten; // Number of bytes transmitted.
+        uint32_t wakeups;      // Number of times waitForData() returned with data pending.
+    } linuxSerialStatistics_t;
+
+    class LinuxSerial final : public SerialTransport
+    {
+      public:
+        LinuxSerial(const char *device);
+        LinuxSerial(int fileDescriptor);
+        ~LinuxSerial();
+
+        void begin(unsigned long baudRate) override;
+        void end() override;
+        void setBaudRate(unsigned long baudRate) override;
+        size_t read(uint8_t *buffer, size_t size) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        void flush() override;
+        uint32_t getOverrunCount() override;
+
+        bool isOpen();
+        int getFileDescriptor();
+        bool waitForData(int timeoutMs);
+
+        void getStatistics(linuxSerialStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        const char *_device;
+        int _fd;
+        bool _ownsFileDescriptor;
+
+        linuxSerialStatistics_t _statistics;
+
+        bool _configure(unsigned long baudRate);
+    };
+} // namespace hal
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,129 @@
+/**
+ * @file SerialTransport.hpp
+ * @author CRSF for Arduino contributors
+ * @brief The byte stream interface that the Serial Receiver reads CRSF frames from, and an adapter for Arduino streams.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+namespace hal
+{
+    /**
+     * @brief The minimal byte stream that the Serial Receiver needs.
+     * Bytes are moved a buffer at a time, so a burst of bytes costs one call through this interface
+     * instead of an available() and a read() per byte, and the per-byte decode loop stays inline.
+     * Implement this for transports that are not Arduino streams (eg hal::LinuxSerial and hal::UdpSerial).
+     */
+    class SerialTransport
+    {
+      public:
+        virtual ~SerialTransport()
+        {
+        }
+
+        virtual void begin(unsigned long baudRate) = 0;
+        virtual void end() = 0;
+
+        /**
+         * @brief Changes the baud rate of a transport that is already running. Bytes that are still being sent may be lost,
+         * so call flush() first. By default this calls begin() again at the new rate, which is how most Arduino UARTs change speed.
+         */
+        virtual void setBaudRate(unsigned long baudRate)
+        {
+            begin(baudRate);
+        }
+
+        /**
+         * @brief Copies up to size bytes that have already arrived into buffer. This must not block.
+         *
+         * @return The number of bytes copied. Fewer than size means there are no more bytes for now.
+         */
+        virtual size_t read(uint8_t *buffer, size_t size) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+        virtual void flush() = 0;
+
+        /**
+         * @brief Returns how many received bytes the UART or its driver has lost to overruns so far.
+         * This is a running total, and is only read when the health counters are read.
+         * Transports that cannot tell return 0.
+         */
+        virtual uint32_t getOverrunCount()
+        {
+            return 0;
+        }
+    };
+
+    /**
+     * @brief Adapts any Arduino style stream to SerialTransport.
+     * This covers HardwareSerial, USB CDC, SoftwareSerial, PIO UARTs, etc.
+     * T's available() and read() are called through T itself. With a concrete type (eg Uart rather than HardwareSerial),
+     * the compiler can call them directly and inline them, instead of going through HardwareSerial's virtual functions.
+     */
+    template <typename T>
+    class StreamTransport final : public SerialTransport
+    {
+      public:
+        StreamTransport(T *stream)
+        {
+            _stream = stream;
+        }
+
+        void begin(unsigned long baudRate) override
+        {
+            _stream->begin(baudRate);
+        }
+
+        void end() override
+        {
+            _stream->end();
+        }
+
+        size_t read(uint8_t *buffer, size_t size) override
+        {
+            const int available = _stream->available();
+            const size_t count = available <= 0 ? 0 : ((size_t)available < size ? (size_t)available : size);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                buffer[i] = (uint8_t)_stream->read();
+            }
+
+            return count;
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) override
+        {
+            return _stream->write(buffer, size);
+        }
+
+        void flush() override
+        {
+            _stream->flush();
+        }
+
+      private:
+        T *_stream;
+    };
+} // namespace hal
@@ -0,0 +1,274 @@
+/**
+ * @file UdpSerial.cpp
+ * @author CRSF for Arduino contributors
+ * @brief Carries raw CRSF frames over UDP, for software-in-the-loop simulation on Linux hosts.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This source file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UdpSerial.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "arpa/inet.h"
+#include "errno.h"
+#include "poll.h"
+#include "sys/socket.h"
+#include "unistd.h"
+
+namespace hal
+{
+    /**
+     * @brief Construct a new UDP Serial object. The socket is opened in begin().
+     *
+     * @param localPort The UDP port that CRSF frames arrive on. 0 lets the kernel pick one (see getLocalPort()).
+     * @param remotePort The UDP port that telemetry is sent to. 0 replies to whoever sent the most recent datagram.
+     * @param host The address to listen on and to send telemetry to. Defaults to localhost.
+     */
+    UdpSerial::UdpSerial(uint16_t localPort, uint16_t remotePort, const char *host)
+    {
+        _host = host;
+        _localPort = localPort;
+        _remotePort = remotePort;
+        _fd = -1;
+        _peerKnown = false;
+        memset(&_peer, 0, sizeof(_peer));
+        _rxHead = 0;
+        _rxTail = 0;
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    UdpSerial::~UdpSerial()
+    {
+        end();
+    }
+
+    /**
+     * @brief Opens and binds the socket. Use isOpen() afterwards to check whether this succeeded.
+     *
+     * @param baudRate Not used. Datagrams are delivered as fast as they arrive.
+     */
+    void UdpSerial::begin(unsigned long baudRate)
+    {
+        (void)baudRate;
+
+        if (_fd >= 0)
+        {
+            return;
+        }
+
+        _fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (_fd < 0)
+        {
+            return;
+        }
+
+        struct sockaddr_in local;
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons(_localPort);
+
+        if (inet_pton(AF_INET, _host, &local.sin_addr) != 1 || bind(_fd, (struct sockaddr *)&local, sizeof(local)) != 0)
+        {
+            close(_fd);
+            _fd = -1;
+            return;
+        }
+
+        if (_remotePort != 0)
+        {
+            _peer.sin_family = AF_INET;
+            _peer.sin_port = htons(_remotePort);
+            _peer.sin_addr = local.sin_addr;
+            _peerKnown = true;
+        }
+
+        _rxHead = 0;
+        _rxTail = 0;
+    }
+
+    void UdpSerial::end()
+    {
+        if (_fd >= 0)
+        {
+            close(_fd);
+            _fd = -1;
+        }
+
+        _rxHead = 0;
+        _rxTail = 0;
+    }
+
+    /**
+     * @brief Copies bytes from the current datagram into buffer.
+     * When the current datagram has been used up, this receives the next one (if there is one) without blocking.
+     */
+    size_t UdpSerial::read(uint8_t *buffer, size_t size)
+    {
+        if (_rxHead == _rxTail && _receiveDatagram() == 0)
+        {
+            return 0;
+        }
+
+        const size_t count = min(size, _rxTail - _rxHead);
+        memcpy(buffer, _rxBuffer + _rxHead, count);
+        _rxHead += count;
+        return count;
+    }
+
+    /**
+     * @brief Sends the buffer as a single datagram.
+     * The Telemetry layer writes each telemetry frame with one call, so each frame becomes one datagram.
+     */
+    size_t UdpSerial::write(const uint8_t *buffer, size_t size)
+    {
+        if (_fd < 0 || !_peerKnown)
+        {
+            _statistics.sendErrors++;
+            return 0;
+        }
+
+        ssize_t result;
+        do
+        {
+            result = sendto(_fd, buffer, size, 0, (const struct sockaddr *)&_peer, sizeof(_peer));
+        } while (result < 0 && errno == EINTR);
+
+        if (result < 0)
+        {
+            _statistics.sendErrors++;
+            return 0;
+        }
+
+        _statistics.datagramsSent++;
+        _statistics.bytesSent += (uint32_t)result;
+        return (size_t)result;
+    }
+
+    /**
+     * @brief Datagrams are sent as soon as they are written, so there is nothing to flush.
+     */
+    void UdpSerial::flush()
+    {
+    }
+
+    bool UdpSerial::isOpen()
+    {
+        return _fd >= 0;
+    }
+
+    int UdpSerial::getFileDescriptor()
+    {
+        return _fd;
+    }
+
+    /**
+     * @brief Returns the UDP port that the socket is bound to. Useful when the kernel picked it.
+     */
+    uint16_t UdpSerial::getLocalPort()
+    {
+        struct sockaddr_in local;
+        socklen_t length = sizeof(local);
+
+        if (_fd < 0 || getsockname(_fd, (struct sockaddr *)&local, &length) != 0)
+        {
+            return 0;
+        }
+
+        return ntohs(local.sin_port);
+    }
+
+    /**
+     * @brief Blocks until a datagram arrives or the timeout expires.
+     *
+     * @param timeoutMs The timeout in milliseconds. -1 waits forever.
+     * @return true if there is data to read.
+     */
+    bool UdpSerial::waitForData(int timeoutMs)
+    {
+        if (_rxHead != _rxTail)
+        {
+            return true;
+        }
+
+        if (_fd < 0)
+        {
+            return false;
+        }
+
+        struct pollfd pfd = {_fd, POLLIN, 0};
+        return poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN);
+    }
+
+    void UdpSerial::getStatistics(udpSerialStatistics_t *statistics)
+    {
+        memcpy(statistics, &_statistics, sizeof(udpSerialStatistics_t));
+    }
+
+    void UdpSerial::resetStatistics()
+    {
+        memset(&_statistics, 0, sizeof(_statistics));
+    }
+
+    size_t UdpSerial::_receiveDatagram()
+    {
+        _rxHead = 0;
+        _rxTail = 0;
+
+        if (_fd < 0)
+        {
+            return 0;
+        }
+
+        struct sockaddr_in source;
+        socklen_t sourceLength = sizeof(source);
+        ssize_t result;
+        do
+        {
+            result = recvfrom(_fd, _rxBuffer, sizeof(_rxBuffer), MSG_TRUNC, (struct sockaddr *)&source, &sourceLength);
+        } while (result < 0 && errno == EINTR);
+
+        if (result <= 0)
+        {
+            return 0;
+        }
+
+        // With MSG_TRUNC, recvfrom() returns the real size of the datagram, even if it did not fit.
+        if ((size_t)result > sizeof(_rxBuffer))
+        {
+            _statistics.datagramsTruncated++;
+            result = sizeof(_rxBuffer);
+        }
+
+        if (_remotePort == 0)
+        {
+            memcpy(&_peer, &source, sizeof(_peer));
+            _peerKnown = true;
+        }
+
+        _rxTail = (size_t)result;
+        _statistics.datagramsReceived++;
+        _statistics.bytesReceived += (uint32_t)result;
+        return _rxTail;
+    }
+} // namespace hal
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,95 @@
+/**
+ * @file UdpSerial.hpp
+ * @author CRSF for Arduino contributors
+ * @brief Carries raw CRSF frames over UDP, for software-in-the-loop simulation on Linux hosts.
+ * @version 1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026, CRSF for Arduino contributors. All rights reserved.
+ *
+ * @section License GNU General Public License v3.0
+ * This header file is a part of the CRSF for Arduino library.
+ * CRSF for Arduino is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CRSF for Arduino is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CRSF for Arduino.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "../../CFA_Config.hpp"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "../SerialTransport/SerialTransport.hpp"
+#include "netinet/in.h"
+
+namespace hal
+{
+#define UDP_SERIAL_DATAGRAM_SIZE_MAX 2048
+#define UDP_SERIAL_DEFAULT_HOST      "127.0.0.1"
+
+    typedef struct udpSerialStatistics_s
+    {
+        uint32_t datagramsReceived;  // Datagrams received.
+        uint32_t datagramsTruncated; // Datagrams that were larger than UDP_SERIAL_DATAGRAM_SIZE_MAX. The excess was lost.
+        uint32_t bytesReceived;      // Bytes received.
+        uint32_t datagramsSent;      // Datagrams sent.
+        uint32_t sendErrors;         // Datagrams that could not be sent, eg because no peer is known yet.
+        uint32_t bytesSent;          // Bytes sent.
+    } udpSerialStatistics_t;
+
+    /**
+     * @brief A serial port that receives CRSF frames from UDP datagrams, and sends telemetry back as datagrams.
+     * Each datagram carries one or more whole CRSF frames. The bytes are handed to the Serial Receiver in order,
+     * exactly as if they had arrived on a UART, so a simulator can drive CRSF for Arduino without any hardware.
+     */
+    class UdpSerial final : public SerialTransport
+    {
+      public:
+        UdpSerial(uint16_t localPort, uint16_t remotePort = 0, const char *host = UDP_SERIAL_DEFAULT_HOST);
+        ~UdpSerial();
+
+        void begin(unsigned long baudRate) override;
+        void end() override;
+        size_t read(uint8_t *buffer, size_t size) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        void flush() override;
+
+        bool isOpen();
+        int getFileDescriptor();
+        uint16_t getLocalPort();
+        bool waitForData(int timeoutMs);
+
+        void getStatistics(udpSerialStatistics_t *statistics);
+        void resetStatistics();
+
+      private:
+        const char *_host;
+        uint16_t _localPort;
+        uint16_t _remotePort;
+        int _fd;
+
+        struct sockaddr_in _peer;
+        bool _peerKnown;
+
+        uint8_t _rxBuffer[UDP_SERIAL_DATAGRAM_SIZE_MAX];
+        size_t _rxHead;
+        size_t _rxTail;
+
+        udpSerialStatistics_t _statistics;
+
+        size_t _receiveDatagram();
+    };
+} // namespace hal
+
+#endif // __linux__ && !ARDUINO